@@ -0,0 +1,97 @@
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "adaptor/scan_codec.hpp"
+
+using namespace duan;
+
+namespace {
+
+/*
+生成一帧模拟的多线雷达扫描：
+下方的线打到地面，上方的线打到随方位角缓慢变化的墙面，
+叠加1cm量级的噪声和少量无回波点
+*/
+RangeScan makeScene(int rings, int beams, std::mt19937& gen) {
+    std::normal_distribution<float> noise(0.0f, 0.01f);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    RangeScan scan;
+    scan.rings = rings;
+    scan.beams = beams;
+    scan.ranges.resize(static_cast<size_t>(rings) * beams);
+    for (int ring = 0; ring < rings; ++ring) {
+        float elevation = -25.0f + 40.0f * ring / (rings - 1);
+        for (int b = 0; b < beams; ++b) {
+            float azimuth = 6.2831853f * b / beams;
+            float range;
+            if (elevation < -2.0f) {
+                range = 1.8f / std::sin(-elevation * 0.0174533f);
+            } else {
+                range = 20.0f + 8.0f * std::sin(azimuth * 3.0f) + 2.0f * std::cos(azimuth * 11.0f);
+            }
+            range += noise(gen);
+            if (uniform(gen) < 0.02f) {
+                range = 0.0f; // 无回波
+            }
+            scan.ranges[static_cast<size_t>(ring) * beams + b] = range;
+        }
+    }
+    return scan;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+int main() {
+    const int rings = 128;
+    const int beams = 2048;
+    const int frames = 50;
+    const double scan_rate_hz = 10.0;
+
+    std::mt19937 gen(1);
+    std::vector<RangeScan> scans;
+    for (int i = 0; i < frames; ++i) {
+        scans.push_back(makeScene(rings, beams, gen));
+    }
+    const double raw_bytes = static_cast<double>(frames) * rings * beams * sizeof(float);
+
+    std::cout << "=== 激光雷达扫描编解码基准 ===" << std::endl;
+    std::cout << "帧: " << frames << " x " << rings << " 线 x " << beams << " 点" << std::endl;
+
+    for (float precision : {0.001f, 0.005f, 0.02f}) {
+        ScanCodecOptions options;
+        options.precision = precision;
+        ScanEncoder encoder(options);
+        std::vector<uint8_t> stream;
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (const auto& scan : scans) {
+            encoder.encode(scan, stream);
+        }
+        double encode_s = secondsSince(t0);
+
+        ScanDecoder decoder;
+        RangeScan decoded;
+        size_t offset = 0;
+        t0 = std::chrono::steady_clock::now();
+        while (offset < stream.size()) {
+            offset += decoder.decode(stream.data() + offset, stream.size() - offset, decoded);
+        }
+        double decode_s = secondsSince(t0);
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << "精度 " << precision * 1000.0f << " mm"
+                  << " | 压缩比 " << std::setprecision(2) << raw_bytes / stream.size() << "x"
+                  << " | 编码 " << raw_bytes / encode_s / 1e9 << " GB/s"
+                  << " | 解码 " << raw_bytes / decode_s / 1e9 << " GB/s"
+                  << " | 解码实时倍率 " << std::setprecision(1)
+                  << (frames / decode_s) / scan_rate_hz << "x @" << scan_rate_hz << "Hz" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "adaptor/sensor_manager.hpp"
+#include "adaptor/static_sensor_manager.hpp"
+
+using namespace duan;
+
+namespace {
+
+double nanosSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+轻量的模拟传感器：每帧只有16个数据点，
+让采集本身足够便宜，从而暴露管理器的分发开销
+K 只用于生成不同的类型
+*/
+template <int K>
+class BenchSensor : public SensorInterface {
+    double timestamp_ = 0.0;
+    bool running_ = false;
+
+public:
+    bool init() override {
+        running_ = true;
+        return true;
+    }
+    SensorDate getSensorData() override {
+        timestamp_ += 0.01;
+        SensorDate data(timestamp_, "bench");
+        data.points.assign(16, static_cast<double>(K));
+        return data;
+    }
+    void stop() override { running_ = false; }
+    std::string getName() const override { return "bench_" + std::to_string(K); }
+};
+
+// 模拟使用者对每帧数据的转换
+inline double convert(const SensorInterface::SensorDate& data) {
+    double sum = 0.0;
+    for (double v : data.points) {
+        sum += v * 0.5;
+    }
+    return sum;
+}
+
+}
+
+int main() {
+    const int rounds = 200000;
+    std::cout << "=== 传感器管理器分发开销基准 ===" << std::endl;
+    std::cout << "8 个传感器, " << rounds << " 轮采集" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+
+    SensorManager dynamic_manager;
+    dynamic_manager.addSensor(std::make_unique<BenchSensor<0>>());
+    dynamic_manager.addSensor(std::make_unique<BenchSensor<1>>());
+    dynamic_manager.addSensor(std::make_unique<BenchSensor<2>>());
+    dynamic_manager.addSensor(std::make_unique<BenchSensor<3>>());
+    dynamic_manager.addSensor(std::make_unique<BenchSensor<4>>());
+    dynamic_manager.addSensor(std::make_unique<BenchSensor<5>>());
+    dynamic_manager.addSensor(std::make_unique<BenchSensor<6>>());
+    dynamic_manager.addSensor(std::make_unique<BenchSensor<7>>());
+
+    using Static = StaticSensorManager<BenchSensor<0>, BenchSensor<1>, BenchSensor<2>, BenchSensor<3>,
+                                       BenchSensor<4>, BenchSensor<5>, BenchSensor<6>, BenchSensor<7>>;
+    std::tuple<> none;
+    Static static_manager(none, none, none, none, none, none, none, none);
+
+    std::cout.setstate(std::ios::failbit);  // 屏蔽初始化日志
+    dynamic_manager.initSensors();
+    static_manager.initSensors();
+    std::cout.clear();
+
+    double checksum = 0.0;
+
+    // 采集并存入容器
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        auto frames = dynamic_manager.acquireAll();
+        checksum += frames.back().timestamp;
+    }
+    const double dynamic_ns = nanosSince(t0) / rounds;
+
+    t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        auto frames = static_manager.acquireAll();
+        checksum += frames.back().timestamp;
+    }
+    const double static_ns = nanosSince(t0) / rounds;
+
+    // 采集后立即转换
+    t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const auto& data : dynamic_manager.acquireAll()) {
+            checksum += convert(data);
+        }
+    }
+    const double dynamic_convert_ns = nanosSince(t0) / rounds;
+
+    t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        static_manager.acquireEach([&checksum](auto, auto&, const SensorInterface::SensorDate& data) {
+            checksum += convert(data);
+        });
+    }
+    const double static_convert_ns = nanosSince(t0) / rounds;
+
+    // 只比较分发本身：不记录统计，直接调用 getSensorData 并转换
+    std::vector<std::unique_ptr<SensorInterface>> raw;
+    raw.push_back(std::make_unique<BenchSensor<0>>());
+    raw.push_back(std::make_unique<BenchSensor<1>>());
+    raw.push_back(std::make_unique<BenchSensor<2>>());
+    raw.push_back(std::make_unique<BenchSensor<3>>());
+    raw.push_back(std::make_unique<BenchSensor<4>>());
+    raw.push_back(std::make_unique<BenchSensor<5>>());
+    raw.push_back(std::make_unique<BenchSensor<6>>());
+    raw.push_back(std::make_unique<BenchSensor<7>>());
+    t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (auto& sensor : raw) {
+            checksum += convert(sensor->getSensorData());
+        }
+    }
+    const double dynamic_raw_ns = nanosSince(t0) / rounds;
+
+    t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        static_manager.forEach([&checksum](auto& sensor) { checksum += convert(sensor.getSensorData()); });
+    }
+    const double static_raw_ns = nanosSince(t0) / rounds;
+
+    std::cout << "acquireAll         动态: " << dynamic_ns << " ns/轮, 静态: " << static_ns
+              << " ns/轮 (" << std::setprecision(2) << dynamic_ns / static_ns << "x)" << std::endl;
+    std::cout << std::setprecision(1);
+    std::cout << "采集+转换          动态: " << dynamic_convert_ns << " ns/轮, 静态: " << static_convert_ns
+              << " ns/轮 (" << std::setprecision(2) << dynamic_convert_ns / static_convert_ns << "x)" << std::endl;
+    std::cout << std::setprecision(1);
+    std::cout << "仅分发(无统计)     动态: " << dynamic_raw_ns << " ns/轮, 静态: " << static_raw_ns
+              << " ns/轮 (" << std::setprecision(2) << dynamic_raw_ns / static_raw_ns << "x)" << std::endl;
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+    return 0;
+}
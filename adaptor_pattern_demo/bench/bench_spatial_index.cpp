@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "adaptor/spatial_index.hpp"
+
+using namespace duan;
+
+namespace {
+
+double millisSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 模拟一帧道路场景: 地面 + 两侧墙面 + 若干障碍物
+PointCloud makeScene(size_t n, std::mt19937& gen) {
+    std::uniform_real_distribution<float> along(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> across(-15.0f, 15.0f);
+    std::uniform_real_distribution<float> height(0.0f, 3.0f);
+    std::normal_distribution<float> noise(0.0f, 0.02f);
+    std::uniform_int_distribution<int> kind(0, 9);
+    PointCloud cloud;
+    cloud.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        int k = kind(gen);
+        if (k < 6) {
+            cloud.push_back(along(gen), across(gen), noise(gen));
+        } else if (k < 9) {
+            cloud.push_back(along(gen), (k == 6 ? -15.0f : 15.0f) + noise(gen), height(gen));
+        } else {
+            cloud.push_back(along(gen) * 0.2f, across(gen) * 0.3f, height(gen) * 0.5f);
+        }
+    }
+    return cloud;
+}
+
+void bruteForceKnn(const PointCloud& cloud, float x, float y, float z, size_t k, std::vector<Neighbor>& out) {
+    out.clear();
+    for (size_t i = 0; i < cloud.size(); ++i) {
+        float dx = cloud.x[i] - x, dy = cloud.y[i] - y, dz = cloud.z[i] - z;
+        Neighbor candidate{static_cast<uint32_t>(i), dx * dx + dy * dy + dz * dz};
+        if (out.size() < k) {
+            out.push_back(candidate);
+            std::push_heap(out.begin(), out.end());
+        } else if (candidate < out.front()) {
+            std::pop_heap(out.begin(), out.end());
+            out.back() = candidate;
+            std::push_heap(out.begin(), out.end());
+        }
+    }
+    std::sort_heap(out.begin(), out.end());
+}
+
+}
+
+int main() {
+    const size_t num_points = 100000;
+    const size_t num_queries = 10000;
+    const size_t k = 8;
+    const float radius = 0.5f;
+
+    std::mt19937 gen(5);
+    PointCloud cloud = makeScene(num_points, gen);
+    PointCloud queries = makeScene(num_queries, gen);
+    std::vector<Neighbor> result;
+
+    std::cout << "=== 空间索引基准 ===" << std::endl;
+    std::cout << "点数: " << num_points << ", 查询数: " << num_queries
+              << ", k=" << k << ", 半径=" << radius << "m" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+
+    // 暴力搜索只跑一部分查询再换算
+    const size_t brute_queries = 500;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t q = 0; q < brute_queries; ++q) {
+        bruteForceKnn(cloud, queries.x[q], queries.y[q], queries.z[q], k, result);
+    }
+    double brute_ms = millisSince(t0) * num_queries / brute_queries;
+    std::cout << "暴力搜索 knn: " << brute_ms << " ms (按" << brute_queries << "次查询换算)" << std::endl;
+
+    for (int threads : {1, 0}) {
+        KdTree tree;
+        t0 = std::chrono::steady_clock::now();
+        tree.build(cloud, threads);
+        double build_ms = millisSince(t0);
+
+        HashedGrid grid(0.5f);
+        t0 = std::chrono::steady_clock::now();
+        grid.build(cloud, threads);
+        double grid_build_ms = millisSince(t0);
+        std::cout << "构建 (" << (threads == 1 ? "单线程" : "多线程") << "): k-d树 " << build_ms
+                  << " ms, 哈希栅格 " << grid_build_ms << " ms" << std::endl;
+        if (threads != 1) {
+            continue;
+        }
+
+        size_t found = 0;
+        t0 = std::chrono::steady_clock::now();
+        for (size_t q = 0; q < num_queries; ++q) {
+            tree.knn(queries.x[q], queries.y[q], queries.z[q], k, result);
+            found += result.size();
+        }
+        double kd_knn_ms = millisSince(t0);
+
+        t0 = std::chrono::steady_clock::now();
+        for (size_t q = 0; q < num_queries; ++q) {
+            grid.knn(queries.x[q], queries.y[q], queries.z[q], k, result);
+            found += result.size();
+        }
+        double grid_knn_ms = millisSince(t0);
+
+        t0 = std::chrono::steady_clock::now();
+        for (size_t q = 0; q < num_queries; ++q) {
+            tree.radius(queries.x[q], queries.y[q], queries.z[q], radius, result);
+            found += result.size();
+        }
+        double kd_radius_ms = millisSince(t0);
+
+        t0 = std::chrono::steady_clock::now();
+        for (size_t q = 0; q < num_queries; ++q) {
+            grid.radius(queries.x[q], queries.y[q], queries.z[q], radius, result);
+            found += result.size();
+        }
+        double grid_radius_ms = millisSince(t0);
+
+        std::cout << "knn:  k-d树 " << kd_knn_ms << " ms (" << brute_ms / kd_knn_ms << "x), 哈希栅格 "
+                  << grid_knn_ms << " ms (" << brute_ms / grid_knn_ms << "x)" << std::endl;
+        std::cout << "半径: k-d树 " << kd_radius_ms << " ms, 哈希栅格 " << grid_radius_ms << " ms"
+                  << " (结果总数 " << found << ")" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,153 @@
+#ifndef IMAGE_FRAME_H
+#define IMAGE_FRAME_H
+
+#include "simd_dispatch.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace duan {
+
+/*
+ * 像素格式
+ * Packed: 各通道交错存放在一个平面内 (RGBRGB...)
+ * Planar: 每个通道一个平面
+ */
+enum class PixelFormat {
+    Gray8,
+    Gray16,
+    RGB8,        // packed, 8位
+    BGR8,        // packed, 8位
+    RGBA8,       // packed, 8位
+    RGB16,       // packed, 16位
+    RGB8Planar,  // 3个全分辨率平面
+    YUV420P      // Y全分辨率，U/V宽高各减半
+};
+
+/*
+ * 像素格式描述
+ */
+struct PixelFormatInfo {
+    int planes;             // 平面数
+    int channels;           // 每个平面内交错的通道数
+    int bytes_per_channel;  // 1 或 2
+    int chroma_shift;       // 第1个平面之后的平面宽高右移位数 (YUV420P为1)
+};
+
+PixelFormatInfo pixelFormatInfo(PixelFormat format);
+const char* pixelFormatName(PixelFormat format);
+
+/*
+ * 图像缓冲池
+ * 按字节数分桶缓存已释放的对齐内存，避免每帧都向系统申请几MB内存
+ * 缓冲区以 shared_ptr 形式借出，最后一个引用释放时自动归还；池销毁后归还的内存直接释放
+ */
+class ImageBufferPool {
+private:
+    struct State {
+        std::mutex mutex;
+        std::unordered_map<size_t, std::vector<uint8_t*>> free_lists;
+        size_t max_cached_per_size;
+        size_t allocations = 0;
+        size_t reuses = 0;
+        ~State();
+    };
+    std::shared_ptr<State> state_;
+
+public:
+    explicit ImageBufferPool(size_t max_cached_per_size = 8);
+
+    // 借出至少 bytes 字节、按 kAlignment 对齐的缓冲区
+    std::shared_ptr<uint8_t> acquire(size_t bytes);
+
+    size_t allocations() const; // 向系统申请内存的次数
+    size_t reuses() const;      // 复用缓存的次数
+
+    static constexpr size_t kAlignment = 64;
+};
+
+/*
+ * 图像帧
+ * 每个平面的行首按64字节对齐，stride 为相邻两行的字节距离（可能大于有效像素字节数）
+ * 复制 ImageFrame 只复制句柄，像素内存共享；需要深拷贝时使用 clone()
+ */
+class ImageFrame {
+private:
+    int width_;
+    int height_;
+    PixelFormat format_;
+    std::shared_ptr<uint8_t> storage_;
+    size_t byte_size_;
+    uint8_t* planes_[3];
+    size_t strides_[3];
+
+    // 按宽高格式计算各平面的 stride 与偏移，返回总字节数
+    size_t layout(size_t offsets[3]);
+
+public:
+    double timestamp = 0.0;
+    std::string frame_id = "camera";
+
+    ImageFrame();
+
+    // 分配一帧图像，pool 为空时直接向系统申请
+    static ImageFrame allocate(int width, int height, PixelFormat format, ImageBufferPool* pool = nullptr);
+
+    // 在外部内存上构造图像（不复制），布局与 allocate 相同
+    // storage 需按 kAlignment 对齐且不小于 requiredBytes()，由 storage 的引用计数管理生命周期
+    static ImageFrame wrap(int width, int height, PixelFormat format, std::shared_ptr<uint8_t> storage);
+    static size_t requiredBytes(int width, int height, PixelFormat format);
+
+    bool empty() const { return !storage_; }
+    int width() const { return width_; }
+    int height() const { return height_; }
+    PixelFormat format() const { return format_; }
+    int planeCount() const;
+    int planeWidth(int plane) const;   // 像素数
+    int planeHeight(int plane) const;
+    size_t rowBytes(int plane) const;  // 一行有效像素的字节数
+    size_t stride(int plane = 0) const { return strides_[plane]; }
+    size_t byteSize() const { return byte_size_; }
+
+    uint8_t* data(int plane = 0) { return planes_[plane]; }
+    const uint8_t* data(int plane = 0) const { return planes_[plane]; }
+
+    template <typename T = uint8_t>
+    T* row(int y, int plane = 0) {
+        return reinterpret_cast<T*>(planes_[plane] + static_cast<size_t>(y) * strides_[plane]);
+    }
+    template <typename T = uint8_t>
+    const T* row(int y, int plane = 0) const {
+        return reinterpret_cast<const T*>(planes_[plane] + static_cast<size_t>(y) * strides_[plane]);
+    }
+
+    ImageFrame clone(ImageBufferPool* pool = nullptr) const;
+};
+
+/*
+颜色转换
+支持: RGB8/BGR8/RGBA8 -> Gray8 (整数权重 77/150/29，与BT.601一致)
+      RGB8 <-> BGR8
+      RGB8 -> RGB8Planar, RGB8Planar -> RGB8
+      Gray16 -> Gray8 (取高8位)
+8位格式走SSE4.1路径 (pshufb拆分/交错通道)，输出与标量实现逐字节相同
+level 用于强制指定指令集（会被限制在CPU支持范围内）
+不支持的组合抛出 std::invalid_argument
+*/
+ImageFrame convertImage(const ImageFrame& src, PixelFormat dst_format, ImageBufferPool* pool = nullptr,
+                        SimdLevel level = SimdLevel::AVX2);
+
+/*
+2x2 盒式滤波降采样，宽高各减半（向下取整）
+每个输出像素为 (a + b + c + d + 2) >> 2，8位单通道平面走AVX2/SSE4.1路径，
+其余格式走通用标量实现
+*/
+ImageFrame downscale2x(const ImageFrame& src, ImageBufferPool* pool = nullptr, SimdLevel level = SimdLevel::AVX2);
+
+}
+
+#endif
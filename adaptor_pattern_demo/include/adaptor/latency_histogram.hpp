@@ -0,0 +1,61 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace duan {
+
+/*
+ * 直方图快照，时间单位为微秒
+ */
+struct HistogramSnapshot {
+    uint64_t count = 0;
+    double mean_us = 0.0;
+    double max_us = 0.0;
+    double p50_us = 0.0;
+    double p90_us = 0.0;
+    double p99_us = 0.0;
+    double p999_us = 0.0;
+};
+
+std::ostream& operator<<(std::ostream& os, const HistogramSnapshot& snapshot);
+
+/*
+ * 无锁的HDR风格延迟直方图（纳秒）
+ * 对数-线性分桶：小于32ns的值每纳秒一个桶，之后每翻一倍分16个桶，相对误差不超过 1/16
+ * record 只做一次 relaxed 原子加，可被多个线程同时调用；
+ * snapshot 读取时可能与写入交错，结果是近似一致的
+ */
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 4;
+    static constexpr uint64_t kMaxValue = (uint64_t(1) << 40) - 1; // 约18分钟，超过的值按上限计
+    static constexpr size_t kBucketCount = 32 + (40 - 5) * 16;
+
+    LatencyHistogram();
+
+    void record(uint64_t value_ns);
+    void reset();
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    HistogramSnapshot snapshot() const;
+
+    // 按分位数查询，返回对应桶的上界（纳秒）
+    uint64_t percentile(double p) const;
+
+private:
+    static size_t bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(size_t index);
+
+    std::atomic<uint64_t> buckets_[kBucketCount];
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> max_;
+};
+
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "sensor_interface.hpp"
 #include "legacy_lidar.hpp"
+#include "point_projection.hpp"
 #include <memory>
 
 namespace duan {
@@ -15,6 +16,7 @@ class LidarAdaptor : public SensorInterface {
 private:
     std::unique_ptr<LegacyLidar> legacy_lidar_; // 老式激光雷达实例
     std::string adaptor_name_; // 适配器名称
+    ScanProjector projector_; // 距离到点云的投影（单线360个方位）
 
 public:
     explicit LidarAdaptor(const std::string& device_id);
@@ -26,6 +28,9 @@ public:
     void stop() override;
     std::string getName() const override;
 
+    // 获取投影后的笛卡尔点云，设备未运行时返回空点云
+    PointCloud getPointCloud();
+
 private:
     // 数据转换辅助函数
     std::vector<double> convertFloatToDouble(const std::vector<float>& input);
@@ -13,9 +13,13 @@ class ModernCamera : public SensorInterface {
 private:
     bool is_initialized_; // 摄像头是否已初始化
     std::string camera_name_; // 摄像头名称
+    int width_; // 图像宽度
+    int height_; // 图像高度
+    uint64_t frame_count_; // 已输出的帧数
+    ImageBufferPool pool_; // 图像缓冲池，帧被使用者释放后内存回到池中
 
 public:
-    explicit ModernCamera(const std::string& name);
+    explicit ModernCamera(const std::string& name, int width = 640, int height = 480);
     virtual ~ModernCamera();
 
     bool init() override;
@@ -0,0 +1,132 @@
+#ifndef OCCUPANCY_GRID_H
+#define OCCUPANCY_GRID_H
+
+#include "point_cloud.hpp"
+#include "point_projection.hpp"
+#include "simd_dispatch.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace duan {
+
+/*
+ * 占据栅格参数
+ * 概率以 log-odds 存储: l = log(p / (1 - p))，0 表示未知
+ */
+struct OccupancyGridConfig {
+    float resolution = 0.2f;        // 每格边长 (米)
+    int size_cells = 512;           // 窗口边长 (格)，必须是2的幂且不小于 kTileSize
+    float log_odds_hit = 0.85f;     // 端点所在格子的增量
+    float log_odds_miss = -0.4f;    // 射线穿过的格子的增量
+    float log_odds_min = -2.0f;     // 限幅，避免长期静止后无法翻转
+    float log_odds_max = 3.5f;
+    float occupied_threshold = 0.85f; // log-odds 大于该值视为占据 (p > 0.7)
+    float free_threshold = -0.4f;     // log-odds 小于该值视为空闲
+    float max_range = 60.0f;        // 超过该距离的回波只更新空闲，不记为障碍
+    bool no_return_as_free = false; // 无回波 (距离为0) 时是否沿射线清空到 max_range
+};
+
+// 传感器在世界坐标下的平面位姿
+struct Pose2D {
+    float x = 0.0f;
+    float y = 0.0f;
+    float yaw = 0.0f;   // 弧度
+};
+
+enum class CellState {
+    Unknown,
+    Free,
+    Occupied
+};
+
+// 世界坐标下的 tile 编号（tile 左下角格子 = tile * kTileSize）
+struct TileCoord {
+    int64_t x;
+    int64_t y;
+};
+
+/*
+ * 车辆周围的滚动二维占据栅格
+ *
+ * 存储: 按 16x16 的 tile 分块，tile 内 256 个格子连续存放，
+ *       射线附近的格子落在少数几个 tile 里，缓存命中率高
+ * 滚动: tile 以世界坐标取模映射到存储位置，车辆移动时只清空移出窗口的 tile，
+ *       已有数据不搬动
+ * 更新: 同一帧内每个格子最多更新一次，端点优先于穿过；
+ *       被修改的 tile 记入脏列表，下游可以只处理变化部分
+ * 射线: 按主轴方向等步长采样 (DDA)，AVX2 路径一次推进8条射线并行计算格子下标，
+ *       与标量路径的浮点运算顺序一致，结果逐位相同
+ */
+class OccupancyGrid {
+public:
+    static constexpr int kTileSize = 16;
+
+    explicit OccupancyGrid(const OccupancyGridConfig& config = OccupancyGridConfig());
+
+    /*
+    插入一帧距离扫描，pose 为传感器位姿
+    水平距离 = range * cos(俯仰角)，所有 ring 都投影到平面
+    scan 的 rings/beams 与几何参数不一致时抛出 std::invalid_argument
+    */
+    void integrate(const RangeScan& scan, const LidarGeometry& geometry, const Pose2D& pose,
+                   SimdLevel level = SimdLevel::AVX2);
+
+    /*
+    插入一帧传感器坐标系下的点云，只使用 z 在 [min_z, max_z] 内的点
+    */
+    void integrate(const PointCloud& cloud, const Pose2D& pose, float min_z, float max_z,
+                   SimdLevel level = SimdLevel::AVX2);
+
+    // 把窗口中心移动到 (x, y) 附近（按 tile 对齐），移出窗口的 tile 被清空
+    void recenter(float x, float y);
+    void clear();
+
+    // O(1) 查询，窗口外返回未知
+    float logOdds(float x, float y) const;
+    float probability(float x, float y) const;
+    CellState state(float x, float y) const;
+    bool isOccupied(float x, float y) const { return logOdds(x, y) > config_.occupied_threshold; }
+
+    // 自上次 clearDirty() 以来被修改（或因滚动被清空）的 tile
+    std::vector<TileCoord> dirtyTiles() const;
+    void clearDirty();
+
+    // 窗口左下角的世界坐标 (米)
+    double originX() const { return static_cast<double>(origin_cell_x_) * config_.resolution; }
+    double originY() const { return static_cast<double>(origin_cell_y_) * config_.resolution; }
+    const OccupancyGridConfig& config() const { return config_; }
+    // 原始存储（按 tile 排列），用于调试与测试
+    const std::vector<float>& rawCells() const { return cells_; }
+
+private:
+    void integrateEndpoints(float sensor_x, float sensor_y, size_t count, SimdLevel level);
+    bool cellIndex(float x, float y, uint32_t& index) const;
+    uint32_t indexOf(int32_t cx, int32_t cy) const;
+    void markFree(uint32_t index);
+    void markTileDirty(uint32_t index);
+    void resetTile(uint32_t tile);
+
+    OccupancyGridConfig config_;
+    int tiles_per_side_;
+    int tile_shift_;                 // log2(tiles_per_side_)
+    int64_t origin_cell_x_ = 0;      // 窗口左下角的世界格子坐标，kTileSize 的倍数
+    int64_t origin_cell_y_ = 0;
+    bool has_origin_ = false;
+
+    std::vector<float> cells_;
+    std::vector<uint32_t> stamps_;   // 每格最近一次更新所在帧: 2*帧号 为空闲，2*帧号+1 为占据
+    uint32_t scan_id_ = 0;
+    std::vector<uint8_t> tile_dirty_;
+    std::vector<uint32_t> dirty_list_;
+
+    // 每帧复用的射线缓冲（窗口格子坐标）
+    std::vector<float> end_x_;
+    std::vector<float> end_y_;
+    std::vector<uint8_t> is_hit_;
+    std::vector<float> cos_az_;
+    std::vector<float> sin_az_;
+};
+
+}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef PARALLEL_UTILS_H
+#define PARALLEL_UTILS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace duan {
+
+/*
+将 [0, n) 平均切成 parts 段，对每段调用 fn(part, begin, end)
+第0段在调用线程上执行，其余各段各开一个线程，函数返回时全部完成
+*/
+template <typename Fn>
+void runPartitioned(size_t n, int parts, Fn&& fn) {
+    if (parts <= 1) {
+        fn(0, size_t(0), n);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(parts - 1);
+    const size_t chunk = (n + parts - 1) / parts;
+    for (int p = 1; p < parts; ++p) {
+        size_t begin = std::min(n, chunk * p);
+        size_t end = std::min(n, begin + chunk);
+        workers.emplace_back([&fn, p, begin, end] { fn(p, begin, end); });
+    }
+    fn(0, size_t(0), std::min(n, chunk));
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/*
+根据数据量决定分段数
+num_threads <= 0 表示使用硬件并发数；每段至少 min_per_part 个元素
+*/
+inline int choosePartitions(size_t n, int num_threads, size_t min_per_part) {
+    int threads = num_threads > 0 ? num_threads : static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(threads, 1);
+    size_t max_parts = std::max<size_t>(1, n / std::max<size_t>(1, min_per_part));
+    return static_cast<int>(std::min<size_t>(static_cast<size_t>(threads), max_parts));
+}
+
+}
+
+#endif
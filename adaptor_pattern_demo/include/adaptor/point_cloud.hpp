@@ -0,0 +1,67 @@
+#ifndef POINT_CLOUD_H
+#define POINT_CLOUD_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+namespace duan {
+
+/*
+ * 原始距离扫描
+ * 多线激光雷达按 ring 主序存放: ranges[ring * beams + beam]
+ * 单线雷达 (如LegacyLidar) 即 rings = 1
+ */
+struct RangeScan {
+    int rings = 1;               // 线数
+    int beams = 0;               // 每线的水平采样数
+    std::vector<float> ranges;   // 距离 (米)
+    double timestamp = 0.0;      // 扫描起始时间戳 (秒)
+    std::string frame_id = "base_link";
+
+    size_t size() const { return ranges.size(); }
+};
+
+/*
+ * 点云数据结构
+ * 采用SoA布局，x/y/z各自连续存放，方便SIMD批量处理
+ * 由投影得到的点云是稠密的，第i个点对应 RangeScan 中的第i个距离
+ */
+struct PointCloud {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    double timestamp = 0.0;      // 时间戳 (秒)
+    std::string frame_id = "base_link";
+
+    size_t size() const { return x.size(); }
+    bool empty() const { return x.empty(); }
+
+    void resize(size_t n) {
+        x.resize(n);
+        y.resize(n);
+        z.resize(n);
+    }
+
+    void reserve(size_t n) {
+        x.reserve(n);
+        y.reserve(n);
+        z.reserve(n);
+    }
+
+    void clear() {
+        x.clear();
+        y.clear();
+        z.clear();
+    }
+
+    void push_back(float px, float py, float pz) {
+        x.push_back(px);
+        y.push_back(py);
+        z.push_back(pz);
+    }
+};
+
+}
+
+#endif
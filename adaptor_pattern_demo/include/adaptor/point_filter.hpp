@@ -0,0 +1,69 @@
+#ifndef POINT_FILTER_H
+#define POINT_FILTER_H
+
+#include "point_cloud.hpp"
+#include "point_projection.hpp"
+#include "sensor_interface.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace duan {
+
+/*
+ * 点云过滤流水线
+ * 通过链式调用组合 ROI裁剪 / 距离门限 / 体素降采样：
+ *   PointFilterPipeline().cropBox(...).rangeGate(1.0f, 80.0f).voxelGrid(0.2f).apply(cloud);
+ * 所有步骤在同一次遍历中完成（融合），不产生中间点云
+ * 体素降采样使用开放寻址哈希表分桶，输出每个体素内点的质心，
+ * 体素按首个落入点的下标排序，输出顺序与线程数无关
+ * 点数超过并行阈值时按下标区间分块，多线程各自分桶后再合并
+ */
+class PointFilterPipeline {
+private:
+    bool crop_enabled_;
+    float min_x_, min_y_, min_z_;
+    float max_x_, max_y_, max_z_;
+
+    bool range_enabled_;
+    float min_range_sq_, max_range_sq_;
+
+    float leaf_size_; // <= 0 表示不做体素降采样
+
+    int num_threads_;            // 0 表示使用硬件并发数
+    size_t parallel_threshold_;  // 点数低于该值时单线程处理
+
+public:
+    PointFilterPipeline();
+
+    // ROI裁剪（闭区间）
+    PointFilterPipeline& cropBox(float min_x, float min_y, float min_z,
+                                 float max_x, float max_y, float max_z);
+    // 距离门限，保留 min_range <= |p| <= max_range 的点
+    PointFilterPipeline& rangeGate(float min_range, float max_range);
+    // 体素降采样，leaf_size为体素边长（米）
+    PointFilterPipeline& voxelGrid(float leaf_size);
+    // 线程数设置
+    PointFilterPipeline& threads(int num_threads, size_t parallel_threshold = 50000);
+
+    /*
+    执行过滤
+    非有限值 (NaN/Inf) 的点总是被丢弃
+    */
+    PointCloud apply(const PointCloud& in) const;
+
+    /*
+    直接处理传感器接口数据：points 视为按 ring 主序排列的距离，
+    先用 projector 投影再过滤
+    */
+    PointCloud apply(const SensorInterface::SensorDate& data, const ScanProjector& projector) const;
+
+private:
+    bool accept(float x, float y, float z) const;
+    int effectiveThreads(size_t n) const;
+    PointCloud gateOnly(const PointCloud& in) const;
+    PointCloud gateAndVoxelize(const PointCloud& in) const;
+};
+
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef POINT_PROJECTION_H
+#define POINT_PROJECTION_H
+
+#include "point_cloud.hpp"
+#include "simd_dispatch.hpp"
+#include "sensor_interface.hpp"
+#include <vector>
+
+namespace duan {
+
+/*
+ * 激光雷达几何参数
+ * 第 beam 个采样的方位角 = azimuth_start_deg + beam * azimuth_step_deg
+ * 第 ring 线的俯仰角 = elevations_deg[ring]
+ */
+struct LidarGeometry {
+    int beams = 360;
+    float azimuth_start_deg = 0.0f;
+    float azimuth_step_deg = 1.0f;
+    std::vector<float> elevations_deg{0.0f};
+
+    int rings() const { return static_cast<int>(elevations_deg.size()); }
+
+    // 单线雷达，水平面内均匀一圈
+    static LidarGeometry singleRing(int beams = 360);
+    // 多线雷达，俯仰角在 [min, max] 内均匀分布
+    static LidarGeometry uniform(int rings, int beams, float min_elevation_deg, float max_elevation_deg);
+};
+
+/*
+将传感器接口数据包装为距离扫描
+data.points 视为按 ring 主序排列的距离，beams = points.size() / rings
+*/
+RangeScan rangeScanFromSensorData(const SensorInterface::SensorDate& data, int rings = 1);
+
+/*
+ * 极坐标到笛卡尔坐标的投影
+ * 构造时预计算每个beam的 sin/cos 以及每条ring的 sin/cos，
+ * 投影时每个点只需乘法：
+ *   x = r * (cos_el * cos_az)
+ *   y = r * (cos_el * sin_az)
+ *   z = r * sin_el
+ * 运行时按CPU选择 AVX2 / SSE / Scalar，三条路径运算顺序一致，输出逐位相同
+ */
+class ScanProjector {
+private:
+    LidarGeometry geometry_;
+    std::vector<float> cos_az_; // 每个beam
+    std::vector<float> sin_az_;
+    std::vector<float> cos_el_; // 每条ring
+    std::vector<float> sin_el_;
+    SimdLevel level_;
+
+public:
+    explicit ScanProjector(const LidarGeometry& geometry);
+
+    /*
+    投影一帧扫描
+    scan 的 rings/beams 必须与几何参数一致，否则抛出 std::invalid_argument
+    输出为稠密点云，第i个点对应 scan.ranges[i]
+    */
+    void project(const RangeScan& scan, PointCloud& out) const;
+    PointCloud project(const RangeScan& scan) const;
+
+    // 指定指令集投影（会被限制在CPU支持范围内），主要用于测试和基准
+    void project(const RangeScan& scan, PointCloud& out, SimdLevel level) const;
+
+    const LidarGeometry& geometry() const { return geometry_; }
+    SimdLevel simdLevel() const { return level_; }
+};
+
+}
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef SCAN_CODEC_H
+#define SCAN_CODEC_H
+
+#include "point_cloud.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace duan {
+
+/*
+ * 激光雷达距离扫描编解码器
+ * 三个阶段：
+ *   1. 量化: q = round(range / precision)，非法距离 (<=0 / NaN / Inf) 记为0
+ *   2. 预测: 同一ring内与前一个有效beam做差，每条ring的第一个beam与上一条ring的第一个beam做差，
+ *      符号0保留给无回波点，避免掉点在前后各产生一次大跳变
+ *   3. 熵编码: 残差zigzag后按64个一组做自适应Rice编码，每组单独选择参数k
+ * 量化误差不超过 precision / 2
+ * 帧格式为小端序，包含自身长度，可以直接顺序拼接成录制文件
+ */
+struct ScanCodecOptions {
+    float precision = 0.005f; // 量化精度（米）
+};
+
+class ScanEncoder {
+private:
+    ScanCodecOptions options_;
+    std::vector<uint32_t> residuals_; // 复用的残差缓冲区
+
+public:
+    explicit ScanEncoder(const ScanCodecOptions& options = ScanCodecOptions());
+
+    /*
+    编码一帧并追加到 out 末尾
+    return 本帧写入的字节数
+    */
+    size_t encode(const RangeScan& scan, std::vector<uint8_t>& out);
+
+    const ScanCodecOptions& options() const { return options_; }
+};
+
+class ScanDecoder {
+private:
+    std::vector<uint32_t> residuals_;
+
+public:
+    /*
+    从 data 开头解码一帧
+    return 本帧消耗的字节数；数据不完整时返回0
+    数据损坏时抛出 std::runtime_error
+    */
+    size_t decode(const uint8_t* data, size_t size, RangeScan& out);
+
+    // 读取帧头中的帧长度，数据不足一个帧头时返回0
+    static size_t peekFrameSize(const uint8_t* data, size_t size);
+};
+
+/*
+ * 流式写入: 每次 write 编码一帧并写到输出流
+ */
+class ScanStreamWriter {
+private:
+    std::ostream& os_;
+    ScanEncoder encoder_;
+    std::vector<uint8_t> buffer_;
+    size_t frames_;
+    size_t bytes_;
+
+public:
+    explicit ScanStreamWriter(std::ostream& os, const ScanCodecOptions& options = ScanCodecOptions());
+
+    bool write(const RangeScan& scan);
+
+    size_t framesWritten() const { return frames_; }
+    size_t bytesWritten() const { return bytes_; }
+};
+
+/*
+ * 流式读取: 每次 read 从输入流读出一帧
+ */
+class ScanStreamReader {
+private:
+    std::istream& is_;
+    ScanDecoder decoder_;
+    std::vector<uint8_t> buffer_;
+
+public:
+    explicit ScanStreamReader(std::istream& is);
+
+    /*
+    读取下一帧
+    return 流结束时返回false；帧被截断或损坏时抛出 std::runtime_error
+    */
+    bool read(RangeScan& scan);
+};
+
+}
+
+#endif
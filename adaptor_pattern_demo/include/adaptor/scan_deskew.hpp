@@ -0,0 +1,78 @@
+#ifndef SCAN_DESKEW_H
+#define SCAN_DESKEW_H
+
+#include "point_cloud.hpp"
+#include "point_projection.hpp"
+#include "simd_dispatch.hpp"
+#include <vector>
+
+namespace duan {
+
+/*
+ * 车辆运动状态，字段与 VehicleState 一致
+ */
+struct VehicleMotion {
+    double speed_kmh = 0.0;           // 车速 (km/h)
+    double steering_angle_deg = 0.0;  // 转向角 (度)，经 steering_ratio 换算为前轮转角
+};
+
+struct DeskewConfig {
+    double scan_period_s = 0.1;       // 一圈扫描的时长，第 b 列的采样时刻 = 起始 + b / beams * period
+    double wheelbase_m = 2.8;         // 轴距，自行车模型: 横摆角速度 = v * tan(前轮转角) / 轴距
+    double steering_ratio = 1.0;      // 转向角 / 前轮转角
+    double sensor_offset_x = 0.0;     // 雷达相对后轴中心的安装位置 (米，车辆坐标系)
+    double sensor_offset_y = 0.0;
+    bool align_to_scan_end = true;    // true: 输出为扫描结束时刻的雷达坐标系；false: 扫描开始时刻
+};
+
+/*
+ * 激光雷达运动补偿（去畸变）
+ * 旋转雷达一圈扫描持续几十毫秒，车辆在此期间的移动会让点云拖影
+ * 按自行车模型对扫描开始/结束两个时刻的车速与转向线性插值，积分出每一列采样时刻的位姿，
+ * 再把每个点变换到参考时刻的雷达坐标系
+ *
+ * 每列的位姿与方位角合并成一张表: x = r * (cos_el * c[b]) + tx[b]，y 同理，z = r * sin_el
+ * 与投影一样每点只有乘加；按方位扇区切分到多个线程，每个扇区内 AVX2/SSE 向量化
+ * 各条路径运算顺序一致，输出逐位相同；距离为0（无回波）的点输出为原点，与 ScanProjector 一致
+ */
+class ScanDeskewer {
+public:
+    explicit ScanDeskewer(const LidarGeometry& geometry, const DeskewConfig& config = DeskewConfig());
+
+    /*
+    对一帧扫描做投影与运动补偿，scan.timestamp 为扫描起始时刻
+    threads <= 0 使用硬件并发数，点数较少时自动减少线程
+    scan 的 rings/beams 与几何参数不一致时抛出 std::invalid_argument
+    */
+    void deskew(const RangeScan& scan, const VehicleMotion& at_start, const VehicleMotion& at_end,
+                PointCloud& out, int threads = 1, SimdLevel level = SimdLevel::AVX2);
+    PointCloud deskew(const RangeScan& scan, const VehicleMotion& at_start, const VehicleMotion& at_end,
+                      int threads = 1);
+
+    // 扫描期间雷达的总位移与转角（参考时刻坐标系下，另一端时刻的位姿）
+    double sweepTranslation() const;
+    double sweepRotation() const;
+
+    const LidarGeometry& geometry() const { return geometry_; }
+    const DeskewConfig& config() const { return config_; }
+
+private:
+    void updateBeamPoses(const VehicleMotion& at_start, const VehicleMotion& at_end);
+
+    LidarGeometry geometry_;
+    DeskewConfig config_;
+    std::vector<double> az_rad_;     // 每列方位角
+    std::vector<float> cos_el_;
+    std::vector<float> sin_el_;
+    // 每列: 方位角叠加补偿转角后的 cos/sin，以及补偿平移
+    std::vector<float> col_cos_;
+    std::vector<float> col_sin_;
+    std::vector<float> col_tx_;
+    std::vector<float> col_ty_;
+    double sweep_translation_ = 0.0;   // 另一端时刻相对参考时刻的位移与转角
+    double sweep_rotation_ = 0.0;
+};
+
+}
+
+#endif
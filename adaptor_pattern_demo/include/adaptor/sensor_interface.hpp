@@ -3,6 +3,8 @@
 
 #include <vector>
 #include <string>
+#include <memory>
+#include "image_frame.hpp"
 
 namespace duan{
 
@@ -18,6 +20,7 @@ public:
         double timestamp; // 时间戳
         std::vector<double> points; // 传感器数据点
         std::string frame_id; // 坐标系ID
+        std::shared_ptr<const ImageFrame> image; // 图像数据（仅摄像头类传感器，其余为空）
 
         SensorDate(double ts = 0.0, const std::string& id = "base_link") : timestamp(ts), frame_id(id) {}
     };
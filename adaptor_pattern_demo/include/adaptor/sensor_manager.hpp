@@ -0,0 +1,128 @@
+#ifndef SENSOR_MANAGER_H
+#define SENSOR_MANAGER_H
+
+#include "sensor_interface.hpp"
+#include "latency_histogram.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace duan {
+
+/*
+ * 传感器的监控参数
+ */
+struct SensorOptions {
+    double deadline_ms = 200.0; // 两帧之间允许的最大间隔，超过视为丢帧/停滞
+};
+
+/*
+ * 单个传感器的统计数据快照
+ */
+struct SensorStatsSnapshot {
+    std::string name;
+    uint64_t frames = 0;           // 成功获取的帧数
+    uint64_t failed_reads = 0;     // 返回空数据的次数
+    uint64_t deadline_misses = 0;  // 帧间隔超过期限的次数
+    uint64_t stalls = 0;           // 看门狗判定停滞的次数
+    bool stalled = false;          // 当前是否处于停滞状态
+    double frame_rate_hz = 0.0;    // 由平均帧间隔换算的帧率
+    HistogramSnapshot acquisition; // getSensorData 耗时
+    HistogramSnapshot frame_age;   // 交给使用者时帧的年龄（当前时间 - 帧时间戳）
+    HistogramSnapshot frame_interval; // 相邻两帧的间隔
+};
+
+/*
+ * 单个传感器的运行时统计，所有字段都可以被采集线程和看门狗线程无锁访问
+ */
+struct SensorStats {
+    explicit SensorStats(const SensorOptions& opts) : options(opts) {}
+
+    SensorOptions options;
+    LatencyHistogram acquisition_ns;
+    LatencyHistogram frame_age_ns;
+    LatencyHistogram frame_interval_ns;
+    std::atomic<uint64_t> frames{0};
+    std::atomic<uint64_t> failed_reads{0};
+    std::atomic<uint64_t> deadline_misses{0};
+    std::atomic<uint64_t> stalls{0};
+    std::atomic<bool> stalled{false};
+    std::atomic<int64_t> last_frame_ns{0}; // steady_clock，0 表示还没有收到过帧
+    std::atomic<int64_t> watch_start_ns{0}; // 看门狗开始监控的时间
+};
+
+// 统计用的单调时钟（纳秒）
+int64_t sensorClockNs();
+
+// 记录一次采集：耗时、帧数/失败数、帧间隔与期限、帧年龄
+void recordAcquisition(SensorStats& stats, const SensorInterface::SensorDate& data, int64_t start_ns, int64_t end_ns);
+
+SensorStatsSnapshot snapshotSensorStats(const std::string& name, const SensorStats& stats);
+void writeSensorStats(std::ostream& os, const std::vector<SensorStatsSnapshot>& stats);
+void resetSensorStats(SensorStats& stats);
+
+/*
+ * 自动驾驶传感器管理器
+ * 每次采集都会记录耗时、帧年龄和帧间隔，
+ * 可选的看门狗线程周期性检查每个传感器是否在期限内产生了新帧
+ */
+class SensorManager {
+public:
+    using StallCallback = std::function<void(const std::string& name, double silent_ms)>;
+
+private:
+    std::vector<std::unique_ptr<SensorInterface>> sensors_; // 存储传感器的容器
+    std::vector<std::unique_ptr<SensorStats>> stats_;       // 与 sensors_ 一一对应
+    mutable std::mutex stats_mutex_;                       // 保护 stats_ 容器本身（增删传感器时）
+
+    std::thread watchdog_;
+    std::mutex watchdog_mutex_;
+    std::condition_variable watchdog_cv_;
+    bool watchdog_running_;
+    StallCallback stall_callback_;
+
+public:
+    SensorManager();
+    ~SensorManager();
+
+    // 添加传感器
+    void addSensor(std::unique_ptr<SensorInterface> sensor, const SensorOptions& options = SensorOptions());
+
+    // 初始化所有传感器
+    bool initSensors();
+
+    // 采集所有传感器的数据并记录统计
+    std::vector<SensorInterface::SensorDate> acquireAll();
+
+    // 获取并打印所有传感器数据
+    void getAllSensorData();
+
+    // 停止所有传感器
+    void stopAllSensors();
+
+    // 启动/停止看门狗，period_ms 为检查周期
+    void startWatchdog(double period_ms = 50.0, StallCallback callback = nullptr);
+    void stopWatchdog();
+
+    // 执行一次看门狗检查，返回当前处于停滞状态的传感器数
+    size_t checkDeadlines();
+
+    // 统计查询
+    std::vector<SensorStatsSnapshot> getStats() const;
+    bool getStats(const std::string& name, SensorStatsSnapshot& out) const;
+    void dumpStats(std::ostream& os) const;
+    void resetStats();
+
+private:
+    void watchdogLoop(double period_ms);
+};
+
+}
+
+#endif
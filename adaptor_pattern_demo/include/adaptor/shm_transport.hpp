@@ -0,0 +1,170 @@
+#ifndef SHM_TRANSPORT_H
+#define SHM_TRANSPORT_H
+
+#include "image_frame.hpp"
+#include "point_cloud.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace duan {
+
+/*
+ * 跨进程共享内存传输
+ * 驱动进程 (ShmWriter) 把每帧数据只写一次到共享内存的环形槽位中，
+ * 感知进程 (ShmReader) 以只读方式映射同一段内存，直接读取槽位，不做任何拷贝
+ *
+ * 协调方式:
+ *   - 每个槽位一个 seqlock 计数器，写入期间为奇数，读者读完后复查计数器判断数据是否被覆盖
+ *   - 写者从不等待读者，读者跟不上时旧帧被覆盖并计入 dropped()
+ *   - 新帧提交后通过 futex 唤醒等待中的读者
+ * 只支持单个写者，读者数量不限
+ */
+
+enum class ShmFrameKind : uint32_t {
+    Raw = 0,        // 任意字节
+    RangeScan = 1,  // width = beams, height = rings, 数据为 float 距离
+    Image = 2       // 数据布局与 ImageFrame::allocate 相同
+};
+
+// 一帧的描述信息
+struct ShmFrameInfo {
+    ShmFrameKind kind = ShmFrameKind::Raw;
+    int32_t width = 0;
+    int32_t height = 0;
+    PixelFormat format = PixelFormat::Gray8;  // 仅 Image 有效
+    size_t bytes = 0;                         // 有效数据字节数
+    double timestamp = 0.0;
+    std::string frame_id;                     // 最多保留47个字符
+};
+
+struct ShmTransportOptions {
+    uint32_t slots = 4;                       // 环形槽位数
+    size_t slot_bytes = 8 * 1024 * 1024;      // 每个槽位的容量
+};
+
+namespace detail {
+struct ShmMapping;
+struct ShmSlotHeader;
+}
+
+class ShmWriter;
+
+/*
+ * 写者借出的槽位
+ * 生产者直接在槽位内存中填充数据，再调用 ShmWriter::commit 发布
+ * 借出期间该槽位对读者不可见
+ */
+class ShmLoan {
+public:
+    ShmLoan() = default;
+
+    uint8_t* data() { return data_; }
+    size_t capacity() const { return capacity_; }
+    bool active() const { return data_ != nullptr; }
+
+    // Image 类型: 可写的图像视图，直接指向共享内存
+    ImageFrame image();
+    // RangeScan 类型: 距离数组，长度为 rings * beams
+    float* ranges() { return reinterpret_cast<float*>(data_); }
+
+    ShmFrameInfo info;
+
+private:
+    friend class ShmWriter;
+    uint8_t* data_ = nullptr;
+    size_t capacity_ = 0;
+    uint64_t frame_seq_ = 0;
+};
+
+class ShmWriter {
+public:
+    // 创建（或重建）名为 name 的共享内存段，name 形如 "/duan_lidar"
+    explicit ShmWriter(const std::string& name, const ShmTransportOptions& options = ShmTransportOptions());
+    // 解除映射并删除共享内存段，已经映射的读者不受影响
+    ~ShmWriter();
+
+    ShmWriter(const ShmWriter&) = delete;
+    ShmWriter& operator=(const ShmWriter&) = delete;
+
+    // 借出下一个槽位，info.bytes 超过槽位容量时抛出 std::invalid_argument
+    ShmLoan loan(const ShmFrameInfo& info);
+    // 发布借出的槽位，返回帧序号
+    uint64_t commit(ShmLoan& loan);
+
+    // 便捷接口：写入一次共享内存后发布
+    uint64_t publish(const RangeScan& scan);
+    uint64_t publish(const ImageFrame& image);
+    uint64_t publish(const void* data, size_t bytes, double timestamp = 0.0, const std::string& frame_id = "");
+
+    const std::string& name() const { return name_; }
+    uint64_t published() const;
+    size_t slotCapacity() const { return options_.slot_bytes; }
+
+private:
+    std::string name_;
+    ShmTransportOptions options_;
+    std::shared_ptr<detail::ShmMapping> mapping_;
+    bool loaned_ = false;
+};
+
+/*
+ * 读者看到的一帧
+ * data() 直接指向共享内存；写者可能随时覆盖该槽位，
+ * 使用完数据后应调用 valid() 确认期间没有被覆盖，否则丢弃结果
+ */
+class ShmFrame {
+public:
+    ShmFrame() = default;
+
+    const ShmFrameInfo& info() const { return info_; }
+    uint64_t seq() const { return frame_seq_; }
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return info_.bytes; }
+    bool valid() const;
+
+    // RangeScan 类型的距离数组
+    const float* ranges() const { return reinterpret_cast<const float*>(data_); }
+    // Image 类型: 共享内存上的只读图像，不复制像素，持有映射直到最后一个引用释放
+    std::shared_ptr<const ImageFrame> image() const;
+    // 拷贝为 RangeScan（需要长期保存数据时使用）
+    RangeScan toRangeScan() const;
+
+private:
+    friend class ShmReader;
+    std::shared_ptr<detail::ShmMapping> mapping_;
+    const detail::ShmSlotHeader* slot_ = nullptr;
+    uint64_t lock_ = 0;
+    uint64_t frame_seq_ = 0;
+    const uint8_t* data_ = nullptr;
+    ShmFrameInfo info_;
+};
+
+class ShmReader {
+public:
+    // 以只读方式映射已存在的共享内存段，不存在、格式不符或布局超出映射时抛出 std::runtime_error
+    // 之后每帧的描述（大小、尺寸、像素格式）与槽位容量不符时按被覆盖的帧丢弃，计入 dropped()
+    explicit ShmReader(const std::string& name);
+
+    // 最新的一帧，尚无数据时返回false
+    bool latest(ShmFrame& out);
+    // 按顺序读取下一帧（从仍在环中的最旧帧开始），没有新帧时返回false
+    bool next(ShmFrame& out);
+    // 等待下一帧，超时返回false
+    bool waitNext(ShmFrame& out, double timeout_ms);
+
+    uint64_t dropped() const { return dropped_; }
+    uint32_t slotCount() const;
+
+private:
+    bool readSlot(uint64_t frame_seq, ShmFrame& out) const;
+
+    std::shared_ptr<detail::ShmMapping> mapping_;
+    uint64_t next_seq_ = 0;
+    uint64_t dropped_ = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef SIMD_DISPATCH_H
+#define SIMD_DISPATCH_H
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DUAN_SIMD_X86 1
+#include <immintrin.h>
+// 按函数粒度开启指令集，整个工程无需 -mavx2，运行时再根据CPU选择
+#define DUAN_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define DUAN_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DUAN_SIMD_X86 0
+#endif
+
+namespace duan {
+
+/*
+ * SIMD指令集等级
+ * 各个计算模块都提供 Scalar 实现，SSE/AVX2 只是加速路径
+ */
+enum class SimdLevel {
+    Scalar = 0,
+    SSE = 1,  // SSE4.1
+    AVX2 = 2
+};
+
+/*
+检测当前CPU支持的最高指令集（结果只计算一次）
+*/
+SimdLevel detectSimdLevel();
+
+/*
+将期望的指令集限制在CPU实际支持的范围内
+用于测试时强制走某条路径
+*/
+SimdLevel clampSimdLevel(SimdLevel requested);
+
+const char* simdLevelName(SimdLevel level);
+
+}
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include "point_cloud.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace duan {
+
+/*
+ * 近邻查询结果
+ * index 为点在原始点云中的下标
+ */
+struct Neighbor {
+    uint32_t index;
+    float dist_sq; // 距离的平方
+
+    bool operator<(const Neighbor& other) const {
+        return dist_sq < other.dist_sq || (dist_sq == other.dist_sq && index < other.index);
+    }
+};
+
+/*
+ * 扁平k-d树
+ * 节点按深度优先顺序存放在一个数组里，左孩子紧跟父节点；
+ * 点坐标按树的顺序重排为SoA，叶子内的点在内存中连续，查询时顺序扫描
+ * 构建时在顶层若干层把左右子树分给不同线程
+ * 坐标非有限（NaN/Inf）的点不入树，查询点非有限时结果为空
+ */
+class KdTree {
+private:
+    struct Node {
+        float split;    // 分割值
+        uint32_t begin; // 点区间 [begin, end)
+        uint32_t end;
+        uint32_t right; // 右孩子的节点下标
+        uint8_t axis;   // 0/1/2 分割轴，3 表示叶子
+    };
+
+    size_t leaf_size_;
+    std::vector<Node> nodes_;
+    std::vector<float> px_, py_, pz_; // 树顺序的点坐标
+    std::vector<uint32_t> index_;     // 树顺序 -> 原始下标
+
+public:
+    explicit KdTree(size_t leaf_size = 16);
+
+    // 从点云构建，num_threads <= 0 表示使用硬件并发数
+    void build(const PointCloud& cloud, int num_threads = 0);
+
+    size_t size() const { return index_.size(); }
+    bool empty() const { return index_.empty(); }
+
+    // k近邻，结果按距离升序
+    void knn(float x, float y, float z, size_t k, std::vector<Neighbor>& out) const;
+    // 半径查询，结果按距离升序
+    void radius(float x, float y, float z, float r, std::vector<Neighbor>& out) const;
+    // 最近邻，空树返回false
+    bool nearest(float x, float y, float z, Neighbor& out) const;
+
+private:
+    void buildNode(uint32_t node, uint32_t begin, uint32_t end, const PointCloud& cloud, int spawn_depth);
+    size_t nodeCount(size_t n) const;
+    template <typename Visitor>
+    void traverse(float x, float y, float z, Visitor&& visit, const float& bound_sq) const;
+};
+
+/*
+ * 哈希均匀栅格
+ * 点按所在栅格排序后以CSR形式存放（每个栅格的点连续），
+ * 栅格键通过开放寻址哈希表映射到CSR下标
+ * 适合查询半径与栅格尺寸相当的场景，k近邻按栅格环逐层向外扩展
+ */
+class HashedGrid {
+private:
+    float cell_size_;
+    float inv_cell_;
+    std::vector<uint64_t> slot_keys_;  // 哈希表: 栅格键
+    std::vector<uint32_t> slot_cells_; // 哈希表: 栅格编号
+    size_t slot_mask_;
+    std::vector<uint32_t> cell_start_; // CSR偏移，长度为栅格数+1
+    std::vector<float> px_, py_, pz_;  // 按栅格排序的点坐标
+    std::vector<uint32_t> index_;      // 排序后 -> 原始下标
+    int32_t min_cell_[3];
+    int32_t max_cell_[3];
+
+public:
+    explicit HashedGrid(float cell_size = 1.0f);
+
+    void build(const PointCloud& cloud, int num_threads = 0);
+
+    size_t size() const { return index_.size(); }
+    bool empty() const { return index_.empty(); }
+    size_t cellCount() const { return cell_start_.empty() ? 0 : cell_start_.size() - 1; }
+    float cellSize() const { return cell_size_; }
+
+    void knn(float x, float y, float z, size_t k, std::vector<Neighbor>& out) const;
+    void radius(float x, float y, float z, float r, std::vector<Neighbor>& out) const;
+    bool nearest(float x, float y, float z, Neighbor& out) const;
+
+private:
+    // 查找栅格，返回CSR编号，不存在返回-1
+    int64_t findCell(int64_t ix, int64_t iy, int64_t iz) const;
+};
+
+}
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef STATIC_SENSOR_MANAGER_H
+#define STATIC_SENSOR_MANAGER_H
+
+#include "sensor_manager.hpp"
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace duan {
+
+/*
+ * 编译期确定传感器列表的管理器
+ * 传感器按值保存在 tuple 中，遍历用折叠表达式展开，
+ * 调用的都是具体类型的成员函数，编译器可以去掉虚调用并内联采集/转换逻辑
+ * 适合车型固定的配置；需要运行时增删传感器（插件）时使用 SensorManager
+ *
+ * 用法:
+ *   StaticSensorManager<ModernCamera, LidarAdaptor> manager(
+ *       std::forward_as_tuple("front"), std::forward_as_tuple("lidar"));
+ * 每个参数是对应传感器的构造参数 tuple，传感器原地构造，不需要可移动
+ */
+template <typename... Sensors>
+class StaticSensorManager {
+    static_assert(sizeof...(Sensors) > 0, "至少需要一个传感器");
+    static_assert((std::is_base_of<SensorInterface, Sensors>::value && ...), "传感器必须实现 SensorInterface");
+
+public:
+    static constexpr size_t kSize = sizeof...(Sensors);
+    using Frames = std::array<SensorInterface::SensorDate, kSize>;
+
+private:
+    // 构造参数打包，使 tuple 可以直接原地构造 Slot（Slot 含原子量，不可移动）
+    template <typename Args>
+    struct SlotInit {
+        Args&& args;
+        const SensorOptions& options;
+    };
+
+    // 传感器与其统计放在一起，采集时访问的内存相邻
+    template <typename S>
+    struct Slot {
+        S sensor;
+        SensorStats stats;
+
+        template <typename Args>
+        explicit Slot(SlotInit<Args>&& init)
+            : sensor(std::make_from_tuple<S>(std::forward<Args>(init.args))), stats(init.options) {}
+    };
+
+    static const SensorOptions& defaultOptions() {
+        static const SensorOptions options;
+        return options;
+    }
+
+    std::tuple<Slot<Sensors>...> slots_;
+
+    template <typename F, size_t... I>
+    void forEachSlot(F&& f, std::index_sequence<I...>) {
+        (f(std::get<I>(slots_), std::integral_constant<size_t, I>()), ...);
+    }
+    template <typename F, size_t... I>
+    void forEachSlot(F&& f, std::index_sequence<I...>) const {
+        (f(std::get<I>(slots_), std::integral_constant<size_t, I>()), ...);
+    }
+
+public:
+    template <typename... Args, typename = std::enable_if_t<sizeof...(Args) == kSize>>
+    explicit StaticSensorManager(Args&&... args) : slots_(SlotInit<Args>{std::forward<Args>(args), defaultOptions()}...) {}
+
+    // 为每个传感器指定监控参数
+    template <typename... Args, typename = std::enable_if_t<sizeof...(Args) == kSize>>
+    StaticSensorManager(const std::array<SensorOptions, kSize>& options, Args&&... args)
+        : StaticSensorManager(options, std::index_sequence_for<Sensors...>(), std::forward<Args>(args)...) {}
+
+    StaticSensorManager(const StaticSensorManager&) = delete;
+    StaticSensorManager& operator=(const StaticSensorManager&) = delete;
+
+    static constexpr size_t size() { return kSize; }
+
+    template <size_t I>
+    auto& get() { return std::get<I>(slots_).sensor; }
+    template <size_t I>
+    const auto& get() const { return std::get<I>(slots_).sensor; }
+
+    // 初始化所有传感器，全部成功返回true
+    bool initSensors() {
+        std::cout << "Initializing sensors..." << std::endl;
+        bool all_success = true;
+        forEachSlot([&all_success](auto& slot, auto) {
+            const bool success = slot.sensor.init();
+            if (success) {
+                std::cout << "Sensor " << slot.sensor.getName() << " initialized successfully." << std::endl;
+            }
+            all_success &= success;
+        }, std::index_sequence_for<Sensors...>());
+        return all_success;
+    }
+
+    // 采集所有传感器的数据并记录统计，结果按模板参数顺序存放
+    Frames acquireAll() {
+        Frames frames;
+        acquireEach([&frames](auto index, auto&, SensorInterface::SensorDate& data) {
+            frames[index] = std::move(data);
+        });
+        return frames;
+    }
+
+    /*
+     * 逐个采集并把数据交给 fn(index, sensor, data)，不经过中间容器
+     * index 为 std::integral_constant，sensor 为具体类型的引用，
+     * 后续的转换逻辑可以与采集一起内联
+     */
+    template <typename F>
+    void acquireEach(F&& fn) {
+        forEachSlot([&fn](auto& slot, auto index) {
+            const int64_t start_ns = sensorClockNs();
+            SensorInterface::SensorDate data = slot.sensor.getSensorData();
+            recordAcquisition(slot.stats, data, start_ns, sensorClockNs());
+            fn(index, slot.sensor, data);
+        }, std::index_sequence_for<Sensors...>());
+    }
+
+    // 对每个传感器调用 fn(sensor)
+    template <typename F>
+    void forEach(F&& fn) {
+        forEachSlot([&fn](auto& slot, auto) { fn(slot.sensor); }, std::index_sequence_for<Sensors...>());
+    }
+
+    void stopAllSensors() {
+        std::cout << "Stopping all sensors..." << std::endl;
+        forEachSlot([](auto& slot, auto) {
+            slot.sensor.stop();
+            std::cout << "Sensor " << slot.sensor.getName() << " stopped." << std::endl;
+        }, std::index_sequence_for<Sensors...>());
+    }
+
+    template <size_t I>
+    SensorStatsSnapshot getStats() const {
+        const auto& slot = std::get<I>(slots_);
+        return snapshotSensorStats(slot.sensor.getName(), slot.stats);
+    }
+
+    std::vector<SensorStatsSnapshot> getStats() const {
+        std::vector<SensorStatsSnapshot> result;
+        result.reserve(kSize);
+        forEachSlot([&result](const auto& slot, auto) {
+            result.push_back(snapshotSensorStats(slot.sensor.getName(), slot.stats));
+        }, std::index_sequence_for<Sensors...>());
+        return result;
+    }
+
+    void dumpStats(std::ostream& os) const {
+        writeSensorStats(os, getStats());
+    }
+
+    void resetStats() {
+        forEachSlot([](auto& slot, auto) { resetSensorStats(slot.stats); }, std::index_sequence_for<Sensors...>());
+    }
+
+private:
+    template <size_t... I, typename... Args>
+    StaticSensorManager(const std::array<SensorOptions, kSize>& options, std::index_sequence<I...>, Args&&... args)
+        : slots_(SlotInit<Args>{std::forward<Args>(args), options[I]}...) {}
+};
+
+}
+
+#endif
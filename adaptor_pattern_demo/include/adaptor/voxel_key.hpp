@@ -0,0 +1,57 @@
+#ifndef VOXEL_KEY_H
+#define VOXEL_KEY_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace duan {
+
+/*
+ * 体素/栅格坐标打包
+ * 每轴21位，加偏移后拼成一个64位键，可表示 ±2^20 个体素
+ */
+constexpr int kVoxelAxisBits = 21;
+constexpr int64_t kVoxelAxisOffset = int64_t(1) << (kVoxelAxisBits - 1);
+constexpr int64_t kVoxelAxisMask = (int64_t(1) << kVoxelAxisBits) - 1;
+constexpr uint64_t kEmptyVoxelKey = ~uint64_t(0);
+
+// 坐标所在的体素下标，限制在键可表示的范围内（超出的与 packVoxelKey 一样落到边界体素）；
+// 非有限值转整数是未定义行为，NaN 归到下边界，调用方应先丢弃非有限的点
+inline int32_t voxelCoord(float v, float inv_leaf) {
+    const float f = std::floor(v * inv_leaf);
+    if (!(f > static_cast<float>(-kVoxelAxisOffset))) {
+        return static_cast<int32_t>(-kVoxelAxisOffset);
+    }
+    if (f > static_cast<float>(kVoxelAxisOffset)) {
+        return static_cast<int32_t>(kVoxelAxisOffset);
+    }
+    return static_cast<int32_t>(f);
+}
+
+inline bool isFinitePoint(float x, float y, float z) {
+    return std::isfinite(x) && std::isfinite(y) && std::isfinite(z);
+}
+
+inline uint64_t packVoxelKey(int64_t ix, int64_t iy, int64_t iz) {
+    auto axis = [](int64_t i) {
+        return static_cast<uint64_t>(std::min(std::max(i + kVoxelAxisOffset, int64_t(0)), kVoxelAxisMask));
+    };
+    return (axis(ix) << (2 * kVoxelAxisBits)) | (axis(iy) << kVoxelAxisBits) | axis(iz);
+}
+
+inline uint64_t voxelKey(float x, float y, float z, float inv_leaf) {
+    return packVoxelKey(voxelCoord(x, inv_leaf), voxelCoord(y, inv_leaf), voxelCoord(z, inv_leaf));
+}
+
+// 64位整数混洗，用于开放寻址哈希表
+inline uint64_t mixHash(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return key;
+}
+
+}
+
+#endif
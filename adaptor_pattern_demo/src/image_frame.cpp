@@ -0,0 +1,590 @@
+#include "adaptor/image_frame.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace duan {
+
+namespace {
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+uint8_t* alignedAlloc(size_t bytes) {
+    void* ptr = std::aligned_alloc(ImageBufferPool::kAlignment, alignUp(bytes, ImageBufferPool::kAlignment));
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return static_cast<uint8_t*>(ptr);
+}
+
+// ---------------- 颜色转换内核 ----------------
+
+constexpr uint32_t kWeightR = 77;
+constexpr uint32_t kWeightG = 150;
+constexpr uint32_t kWeightB = 29;
+
+inline uint8_t grayPixel(uint32_t r, uint32_t g, uint32_t b) {
+    return static_cast<uint8_t>((r * kWeightR + g * kWeightG + b * kWeightB + 128) >> 8);
+}
+
+// r_off/b_off 为红/蓝通道在像素内的偏移，channels 为每像素字节数
+void packedToGrayScalar(const uint8_t* src, uint8_t* dst, int begin, int end, int channels, int r_off, int b_off) {
+    for (int x = begin; x < end; ++x) {
+        const uint8_t* p = src + x * channels;
+        dst[x] = grayPixel(p[r_off], p[1], p[b_off]);
+    }
+}
+
+void deinterleaveScalar(const uint8_t* src, uint8_t* c0, uint8_t* c1, uint8_t* c2, int begin, int end) {
+    for (int x = begin; x < end; ++x) {
+        c0[x] = src[3 * x];
+        c1[x] = src[3 * x + 1];
+        c2[x] = src[3 * x + 2];
+    }
+}
+
+void interleaveScalar(const uint8_t* c0, const uint8_t* c1, const uint8_t* c2, uint8_t* dst, int begin, int end) {
+    for (int x = begin; x < end; ++x) {
+        dst[3 * x] = c0[x];
+        dst[3 * x + 1] = c1[x];
+        dst[3 * x + 2] = c2[x];
+    }
+}
+
+#if DUAN_SIMD_X86
+/*
+pshufb 掩码表
+deinterleave[C][ch][k]: 从第k个16字节块中取出第ch个通道，放到输出的对应位置
+interleave[ch][k]: 从第ch个平面取字节，组成第k个16字节输出块
+*/
+struct ShuffleMasks {
+    alignas(16) int8_t deinterleave3[3][3][16];
+    alignas(16) int8_t deinterleave4[4][4][16];
+    alignas(16) int8_t interleave3[3][3][16];
+
+    ShuffleMasks() {
+        for (int ch = 0; ch < 3; ++ch) {
+            for (int k = 0; k < 3; ++k) {
+                for (int i = 0; i < 16; ++i) {
+                    int g = 3 * i + ch - 16 * k;
+                    deinterleave3[ch][k][i] = (g >= 0 && g < 16) ? static_cast<int8_t>(g) : int8_t(-128);
+                    int out = 16 * k + i;
+                    interleave3[ch][k][i] = (out % 3 == ch) ? static_cast<int8_t>(out / 3) : int8_t(-128);
+                }
+            }
+        }
+        for (int ch = 0; ch < 4; ++ch) {
+            for (int k = 0; k < 4; ++k) {
+                for (int i = 0; i < 16; ++i) {
+                    int g = 4 * i + ch - 16 * k;
+                    deinterleave4[ch][k][i] = (g >= 0 && g < 16) ? static_cast<int8_t>(g) : int8_t(-128);
+                }
+            }
+        }
+    }
+};
+
+const ShuffleMasks& masks() {
+    static const ShuffleMasks instance;
+    return instance;
+}
+
+DUAN_TARGET_SSE41
+inline __m128i gather(const __m128i* chunks, const int8_t (*mask)[16], int count) {
+    __m128i out = _mm_shuffle_epi8(chunks[0], _mm_load_si128(reinterpret_cast<const __m128i*>(mask[0])));
+    for (int k = 1; k < count; ++k) {
+        out = _mm_or_si128(out, _mm_shuffle_epi8(chunks[k], _mm_load_si128(reinterpret_cast<const __m128i*>(mask[k]))));
+    }
+    return out;
+}
+
+DUAN_TARGET_SSE41
+inline __m128i grayFromChannels(__m128i r, __m128i g, __m128i b) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i wr = _mm_set1_epi16(kWeightR);
+    const __m128i wg = _mm_set1_epi16(kWeightG);
+    const __m128i wb = _mm_set1_epi16(kWeightB);
+    const __m128i round = _mm_set1_epi16(128);
+    // 最大值 256*255+128 < 65536，16位无符号运算不会溢出
+    __m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(r, zero), wr),
+                                             _mm_mullo_epi16(_mm_unpacklo_epi8(g, zero), wg)),
+                               _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), wb), round));
+    __m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(r, zero), wr),
+                                             _mm_mullo_epi16(_mm_unpackhi_epi8(g, zero), wg)),
+                               _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), wb), round));
+    return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+}
+
+DUAN_TARGET_SSE41
+int packedToGraySse(const uint8_t* src, uint8_t* dst, int width, int channels, int r_off, int b_off) {
+    const ShuffleMasks& m = masks();
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m128i chunks[4];
+        for (int k = 0; k < channels; ++k) {
+            chunks[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * channels + 16 * k));
+        }
+        __m128i r, g, b;
+        if (channels == 3) {
+            r = gather(chunks, m.deinterleave3[r_off], 3);
+            g = gather(chunks, m.deinterleave3[1], 3);
+            b = gather(chunks, m.deinterleave3[b_off], 3);
+        } else {
+            r = gather(chunks, m.deinterleave4[r_off], 4);
+            g = gather(chunks, m.deinterleave4[1], 4);
+            b = gather(chunks, m.deinterleave4[b_off], 4);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), grayFromChannels(r, g, b));
+    }
+    return x;
+}
+
+DUAN_TARGET_SSE41
+int deinterleaveSse(const uint8_t* src, uint8_t* c0, uint8_t* c1, uint8_t* c2, int width) {
+    const ShuffleMasks& m = masks();
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m128i chunks[3];
+        for (int k = 0; k < 3; ++k) {
+            chunks[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * x + 16 * k));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(c0 + x), gather(chunks, m.deinterleave3[0], 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(c1 + x), gather(chunks, m.deinterleave3[1], 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(c2 + x), gather(chunks, m.deinterleave3[2], 3));
+    }
+    return x;
+}
+
+DUAN_TARGET_SSE41
+int interleaveSse(const uint8_t* c0, const uint8_t* c1, const uint8_t* c2, uint8_t* dst, int width) {
+    const ShuffleMasks& m = masks();
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        const __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c0 + x));
+        const __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c1 + x));
+        const __m128i p2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c2 + x));
+        for (int k = 0; k < 3; ++k) {
+            __m128i out = _mm_or_si128(
+                _mm_or_si128(_mm_shuffle_epi8(p0, _mm_load_si128(reinterpret_cast<const __m128i*>(m.interleave3[0][k]))),
+                             _mm_shuffle_epi8(p1, _mm_load_si128(reinterpret_cast<const __m128i*>(m.interleave3[1][k])))),
+                _mm_shuffle_epi8(p2, _mm_load_si128(reinterpret_cast<const __m128i*>(m.interleave3[2][k]))));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 3 * x + 16 * k), out);
+        }
+    }
+    return x;
+}
+#endif
+
+// ---------------- 降采样内核 ----------------
+
+// 8位单通道一行，out_width 个输出像素中 SIMD 处理前 simd_end 个（保证 2x+1 不越界）
+void downscaleRow8Scalar(const uint8_t* r0, const uint8_t* r1, uint8_t* dst, int begin, int end, int src_width) {
+    for (int x = begin; x < end; ++x) {
+        const int x0 = 2 * x;
+        const int x1 = std::min(2 * x + 1, src_width - 1);
+        dst[x] = static_cast<uint8_t>((r0[x0] + r0[x1] + r1[x0] + r1[x1] + 2) >> 2);
+    }
+}
+
+#if DUAN_SIMD_X86
+DUAN_TARGET_SSE41
+int downscaleRow8Sse(const uint8_t* r0, const uint8_t* r1, uint8_t* dst, int out_width, int src_width) {
+    const __m128i ones = _mm_set1_epi8(1);
+    const __m128i two = _mm_set1_epi16(2);
+    int x = 0;
+    for (; x + 16 <= out_width && 2 * x + 32 <= src_width; x += 16) {
+        __m128i a = _mm_add_epi16(_mm_maddubs_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + 2 * x)), ones),
+                                  _mm_maddubs_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + 2 * x)), ones));
+        __m128i b = _mm_add_epi16(_mm_maddubs_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + 2 * x + 16)), ones),
+                                  _mm_maddubs_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + 2 * x + 16)), ones));
+        a = _mm_srli_epi16(_mm_add_epi16(a, two), 2);
+        b = _mm_srli_epi16(_mm_add_epi16(b, two), 2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(a, b));
+    }
+    return x;
+}
+
+DUAN_TARGET_AVX2
+int downscaleRow8Avx2(const uint8_t* r0, const uint8_t* r1, uint8_t* dst, int out_width, int src_width) {
+    const __m256i ones = _mm256_set1_epi8(1);
+    const __m256i two = _mm256_set1_epi16(2);
+    int x = 0;
+    for (; x + 32 <= out_width && 2 * x + 64 <= src_width; x += 32) {
+        __m256i a = _mm256_add_epi16(_mm256_maddubs_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(r0 + 2 * x)), ones),
+                                     _mm256_maddubs_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(r1 + 2 * x)), ones));
+        __m256i b = _mm256_add_epi16(_mm256_maddubs_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(r0 + 2 * x + 32)), ones),
+                                     _mm256_maddubs_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(r1 + 2 * x + 32)), ones));
+        a = _mm256_srli_epi16(_mm256_add_epi16(a, two), 2);
+        b = _mm256_srli_epi16(_mm256_add_epi16(b, two), 2);
+        // packus 在每个128位通道内交错，需要重排回顺序
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x), packed);
+    }
+    return x;
+}
+#endif
+
+// 通用降采样：任意位宽和通道数，边界像素复制
+template <typename T>
+void downscalePlaneGeneric(const ImageFrame& src, ImageFrame& dst, int plane, int channels) {
+    const int src_w = src.planeWidth(plane);
+    const int src_h = src.planeHeight(plane);
+    const int dst_w = dst.planeWidth(plane);
+    const int dst_h = dst.planeHeight(plane);
+    for (int y = 0; y < dst_h; ++y) {
+        const T* r0 = src.row<T>(std::min(2 * y, src_h - 1), plane);
+        const T* r1 = src.row<T>(std::min(2 * y + 1, src_h - 1), plane);
+        T* out = dst.row<T>(y, plane);
+        for (int x = 0; x < dst_w; ++x) {
+            const int x0 = std::min(2 * x, src_w - 1) * channels;
+            const int x1 = std::min(2 * x + 1, src_w - 1) * channels;
+            for (int c = 0; c < channels; ++c) {
+                const uint32_t sum = uint32_t(r0[x0 + c]) + r0[x1 + c] + r1[x0 + c] + r1[x1 + c] + 2;
+                out[x * channels + c] = static_cast<T>(sum >> 2);
+            }
+        }
+    }
+}
+
+}
+
+// ==================== PixelFormat ====================
+
+PixelFormatInfo pixelFormatInfo(PixelFormat format) {
+    switch (format) {
+        case PixelFormat::Gray8: return {1, 1, 1, 0};
+        case PixelFormat::Gray16: return {1, 1, 2, 0};
+        case PixelFormat::RGB8: return {1, 3, 1, 0};
+        case PixelFormat::BGR8: return {1, 3, 1, 0};
+        case PixelFormat::RGBA8: return {1, 4, 1, 0};
+        case PixelFormat::RGB16: return {1, 3, 2, 0};
+        case PixelFormat::RGB8Planar: return {3, 1, 1, 0};
+        case PixelFormat::YUV420P: return {3, 1, 1, 1};
+    }
+    return {1, 1, 1, 0};
+}
+
+const char* pixelFormatName(PixelFormat format) {
+    switch (format) {
+        case PixelFormat::Gray8: return "GRAY8";
+        case PixelFormat::Gray16: return "GRAY16";
+        case PixelFormat::RGB8: return "RGB8";
+        case PixelFormat::BGR8: return "BGR8";
+        case PixelFormat::RGBA8: return "RGBA8";
+        case PixelFormat::RGB16: return "RGB16";
+        case PixelFormat::RGB8Planar: return "RGB8_PLANAR";
+        case PixelFormat::YUV420P: return "YUV420P";
+    }
+    return "UNKNOWN";
+}
+
+// ==================== ImageBufferPool ====================
+
+ImageBufferPool::State::~State() {
+    for (auto& entry : free_lists) {
+        for (uint8_t* buffer : entry.second) {
+            std::free(buffer);
+        }
+    }
+}
+
+ImageBufferPool::ImageBufferPool(size_t max_cached_per_size) : state_(std::make_shared<State>()) {
+    state_->max_cached_per_size = max_cached_per_size;
+}
+
+std::shared_ptr<uint8_t> ImageBufferPool::acquire(size_t bytes) {
+    bytes = alignUp(bytes, kAlignment);
+    uint8_t* buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        auto& free_list = state_->free_lists[bytes];
+        if (!free_list.empty()) {
+            buffer = free_list.back();
+            free_list.pop_back();
+            ++state_->reuses;
+        } else {
+            ++state_->allocations;
+        }
+    }
+    if (!buffer) {
+        buffer = alignedAlloc(bytes);
+    }
+
+    std::weak_ptr<State> weak_state = state_;
+    return std::shared_ptr<uint8_t>(buffer, [weak_state, bytes](uint8_t* ptr) {
+        if (auto state = weak_state.lock()) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            auto& free_list = state->free_lists[bytes];
+            if (free_list.size() < state->max_cached_per_size) {
+                free_list.push_back(ptr);
+                return;
+            }
+        }
+        std::free(ptr);
+    });
+}
+
+size_t ImageBufferPool::allocations() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->allocations;
+}
+
+size_t ImageBufferPool::reuses() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->reuses;
+}
+
+// ==================== ImageFrame ====================
+
+ImageFrame::ImageFrame()
+    : width_(0), height_(0), format_(PixelFormat::Gray8), byte_size_(0),
+      planes_{nullptr, nullptr, nullptr}, strides_{0, 0, 0} {}
+
+size_t ImageFrame::layout(size_t offsets[3]) {
+    const PixelFormatInfo info = pixelFormatInfo(format_);
+    size_t total = 0;
+    for (int p = 0; p < 3; ++p) {
+        offsets[p] = 0;
+        strides_[p] = 0;
+    }
+    for (int p = 0; p < info.planes; ++p) {
+        offsets[p] = total;
+        strides_[p] = alignUp(rowBytes(p), ImageBufferPool::kAlignment);
+        total += strides_[p] * static_cast<size_t>(planeHeight(p));
+    }
+    byte_size_ = total;
+    return total;
+}
+
+ImageFrame ImageFrame::allocate(int width, int height, PixelFormat format, ImageBufferPool* pool) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("ImageFrame: 图像尺寸无效");
+    }
+    ImageFrame frame;
+    frame.width_ = width;
+    frame.height_ = height;
+    frame.format_ = format;
+
+    size_t offsets[3];
+    const size_t total = frame.layout(offsets);
+    if (pool) {
+        frame.storage_ = pool->acquire(total);
+    } else {
+        frame.storage_ = std::shared_ptr<uint8_t>(alignedAlloc(total), [](uint8_t* ptr) { std::free(ptr); });
+    }
+    for (int p = 0; p < frame.planeCount(); ++p) {
+        frame.planes_[p] = frame.storage_.get() + offsets[p];
+    }
+    return frame;
+}
+
+ImageFrame ImageFrame::wrap(int width, int height, PixelFormat format, std::shared_ptr<uint8_t> storage) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("ImageFrame: 图像尺寸无效");
+    }
+    if (!storage || reinterpret_cast<uintptr_t>(storage.get()) % ImageBufferPool::kAlignment != 0) {
+        throw std::invalid_argument("ImageFrame: 外部内存为空或未按64字节对齐");
+    }
+    ImageFrame frame;
+    frame.width_ = width;
+    frame.height_ = height;
+    frame.format_ = format;
+
+    size_t offsets[3];
+    frame.layout(offsets);
+    frame.storage_ = std::move(storage);
+    for (int p = 0; p < frame.planeCount(); ++p) {
+        frame.planes_[p] = frame.storage_.get() + offsets[p];
+    }
+    return frame;
+}
+
+size_t ImageFrame::requiredBytes(int width, int height, PixelFormat format) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("ImageFrame: 图像尺寸无效");
+    }
+    ImageFrame frame;
+    frame.width_ = width;
+    frame.height_ = height;
+    frame.format_ = format;
+    size_t offsets[3];
+    return frame.layout(offsets);
+}
+
+int ImageFrame::planeCount() const {
+    return pixelFormatInfo(format_).planes;
+}
+
+int ImageFrame::planeWidth(int plane) const {
+    const int shift = plane == 0 ? 0 : pixelFormatInfo(format_).chroma_shift;
+    return (width_ + (1 << shift) - 1) >> shift;
+}
+
+int ImageFrame::planeHeight(int plane) const {
+    const int shift = plane == 0 ? 0 : pixelFormatInfo(format_).chroma_shift;
+    return (height_ + (1 << shift) - 1) >> shift;
+}
+
+size_t ImageFrame::rowBytes(int plane) const {
+    const PixelFormatInfo info = pixelFormatInfo(format_);
+    return static_cast<size_t>(planeWidth(plane)) * info.channels * info.bytes_per_channel;
+}
+
+ImageFrame ImageFrame::clone(ImageBufferPool* pool) const {
+    if (empty()) {
+        return ImageFrame();
+    }
+    ImageFrame copy = allocate(width_, height_, format_, pool);
+    copy.timestamp = timestamp;
+    copy.frame_id = frame_id;
+    for (int p = 0; p < planeCount(); ++p) {
+        for (int y = 0; y < planeHeight(p); ++y) {
+            std::memcpy(copy.row(y, p), row(y, p), rowBytes(p));
+        }
+    }
+    return copy;
+}
+
+// ==================== 转换 ====================
+
+ImageFrame convertImage(const ImageFrame& src, PixelFormat dst_format, ImageBufferPool* pool, SimdLevel level) {
+    if (src.empty()) {
+        throw std::invalid_argument("convertImage: 源图像为空");
+    }
+    const PixelFormat sf = src.format();
+    const int width = src.width();
+    const int height = src.height();
+    if (sf == dst_format) {
+        return src.clone(pool);
+    }
+
+    ImageFrame dst = ImageFrame::allocate(width, height, dst_format, pool);
+    dst.timestamp = src.timestamp;
+    dst.frame_id = src.frame_id;
+    [[maybe_unused]] const bool simd = clampSimdLevel(level) != SimdLevel::Scalar;
+
+    if ((sf == PixelFormat::RGB8 || sf == PixelFormat::BGR8 || sf == PixelFormat::RGBA8) && dst_format == PixelFormat::Gray8) {
+        const int channels = sf == PixelFormat::RGBA8 ? 4 : 3;
+        const int r_off = sf == PixelFormat::BGR8 ? 2 : 0;
+        const int b_off = sf == PixelFormat::BGR8 ? 0 : 2;
+        for (int y = 0; y < height; ++y) {
+            int x = 0;
+#if DUAN_SIMD_X86
+            if (simd) {
+                x = packedToGraySse(src.row(y), dst.row(y), width, channels, r_off, b_off);
+            }
+#endif
+            packedToGrayScalar(src.row(y), dst.row(y), x, width, channels, r_off, b_off);
+        }
+        return dst;
+    }
+
+    if ((sf == PixelFormat::RGB8 && dst_format == PixelFormat::BGR8) ||
+        (sf == PixelFormat::BGR8 && dst_format == PixelFormat::RGB8)) {
+        // 先拆成三个通道再按相反顺序交错，避免跨16字节块的字节搬移
+        std::vector<uint8_t> c0(width), c1(width), c2(width);
+        for (int y = 0; y < height; ++y) {
+            int x = 0;
+#if DUAN_SIMD_X86
+            if (simd) {
+                x = deinterleaveSse(src.row(y), c0.data(), c1.data(), c2.data(), width);
+            }
+#endif
+            deinterleaveScalar(src.row(y), c0.data(), c1.data(), c2.data(), x, width);
+            x = 0;
+#if DUAN_SIMD_X86
+            if (simd) {
+                x = interleaveSse(c2.data(), c1.data(), c0.data(), dst.row(y), width);
+            }
+#endif
+            interleaveScalar(c2.data(), c1.data(), c0.data(), dst.row(y), x, width);
+        }
+        return dst;
+    }
+
+    if (sf == PixelFormat::RGB8 && dst_format == PixelFormat::RGB8Planar) {
+        for (int y = 0; y < height; ++y) {
+            int x = 0;
+#if DUAN_SIMD_X86
+            if (simd) {
+                x = deinterleaveSse(src.row(y), dst.row(y, 0), dst.row(y, 1), dst.row(y, 2), width);
+            }
+#endif
+            deinterleaveScalar(src.row(y), dst.row(y, 0), dst.row(y, 1), dst.row(y, 2), x, width);
+        }
+        return dst;
+    }
+
+    if (sf == PixelFormat::RGB8Planar && dst_format == PixelFormat::RGB8) {
+        for (int y = 0; y < height; ++y) {
+            int x = 0;
+#if DUAN_SIMD_X86
+            if (simd) {
+                x = interleaveSse(src.row(y, 0), src.row(y, 1), src.row(y, 2), dst.row(y), width);
+            }
+#endif
+            interleaveScalar(src.row(y, 0), src.row(y, 1), src.row(y, 2), dst.row(y), x, width);
+        }
+        return dst;
+    }
+
+    if (sf == PixelFormat::Gray16 && dst_format == PixelFormat::Gray8) {
+        for (int y = 0; y < height; ++y) {
+            const uint16_t* in = src.row<uint16_t>(y);
+            uint8_t* out = dst.row(y);
+            for (int x = 0; x < width; ++x) {
+                out[x] = static_cast<uint8_t>(in[x] >> 8);
+            }
+        }
+        return dst;
+    }
+
+    throw std::invalid_argument(std::string("convertImage: 不支持的转换 ") + pixelFormatName(sf) +
+                                " -> " + pixelFormatName(dst_format));
+}
+
+ImageFrame downscale2x(const ImageFrame& src, ImageBufferPool* pool, SimdLevel level) {
+    if (src.empty() || src.width() < 2 || src.height() < 2) {
+        throw std::invalid_argument("downscale2x: 源图像过小");
+    }
+    ImageFrame dst = ImageFrame::allocate(src.width() / 2, src.height() / 2, src.format(), pool);
+    dst.timestamp = src.timestamp;
+    dst.frame_id = src.frame_id;
+    const PixelFormatInfo info = pixelFormatInfo(src.format());
+    level = clampSimdLevel(level);
+
+    for (int p = 0; p < info.planes; ++p) {
+        if (info.bytes_per_channel == 2) {
+            downscalePlaneGeneric<uint16_t>(src, dst, p, info.channels);
+            continue;
+        }
+        if (info.channels != 1) {
+            downscalePlaneGeneric<uint8_t>(src, dst, p, info.channels);
+            continue;
+        }
+        const int src_w = src.planeWidth(p);
+        const int src_h = src.planeHeight(p);
+        const int dst_w = dst.planeWidth(p);
+        for (int y = 0; y < dst.planeHeight(p); ++y) {
+            const uint8_t* r0 = src.row(std::min(2 * y, src_h - 1), p);
+            const uint8_t* r1 = src.row(std::min(2 * y + 1, src_h - 1), p);
+            uint8_t* out = dst.row(y, p);
+            int x = 0;
+#if DUAN_SIMD_X86
+            if (level == SimdLevel::AVX2) {
+                x = downscaleRow8Avx2(r0, r1, out, dst_w, src_w);
+            }
+            if (level != SimdLevel::Scalar) {
+                x += downscaleRow8Sse(r0 + 2 * x, r1 + 2 * x, out + x, dst_w - x, src_w - 2 * x);
+            }
+#endif
+            downscaleRow8Scalar(r0, r1, out, x, dst_w, src_w);
+        }
+    }
+    return dst;
+}
+
+}
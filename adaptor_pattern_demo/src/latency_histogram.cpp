@@ -0,0 +1,95 @@
+#include "adaptor/latency_histogram.hpp"
+#include <algorithm>
+#include <iomanip>
+
+namespace duan {
+
+std::ostream& operator<<(std::ostream& os, const HistogramSnapshot& s) {
+    std::ios::fmtflags flags = os.flags();
+    os << std::fixed << std::setprecision(1)
+       << "n=" << s.count << " mean=" << s.mean_us << "us p50=" << s.p50_us << "us p90=" << s.p90_us
+       << "us p99=" << s.p99_us << "us p99.9=" << s.p999_us << "us max=" << s.max_us << "us";
+    os.flags(flags);
+    return os;
+}
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < 32) {
+        return static_cast<size_t>(value);
+    }
+    // 保留最高的5位: mantissa ∈ [16, 31]
+    const int msb = 63 - __builtin_clzll(value);
+    const int shift = msb - kSubBucketBits;
+    const uint64_t mantissa = value >> shift;
+    return 32 + static_cast<size_t>(shift - 1) * 16 + static_cast<size_t>(mantissa - 16);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < 32) {
+        return index;
+    }
+    const size_t shift = (index - 32) / 16 + 1;
+    const uint64_t mantissa = (index - 32) % 16 + 16;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value_ns) {
+    value_ns = std::min(value_ns, kMaxValue);
+    buckets_[bucketIndex(value_ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value_ns, std::memory_order_relaxed);
+    uint64_t current = max_.load(std::memory_order_relaxed);
+    while (value_ns > current && !max_.compare_exchange_weak(current, value_ns, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    uint64_t total = 0;
+    uint64_t counts[kBucketCount];
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(p / 100.0 * total + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), max_.load(std::memory_order_relaxed));
+        }
+    }
+    return max_.load(std::memory_order_relaxed);
+}
+
+HistogramSnapshot LatencyHistogram::snapshot() const {
+    HistogramSnapshot s;
+    s.count = count();
+    if (s.count == 0) {
+        return s;
+    }
+    s.mean_us = static_cast<double>(sum_.load(std::memory_order_relaxed)) / s.count / 1000.0;
+    s.max_us = max_.load(std::memory_order_relaxed) / 1000.0;
+    s.p50_us = percentile(50.0) / 1000.0;
+    s.p90_us = percentile(90.0) / 1000.0;
+    s.p99_us = percentile(99.0) / 1000.0;
+    s.p999_us = percentile(99.9) / 1000.0;
+    return s;
+}
+
+}
@@ -4,7 +4,8 @@
 namespace duan {
 
 LidarAdaptor::LidarAdaptor(const std::string& device_id)
-    : legacy_lidar_(std::make_unique<LegacyLidar>(device_id)), adaptor_name_("LidarAdaptor_" + device_id) {
+    : legacy_lidar_(std::make_unique<LegacyLidar>(device_id)), adaptor_name_("LidarAdaptor_" + device_id),
+      projector_(LidarGeometry::singleRing(360)) {
     std::cout << "[LidarAdaptor] 创建适配器: " << adaptor_name_ << " for device: " << device_id << std::endl;
 }
 
@@ -42,6 +43,28 @@ std::string LidarAdaptor::getName() const {
     return adaptor_name_;
 }
 
+PointCloud LidarAdaptor::getPointCloud() {
+    PointCloud cloud;
+    if (!legacy_lidar_->isDeviceRunning()) {
+        std::cerr << "[LidarAdaptor] 设备未运行，无法获取点云: " << adaptor_name_ << std::endl;
+        return cloud;
+    }
+
+    RangeScan scan;
+    scan.ranges = legacy_lidar_->readLidarPoints();
+    scan.rings = 1;
+    scan.beams = static_cast<int>(scan.ranges.size());
+    scan.timestamp = convertTimestamp(legacy_lidar_->getCurrentTimestamp());
+    scan.frame_id = "lidar_" + legacy_lidar_->getDeviceId();
+
+    if (scan.beams != projector_.geometry().beams) {
+        std::cerr << "[LidarAdaptor] 扫描点数与几何参数不一致: " << scan.beams << std::endl;
+        return cloud;
+    }
+    projector_.project(scan, cloud);
+    return cloud;
+}
+
 std::vector<double> LidarAdaptor::convertFloatToDouble(const std::vector<float>& input) {
     std::vector<double> output;
     output.reserve(input.size());
@@ -1,12 +1,12 @@
 #include "adaptor/modern_camera.hpp"
 #include <iostream>
 #include <chrono>
-#include <random>
+#include <algorithm>
 
 namespace duan {
 
-ModernCamera::ModernCamera(const std::string& name)
-    : is_initialized_(false), camera_name_(name) {
+ModernCamera::ModernCamera(const std::string& name, int width, int height)
+    : is_initialized_(false), camera_name_(name), width_(width), height_(height), frame_count_(0) {
     std::cout << "[ModernCamera] 创建摄像头: " << camera_name_ << std::endl;
 }
 
@@ -34,18 +34,29 @@ SensorInterface::SensorDate ModernCamera::getSensorData() {
     }
 
     SensorInterface::SensorDate data;
-    data.timestamp = static_cast<double>(std::chrono::system_clock::now().time_since_epoch().count()) / 1000000.0; // 转换为秒
+    data.timestamp = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count(); // 秒
     data.frame_id = "camera_" + camera_name_;
 
-    // 模拟生成一些摄像头数据点
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<double> dist(0.0, 255.0); // 模拟RGB值
-
-    for (int i = 0; i < 100; ++i) { // 假设每次获取10个数据点
-        data.points.push_back(dist(gen));
+    // 模拟生成一帧RGB图像：随帧号移动的渐变条纹
+    ImageFrame image = ImageFrame::allocate(width_, height_, PixelFormat::RGB8, &pool_);
+    image.timestamp = data.timestamp;
+    image.frame_id = data.frame_id;
+    const int phase = static_cast<int>(frame_count_++ % 256);
+    for (int y = 0; y < height_; ++y) {
+        uint8_t* row = image.row(y);
+        for (int x = 0; x < width_; ++x) {
+            row[3 * x] = static_cast<uint8_t>(x + phase);
+            row[3 * x + 1] = static_cast<uint8_t>(y + phase);
+            row[3 * x + 2] = static_cast<uint8_t>((x ^ y) + phase);
+        }
     }
 
+    // 兼容旧接口：points 中保留前100个通道值作为预览
+    const uint8_t* first_row = image.row(0);
+    const size_t preview = std::min<size_t>(100, image.rowBytes(0));
+    data.points.assign(first_row, first_row + preview);
+    data.image = std::make_shared<const ImageFrame>(std::move(image));
+
     std::cout << "[ModernCamera] 获取摄像头数据: " << camera_name_ << std::endl;
     return data;
 }
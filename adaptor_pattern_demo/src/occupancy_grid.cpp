@@ -0,0 +1,446 @@
+#include "adaptor/occupancy_grid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace duan {
+
+namespace {
+
+constexpr float kDegToRad = 0.017453292519943295f;
+constexpr int kTileShift = 4;  // log2(kTileSize)
+constexpr int kTileCells = OccupancyGrid::kTileSize * OccupancyGrid::kTileSize;
+
+int64_t floorDiv(int64_t a, int64_t b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+int64_t posMod(int64_t a, int64_t m) {
+    const int64_t r = a % m;
+    return r < 0 ? r + m : r;
+}
+
+/*
+单条射线的DDA参数
+从 (sx, sy) 出发走 steps 步，第k步所在格子为 floor(sx + k*dx), floor(sy + k*dy)
+不包含端点所在格子
+*/
+struct Ray {
+    float dx;
+    float dy;
+    int32_t steps;
+};
+
+// 逐条射线遍历，index_of 计算存储下标，visit 处理格子
+template <typename IndexOf, typename Visit>
+void traceScalar(const Ray* rays, size_t begin, size_t end, float sx, float sy, IndexOf&& index_of, Visit&& visit) {
+    for (size_t r = begin; r < end; ++r) {
+        const Ray& ray = rays[r];
+        for (int32_t k = 0; k < ray.steps; ++k) {
+            const float kf = static_cast<float>(k);
+            const float fx = sx + kf * ray.dx;
+            const float fy = sy + kf * ray.dy;
+            visit(index_of(static_cast<int32_t>(fx), static_cast<int32_t>(fy)));
+        }
+    }
+}
+
+#if DUAN_SIMD_X86
+/*
+AVX2: 8条射线为一组同步推进，每一步并行算出8个格子的存储下标
+下标计算: tile = ((oty + cy>>4) & mask) << shift | ((otx + cx>>4) & mask)
+          index = tile << 8 | (cy & 15) << 4 | (cx & 15)
+浮点运算与 traceScalar 相同 (先乘后加，不使用FMA)
+返回处理完的射线数（8的倍数）
+*/
+template <typename Visit>
+DUAN_TARGET_AVX2
+size_t traceAvx2(const Ray* rays, size_t count, float sx, float sy, int32_t tile_x0, int32_t tile_y0,
+                 int32_t tile_mask, int32_t tile_shift, Visit&& visit) {
+    const size_t groups = count / 8;
+    const __m256 vsx = _mm256_set1_ps(sx);
+    const __m256 vsy = _mm256_set1_ps(sy);
+    const __m256i vtx0 = _mm256_set1_epi32(tile_x0);
+    const __m256i vty0 = _mm256_set1_epi32(tile_y0);
+    const __m256i vmask = _mm256_set1_epi32(tile_mask);
+    const __m256i vlocal = _mm256_set1_epi32(OccupancyGrid::kTileSize - 1);
+    const __m128i vshift = _mm_cvtsi32_si128(tile_shift);
+    alignas(32) int32_t steps[8];
+    alignas(32) float dxs[8];
+    alignas(32) float dys[8];
+    alignas(32) uint32_t indices[8];
+
+    for (size_t g = 0; g < groups; ++g) {
+        int32_t max_steps = 0;
+        for (int i = 0; i < 8; ++i) {
+            const Ray& ray = rays[g * 8 + i];
+            dxs[i] = ray.dx;
+            dys[i] = ray.dy;
+            steps[i] = ray.steps;
+            max_steps = std::max(max_steps, ray.steps);
+        }
+        const __m256 vdx = _mm256_load_ps(dxs);
+        const __m256 vdy = _mm256_load_ps(dys);
+        const __m256i vsteps = _mm256_load_si256(reinterpret_cast<const __m256i*>(steps));
+
+        for (int32_t k = 0; k < max_steps; ++k) {
+            const __m256 kf = _mm256_set1_ps(static_cast<float>(k));
+            const __m256 fx = _mm256_add_ps(vsx, _mm256_mul_ps(kf, vdx));
+            const __m256 fy = _mm256_add_ps(vsy, _mm256_mul_ps(kf, vdy));
+            const __m256i cx = _mm256_cvttps_epi32(fx);
+            const __m256i cy = _mm256_cvttps_epi32(fy);
+
+            const __m256i tx = _mm256_and_si256(_mm256_add_epi32(vtx0, _mm256_srli_epi32(cx, kTileShift)), vmask);
+            const __m256i ty = _mm256_and_si256(_mm256_add_epi32(vty0, _mm256_srli_epi32(cy, kTileShift)), vmask);
+            const __m256i tile = _mm256_or_si256(_mm256_sll_epi32(ty, vshift), tx);
+            const __m256i local = _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(cy, vlocal), kTileShift),
+                                                  _mm256_and_si256(cx, vlocal));
+            const __m256i index = _mm256_or_si256(_mm256_slli_epi32(tile, 2 * kTileShift), local);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(indices), index);
+
+            // k < steps 的车道有效
+            const __m256i active = _mm256_cmpgt_epi32(vsteps, _mm256_set1_epi32(k));
+            unsigned lanes = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(active)));
+            while (lanes) {
+                const int lane = __builtin_ctz(lanes);
+                lanes &= lanes - 1;
+                visit(indices[lane]);
+            }
+        }
+    }
+    return groups * 8;
+}
+#endif
+
+}
+
+OccupancyGrid::OccupancyGrid(const OccupancyGridConfig& config) : config_(config) {
+    const int size = config.size_cells;
+    if (size < kTileSize || (size & (size - 1)) != 0) {
+        throw std::invalid_argument("OccupancyGrid: size_cells 必须是2的幂且不小于16");
+    }
+    if (config.resolution <= 0.0f) {
+        throw std::invalid_argument("OccupancyGrid: resolution 必须大于0");
+    }
+    tiles_per_side_ = size / kTileSize;
+    tile_shift_ = 0;
+    while ((1 << tile_shift_) < tiles_per_side_) {
+        ++tile_shift_;
+    }
+    const size_t total = static_cast<size_t>(size) * size;
+    cells_.assign(total, 0.0f);
+    stamps_.assign(total, 0);
+    tile_dirty_.assign(static_cast<size_t>(tiles_per_side_) * tiles_per_side_, 0);
+}
+
+void OccupancyGrid::clear() {
+    std::fill(cells_.begin(), cells_.end(), 0.0f);
+    for (uint32_t t = 0; t < tile_dirty_.size(); ++t) {
+        markTileDirty(t << (2 * kTileShift));
+    }
+}
+
+void OccupancyGrid::resetTile(uint32_t tile) {
+    std::fill(cells_.begin() + static_cast<size_t>(tile) * kTileCells,
+              cells_.begin() + static_cast<size_t>(tile + 1) * kTileCells, 0.0f);
+    markTileDirty(tile << (2 * kTileShift));
+}
+
+void OccupancyGrid::recenter(float x, float y) {
+    const int64_t half_tiles = tiles_per_side_ / 2;
+    const int64_t center_cx = static_cast<int64_t>(std::floor(static_cast<double>(x) / config_.resolution));
+    const int64_t center_cy = static_cast<int64_t>(std::floor(static_cast<double>(y) / config_.resolution));
+    const int64_t new_tx = floorDiv(center_cx, kTileSize) - half_tiles;
+    const int64_t new_ty = floorDiv(center_cy, kTileSize) - half_tiles;
+
+    if (!has_origin_) {
+        origin_cell_x_ = new_tx * kTileSize;
+        origin_cell_y_ = new_ty * kTileSize;
+        has_origin_ = true;
+        return;
+    }
+    const int64_t old_tx = origin_cell_x_ / kTileSize;
+    const int64_t old_ty = origin_cell_y_ / kTileSize;
+    if (new_tx == old_tx && new_ty == old_ty) {
+        return;
+    }
+
+    // 某个存储列/行在新旧窗口中对应的世界 tile 不同，说明它移出了窗口
+    const int64_t n = tiles_per_side_;
+    std::vector<uint8_t> col_changed(n), row_changed(n);
+    for (int64_t s = 0; s < n; ++s) {
+        const int64_t old_world_x = old_tx + posMod(s - old_tx, n);
+        const int64_t new_world_x = new_tx + posMod(s - new_tx, n);
+        col_changed[s] = old_world_x != new_world_x;
+        const int64_t old_world_y = old_ty + posMod(s - old_ty, n);
+        const int64_t new_world_y = new_ty + posMod(s - new_ty, n);
+        row_changed[s] = old_world_y != new_world_y;
+    }
+    for (int64_t row = 0; row < n; ++row) {
+        for (int64_t col = 0; col < n; ++col) {
+            if (row_changed[row] || col_changed[col]) {
+                resetTile(static_cast<uint32_t>(row * n + col));
+            }
+        }
+    }
+    origin_cell_x_ = new_tx * kTileSize;
+    origin_cell_y_ = new_ty * kTileSize;
+}
+
+uint32_t OccupancyGrid::indexOf(int32_t cx, int32_t cy) const {
+    const int32_t mask = tiles_per_side_ - 1;
+    const int32_t tile_x0 = static_cast<int32_t>(posMod(origin_cell_x_ / kTileSize, tiles_per_side_));
+    const int32_t tile_y0 = static_cast<int32_t>(posMod(origin_cell_y_ / kTileSize, tiles_per_side_));
+    const int32_t tx = (tile_x0 + (cx >> kTileShift)) & mask;
+    const int32_t ty = (tile_y0 + (cy >> kTileShift)) & mask;
+    const uint32_t tile = static_cast<uint32_t>((ty << tile_shift_) | tx);
+    return (tile << (2 * kTileShift)) | static_cast<uint32_t>(((cy & (kTileSize - 1)) << kTileShift) | (cx & (kTileSize - 1)));
+}
+
+bool OccupancyGrid::cellIndex(float x, float y, uint32_t& index) const {
+    if (!has_origin_) {
+        return false;
+    }
+    const int64_t cx = static_cast<int64_t>(std::floor(static_cast<double>(x) / config_.resolution)) - origin_cell_x_;
+    const int64_t cy = static_cast<int64_t>(std::floor(static_cast<double>(y) / config_.resolution)) - origin_cell_y_;
+    if (cx < 0 || cy < 0 || cx >= config_.size_cells || cy >= config_.size_cells) {
+        return false;
+    }
+    index = indexOf(static_cast<int32_t>(cx), static_cast<int32_t>(cy));
+    return true;
+}
+
+void OccupancyGrid::markTileDirty(uint32_t index) {
+    const uint32_t tile = index >> (2 * kTileShift);
+    if (!tile_dirty_[tile]) {
+        tile_dirty_[tile] = 1;
+        dirty_list_.push_back(tile);
+    }
+}
+
+void OccupancyGrid::markFree(uint32_t index) {
+    const uint32_t free_stamp = 2 * scan_id_;
+    if (stamps_[index] >= free_stamp) {
+        return;  // 本帧已更新过（空闲或占据）
+    }
+    stamps_[index] = free_stamp;
+    cells_[index] = std::max(cells_[index] + config_.log_odds_miss, config_.log_odds_min);
+    markTileDirty(index);
+}
+
+void OccupancyGrid::integrate(const RangeScan& scan, const LidarGeometry& geometry, const Pose2D& pose,
+                              SimdLevel level) {
+    if (scan.rings != geometry.rings() || scan.beams != geometry.beams ||
+        scan.ranges.size() != static_cast<size_t>(scan.rings) * scan.beams) {
+        throw std::invalid_argument("OccupancyGrid: 扫描尺寸与几何参数不一致");
+    }
+    recenter(pose.x, pose.y);
+
+    // 方位角加上航向后的方向表
+    const size_t beams = static_cast<size_t>(scan.beams);
+    cos_az_.resize(beams);
+    sin_az_.resize(beams);
+    for (size_t b = 0; b < beams; ++b) {
+        const float az = (geometry.azimuth_start_deg + static_cast<float>(b) * geometry.azimuth_step_deg) * kDegToRad + pose.yaw;
+        cos_az_[b] = std::cos(az);
+        sin_az_[b] = std::sin(az);
+    }
+
+    const float inv_res = 1.0f / config_.resolution;
+    const float sx = static_cast<float>(static_cast<double>(pose.x) / config_.resolution - static_cast<double>(origin_cell_x_));
+    const float sy = static_cast<float>(static_cast<double>(pose.y) / config_.resolution - static_cast<double>(origin_cell_y_));
+    const size_t total = scan.ranges.size();
+    end_x_.resize(total);
+    end_y_.resize(total);
+    is_hit_.resize(total);
+
+    size_t count = 0;
+    for (int ring = 0; ring < scan.rings; ++ring) {
+        const float cos_el = std::cos(geometry.elevations_deg[ring] * kDegToRad);
+        const float* ranges = scan.ranges.data() + static_cast<size_t>(ring) * beams;
+        for (size_t b = 0; b < beams; ++b) {
+            float range = ranges[b];
+            uint8_t hit = 1;
+            if (!(range > 0.0f)) {
+                if (!config_.no_return_as_free) {
+                    continue;
+                }
+                range = config_.max_range;
+                hit = 0;
+            } else if (range > config_.max_range) {
+                range = config_.max_range;
+                hit = 0;
+            }
+            const float d = range * cos_el * inv_res;
+            end_x_[count] = sx + d * cos_az_[b];
+            end_y_[count] = sy + d * sin_az_[b];
+            is_hit_[count] = hit;
+            ++count;
+        }
+    }
+    integrateEndpoints(sx, sy, count, level);
+}
+
+void OccupancyGrid::integrate(const PointCloud& cloud, const Pose2D& pose, float min_z, float max_z,
+                              SimdLevel level) {
+    recenter(pose.x, pose.y);
+
+    const float inv_res = 1.0f / config_.resolution;
+    const float c = std::cos(pose.yaw) * inv_res;
+    const float s = std::sin(pose.yaw) * inv_res;
+    const float sx = static_cast<float>(static_cast<double>(pose.x) / config_.resolution - static_cast<double>(origin_cell_x_));
+    const float sy = static_cast<float>(static_cast<double>(pose.y) / config_.resolution - static_cast<double>(origin_cell_y_));
+    const float max_range_sq = config_.max_range * config_.max_range;
+    end_x_.resize(cloud.size());
+    end_y_.resize(cloud.size());
+    is_hit_.resize(cloud.size());
+
+    size_t count = 0;
+    for (size_t i = 0; i < cloud.size(); ++i) {
+        // 写成取反的形式，z 为 NaN 时同样跳过
+        if (!(cloud.z[i] >= min_z && cloud.z[i] <= max_z)) {
+            continue;
+        }
+        float px = cloud.x[i];
+        float py = cloud.y[i];
+        // 非有限坐标在射线步数换算成整数时是未定义行为，直接丢弃
+        if (!std::isfinite(px) || !std::isfinite(py)) {
+            continue;
+        }
+        const float dist_sq = px * px + py * py;
+        uint8_t hit = 1;
+        if (dist_sq > max_range_sq) {
+            const float scale = config_.max_range / std::sqrt(dist_sq);
+            px *= scale;
+            py *= scale;
+            hit = 0;
+        }
+        end_x_[count] = sx + (c * px - s * py);
+        end_y_[count] = sy + (s * px + c * py);
+        is_hit_[count] = hit;
+        ++count;
+    }
+    integrateEndpoints(sx, sy, count, level);
+}
+
+void OccupancyGrid::integrateEndpoints(float sx, float sy, size_t count, SimdLevel level) {
+    // 帧号用于去重，回绕时重置
+    if (scan_id_ >= 0x7FFFFFFFu) {
+        std::fill(stamps_.begin(), stamps_.end(), 0);
+        scan_id_ = 0;
+    }
+    ++scan_id_;
+    const uint32_t hit_stamp = 2 * scan_id_ + 1;
+    const float size = static_cast<float>(config_.size_cells);
+    const float hi = size - 1e-3f;
+
+    // 1. 端点裁剪到窗口内，窗口外的端点不算命中；命中格子先打上占据标记
+    std::vector<Ray> rays;
+    rays.reserve(count);
+    std::vector<uint32_t> hits;
+    hits.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        float ex = end_x_[i];
+        float ey = end_y_[i];
+        const float dx = ex - sx;
+        const float dy = ey - sy;
+        float t = 1.0f;
+        if (ex > hi) t = std::min(t, (hi - sx) / dx);
+        if (ex < 0.0f) t = std::min(t, -sx / dx);
+        if (ey > hi) t = std::min(t, (hi - sy) / dy);
+        if (ey < 0.0f) t = std::min(t, -sy / dy);
+        bool hit = is_hit_[i] != 0;
+        if (t < 1.0f) {
+            t = std::max(t, 0.0f);
+            ex = sx + t * dx;
+            ey = sy + t * dy;
+            hit = false;
+        }
+        const float span = std::max(std::fabs(ex - sx), std::fabs(ey - sy));
+        const int32_t steps = static_cast<int32_t>(std::ceil(span));
+        if (steps > 0) {
+            const float inv = 1.0f / static_cast<float>(steps);
+            rays.push_back({(ex - sx) * inv, (ey - sy) * inv, steps});
+        }
+        if (hit) {
+            const uint32_t index = indexOf(static_cast<int32_t>(ex), static_cast<int32_t>(ey));
+            if (stamps_[index] != hit_stamp) {
+                stamps_[index] = hit_stamp;
+                hits.push_back(index);
+            }
+        }
+    }
+
+    // 2. 沿射线更新空闲格子（占据标记的格子跳过）
+    const int32_t tile_x0 = static_cast<int32_t>(posMod(origin_cell_x_ / kTileSize, tiles_per_side_));
+    const int32_t tile_y0 = static_cast<int32_t>(posMod(origin_cell_y_ / kTileSize, tiles_per_side_));
+    const int32_t tile_mask = tiles_per_side_ - 1;
+    const int32_t tile_shift = tile_shift_;
+    auto visit = [this](uint32_t index) { markFree(index); };
+    // 与 indexOf 相同，窗口原点在循环外取出
+    auto index_of = [=](int32_t cx, int32_t cy) {
+        const uint32_t tile = static_cast<uint32_t>((((tile_y0 + (cy >> kTileShift)) & tile_mask) << tile_shift) |
+                                                    ((tile_x0 + (cx >> kTileShift)) & tile_mask));
+        return (tile << (2 * kTileShift)) |
+               static_cast<uint32_t>(((cy & (kTileSize - 1)) << kTileShift) | (cx & (kTileSize - 1)));
+    };
+    size_t done = 0;
+#if DUAN_SIMD_X86
+    if (clampSimdLevel(level) == SimdLevel::AVX2) {
+        done = traceAvx2(rays.data(), rays.size(), sx, sy, tile_x0, tile_y0, tile_mask, tile_shift, visit);
+    }
+#else
+    (void)level;
+#endif
+    traceScalar(rays.data(), done, rays.size(), sx, sy, index_of, visit);
+
+    // 3. 命中格子
+    for (uint32_t index : hits) {
+        cells_[index] = std::min(cells_[index] + config_.log_odds_hit, config_.log_odds_max);
+        markTileDirty(index);
+    }
+}
+
+float OccupancyGrid::logOdds(float x, float y) const {
+    uint32_t index;
+    return cellIndex(x, y, index) ? cells_[index] : 0.0f;
+}
+
+float OccupancyGrid::probability(float x, float y) const {
+    return 1.0f / (1.0f + std::exp(-logOdds(x, y)));
+}
+
+CellState OccupancyGrid::state(float x, float y) const {
+    const float l = logOdds(x, y);
+    if (l > config_.occupied_threshold) {
+        return CellState::Occupied;
+    }
+    if (l < config_.free_threshold) {
+        return CellState::Free;
+    }
+    return CellState::Unknown;
+}
+
+std::vector<TileCoord> OccupancyGrid::dirtyTiles() const {
+    // 存储位置 -> 当前窗口中对应的世界 tile
+    const int64_t n = tiles_per_side_;
+    const int64_t tx0 = origin_cell_x_ / kTileSize;
+    const int64_t ty0 = origin_cell_y_ / kTileSize;
+    std::vector<TileCoord> tiles;
+    tiles.reserve(dirty_list_.size());
+    for (uint32_t tile : dirty_list_) {
+        const int64_t col = tile & (n - 1);
+        const int64_t row = tile >> tile_shift_;
+        tiles.push_back({tx0 + posMod(col - tx0, n), ty0 + posMod(row - ty0, n)});
+    }
+    return tiles;
+}
+
+void OccupancyGrid::clearDirty() {
+    for (uint32_t tile : dirty_list_) {
+        tile_dirty_[tile] = 0;
+    }
+    dirty_list_.clear();
+}
+
+}
@@ -0,0 +1,265 @@
+#include "adaptor/point_filter.hpp"
+#include "adaptor/parallel_utils.hpp"
+#include "adaptor/voxel_key.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace duan {
+
+namespace {
+
+// 体素累加器，用double累加避免大点数下的精度损失
+struct VoxelAccum {
+    double sx = 0.0, sy = 0.0, sz = 0.0;
+    uint32_t count = 0;
+    uint32_t first_index = 0; // 首个落入该体素的点下标，用于稳定排序输出
+};
+
+/*
+ * 开放寻址（线性探测）哈希表
+ * 键和累加器分开存放，探测时只触碰键数组
+ */
+class VoxelTable {
+private:
+    std::vector<uint64_t> keys_;
+    std::vector<VoxelAccum> values_;
+    size_t mask_;
+    size_t size_;
+
+public:
+    explicit VoxelTable(size_t expected) : size_(0) {
+        size_t capacity = 16;
+        while (capacity < expected * 2) {
+            capacity <<= 1;
+        }
+        keys_.assign(capacity, kEmptyVoxelKey);
+        values_.resize(capacity);
+        mask_ = capacity - 1;
+    }
+
+    VoxelAccum& slot(uint64_t key, uint32_t index) {
+        if ((size_ + 1) * 2 > keys_.size()) {
+            grow();
+        }
+        size_t pos = mixHash(key) & mask_;
+        while (keys_[pos] != kEmptyVoxelKey && keys_[pos] != key) {
+            pos = (pos + 1) & mask_;
+        }
+        if (keys_[pos] == kEmptyVoxelKey) {
+            keys_[pos] = key;
+            values_[pos] = VoxelAccum();
+            values_[pos].first_index = index;
+            ++size_;
+        }
+        return values_[pos];
+    }
+
+    void add(uint64_t key, uint32_t index, float x, float y, float z) {
+        VoxelAccum& acc = slot(key, index);
+        acc.sx += x;
+        acc.sy += y;
+        acc.sz += z;
+        ++acc.count;
+    }
+
+    void merge(const VoxelTable& other) {
+        for (size_t i = 0; i < other.keys_.size(); ++i) {
+            if (other.keys_[i] == kEmptyVoxelKey) {
+                continue;
+            }
+            const VoxelAccum& src = other.values_[i];
+            VoxelAccum& dst = slot(other.keys_[i], src.first_index);
+            dst.sx += src.sx;
+            dst.sy += src.sy;
+            dst.sz += src.sz;
+            dst.count += src.count;
+            dst.first_index = std::min(dst.first_index, src.first_index);
+        }
+    }
+
+    size_t size() const { return size_; }
+
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t i = 0; i < keys_.size(); ++i) {
+            if (keys_[i] != kEmptyVoxelKey) {
+                fn(values_[i]);
+            }
+        }
+    }
+
+private:
+    void grow() {
+        std::vector<uint64_t> old_keys;
+        std::vector<VoxelAccum> old_values;
+        old_keys.swap(keys_);
+        old_values.swap(values_);
+        keys_.assign(old_keys.size() * 2, kEmptyVoxelKey);
+        values_.resize(old_keys.size() * 2);
+        mask_ = keys_.size() - 1;
+        size_ = 0;
+        for (size_t i = 0; i < old_keys.size(); ++i) {
+            if (old_keys[i] == kEmptyVoxelKey) {
+                continue;
+            }
+            size_t pos = mixHash(old_keys[i]) & mask_;
+            while (keys_[pos] != kEmptyVoxelKey) {
+                pos = (pos + 1) & mask_;
+            }
+            keys_[pos] = old_keys[i];
+            values_[pos] = old_values[i];
+            ++size_;
+        }
+    }
+};
+
+}
+
+PointFilterPipeline::PointFilterPipeline()
+    : crop_enabled_(false), min_x_(0), min_y_(0), min_z_(0), max_x_(0), max_y_(0), max_z_(0),
+      range_enabled_(false), min_range_sq_(0), max_range_sq_(0),
+      leaf_size_(0.0f), num_threads_(1), parallel_threshold_(50000) {}
+
+PointFilterPipeline& PointFilterPipeline::cropBox(float min_x, float min_y, float min_z,
+                                                  float max_x, float max_y, float max_z) {
+    crop_enabled_ = true;
+    min_x_ = min_x;
+    min_y_ = min_y;
+    min_z_ = min_z;
+    max_x_ = max_x;
+    max_y_ = max_y;
+    max_z_ = max_z;
+    return *this;
+}
+
+PointFilterPipeline& PointFilterPipeline::rangeGate(float min_range, float max_range) {
+    range_enabled_ = true;
+    min_range_sq_ = min_range * min_range;
+    max_range_sq_ = max_range * max_range;
+    return *this;
+}
+
+PointFilterPipeline& PointFilterPipeline::voxelGrid(float leaf_size) {
+    leaf_size_ = leaf_size;
+    return *this;
+}
+
+PointFilterPipeline& PointFilterPipeline::threads(int num_threads, size_t parallel_threshold) {
+    num_threads_ = num_threads;
+    parallel_threshold_ = parallel_threshold;
+    return *this;
+}
+
+bool PointFilterPipeline::accept(float x, float y, float z) const {
+    if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z)) {
+        return false;
+    }
+    if (crop_enabled_ &&
+        (x < min_x_ || x > max_x_ || y < min_y_ || y > max_y_ || z < min_z_ || z > max_z_)) {
+        return false;
+    }
+    if (range_enabled_) {
+        float r2 = x * x + y * y + z * z;
+        if (r2 < min_range_sq_ || r2 > max_range_sq_) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int PointFilterPipeline::effectiveThreads(size_t n) const {
+    if (n < parallel_threshold_) {
+        return 1;
+    }
+    // 每个线程至少处理 parallel_threshold_/2 个点，避免切得过碎
+    return choosePartitions(n, num_threads_, parallel_threshold_ / 2);
+}
+
+PointCloud PointFilterPipeline::apply(const PointCloud& in) const {
+    PointCloud out = leaf_size_ > 0.0f ? gateAndVoxelize(in) : gateOnly(in);
+    out.timestamp = in.timestamp;
+    out.frame_id = in.frame_id;
+    return out;
+}
+
+PointCloud PointFilterPipeline::apply(const SensorInterface::SensorDate& data, const ScanProjector& projector) const {
+    RangeScan scan = rangeScanFromSensorData(data, projector.geometry().rings());
+    return apply(projector.project(scan));
+}
+
+PointCloud PointFilterPipeline::gateOnly(const PointCloud& in) const {
+    const size_t n = in.size();
+    const int parts = effectiveThreads(n);
+    std::vector<PointCloud> partial(parts);
+
+    runPartitioned(n, parts, [&](int p, size_t begin, size_t end) {
+        PointCloud& local = partial[p];
+        local.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            if (accept(in.x[i], in.y[i], in.z[i])) {
+                local.push_back(in.x[i], in.y[i], in.z[i]);
+            }
+        }
+    });
+
+    if (parts == 1) {
+        return std::move(partial[0]);
+    }
+    PointCloud out;
+    size_t total = 0;
+    for (const auto& local : partial) {
+        total += local.size();
+    }
+    out.reserve(total);
+    for (const auto& local : partial) {
+        out.x.insert(out.x.end(), local.x.begin(), local.x.end());
+        out.y.insert(out.y.end(), local.y.begin(), local.y.end());
+        out.z.insert(out.z.end(), local.z.begin(), local.z.end());
+    }
+    return out;
+}
+
+PointCloud PointFilterPipeline::gateAndVoxelize(const PointCloud& in) const {
+    const size_t n = in.size();
+    const int parts = effectiveThreads(n);
+    const float inv_leaf = 1.0f / leaf_size_;
+    std::vector<VoxelTable> tables;
+    tables.reserve(parts);
+    for (int p = 0; p < parts; ++p) {
+        tables.emplace_back(std::min<size_t>(n / parts + 1, 1 << 16));
+    }
+
+    runPartitioned(n, parts, [&](int p, size_t begin, size_t end) {
+        VoxelTable& table = tables[p];
+        for (size_t i = begin; i < end; ++i) {
+            const float x = in.x[i], y = in.y[i], z = in.z[i];
+            if (accept(x, y, z)) {
+                table.add(voxelKey(x, y, z, inv_leaf), static_cast<uint32_t>(i), x, y, z);
+            }
+        }
+    });
+
+    for (int p = 1; p < parts; ++p) {
+        tables[0].merge(tables[p]);
+    }
+
+    std::vector<const VoxelAccum*> voxels;
+    voxels.reserve(tables[0].size());
+    tables[0].forEach([&voxels](const VoxelAccum& acc) { voxels.push_back(&acc); });
+    std::sort(voxels.begin(), voxels.end(), [](const VoxelAccum* a, const VoxelAccum* b) {
+        return a->first_index < b->first_index;
+    });
+
+    PointCloud out;
+    out.reserve(voxels.size());
+    for (const VoxelAccum* acc : voxels) {
+        const double inv = 1.0 / acc->count;
+        out.push_back(static_cast<float>(acc->sx * inv),
+                      static_cast<float>(acc->sy * inv),
+                      static_cast<float>(acc->sz * inv));
+    }
+    return out;
+}
+
+}
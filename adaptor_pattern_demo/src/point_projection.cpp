@@ -0,0 +1,165 @@
+#include "adaptor/point_projection.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace duan {
+
+namespace {
+
+constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+
+// 单条ring的标量投影，同时作为SIMD路径的尾部处理
+void projectRingScalar(const float* r, const float* cos_az, const float* sin_az,
+                       float ce, float se, float* x, float* y, float* z, int begin, int end) {
+    for (int b = begin; b < end; ++b) {
+        float kx = ce * cos_az[b];
+        float ky = ce * sin_az[b];
+        x[b] = r[b] * kx;
+        y[b] = r[b] * ky;
+        z[b] = r[b] * se;
+    }
+}
+
+#if DUAN_SIMD_X86
+DUAN_TARGET_SSE41
+void projectRingSse(const float* r, const float* cos_az, const float* sin_az,
+                    float ce, float se, float* x, float* y, float* z, int n) {
+    const __m128 vce = _mm_set1_ps(ce);
+    const __m128 vse = _mm_set1_ps(se);
+    int b = 0;
+    for (; b + 4 <= n; b += 4) {
+        __m128 vr = _mm_loadu_ps(r + b);
+        __m128 kx = _mm_mul_ps(vce, _mm_loadu_ps(cos_az + b));
+        __m128 ky = _mm_mul_ps(vce, _mm_loadu_ps(sin_az + b));
+        _mm_storeu_ps(x + b, _mm_mul_ps(vr, kx));
+        _mm_storeu_ps(y + b, _mm_mul_ps(vr, ky));
+        _mm_storeu_ps(z + b, _mm_mul_ps(vr, vse));
+    }
+    projectRingScalar(r, cos_az, sin_az, ce, se, x, y, z, b, n);
+}
+
+DUAN_TARGET_AVX2
+void projectRingAvx2(const float* r, const float* cos_az, const float* sin_az,
+                     float ce, float se, float* x, float* y, float* z, int n) {
+    const __m256 vce = _mm256_set1_ps(ce);
+    const __m256 vse = _mm256_set1_ps(se);
+    int b = 0;
+    for (; b + 8 <= n; b += 8) {
+        __m256 vr = _mm256_loadu_ps(r + b);
+        __m256 kx = _mm256_mul_ps(vce, _mm256_loadu_ps(cos_az + b));
+        __m256 ky = _mm256_mul_ps(vce, _mm256_loadu_ps(sin_az + b));
+        _mm256_storeu_ps(x + b, _mm256_mul_ps(vr, kx));
+        _mm256_storeu_ps(y + b, _mm256_mul_ps(vr, ky));
+        _mm256_storeu_ps(z + b, _mm256_mul_ps(vr, vse));
+    }
+    projectRingScalar(r, cos_az, sin_az, ce, se, x, y, z, b, n);
+}
+#endif
+
+}
+
+RangeScan rangeScanFromSensorData(const SensorInterface::SensorDate& data, int rings) {
+    if (rings <= 0 || data.points.size() % static_cast<size_t>(rings) != 0) {
+        throw std::invalid_argument("rangeScanFromSensorData: 点数无法按线数整除");
+    }
+    RangeScan scan;
+    scan.rings = rings;
+    scan.beams = static_cast<int>(data.points.size() / rings);
+    scan.ranges.assign(data.points.begin(), data.points.end());
+    scan.timestamp = data.timestamp;
+    scan.frame_id = data.frame_id;
+    return scan;
+}
+
+LidarGeometry LidarGeometry::singleRing(int beams) {
+    LidarGeometry geometry;
+    geometry.beams = beams;
+    geometry.azimuth_start_deg = 0.0f;
+    geometry.azimuth_step_deg = 360.0f / static_cast<float>(beams);
+    geometry.elevations_deg = {0.0f};
+    return geometry;
+}
+
+LidarGeometry LidarGeometry::uniform(int rings, int beams, float min_elevation_deg, float max_elevation_deg) {
+    LidarGeometry geometry = singleRing(beams);
+    geometry.elevations_deg.resize(rings);
+    for (int i = 0; i < rings; ++i) {
+        float t = rings > 1 ? static_cast<float>(i) / static_cast<float>(rings - 1) : 0.0f;
+        geometry.elevations_deg[i] = min_elevation_deg + t * (max_elevation_deg - min_elevation_deg);
+    }
+    return geometry;
+}
+
+ScanProjector::ScanProjector(const LidarGeometry& geometry)
+    : geometry_(geometry), level_(detectSimdLevel()) {
+    if (geometry_.beams <= 0 || geometry_.rings() <= 0) {
+        throw std::invalid_argument("ScanProjector: 几何参数无效");
+    }
+
+    // 在double精度下计算三角函数，再截断为float
+    cos_az_.resize(geometry_.beams);
+    sin_az_.resize(geometry_.beams);
+    for (int b = 0; b < geometry_.beams; ++b) {
+        double az = (geometry_.azimuth_start_deg + static_cast<double>(b) * geometry_.azimuth_step_deg) * kDegToRad;
+        cos_az_[b] = static_cast<float>(std::cos(az));
+        sin_az_[b] = static_cast<float>(std::sin(az));
+    }
+
+    cos_el_.resize(geometry_.rings());
+    sin_el_.resize(geometry_.rings());
+    for (int r = 0; r < geometry_.rings(); ++r) {
+        double el = geometry_.elevations_deg[r] * kDegToRad;
+        cos_el_[r] = static_cast<float>(std::cos(el));
+        sin_el_[r] = static_cast<float>(std::sin(el));
+    }
+}
+
+void ScanProjector::project(const RangeScan& scan, PointCloud& out) const {
+    project(scan, out, level_);
+}
+
+PointCloud ScanProjector::project(const RangeScan& scan) const {
+    PointCloud cloud;
+    project(scan, cloud, level_);
+    return cloud;
+}
+
+void ScanProjector::project(const RangeScan& scan, PointCloud& out, SimdLevel level) const {
+    const int beams = geometry_.beams;
+    const int rings = geometry_.rings();
+    if (scan.beams != beams || scan.rings != rings ||
+        scan.ranges.size() != static_cast<size_t>(beams) * static_cast<size_t>(rings)) {
+        throw std::invalid_argument("ScanProjector: 扫描尺寸与几何参数不一致");
+    }
+
+    out.resize(scan.ranges.size());
+    out.timestamp = scan.timestamp;
+    out.frame_id = scan.frame_id;
+
+    level = clampSimdLevel(level);
+    for (int ring = 0; ring < rings; ++ring) {
+        const size_t offset = static_cast<size_t>(ring) * beams;
+        const float* r = scan.ranges.data() + offset;
+        float* x = out.x.data() + offset;
+        float* y = out.y.data() + offset;
+        float* z = out.z.data() + offset;
+        const float ce = cos_el_[ring];
+        const float se = sin_el_[ring];
+
+        switch (level) {
+#if DUAN_SIMD_X86
+            case SimdLevel::AVX2:
+                projectRingAvx2(r, cos_az_.data(), sin_az_.data(), ce, se, x, y, z, beams);
+                break;
+            case SimdLevel::SSE:
+                projectRingSse(r, cos_az_.data(), sin_az_.data(), ce, se, x, y, z, beams);
+                break;
+#endif
+            default:
+                projectRingScalar(r, cos_az_.data(), sin_az_.data(), ce, se, x, y, z, 0, beams);
+                break;
+        }
+    }
+}
+
+}
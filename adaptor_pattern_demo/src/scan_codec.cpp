@@ -0,0 +1,367 @@
+#include "adaptor/scan_codec.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace duan {
+
+namespace {
+
+constexpr uint32_t kFrameMagic = 0x31435344; // "DSC1"
+constexpr size_t kFixedHeaderSize = 30;
+constexpr size_t kBlockSize = 64;
+constexpr uint32_t kEscapeQuotient = 24;     // 商达到该值时改为直接写32位原值
+constexpr uint32_t kMaxQuantized = 0x7fffffff;
+
+template <typename T>
+void putRaw(std::vector<uint8_t>& out, T value) {
+    uint8_t bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T getRaw(const uint8_t* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+// 帧头描述的扫描编码后可能的最大帧长: 每块5位参数，每个残差最长为转义前缀加32位原值
+uint64_t maxFrameSize(int rings, int beams, size_t id_len) {
+    const uint64_t n = static_cast<uint64_t>(rings) * static_cast<uint64_t>(beams);
+    const uint64_t blocks = (n + kBlockSize - 1) / kBlockSize;
+    const uint64_t bits = blocks * 5 + n * (kEscapeQuotient + 32);
+    return kFixedHeaderSize + id_len + (bits + 7) / 8;
+}
+
+inline uint32_t zigzag(int32_t v) {
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+inline int32_t unzigzag(uint32_t v) {
+    return static_cast<int32_t>(v >> 1) ^ -static_cast<int32_t>(v & 1);
+}
+
+// 低位优先的位写入器
+class BitWriter {
+private:
+    std::vector<uint8_t>& out_;
+    uint64_t acc_;
+    int bits_;
+
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : out_(out), acc_(0), bits_(0) {}
+
+    // nbits <= 32
+    void put(uint64_t value, int nbits) {
+        acc_ |= value << bits_;
+        bits_ += nbits;
+        while (bits_ >= 8) {
+            out_.push_back(static_cast<uint8_t>(acc_));
+            acc_ >>= 8;
+            bits_ -= 8;
+        }
+    }
+
+    void flush() {
+        if (bits_ > 0) {
+            out_.push_back(static_cast<uint8_t>(acc_));
+        }
+        acc_ = 0;
+        bits_ = 0;
+    }
+};
+
+// 低位优先的位读取器，越界读取按0填充，结束后由调用者检查 overrun()
+class BitReader {
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_;
+    uint64_t acc_;
+    int bits_;
+    size_t consumed_bits_;
+
+public:
+    BitReader(const uint8_t* data, size_t size)
+        : data_(data), size_(size), pos_(0), acc_(0), bits_(0), consumed_bits_(0) {}
+
+    void refill() {
+        while (bits_ <= 56) {
+            uint64_t byte = pos_ < size_ ? data_[pos_] : 0;
+            ++pos_;
+            acc_ |= byte << bits_;
+            bits_ += 8;
+        }
+    }
+
+    uint64_t peek() const { return acc_; }
+
+    void skip(int nbits) {
+        acc_ >>= nbits;
+        bits_ -= nbits;
+        consumed_bits_ += nbits;
+    }
+
+    // nbits <= 32，调用前需保证已 refill
+    uint32_t take(int nbits) {
+        uint32_t value = nbits == 0 ? 0 : static_cast<uint32_t>(acc_ & ((uint64_t(1) << nbits) - 1));
+        skip(nbits);
+        return value;
+    }
+
+    bool overrun() const { return consumed_bits_ > size_ * 8; }
+};
+
+inline uint32_t quantize(float range, double inv_precision) {
+    if (!(range > 0.0f) || !std::isfinite(range)) {
+        return 0;
+    }
+    double q = std::round(static_cast<double>(range) * inv_precision);
+    return q >= kMaxQuantized ? kMaxQuantized : static_cast<uint32_t>(q);
+}
+
+// 选择Rice参数k，使 2^k 接近本组残差均值
+inline int chooseRiceParam(const uint32_t* values, size_t n) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += values[i];
+    }
+    int k = 0;
+    while (k < 31 && (static_cast<uint64_t>(n) << (k + 1)) <= sum) {
+        ++k;
+    }
+    return k;
+}
+
+}
+
+ScanEncoder::ScanEncoder(const ScanCodecOptions& options) : options_(options) {
+    if (!(options_.precision > 0.0f)) {
+        throw std::invalid_argument("ScanEncoder: 量化精度必须为正数");
+    }
+}
+
+size_t ScanEncoder::encode(const RangeScan& scan, std::vector<uint8_t>& out) {
+    const size_t n = scan.ranges.size();
+    if (scan.rings <= 0 || scan.beams < 0 || n != static_cast<size_t>(scan.rings) * static_cast<size_t>(scan.beams) ||
+        scan.rings > 0xffff || scan.frame_id.size() > 0xffff) {
+        throw std::invalid_argument("ScanEncoder: 扫描尺寸无效");
+    }
+
+    // 量化 + 预测
+    residuals_.resize(n);
+    const double inv_precision = 1.0 / static_cast<double>(options_.precision);
+    uint32_t prev_ring_first = 0;
+    for (int ring = 0; ring < scan.rings; ++ring) {
+        const float* r = scan.ranges.data() + static_cast<size_t>(ring) * scan.beams;
+        uint32_t* res = residuals_.data() + static_cast<size_t>(ring) * scan.beams;
+        uint32_t prev = prev_ring_first;
+        for (int b = 0; b < scan.beams; ++b) {
+            uint32_t q = quantize(r[b], inv_precision);
+            if (q == 0) {
+                res[b] = 0; // 无回波点不更新预测值
+            } else {
+                res[b] = zigzag(static_cast<int32_t>(q - prev)) + 1;
+                prev = q;
+            }
+            if (b == 0) {
+                prev_ring_first = prev;
+            }
+        }
+    }
+
+    // 帧头
+    const size_t start = out.size();
+    putRaw<uint32_t>(out, kFrameMagic);
+    putRaw<uint32_t>(out, 0); // 帧长度，最后回填
+    putRaw<uint16_t>(out, static_cast<uint16_t>(scan.rings));
+    putRaw<uint16_t>(out, 0);
+    putRaw<uint32_t>(out, static_cast<uint32_t>(scan.beams));
+    putRaw<float>(out, options_.precision);
+    putRaw<double>(out, scan.timestamp);
+    putRaw<uint16_t>(out, static_cast<uint16_t>(scan.frame_id.size()));
+    out.insert(out.end(), scan.frame_id.begin(), scan.frame_id.end());
+
+    // Rice编码
+    out.reserve(out.size() + n * 2);
+    BitWriter writer(out);
+    for (size_t block = 0; block < n; block += kBlockSize) {
+        const size_t count = std::min(kBlockSize, n - block);
+        const uint32_t* values = residuals_.data() + block;
+        const int k = chooseRiceParam(values, count);
+        writer.put(static_cast<uint64_t>(k), 5);
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t quotient = values[i] >> k;
+            if (quotient >= kEscapeQuotient) {
+                writer.put((uint64_t(1) << kEscapeQuotient) - 1, kEscapeQuotient);
+                writer.put(values[i], 32);
+            } else {
+                writer.put((uint64_t(1) << quotient) - 1, static_cast<int>(quotient) + 1);
+                if (k > 0) {
+                    writer.put(values[i] & ((uint64_t(1) << k) - 1), k);
+                }
+            }
+        }
+    }
+    writer.flush();
+
+    const size_t frame_size = out.size() - start;
+    const uint32_t frame_size32 = static_cast<uint32_t>(frame_size);
+    std::memcpy(out.data() + start + 4, &frame_size32, sizeof(frame_size32));
+    return frame_size;
+}
+
+size_t ScanDecoder::peekFrameSize(const uint8_t* data, size_t size) {
+    if (size < 8) {
+        return 0;
+    }
+    if (getRaw<uint32_t>(data) != kFrameMagic) {
+        throw std::runtime_error("ScanDecoder: 帧头标识错误");
+    }
+    return getRaw<uint32_t>(data + 4);
+}
+
+size_t ScanDecoder::decode(const uint8_t* data, size_t size, RangeScan& out) {
+    const size_t frame_size = peekFrameSize(data, size);
+    if (frame_size == 0 || size < frame_size) {
+        return 0;
+    }
+    if (frame_size < kFixedHeaderSize) {
+        throw std::runtime_error("ScanDecoder: 帧长度错误");
+    }
+
+    const int rings = getRaw<uint16_t>(data + 8);
+    const int beams = static_cast<int>(getRaw<uint32_t>(data + 12));
+    const float precision = getRaw<float>(data + 16);
+    const double timestamp = getRaw<double>(data + 20);
+    const size_t id_len = getRaw<uint16_t>(data + 28);
+    if (kFixedHeaderSize + id_len > frame_size || rings <= 0 || beams < 0 ||
+        frame_size > maxFrameSize(rings, beams, id_len)) {
+        throw std::runtime_error("ScanDecoder: 帧头损坏");
+    }
+
+    out.rings = rings;
+    out.beams = beams;
+    out.timestamp = timestamp;
+    out.frame_id.assign(reinterpret_cast<const char*>(data + kFixedHeaderSize), id_len);
+
+    const size_t n = static_cast<size_t>(rings) * static_cast<size_t>(beams);
+    const size_t payload_offset = kFixedHeaderSize + id_len;
+    // 每个残差至少占1位，点数超过载荷位数的帧头必然损坏，在分配缓冲区之前拒绝
+    if (n > (frame_size - payload_offset) * 8) {
+        throw std::runtime_error("ScanDecoder: 点数与数据长度不符");
+    }
+    BitReader reader(data + payload_offset, frame_size - payload_offset);
+
+    // Rice解码
+    residuals_.resize(n);
+    for (size_t block = 0; block < n; block += kBlockSize) {
+        const size_t count = std::min(kBlockSize, n - block);
+        reader.refill();
+        const int k = static_cast<int>(reader.take(5));
+        for (size_t i = 0; i < count; ++i) {
+            reader.refill();
+            // 只数到转义长度: 连续 kEscapeQuotient 个1即为转义，其后的32位原值本身可能全为1；
+            // 补上的哨兵位保证 ctz 的参数不为0（全1的字对 ctz 是未定义行为）
+            const uint32_t quotient =
+                static_cast<uint32_t>(__builtin_ctzll(~reader.peek() | (uint64_t(1) << kEscapeQuotient)));
+            if (quotient >= kEscapeQuotient) {
+                reader.skip(kEscapeQuotient);
+                reader.refill();
+                residuals_[block + i] = reader.take(32);
+            } else {
+                reader.skip(static_cast<int>(quotient) + 1);
+                residuals_[block + i] = (quotient << k) | reader.take(k);
+            }
+        }
+        if (reader.overrun()) {
+            throw std::runtime_error("ScanDecoder: 数据被截断");
+        }
+    }
+
+    // 逆预测 + 反量化
+    out.ranges.resize(n);
+    const double dprecision = static_cast<double>(precision);
+    uint32_t prev_ring_first = 0;
+    for (int ring = 0; ring < rings; ++ring) {
+        const uint32_t* res = residuals_.data() + static_cast<size_t>(ring) * beams;
+        float* r = out.ranges.data() + static_cast<size_t>(ring) * beams;
+        uint32_t prev = prev_ring_first;
+        for (int b = 0; b < beams; ++b) {
+            if (res[b] == 0) {
+                r[b] = 0.0f;
+            } else {
+                prev += static_cast<uint32_t>(unzigzag(res[b] - 1));
+                r[b] = static_cast<float>(prev * dprecision);
+            }
+            if (b == 0) {
+                prev_ring_first = prev;
+            }
+        }
+    }
+    return frame_size;
+}
+
+ScanStreamWriter::ScanStreamWriter(std::ostream& os, const ScanCodecOptions& options)
+    : os_(os), encoder_(options), frames_(0), bytes_(0) {}
+
+bool ScanStreamWriter::write(const RangeScan& scan) {
+    buffer_.clear();
+    size_t size = encoder_.encode(scan, buffer_);
+    os_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(size));
+    if (!os_) {
+        return false;
+    }
+    ++frames_;
+    bytes_ += size;
+    return true;
+}
+
+ScanStreamReader::ScanStreamReader(std::istream& is) : is_(is) {}
+
+bool ScanStreamReader::read(RangeScan& scan) {
+    buffer_.resize(kFixedHeaderSize);
+    is_.read(reinterpret_cast<char*>(buffer_.data()), 8);
+    if (is_.gcount() == 0) {
+        return false;
+    }
+    if (is_.gcount() != 8) {
+        throw std::runtime_error("ScanStreamReader: 帧头被截断");
+    }
+    const size_t frame_size = ScanDecoder::peekFrameSize(buffer_.data(), buffer_.size());
+    if (frame_size < kFixedHeaderSize) {
+        throw std::runtime_error("ScanStreamReader: 帧长度错误");
+    }
+    is_.read(reinterpret_cast<char*>(buffer_.data() + 8), static_cast<std::streamsize>(kFixedHeaderSize - 8));
+    if (static_cast<size_t>(is_.gcount()) != kFixedHeaderSize - 8) {
+        throw std::runtime_error("ScanStreamReader: 帧头被截断");
+    }
+    // 帧长度来自不可信的数据: 先按帧头的尺寸校验上限，再分配
+    const int rings = getRaw<uint16_t>(buffer_.data() + 8);
+    const uint32_t beams = getRaw<uint32_t>(buffer_.data() + 12);
+    const size_t id_len = getRaw<uint16_t>(buffer_.data() + 28);
+    if (rings <= 0 || beams > static_cast<uint32_t>(std::numeric_limits<int>::max()) ||
+        kFixedHeaderSize + id_len > frame_size ||
+        frame_size > maxFrameSize(rings, static_cast<int>(beams), id_len)) {
+        throw std::runtime_error("ScanStreamReader: 帧头损坏");
+    }
+    // 按实际读到的数据分段扩大缓冲区，截断的流不会先分配整帧
+    constexpr size_t kReadChunk = size_t(1) << 20;
+    size_t have = kFixedHeaderSize;
+    while (have < frame_size) {
+        const size_t chunk = std::min(kReadChunk, frame_size - have);
+        buffer_.resize(have + chunk);
+        is_.read(reinterpret_cast<char*>(buffer_.data() + have), static_cast<std::streamsize>(chunk));
+        if (static_cast<size_t>(is_.gcount()) != chunk) {
+            throw std::runtime_error("ScanStreamReader: 帧数据被截断");
+        }
+        have += chunk;
+    }
+    return decoder_.decode(buffer_.data(), buffer_.size(), scan) == frame_size;
+}
+
+}
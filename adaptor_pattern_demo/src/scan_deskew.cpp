@@ -0,0 +1,220 @@
+#include "adaptor/scan_deskew.hpp"
+#include "adaptor/parallel_utils.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace duan {
+
+namespace {
+
+constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+
+// 每个线程至少处理的列数，列太少时线程开销大于收益
+constexpr size_t kMinBeamsPerSector = 128;
+
+struct Pose {
+    double x;
+    double y;
+    double yaw;
+};
+
+// 单条ring的标量实现，同时作为SIMD路径的尾部处理
+void deskewRingScalar(const float* r, const float* c, const float* s, const float* tx, const float* ty,
+                      float ce, float se, float* x, float* y, float* z, int begin, int end) {
+    for (int b = begin; b < end; ++b) {
+        const float kx = ce * c[b];
+        const float ky = ce * s[b];
+        const bool valid = r[b] > 0.0f;
+        x[b] = r[b] * kx + (valid ? tx[b] : 0.0f);
+        y[b] = r[b] * ky + (valid ? ty[b] : 0.0f);
+        z[b] = r[b] * se;
+    }
+}
+
+#if DUAN_SIMD_X86
+DUAN_TARGET_SSE41
+void deskewRingSse(const float* r, const float* c, const float* s, const float* tx, const float* ty,
+                   float ce, float se, float* x, float* y, float* z, int begin, int end) {
+    const __m128 vce = _mm_set1_ps(ce);
+    const __m128 vse = _mm_set1_ps(se);
+    const __m128 zero = _mm_setzero_ps();
+    int b = begin;
+    for (; b + 4 <= end; b += 4) {
+        const __m128 vr = _mm_loadu_ps(r + b);
+        const __m128 valid = _mm_cmpgt_ps(vr, zero);
+        const __m128 kx = _mm_mul_ps(vce, _mm_loadu_ps(c + b));
+        const __m128 ky = _mm_mul_ps(vce, _mm_loadu_ps(s + b));
+        _mm_storeu_ps(x + b, _mm_add_ps(_mm_mul_ps(vr, kx), _mm_and_ps(valid, _mm_loadu_ps(tx + b))));
+        _mm_storeu_ps(y + b, _mm_add_ps(_mm_mul_ps(vr, ky), _mm_and_ps(valid, _mm_loadu_ps(ty + b))));
+        _mm_storeu_ps(z + b, _mm_mul_ps(vr, vse));
+    }
+    deskewRingScalar(r, c, s, tx, ty, ce, se, x, y, z, b, end);
+}
+
+DUAN_TARGET_AVX2
+void deskewRingAvx2(const float* r, const float* c, const float* s, const float* tx, const float* ty,
+                    float ce, float se, float* x, float* y, float* z, int begin, int end) {
+    const __m256 vce = _mm256_set1_ps(ce);
+    const __m256 vse = _mm256_set1_ps(se);
+    const __m256 zero = _mm256_setzero_ps();
+    int b = begin;
+    for (; b + 8 <= end; b += 8) {
+        const __m256 vr = _mm256_loadu_ps(r + b);
+        const __m256 valid = _mm256_cmp_ps(vr, zero, _CMP_GT_OQ);
+        const __m256 kx = _mm256_mul_ps(vce, _mm256_loadu_ps(c + b));
+        const __m256 ky = _mm256_mul_ps(vce, _mm256_loadu_ps(s + b));
+        _mm256_storeu_ps(x + b, _mm256_add_ps(_mm256_mul_ps(vr, kx), _mm256_and_ps(valid, _mm256_loadu_ps(tx + b))));
+        _mm256_storeu_ps(y + b, _mm256_add_ps(_mm256_mul_ps(vr, ky), _mm256_and_ps(valid, _mm256_loadu_ps(ty + b))));
+        _mm256_storeu_ps(z + b, _mm256_mul_ps(vr, vse));
+    }
+    deskewRingScalar(r, c, s, tx, ty, ce, se, x, y, z, b, end);
+}
+#endif
+
+double yawRate(const VehicleMotion& motion, const DeskewConfig& config) {
+    const double v = motion.speed_kmh / 3.6;
+    const double wheel = motion.steering_angle_deg / config.steering_ratio * kDegToRad;
+    return v * std::tan(wheel) / config.wheelbase_m;
+}
+
+
+}
+
+ScanDeskewer::ScanDeskewer(const LidarGeometry& geometry, const DeskewConfig& config)
+    : geometry_(geometry), config_(config) {
+    if (config.scan_period_s <= 0.0 || config.wheelbase_m <= 0.0 || config.steering_ratio == 0.0) {
+        throw std::invalid_argument("ScanDeskewer: 扫描周期、轴距必须大于0，转向比不能为0");
+    }
+    const size_t beams = static_cast<size_t>(geometry.beams);
+    az_rad_.resize(beams);
+    for (size_t b = 0; b < beams; ++b) {
+        az_rad_[b] = (geometry.azimuth_start_deg + static_cast<double>(b) * geometry.azimuth_step_deg) * kDegToRad;
+    }
+    for (float el : geometry.elevations_deg) {
+        cos_el_.push_back(static_cast<float>(std::cos(el * kDegToRad)));
+        sin_el_.push_back(static_cast<float>(std::sin(el * kDegToRad)));
+    }
+    col_cos_.resize(beams);
+    col_sin_.resize(beams);
+    col_tx_.resize(beams);
+    col_ty_.resize(beams);
+    updateBeamPoses(VehicleMotion(), VehicleMotion());
+}
+
+void ScanDeskewer::updateBeamPoses(const VehicleMotion& at_start, const VehicleMotion& at_end) {
+    const size_t beams = az_rad_.size();
+    if (beams == 0) {
+        return;
+    }
+    // 车速、横摆角速度在扫描期间线性变化，按列做中点积分得到后轴中心位姿（扫描开始坐标系）
+    const double v0 = at_start.speed_kmh / 3.6;
+    const double v1 = at_end.speed_kmh / 3.6;
+    const double w0 = yawRate(at_start, config_);
+    const double w1 = yawRate(at_end, config_);
+    const double dt = config_.scan_period_s / static_cast<double>(beams);
+
+    std::vector<Pose> vehicle(beams + 1);
+    vehicle[0] = {0.0, 0.0, 0.0};
+    for (size_t b = 0; b < beams; ++b) {
+        const double u = (static_cast<double>(b) + 0.5) / static_cast<double>(beams);
+        const double v = v0 + (v1 - v0) * u;
+        const double w = w0 + (w1 - w0) * u;
+        const Pose& p = vehicle[b];
+        const double mid_yaw = p.yaw + 0.5 * w * dt;
+        vehicle[b + 1] = {p.x + v * dt * std::cos(mid_yaw), p.y + v * dt * std::sin(mid_yaw), p.yaw + w * dt};
+    }
+
+    // 雷达位姿 = 车辆位姿 * 安装位置
+    auto sensorPose = [this](const Pose& v) {
+        const double c = std::cos(v.yaw);
+        const double s = std::sin(v.yaw);
+        return Pose{v.x + c * config_.sensor_offset_x - s * config_.sensor_offset_y,
+                    v.y + s * config_.sensor_offset_x + c * config_.sensor_offset_y, v.yaw};
+    };
+    // 每列相对参考位姿的变换 reference^-1 * pose
+    const Pose reference = sensorPose(config_.align_to_scan_end ? vehicle[beams] : vehicle[0]);
+    const double ref_cos = std::cos(reference.yaw);
+    const double ref_sin = std::sin(reference.yaw);
+    for (size_t b = 0; b < beams; ++b) {
+        const Pose pose = sensorPose(vehicle[b]);
+        const double dx = pose.x - reference.x;
+        const double dy = pose.y - reference.y;
+        const Pose rel{ref_cos * dx + ref_sin * dy, -ref_sin * dx + ref_cos * dy, pose.yaw - reference.yaw};
+        col_cos_[b] = static_cast<float>(std::cos(az_rad_[b] + rel.yaw));
+        col_sin_[b] = static_cast<float>(std::sin(az_rad_[b] + rel.yaw));
+        col_tx_[b] = static_cast<float>(rel.x);
+        col_ty_[b] = static_cast<float>(rel.y);
+    }
+
+    // 另一端时刻（参考为结束时取扫描开始，反之取扫描结束）的位姿，不是最后一列的起始位姿
+    const Pose other = sensorPose(config_.align_to_scan_end ? vehicle[0] : vehicle[beams]);
+    const double dx = other.x - reference.x;
+    const double dy = other.y - reference.y;
+    sweep_translation_ = std::hypot(ref_cos * dx + ref_sin * dy, -ref_sin * dx + ref_cos * dy);
+    sweep_rotation_ = other.yaw - reference.yaw;
+}
+
+void ScanDeskewer::deskew(const RangeScan& scan, const VehicleMotion& at_start, const VehicleMotion& at_end,
+                          PointCloud& out, int threads, SimdLevel level) {
+    if (scan.rings != geometry_.rings() || scan.beams != geometry_.beams ||
+        scan.ranges.size() != static_cast<size_t>(scan.rings) * scan.beams) {
+        throw std::invalid_argument("ScanDeskewer: 扫描尺寸与几何参数不一致");
+    }
+    updateBeamPoses(at_start, at_end);
+
+    out.resize(scan.size());
+    out.timestamp = scan.timestamp + (config_.align_to_scan_end ? config_.scan_period_s : 0.0);
+    out.frame_id = scan.frame_id;
+
+    const SimdLevel simd = clampSimdLevel(level);
+    const size_t beams = static_cast<size_t>(scan.beams);
+    const int parts = choosePartitions(beams, threads, kMinBeamsPerSector);
+
+    // 按方位扇区（列区间）切分，每个扇区处理全部 ring
+    runPartitioned(beams, parts, [&](int, size_t begin, size_t end) {
+        for (int ring = 0; ring < scan.rings; ++ring) {
+            const size_t offset = static_cast<size_t>(ring) * beams;
+            const float* r = scan.ranges.data() + offset;
+            float* x = out.x.data() + offset;
+            float* y = out.y.data() + offset;
+            float* z = out.z.data() + offset;
+            const int b0 = static_cast<int>(begin);
+            const int b1 = static_cast<int>(end);
+#if DUAN_SIMD_X86
+            if (simd == SimdLevel::AVX2) {
+                deskewRingAvx2(r, col_cos_.data(), col_sin_.data(), col_tx_.data(), col_ty_.data(),
+                               cos_el_[ring], sin_el_[ring], x, y, z, b0, b1);
+                continue;
+            }
+            if (simd == SimdLevel::SSE) {
+                deskewRingSse(r, col_cos_.data(), col_sin_.data(), col_tx_.data(), col_ty_.data(),
+                              cos_el_[ring], sin_el_[ring], x, y, z, b0, b1);
+                continue;
+            }
+#endif
+            deskewRingScalar(r, col_cos_.data(), col_sin_.data(), col_tx_.data(), col_ty_.data(),
+                             cos_el_[ring], sin_el_[ring], x, y, z, b0, b1);
+        }
+    });
+    (void)simd;
+}
+
+PointCloud ScanDeskewer::deskew(const RangeScan& scan, const VehicleMotion& at_start, const VehicleMotion& at_end,
+                                int threads) {
+    PointCloud out;
+    deskew(scan, at_start, at_end, out, threads);
+    return out;
+}
+
+double ScanDeskewer::sweepTranslation() const {
+    return sweep_translation_;
+}
+
+double ScanDeskewer::sweepRotation() const {
+    double rot = sweep_rotation_;
+    while (rot > 3.14159265358979323846) rot -= 2 * 3.14159265358979323846;
+    while (rot < -3.14159265358979323846) rot += 2 * 3.14159265358979323846;
+    return rot;
+}
+
+}
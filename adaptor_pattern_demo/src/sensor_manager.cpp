@@ -0,0 +1,295 @@
+#include "adaptor/sensor_manager.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+
+namespace duan {
+
+namespace {
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double wallNowSeconds() {
+    return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+}
+
+int64_t sensorClockNs() {
+    return steadyNowNs();
+}
+
+void recordAcquisition(SensorStats& stats, const SensorInterface::SensorDate& data, int64_t start_ns, int64_t end_ns) {
+    stats.acquisition_ns.record(static_cast<uint64_t>(end_ns - start_ns));
+
+    if (data.points.empty()) {
+        stats.failed_reads.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    stats.frames.fetch_add(1, std::memory_order_relaxed);
+    const int64_t last_ns = stats.last_frame_ns.exchange(end_ns, std::memory_order_relaxed);
+    if (last_ns != 0) {
+        const int64_t interval_ns = end_ns - last_ns;
+        stats.frame_interval_ns.record(static_cast<uint64_t>(interval_ns));
+        if (interval_ns > static_cast<int64_t>(stats.options.deadline_ms * 1e6)) {
+            stats.deadline_misses.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    stats.stalled.store(false, std::memory_order_relaxed);
+
+    // 帧时间戳为系统时钟（秒），年龄为负说明时钟不同步，按0计
+    const double age_s = wallNowSeconds() - data.timestamp;
+    stats.frame_age_ns.record(age_s > 0.0 ? static_cast<uint64_t>(age_s * 1e9) : 0);
+}
+
+SensorStatsSnapshot snapshotSensorStats(const std::string& name, const SensorStats& stats) {
+    SensorStatsSnapshot snapshot;
+    snapshot.name = name;
+    snapshot.frames = stats.frames.load(std::memory_order_relaxed);
+    snapshot.failed_reads = stats.failed_reads.load(std::memory_order_relaxed);
+    snapshot.deadline_misses = stats.deadline_misses.load(std::memory_order_relaxed);
+    snapshot.stalls = stats.stalls.load(std::memory_order_relaxed);
+    snapshot.stalled = stats.stalled.load(std::memory_order_relaxed);
+    snapshot.acquisition = stats.acquisition_ns.snapshot();
+    snapshot.frame_age = stats.frame_age_ns.snapshot();
+    snapshot.frame_interval = stats.frame_interval_ns.snapshot();
+    if (snapshot.frame_interval.mean_us > 0.0) {
+        snapshot.frame_rate_hz = 1e6 / snapshot.frame_interval.mean_us;
+    }
+    return snapshot;
+}
+
+void writeSensorStats(std::ostream& os, const std::vector<SensorStatsSnapshot>& stats) {
+    std::ios::fmtflags flags = os.flags();
+    for (const auto& s : stats) {
+        os << "[" << s.name << "] frames=" << s.frames << " failed=" << s.failed_reads
+           << " deadline_misses=" << s.deadline_misses << " stalls=" << s.stalls
+           << (s.stalled ? " STALLED" : "") << " rate=" << std::fixed << std::setprecision(1)
+           << s.frame_rate_hz << "Hz" << std::endl;
+        os << "  acquisition:    " << s.acquisition << std::endl;
+        os << "  frame_age:      " << s.frame_age << std::endl;
+        os << "  frame_interval: " << s.frame_interval << std::endl;
+    }
+    os.flags(flags);
+}
+
+void resetSensorStats(SensorStats& stats) {
+    stats.acquisition_ns.reset();
+    stats.frame_age_ns.reset();
+    stats.frame_interval_ns.reset();
+    stats.frames.store(0, std::memory_order_relaxed);
+    stats.failed_reads.store(0, std::memory_order_relaxed);
+    stats.deadline_misses.store(0, std::memory_order_relaxed);
+    stats.stalls.store(0, std::memory_order_relaxed);
+}
+
+SensorManager::SensorManager() : watchdog_running_(false) {}
+
+SensorManager::~SensorManager() {
+    stopWatchdog();
+}
+
+void SensorManager::addSensor(std::unique_ptr<SensorInterface> sensor, const SensorOptions& options) {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    auto stats = std::make_unique<SensorStats>(options);
+    stats->watch_start_ns.store(steadyNowNs(), std::memory_order_relaxed);
+    sensors_.push_back(std::move(sensor));
+    stats_.push_back(std::move(stats));
+}
+
+bool SensorManager::initSensors() {
+    std::cout << "Initializing sensors..." << std::endl;
+    bool all_success = true;
+
+    for (auto& sensor : sensors_) {
+        bool success = sensor->init();
+        if (success) {
+            std::cout << "Sensor " << sensor->getName() << " initialized successfully." << std::endl;
+        }
+        all_success &= success;
+    }
+    return all_success;
+}
+
+std::vector<SensorInterface::SensorDate> SensorManager::acquireAll() {
+    // 在锁内取出传感器与统计的快照，采集在锁外进行，慢传感器不会挡住看门狗与并发的 addSensor
+    // 元素由 unique_ptr 持有，容器扩容时地址不变
+    std::vector<std::pair<SensorInterface*, SensorStats*>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        snapshot.reserve(sensors_.size());
+        for (size_t i = 0; i < sensors_.size(); ++i) {
+            snapshot.emplace_back(sensors_[i].get(), stats_[i].get());
+        }
+    }
+    std::vector<SensorInterface::SensorDate> frames;
+    frames.reserve(snapshot.size());
+    for (const auto& [sensor, stats] : snapshot) {
+        const int64_t start_ns = steadyNowNs();
+        SensorInterface::SensorDate data = sensor->getSensorData();
+        recordAcquisition(*stats, data, start_ns, steadyNowNs());
+        frames.push_back(std::move(data));
+    }
+    return frames;
+}
+
+void SensorManager::getAllSensorData() {
+    std::cout << "Getting sensor data..." << std::endl;
+    std::vector<SensorInterface::SensorDate> frames = acquireAll();
+    std::vector<std::string> names;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        for (size_t s = 0; s < frames.size(); ++s) {
+            names.push_back(sensors_[s]->getName());
+        }
+    }
+    for (size_t s = 0; s < frames.size(); ++s) {
+        const SensorInterface::SensorDate& data = frames[s];
+        std::cout << "Sensor: " << names[s]
+                  << ", Timestamp: " << data.timestamp
+                  << ", Points: " << data.points.size()
+                  << ", Frame ID: " << data.frame_id << std::endl;
+        // 显示前几个数据点
+        if (!data.points.empty()) {
+            std::cout << "前5个数据点: ";
+            for (size_t i = 0; i < std::min(data.points.size(), size_t(5)); ++i) {
+                std::cout << std::fixed << std::setprecision(2) << data.points[i] << " ";
+            }
+            std::cout << std::endl;
+        }
+    }
+}
+
+void SensorManager::stopAllSensors() {
+    std::cout << "Stopping all sensors..." << std::endl;
+    for (const auto& sensor : sensors_) {
+        sensor->stop();
+        std::cout << "Sensor " << sensor->getName() << " stopped." << std::endl;
+    }
+}
+
+void SensorManager::startWatchdog(double period_ms, StallCallback callback) {
+    stopWatchdog();
+    {
+        std::lock_guard<std::mutex> lock(watchdog_mutex_);
+        watchdog_running_ = true;
+        stall_callback_ = std::move(callback);
+    }
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        const int64_t now_ns = steadyNowNs();
+        for (auto& stats : stats_) {
+            stats->watch_start_ns.store(now_ns, std::memory_order_relaxed);
+        }
+    }
+    watchdog_ = std::thread([this, period_ms] { watchdogLoop(period_ms); });
+}
+
+void SensorManager::stopWatchdog() {
+    {
+        std::lock_guard<std::mutex> lock(watchdog_mutex_);
+        watchdog_running_ = false;
+    }
+    watchdog_cv_.notify_all();
+    if (watchdog_.joinable()) {
+        watchdog_.join();
+    }
+}
+
+void SensorManager::watchdogLoop(double period_ms) {
+    const auto period = std::chrono::duration<double, std::milli>(period_ms);
+    std::unique_lock<std::mutex> lock(watchdog_mutex_);
+    while (watchdog_running_) {
+        watchdog_cv_.wait_for(lock, period, [this] { return !watchdog_running_; });
+        if (!watchdog_running_) {
+            break;
+        }
+        lock.unlock();
+        checkDeadlines();
+        lock.lock();
+    }
+}
+
+size_t SensorManager::checkDeadlines() {
+    struct Stall {
+        std::string name;
+        double silent_ms;
+    };
+    std::vector<Stall> new_stalls;
+    size_t stalled = 0;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        const int64_t now_ns = steadyNowNs();
+        for (size_t i = 0; i < stats_.size(); ++i) {
+            SensorStats& stats = *stats_[i];
+            int64_t last_ns = stats.last_frame_ns.load(std::memory_order_relaxed);
+            if (last_ns == 0) {
+                last_ns = stats.watch_start_ns.load(std::memory_order_relaxed);
+            }
+            const double silent_ms = (now_ns - last_ns) / 1e6;
+            if (silent_ms <= stats.options.deadline_ms) {
+                continue;
+            }
+            ++stalled;
+            // 只在进入停滞状态时计数和通知一次
+            if (!stats.stalled.exchange(true, std::memory_order_relaxed)) {
+                stats.stalls.fetch_add(1, std::memory_order_relaxed);
+                new_stalls.push_back({sensors_[i]->getName(), silent_ms});
+            }
+        }
+    }
+
+    StallCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(watchdog_mutex_);
+        callback = stall_callback_;
+    }
+    for (const auto& stall : new_stalls) {
+        if (callback) {
+            callback(stall.name, stall.silent_ms);
+        } else {
+            std::cerr << "[SensorManager] 传感器超时: " << stall.name << " 已 "
+                      << stall.silent_ms << " ms 没有新数据" << std::endl;
+        }
+    }
+    return stalled;
+}
+
+std::vector<SensorStatsSnapshot> SensorManager::getStats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    std::vector<SensorStatsSnapshot> result;
+    result.reserve(stats_.size());
+    for (size_t i = 0; i < stats_.size(); ++i) {
+        result.push_back(snapshotSensorStats(sensors_[i]->getName(), *stats_[i]));
+    }
+    return result;
+}
+
+bool SensorManager::getStats(const std::string& name, SensorStatsSnapshot& out) const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    for (size_t i = 0; i < stats_.size(); ++i) {
+        if (sensors_[i]->getName() == name) {
+            out = snapshotSensorStats(name, *stats_[i]);
+            return true;
+        }
+    }
+    return false;
+}
+
+void SensorManager::dumpStats(std::ostream& os) const {
+    writeSensorStats(os, getStats());
+}
+
+void SensorManager::resetStats() {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    for (auto& stats : stats_) {
+        resetSensorStats(*stats);
+    }
+}
+
+}
@@ -0,0 +1,495 @@
+#include "adaptor/shm_transport.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace duan {
+
+namespace detail {
+
+constexpr uint32_t kShmMagic = 0x4D485344;  // "DSHM"
+constexpr uint32_t kShmVersion = 1;
+constexpr size_t kPageSize = 4096;
+constexpr size_t kFrameIdBytes = 48;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "共享内存中的计数器必须无锁");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex 字必须是 32 位");
+
+struct alignas(64) ShmSegmentHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slots;
+    uint32_t reserved;
+    uint64_t slot_stride;      // 相邻两个槽位数据区的距离
+    uint64_t payload_offset;   // 第一个槽位数据区相对段首的偏移
+    uint64_t total_bytes;
+    alignas(64) std::atomic<uint64_t> head;        // 已提交的帧数，最新帧序号为 head - 1
+    alignas(64) std::atomic<uint32_t> futex_word;  // 每次提交加一，读者在此等待
+};
+
+// 槽位头，seqlock 取值: 写入第 s 帧时为 2s+1，提交后为 2s+2
+struct alignas(64) ShmSlotHeader {
+    std::atomic<uint64_t> lock;
+    uint64_t frame_seq;
+    uint32_t kind;
+    uint32_t format;
+    int32_t width;
+    int32_t height;
+    uint64_t bytes;
+    double timestamp;
+    char frame_id[kFrameIdBytes];
+};
+
+struct ShmMapping {
+    uint8_t* base = nullptr;
+    size_t size = 0;
+    // 布局在创建或校验后记在进程本地，之后不再读共享内存里可被对方改写的字段
+    uint32_t slots = 0;
+    uint64_t slot_stride = 0;
+    uint64_t payload_offset = 0;
+
+    ~ShmMapping() {
+        if (base) {
+            munmap(base, size);
+        }
+    }
+
+    ShmSegmentHeader* header() const { return reinterpret_cast<ShmSegmentHeader*>(base); }
+    ShmSlotHeader* slot(uint64_t frame_seq) const {
+        return reinterpret_cast<ShmSlotHeader*>(base + sizeof(ShmSegmentHeader)) + frame_seq % slots;
+    }
+    uint8_t* payload(uint64_t frame_seq) const {
+        return base + payload_offset + (frame_seq % slots) * slot_stride;
+    }
+};
+
+}
+
+namespace {
+
+using detail::ShmMapping;
+using detail::ShmSegmentHeader;
+using detail::ShmSlotHeader;
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+std::string errnoText() {
+    return std::strerror(errno);
+}
+
+// 读者对槽位描述的检查: 数据不超出槽位，且足够容纳描述的扫描或图像；不通过的按被覆盖的帧丢弃
+bool frameFits(uint32_t kind, uint32_t format, const ShmFrameInfo& info, uint64_t capacity) {
+    if (info.bytes > capacity) {
+        return false;
+    }
+    const uint64_t pixels = static_cast<uint64_t>(static_cast<uint32_t>(std::max(info.width, 0))) *
+                            static_cast<uint32_t>(std::max(info.height, 0));
+    switch (static_cast<ShmFrameKind>(kind)) {
+    case ShmFrameKind::Raw:
+        return true;
+    case ShmFrameKind::RangeScan:
+        return info.width >= 0 && info.height >= 0 && pixels * sizeof(float) <= info.bytes;
+    case ShmFrameKind::Image:
+        // 每个像素至少一个字节，先排除尺寸离谱的帧头再按格式计算布局
+        return format <= static_cast<uint32_t>(PixelFormat::YUV420P) && info.width > 0 && info.height > 0 &&
+               pixels <= info.bytes && ImageFrame::requiredBytes(info.width, info.height, info.format) <= info.bytes;
+    }
+    return false;
+}
+
+uint32_t* futexAddress(const std::atomic<uint32_t>& word) {
+    return reinterpret_cast<uint32_t*>(const_cast<std::atomic<uint32_t>*>(&word));
+}
+
+// 共享（非 PRIVATE）futex，跨进程有效
+void futexWait(const std::atomic<uint32_t>& word, uint32_t expected, double timeout_ms) {
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(timeout_ms / 1000.0);
+    ts.tv_nsec = static_cast<long>((timeout_ms - static_cast<double>(ts.tv_sec) * 1000.0) * 1e6);
+    syscall(SYS_futex, futexAddress(word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+void futexWakeAll(const std::atomic<uint32_t>& word) {
+    syscall(SYS_futex, futexAddress(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+}
+
+// ---------------- ShmLoan ----------------
+
+ImageFrame ShmLoan::image() {
+    if (!data_ || info.kind != ShmFrameKind::Image) {
+        throw std::runtime_error("ShmLoan: 不是图像类型的槽位");
+    }
+    // 不接管内存，生命周期由 ShmWriter 保证
+    return ImageFrame::wrap(info.width, info.height, info.format, std::shared_ptr<uint8_t>(data_, [](uint8_t*) {}));
+}
+
+// ---------------- ShmWriter ----------------
+
+ShmWriter::ShmWriter(const std::string& name, const ShmTransportOptions& options)
+    : name_(name), options_(options) {
+    if (options.slots < 2 || options.slot_bytes == 0) {
+        throw std::invalid_argument("ShmWriter: 至少需要2个槽位且槽位容量大于0");
+    }
+    const size_t headers = sizeof(ShmSegmentHeader) + sizeof(ShmSlotHeader) * options.slots;
+    const size_t payload_offset = alignUp(headers, detail::kPageSize);
+    const size_t slot_stride = alignUp(options.slot_bytes, detail::kPageSize);
+    const size_t total = payload_offset + slot_stride * options.slots;
+
+    // 重建同名段，避免残留的旧段格式不一致
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("ShmWriter: 创建共享内存失败 " + name + ": " + errnoText());
+    }
+    if (ftruncate(fd, static_cast<off_t>(total)) != 0) {
+        const std::string err = errnoText();
+        close(fd);
+        shm_unlink(name.c_str());
+        throw std::runtime_error("ShmWriter: 设置共享内存大小失败 " + name + ": " + err);
+    }
+    void* base = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        const std::string err = errnoText();
+        shm_unlink(name.c_str());
+        throw std::runtime_error("ShmWriter: 映射共享内存失败 " + name + ": " + err);
+    }
+
+    mapping_ = std::make_shared<ShmMapping>();
+    mapping_->base = static_cast<uint8_t*>(base);
+    mapping_->size = total;
+    mapping_->slots = options.slots;
+    mapping_->slot_stride = slot_stride;
+    mapping_->payload_offset = payload_offset;
+
+    // ftruncate 得到的内存已清零，这里只需构造原子量和写入布局
+    ShmSegmentHeader* header = new (base) ShmSegmentHeader;
+    header->version = detail::kShmVersion;
+    header->slots = options.slots;
+    header->reserved = 0;
+    header->slot_stride = slot_stride;
+    header->payload_offset = payload_offset;
+    header->total_bytes = total;
+    header->head.store(0, std::memory_order_relaxed);
+    header->futex_word.store(0, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < options.slots; ++i) {
+        ShmSlotHeader* slot = new (mapping_->slot(i)) ShmSlotHeader;
+        slot->lock.store(0, std::memory_order_relaxed);
+    }
+    // 魔数最后写入，读者看到魔数即说明布局已就绪
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = detail::kShmMagic;
+}
+
+ShmWriter::~ShmWriter() {
+    shm_unlink(name_.c_str());
+}
+
+ShmLoan ShmWriter::loan(const ShmFrameInfo& info) {
+    if (loaned_) {
+        throw std::runtime_error("ShmWriter: 上一个槽位尚未提交");
+    }
+    if (info.bytes > options_.slot_bytes) {
+        throw std::invalid_argument("ShmWriter: 帧大小 " + std::to_string(info.bytes) + " 超过槽位容量 " +
+                                    std::to_string(options_.slot_bytes));
+    }
+    ShmSegmentHeader* header = mapping_->header();
+    const uint64_t frame_seq = header->head.load(std::memory_order_relaxed);
+    ShmSlotHeader* slot = mapping_->slot(frame_seq);
+
+    // 先把槽位标记为写入中，再改动数据
+    slot->lock.store(2 * frame_seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    ShmLoan loan;
+    loan.info = info;
+    loan.data_ = mapping_->payload(frame_seq);
+    loan.capacity_ = options_.slot_bytes;
+    loan.frame_seq_ = frame_seq;
+    loaned_ = true;
+    return loan;
+}
+
+uint64_t ShmWriter::commit(ShmLoan& loan) {
+    if (!loan.active() || !loaned_) {
+        throw std::runtime_error("ShmWriter: 没有待提交的槽位");
+    }
+    if (loan.info.bytes > options_.slot_bytes) {
+        throw std::invalid_argument("ShmWriter: 帧大小超过槽位容量");
+    }
+    const uint64_t frame_seq = loan.frame_seq_;
+    ShmSlotHeader* slot = mapping_->slot(frame_seq);
+    slot->frame_seq = frame_seq;
+    slot->kind = static_cast<uint32_t>(loan.info.kind);
+    slot->format = static_cast<uint32_t>(loan.info.format);
+    slot->width = loan.info.width;
+    slot->height = loan.info.height;
+    slot->bytes = loan.info.bytes;
+    slot->timestamp = loan.info.timestamp;
+    const size_t id_len = std::min(loan.info.frame_id.size(), detail::kFrameIdBytes - 1);
+    std::memcpy(slot->frame_id, loan.info.frame_id.data(), id_len);
+    slot->frame_id[id_len] = '\0';
+
+    slot->lock.store(2 * frame_seq + 2, std::memory_order_release);
+
+    ShmSegmentHeader* header = mapping_->header();
+    header->head.store(frame_seq + 1, std::memory_order_release);
+    header->futex_word.fetch_add(1, std::memory_order_release);
+    // 读者只读映射，无法登记等待者，因此每次提交都唤醒
+    futexWakeAll(header->futex_word);
+
+    loan.data_ = nullptr;
+    loaned_ = false;
+    return frame_seq;
+}
+
+uint64_t ShmWriter::publish(const RangeScan& scan) {
+    ShmFrameInfo info;
+    info.kind = ShmFrameKind::RangeScan;
+    info.width = scan.beams;
+    info.height = scan.rings;
+    info.bytes = scan.ranges.size() * sizeof(float);
+    info.timestamp = scan.timestamp;
+    info.frame_id = scan.frame_id;
+    ShmLoan slot = loan(info);
+    std::memcpy(slot.data(), scan.ranges.data(), info.bytes);
+    return commit(slot);
+}
+
+uint64_t ShmWriter::publish(const ImageFrame& image) {
+    if (image.empty()) {
+        throw std::invalid_argument("ShmWriter: 图像为空");
+    }
+    ShmFrameInfo info;
+    info.kind = ShmFrameKind::Image;
+    info.width = image.width();
+    info.height = image.height();
+    info.format = image.format();
+    info.bytes = ImageFrame::requiredBytes(image.width(), image.height(), image.format());
+    info.timestamp = image.timestamp;
+    info.frame_id = image.frame_id;
+    ShmLoan slot = loan(info);
+    // 布局相同，stride 一致时整块复制
+    ImageFrame dst = slot.image();
+    for (int p = 0; p < image.planeCount(); ++p) {
+        if (image.stride(p) == dst.stride(p)) {
+            std::memcpy(dst.data(p), image.data(p), image.stride(p) * static_cast<size_t>(image.planeHeight(p)));
+        } else {
+            for (int y = 0; y < image.planeHeight(p); ++y) {
+                std::memcpy(dst.row(y, p), image.row(y, p), image.rowBytes(p));
+            }
+        }
+    }
+    return commit(slot);
+}
+
+uint64_t ShmWriter::publish(const void* data, size_t bytes, double timestamp, const std::string& frame_id) {
+    ShmFrameInfo info;
+    info.kind = ShmFrameKind::Raw;
+    info.bytes = bytes;
+    info.timestamp = timestamp;
+    info.frame_id = frame_id;
+    ShmLoan slot = loan(info);
+    if (bytes > 0) {
+        std::memcpy(slot.data(), data, bytes);
+    }
+    return commit(slot);
+}
+
+uint64_t ShmWriter::published() const {
+    return mapping_->header()->head.load(std::memory_order_acquire);
+}
+
+// ---------------- ShmFrame ----------------
+
+bool ShmFrame::valid() const {
+    if (!slot_) {
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot_->lock.load(std::memory_order_relaxed) == lock_;
+}
+
+std::shared_ptr<const ImageFrame> ShmFrame::image() const {
+    if (!slot_ || info_.kind != ShmFrameKind::Image) {
+        throw std::runtime_error("ShmFrame: 不是图像帧");
+    }
+    // 别名构造：引用计数挂在映射上，像素指针指向槽位
+    std::shared_ptr<uint8_t> storage(mapping_, const_cast<uint8_t*>(data_));
+    auto frame = std::make_shared<ImageFrame>(ImageFrame::wrap(info_.width, info_.height, info_.format, std::move(storage)));
+    frame->timestamp = info_.timestamp;
+    frame->frame_id = info_.frame_id;
+    return frame;
+}
+
+RangeScan ShmFrame::toRangeScan() const {
+    if (!slot_ || info_.kind != ShmFrameKind::RangeScan) {
+        throw std::runtime_error("ShmFrame: 不是距离扫描帧");
+    }
+    RangeScan scan;
+    scan.rings = info_.height;
+    scan.beams = info_.width;
+    scan.timestamp = info_.timestamp;
+    scan.frame_id = info_.frame_id;
+    scan.ranges.assign(ranges(), ranges() + info_.bytes / sizeof(float));
+    return scan;
+}
+
+// ---------------- ShmReader ----------------
+
+ShmReader::ShmReader(const std::string& name) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw std::runtime_error("ShmReader: 打开共享内存失败 " + name + ": " + errnoText());
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ShmSegmentHeader)) {
+        close(fd);
+        throw std::runtime_error("ShmReader: 共享内存大小无效 " + name);
+    }
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("ShmReader: 映射共享内存失败 " + name + ": " + errnoText());
+    }
+    mapping_ = std::make_shared<ShmMapping>();
+    mapping_->base = static_cast<uint8_t*>(base);
+    mapping_->size = size;
+
+    const ShmSegmentHeader* header = mapping_->header();
+    const uint32_t magic = header->magic;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (magic != detail::kShmMagic || header->version != detail::kShmVersion || header->total_bytes != size) {
+        throw std::runtime_error("ShmReader: 共享内存格式不匹配 " + name);
+    }
+    // 写者在另一个进程，布局字段不可信: 槽位头与全部数据区都必须落在映射之内，且数据区按页对齐
+    const uint32_t slots = header->slots;
+    const uint64_t slot_stride = header->slot_stride;
+    const uint64_t payload_offset = header->payload_offset;
+    const uint64_t headers = sizeof(ShmSegmentHeader) + sizeof(ShmSlotHeader) * static_cast<uint64_t>(slots);
+    if (slots < 2 || headers > payload_offset || payload_offset > size || slot_stride == 0 ||
+        slot_stride > (size - payload_offset) / slots || payload_offset % detail::kPageSize != 0 ||
+        slot_stride % detail::kPageSize != 0) {
+        throw std::runtime_error("ShmReader: 共享内存布局无效 " + name);
+    }
+    mapping_->slots = slots;
+    mapping_->slot_stride = slot_stride;
+    mapping_->payload_offset = payload_offset;
+
+    const uint64_t head = header->head.load(std::memory_order_acquire);
+    next_seq_ = head > slots ? head - slots : 0;
+}
+
+uint32_t ShmReader::slotCount() const {
+    return mapping_->slots;
+}
+
+bool ShmReader::readSlot(uint64_t frame_seq, ShmFrame& out) const {
+    const ShmSlotHeader* slot = mapping_->slot(frame_seq);
+    const uint64_t expected = 2 * frame_seq + 2;
+    if (slot->lock.load(std::memory_order_acquire) != expected) {
+        return false;
+    }
+
+    // 共享内存可能同时被改写，字段只读一次，检查与使用的是同一份
+    const uint32_t kind = slot->kind;
+    const uint32_t format = slot->format;
+    ShmFrameInfo info;
+    info.kind = static_cast<ShmFrameKind>(kind);
+    info.format = static_cast<PixelFormat>(format);
+    info.width = slot->width;
+    info.height = slot->height;
+    info.bytes = slot->bytes;
+    info.timestamp = slot->timestamp;
+    info.frame_id.assign(slot->frame_id, strnlen(slot->frame_id, detail::kFrameIdBytes));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->lock.load(std::memory_order_relaxed) != expected) {
+        return false;
+    }
+    if (!frameFits(kind, format, info, mapping_->slot_stride)) {
+        return false;
+    }
+
+    out.mapping_ = mapping_;
+    out.slot_ = slot;
+    out.lock_ = expected;
+    out.frame_seq_ = frame_seq;
+    out.data_ = mapping_->payload(frame_seq);
+    out.info_ = std::move(info);
+    return true;
+}
+
+bool ShmReader::next(ShmFrame& out) {
+    const ShmSegmentHeader* header = mapping_->header();
+    for (;;) {
+        const uint64_t head = header->head.load(std::memory_order_acquire);
+        if (next_seq_ >= head) {
+            return false;
+        }
+        // 落后超过一整圈的帧已被覆盖
+        const uint32_t slots = mapping_->slots;
+        if (head - next_seq_ > slots) {
+            dropped_ += head - slots - next_seq_;
+            next_seq_ = head - slots;
+        }
+        if (readSlot(next_seq_, out)) {
+            ++next_seq_;
+            return true;
+        }
+        ++dropped_;
+        ++next_seq_;
+    }
+}
+
+bool ShmReader::latest(ShmFrame& out) {
+    const ShmSegmentHeader* header = mapping_->header();
+    // 读的过程中可能被覆盖，重试几次
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        const uint64_t head = header->head.load(std::memory_order_acquire);
+        if (head == 0) {
+            return false;
+        }
+        if (readSlot(head - 1, out)) {
+            next_seq_ = std::max(next_seq_, head);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ShmReader::waitNext(ShmFrame& out, double timeout_ms) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double, std::milli>(timeout_ms);
+    const std::atomic<uint32_t>& word = mapping_->header()->futex_word;
+    for (;;) {
+        // 先取 futex 字再检查，保证检查之后的提交一定能唤醒我们
+        const uint32_t observed = word.load(std::memory_order_acquire);
+        if (next(out)) {
+            return true;
+        }
+        const double remaining =
+            std::chrono::duration<double, std::milli>(deadline - std::chrono::steady_clock::now()).count();
+        if (remaining <= 0.0) {
+            return false;
+        }
+        futexWait(word, observed, remaining);
+    }
+}
+
+}
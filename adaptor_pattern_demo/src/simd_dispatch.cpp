@@ -0,0 +1,34 @@
+#include "adaptor/simd_dispatch.hpp"
+
+namespace duan {
+
+SimdLevel detectSimdLevel() {
+    static const SimdLevel level = [] {
+#if DUAN_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return SimdLevel::AVX2;
+        }
+        if (__builtin_cpu_supports("sse4.1")) {
+            return SimdLevel::SSE;
+        }
+#endif
+        return SimdLevel::Scalar;
+    }();
+    return level;
+}
+
+SimdLevel clampSimdLevel(SimdLevel requested) {
+    SimdLevel best = detectSimdLevel();
+    return static_cast<int>(requested) > static_cast<int>(best) ? best : requested;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::SSE: return "SSE4.1";
+        default: return "Scalar";
+    }
+}
+
+}
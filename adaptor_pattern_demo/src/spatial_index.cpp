@@ -0,0 +1,445 @@
+#include "adaptor/spatial_index.hpp"
+#include "adaptor/parallel_utils.hpp"
+#include "adaptor/voxel_key.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace duan {
+
+namespace {
+
+constexpr uint8_t kLeafAxis = 3;
+
+inline float distSq(float ax, float ay, float az, float bx, float by, float bz) {
+    float dx = ax - bx, dy = ay - by, dz = az - bz;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+// 保持最近k个候选的最大堆
+class KnnHeap {
+private:
+    std::vector<Neighbor>& heap_;
+    size_t k_;
+
+public:
+    KnnHeap(std::vector<Neighbor>& storage, size_t k) : heap_(storage), k_(k) {
+        heap_.clear();
+        heap_.reserve(k);
+    }
+
+    void push(uint32_t index, float dist_sq) {
+        Neighbor candidate{index, dist_sq};
+        if (heap_.size() < k_) {
+            heap_.push_back(candidate);
+            std::push_heap(heap_.begin(), heap_.end());
+        } else if (candidate < heap_.front()) {
+            std::pop_heap(heap_.begin(), heap_.end());
+            heap_.back() = candidate;
+            std::push_heap(heap_.begin(), heap_.end());
+        }
+    }
+
+    bool full() const { return heap_.size() >= k_; }
+
+    // 当前的剪枝半径平方
+    float bound() const {
+        return full() ? heap_.front().dist_sq : std::numeric_limits<float>::infinity();
+    }
+
+    void finish() { std::sort_heap(heap_.begin(), heap_.end()); }
+};
+
+}
+
+// ==================== KdTree ====================
+
+KdTree::KdTree(size_t leaf_size) : leaf_size_(std::max<size_t>(leaf_size, 1)) {}
+
+size_t KdTree::nodeCount(size_t n) const {
+    if (n <= leaf_size_) {
+        return 1;
+    }
+    return 1 + nodeCount(n / 2) + nodeCount(n - n / 2);
+}
+
+void KdTree::build(const PointCloud& cloud, int num_threads) {
+    size_t n = cloud.size();
+    if (n > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("KdTree: 点数过多");
+    }
+    // 非有限的点不入树: NaN 破坏 nth_element 需要的严格弱序，保留其余点的原始下标
+    index_.clear();
+    index_.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (isFinitePoint(cloud.x[i], cloud.y[i], cloud.z[i])) {
+            index_.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    nodes_.clear();
+    px_.clear();
+    py_.clear();
+    pz_.clear();
+    n = index_.size();
+    if (n == 0) {
+        return;
+    }
+
+    // 节点数只取决于点数，预先分配后各子树可以独立写入
+    nodes_.resize(nodeCount(n));
+    const int threads = choosePartitions(n, num_threads, 20000);
+    int spawn_depth = 0;
+    while ((1 << spawn_depth) < threads) {
+        ++spawn_depth;
+    }
+    buildNode(0, 0, static_cast<uint32_t>(n), cloud, spawn_depth);
+
+    // 按树的顺序重排坐标
+    px_.resize(n);
+    py_.resize(n);
+    pz_.resize(n);
+    runPartitioned(n, threads, [&](int, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            px_[i] = cloud.x[index_[i]];
+            py_[i] = cloud.y[index_[i]];
+            pz_[i] = cloud.z[index_[i]];
+        }
+    });
+}
+
+void KdTree::buildNode(uint32_t node, uint32_t begin, uint32_t end, const PointCloud& cloud, int spawn_depth) {
+    Node& current = nodes_[node];
+    current.begin = begin;
+    current.end = end;
+    const uint32_t n = end - begin;
+    if (n <= leaf_size_) {
+        current.axis = kLeafAxis;
+        current.split = 0.0f;
+        current.right = 0;
+        return;
+    }
+
+    // 选择跨度最大的轴
+    float lo[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    float hi[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+    for (uint32_t i = begin; i < end; ++i) {
+        const uint32_t idx = index_[i];
+        lo[0] = std::min(lo[0], cloud.x[idx]);
+        hi[0] = std::max(hi[0], cloud.x[idx]);
+        lo[1] = std::min(lo[1], cloud.y[idx]);
+        hi[1] = std::max(hi[1], cloud.y[idx]);
+        lo[2] = std::min(lo[2], cloud.z[idx]);
+        hi[2] = std::max(hi[2], cloud.z[idx]);
+    }
+    uint8_t axis = 0;
+    for (uint8_t a = 1; a < 3; ++a) {
+        if (hi[a] - lo[a] > hi[axis] - lo[axis]) {
+            axis = a;
+        }
+    }
+    const std::vector<float>& coord = axis == 0 ? cloud.x : (axis == 1 ? cloud.y : cloud.z);
+
+    const uint32_t mid = begin + n / 2;
+    std::nth_element(index_.begin() + begin, index_.begin() + mid, index_.begin() + end,
+                     [&coord](uint32_t a, uint32_t b) { return coord[a] < coord[b]; });
+
+    const uint32_t left = node + 1;
+    const uint32_t right = left + static_cast<uint32_t>(nodeCount(mid - begin));
+    current.axis = axis;
+    current.split = coord[index_[mid]];
+    current.right = right;
+
+    if (spawn_depth > 0) {
+        std::thread worker([=, &cloud] { buildNode(left, begin, mid, cloud, spawn_depth - 1); });
+        buildNode(right, mid, end, cloud, spawn_depth - 1);
+        worker.join();
+    } else {
+        buildNode(left, begin, mid, cloud, 0);
+        buildNode(right, mid, end, cloud, 0);
+    }
+}
+
+/*
+深度优先遍历，先进入查询点所在的一侧
+bound_sq 由访问者动态收紧，到分割面距离超过它的子树被剪掉
+*/
+template <typename Visitor>
+void KdTree::traverse(float x, float y, float z, Visitor&& visit, const float& bound_sq) const {
+    struct Pending {
+        uint32_t node;
+        float plane_dist_sq;
+    };
+    Pending stack[64];
+    int top = 0;
+    stack[top++] = {0, 0.0f};
+    const float q[3] = {x, y, z};
+
+    while (top > 0) {
+        const Pending item = stack[--top];
+        if (item.plane_dist_sq > bound_sq) {
+            continue;
+        }
+        uint32_t node = item.node;
+        // 沿近侧一路下降，远侧压栈
+        while (nodes_[node].axis != kLeafAxis) {
+            const Node& current = nodes_[node];
+            const float diff = q[current.axis] - current.split;
+            const uint32_t near_child = diff < 0.0f ? node + 1 : current.right;
+            const uint32_t far_child = diff < 0.0f ? current.right : node + 1;
+            const float far_dist_sq = diff * diff;
+            if (far_dist_sq <= bound_sq) {
+                stack[top++] = {far_child, far_dist_sq};
+            }
+            node = near_child;
+        }
+        const Node& leaf = nodes_[node];
+        for (uint32_t i = leaf.begin; i < leaf.end; ++i) {
+            visit(i, distSq(px_[i], py_[i], pz_[i], x, y, z));
+        }
+    }
+}
+
+void KdTree::knn(float x, float y, float z, size_t k, std::vector<Neighbor>& out) const {
+    KnnHeap heap(out, k);
+    if (empty() || k == 0 || !isFinitePoint(x, y, z)) {
+        return;
+    }
+    float bound = std::numeric_limits<float>::infinity();
+    traverse(x, y, z, [&](uint32_t i, float d2) {
+        heap.push(index_[i], d2);
+        bound = heap.bound();
+    }, bound);
+    heap.finish();
+}
+
+void KdTree::radius(float x, float y, float z, float r, std::vector<Neighbor>& out) const {
+    out.clear();
+    if (empty() || !isFinitePoint(x, y, z) || !(r >= 0.0f)) {
+        return;
+    }
+    const float bound = r * r;
+    traverse(x, y, z, [&](uint32_t i, float d2) {
+        if (d2 <= bound) {
+            out.push_back({index_[i], d2});
+        }
+    }, bound);
+    std::sort(out.begin(), out.end());
+}
+
+bool KdTree::nearest(float x, float y, float z, Neighbor& out) const {
+    std::vector<Neighbor> result;
+    knn(x, y, z, 1, result);
+    if (result.empty()) {
+        return false;
+    }
+    out = result.front();
+    return true;
+}
+
+// ==================== HashedGrid ====================
+
+HashedGrid::HashedGrid(float cell_size)
+    : cell_size_(cell_size), inv_cell_(1.0f / cell_size), slot_mask_(0),
+      min_cell_{0, 0, 0}, max_cell_{0, 0, 0} {
+    if (!(cell_size > 0.0f)) {
+        throw std::invalid_argument("HashedGrid: 栅格尺寸必须为正数");
+    }
+}
+
+void HashedGrid::build(const PointCloud& cloud, int num_threads) {
+    const size_t total = cloud.size();
+    if (total > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("HashedGrid: 点数过多");
+    }
+
+    // 并行计算每个点的栅格键，每段各自排序后归并
+    std::vector<std::pair<uint64_t, uint32_t>> keyed(total);
+    const int parts = choosePartitions(total, num_threads, 20000);
+    std::vector<size_t> bounds(parts + 1, total);
+    runPartitioned(total, parts, [&](int p, size_t begin, size_t end) {
+        bounds[p] = begin;
+        for (size_t i = begin; i < end; ++i) {
+            // 非有限的点不入索引: 键取空键，排序后都在末尾
+            const uint64_t key = isFinitePoint(cloud.x[i], cloud.y[i], cloud.z[i])
+                                     ? voxelKey(cloud.x[i], cloud.y[i], cloud.z[i], inv_cell_)
+                                     : kEmptyVoxelKey;
+            keyed[i] = {key, static_cast<uint32_t>(i)};
+        }
+        std::sort(keyed.begin() + begin, keyed.begin() + end);
+    });
+    for (int width = 1; width < parts; width *= 2) {
+        for (int p = 0; p + width < parts; p += 2 * width) {
+            const size_t last = bounds[std::min(p + 2 * width, parts)];
+            std::inplace_merge(keyed.begin() + bounds[p], keyed.begin() + bounds[p + width], keyed.begin() + last);
+        }
+    }
+
+    // 去掉末尾非有限的点
+    size_t n = keyed.size();
+    while (n > 0 && keyed[n - 1].first == kEmptyVoxelKey) {
+        --n;
+    }
+
+    // 生成CSR
+    px_.resize(n);
+    py_.resize(n);
+    pz_.resize(n);
+    index_.resize(n);
+    cell_start_.clear();
+    std::vector<uint64_t> cell_keys;
+    for (int a = 0; a < 3; ++a) {
+        min_cell_[a] = std::numeric_limits<int32_t>::max();
+        max_cell_[a] = std::numeric_limits<int32_t>::min();
+    }
+    for (size_t i = 0; i < n; ++i) {
+        const uint32_t idx = keyed[i].second;
+        if (i == 0 || keyed[i].first != keyed[i - 1].first) {
+            cell_start_.push_back(static_cast<uint32_t>(i));
+            cell_keys.push_back(keyed[i].first);
+            const int32_t c[3] = {voxelCoord(cloud.x[idx], inv_cell_), voxelCoord(cloud.y[idx], inv_cell_),
+                                  voxelCoord(cloud.z[idx], inv_cell_)};
+            for (int a = 0; a < 3; ++a) {
+                min_cell_[a] = std::min(min_cell_[a], c[a]);
+                max_cell_[a] = std::max(max_cell_[a], c[a]);
+            }
+        }
+        px_[i] = cloud.x[idx];
+        py_[i] = cloud.y[idx];
+        pz_[i] = cloud.z[idx];
+        index_[i] = idx;
+    }
+    cell_start_.push_back(static_cast<uint32_t>(n));
+
+    // 栅格键 -> CSR编号 的哈希表，负载因子不超过0.5
+    size_t capacity = 16;
+    while (capacity < cell_keys.size() * 2) {
+        capacity <<= 1;
+    }
+    slot_keys_.assign(capacity, kEmptyVoxelKey);
+    slot_cells_.assign(capacity, 0);
+    slot_mask_ = capacity - 1;
+    for (size_t c = 0; c < cell_keys.size(); ++c) {
+        size_t pos = mixHash(cell_keys[c]) & slot_mask_;
+        while (slot_keys_[pos] != kEmptyVoxelKey) {
+            pos = (pos + 1) & slot_mask_;
+        }
+        slot_keys_[pos] = cell_keys[c];
+        slot_cells_[pos] = static_cast<uint32_t>(c);
+    }
+}
+
+int64_t HashedGrid::findCell(int64_t ix, int64_t iy, int64_t iz) const {
+    if (slot_keys_.empty()) {
+        return -1;
+    }
+    const uint64_t key = packVoxelKey(ix, iy, iz);
+    size_t pos = mixHash(key) & slot_mask_;
+    while (slot_keys_[pos] != kEmptyVoxelKey) {
+        if (slot_keys_[pos] == key) {
+            return slot_cells_[pos];
+        }
+        pos = (pos + 1) & slot_mask_;
+    }
+    return -1;
+}
+
+void HashedGrid::knn(float x, float y, float z, size_t k, std::vector<Neighbor>& out) const {
+    KnnHeap heap(out, k);
+    if (empty() || k == 0 || !isFinitePoint(x, y, z)) {
+        return;
+    }
+    const int64_t c[3] = {voxelCoord(x, inv_cell_), voxelCoord(y, inv_cell_), voxelCoord(z, inv_cell_)};
+
+    // 每环只遍历与非空栅格包围盒相交的部分；查询点在包围盒外时，离包围盒更近的环都是空的，直接跳过
+    int64_t lo[3], hi[3];
+    int64_t first_ring = 0;
+    int64_t max_ring = 0;
+    for (int a = 0; a < 3; ++a) {
+        lo[a] = min_cell_[a] - c[a];
+        hi[a] = max_cell_[a] - c[a];
+        first_ring = std::max(first_ring, std::max(lo[a], -hi[a]));
+        max_ring = std::max(max_ring, std::max(-lo[a], hi[a]));
+    }
+
+    auto visitCell = [&](int64_t dx, int64_t dy, int64_t dz) {
+        const int64_t cell = findCell(c[0] + dx, c[1] + dy, c[2] + dz);
+        if (cell < 0) {
+            return;
+        }
+        for (uint32_t i = cell_start_[cell]; i < cell_start_[cell + 1]; ++i) {
+            heap.push(index_[i], distSq(px_[i], py_[i], pz_[i], x, y, z));
+        }
+    };
+
+    for (int64_t s = first_ring; s <= max_ring; ++s) {
+        // 遍历切比雪夫距离恰好为s的一圈栅格，限制在包围盒内
+        const int64_t x0 = std::max(-s, lo[0]), x1 = std::min(s, hi[0]);
+        const int64_t y0 = std::max(-s, lo[1]), y1 = std::min(s, hi[1]);
+        const int64_t z0 = std::max(-s, lo[2]), z1 = std::min(s, hi[2]);
+        for (int64_t dx = x0; dx <= x1; ++dx) {
+            for (int64_t dy = y0; dy <= y1; ++dy) {
+                if (std::abs(dx) == s || std::abs(dy) == s) {
+                    for (int64_t dz = z0; dz <= z1; ++dz) {
+                        visitCell(dx, dy, dz);
+                    }
+                } else {
+                    if (-s >= z0) {
+                        visitCell(dx, dy, -s);
+                    }
+                    if (s > 0 && s <= z1) {
+                        visitCell(dx, dy, s);
+                    }
+                }
+            }
+        }
+        // 第s+1环的点离查询点至少 s 个栅格
+        const float shell = static_cast<float>(s) * cell_size_;
+        if (heap.full() && heap.bound() <= shell * shell) {
+            break;
+        }
+    }
+    heap.finish();
+}
+
+void HashedGrid::radius(float x, float y, float z, float r, std::vector<Neighbor>& out) const {
+    out.clear();
+    if (empty() || !isFinitePoint(x, y, z) || !(r >= 0.0f)) {
+        return;
+    }
+    const float r2 = r * r;
+    const int64_t x0 = voxelCoord(x - r, inv_cell_), x1 = voxelCoord(x + r, inv_cell_);
+    const int64_t y0 = voxelCoord(y - r, inv_cell_), y1 = voxelCoord(y + r, inv_cell_);
+    const int64_t z0 = voxelCoord(z - r, inv_cell_), z1 = voxelCoord(z + r, inv_cell_);
+    for (int64_t ix = std::max<int64_t>(x0, min_cell_[0]); ix <= std::min<int64_t>(x1, max_cell_[0]); ++ix) {
+        for (int64_t iy = std::max<int64_t>(y0, min_cell_[1]); iy <= std::min<int64_t>(y1, max_cell_[1]); ++iy) {
+            for (int64_t iz = std::max<int64_t>(z0, min_cell_[2]); iz <= std::min<int64_t>(z1, max_cell_[2]); ++iz) {
+                const int64_t cell = findCell(ix, iy, iz);
+                if (cell < 0) {
+                    continue;
+                }
+                for (uint32_t i = cell_start_[cell]; i < cell_start_[cell + 1]; ++i) {
+                    const float d2 = distSq(px_[i], py_[i], pz_[i], x, y, z);
+                    if (d2 <= r2) {
+                        out.push_back({index_[i], d2});
+                    }
+                }
+            }
+        }
+    }
+    std::sort(out.begin(), out.end());
+}
+
+bool HashedGrid::nearest(float x, float y, float z, Neighbor& out) const {
+    std::vector<Neighbor> result;
+    knn(x, y, z, 1, result);
+    if (result.empty()) {
+        return false;
+    }
+    out = result.front();
+    return true;
+}
+
+}
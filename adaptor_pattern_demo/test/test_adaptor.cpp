@@ -2,6 +2,30 @@
 #include <cassert>
 #include "adaptor/lidar_adaptor.hpp"
 #include "adaptor/modern_camera.hpp"
+#include "adaptor/point_projection.hpp"
+#include "adaptor/point_filter.hpp"
+#include "adaptor/scan_codec.hpp"
+#include "adaptor/spatial_index.hpp"
+#include "adaptor/sensor_manager.hpp"
+#include "adaptor/static_sensor_manager.hpp"
+#include "adaptor/image_frame.hpp"
+#include "adaptor/shm_transport.hpp"
+#include "adaptor/occupancy_grid.hpp"
+#include "adaptor/scan_deskew.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <sstream>
+#include <cmath>
+#include <limits>
+#include <cstring>
+#include <random>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 using namespace duan;
 
@@ -47,12 +71,976 @@ void testModernCamera() {
     std::cout << "现代摄像头测试通过！" << std::endl;
 }
 
+void testScanProjection() {
+    std::cout << "测试点云投影..." << std::endl;
+
+    // 单线: 90度方向的点应落在y轴上
+    ScanProjector single(LidarGeometry::singleRing(360));
+    RangeScan scan;
+    scan.rings = 1;
+    scan.beams = 360;
+    scan.ranges.assign(360, 10.0f);
+    PointCloud cloud = single.project(scan);
+    assert(cloud.size() == 360);
+    assert(std::fabs(cloud.x[0] - 10.0f) < 1e-4f);
+    assert(std::fabs(cloud.y[90] - 10.0f) < 1e-4f);
+    assert(std::fabs(cloud.x[90]) < 1e-4f);
+    assert(cloud.z[45] == 0.0f);
+
+    // 多线: 各指令集路径输出逐位一致（beams不是8的倍数，覆盖尾部处理）
+    LidarGeometry geometry = LidarGeometry::uniform(16, 1001, -15.0f, 15.0f);
+    ScanProjector multi(geometry);
+    RangeScan multi_scan;
+    multi_scan.rings = 16;
+    multi_scan.beams = 1001;
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(0.5f, 120.0f);
+    for (int i = 0; i < 16 * 1001; ++i) {
+        multi_scan.ranges.push_back(dist(gen));
+    }
+    PointCloud scalar_out, sse_out, avx_out;
+    multi.project(multi_scan, scalar_out, SimdLevel::Scalar);
+    multi.project(multi_scan, sse_out, SimdLevel::SSE);
+    multi.project(multi_scan, avx_out, SimdLevel::AVX2);
+    const size_t bytes = scalar_out.size() * sizeof(float);
+    assert(std::memcmp(scalar_out.x.data(), sse_out.x.data(), bytes) == 0);
+    assert(std::memcmp(scalar_out.y.data(), avx_out.y.data(), bytes) == 0);
+    assert(std::memcmp(scalar_out.z.data(), avx_out.z.data(), bytes) == 0);
+
+    // 尺寸不一致应报错
+    bool thrown = false;
+    try {
+        single.project(multi_scan);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 适配器直接输出点云
+    LidarAdaptor adaptor("TEST_LIDAR_PROJ");
+    assert(adaptor.init());
+    PointCloud lidar_cloud = adaptor.getPointCloud();
+    assert(lidar_cloud.size() == 360);
+    assert(lidar_cloud.frame_id.find("lidar") != std::string::npos);
+    adaptor.stop();
+
+    std::cout << "点云投影测试通过！(" << simdLevelName(detectSimdLevel()) << ")" << std::endl;
+}
+
+void testPointFilter() {
+    std::cout << "测试点云过滤流水线..." << std::endl;
+
+    // ROI + 距离门限
+    PointCloud cloud;
+    cloud.push_back(1.0f, 0.0f, 0.0f);    // 距离太近
+    cloud.push_back(5.0f, 0.0f, 0.0f);    // 保留
+    cloud.push_back(0.0f, 50.0f, 0.0f);   // 超出ROI
+    cloud.push_back(5.0f, 5.0f, 9.0f);    // 超出ROI高度
+    cloud.push_back(NAN, 1.0f, 1.0f);     // 非法值
+    PointCloud gated = PointFilterPipeline()
+                           .cropBox(-20.0f, -20.0f, -2.0f, 20.0f, 20.0f, 3.0f)
+                           .rangeGate(2.0f, 30.0f)
+                           .apply(cloud);
+    assert(gated.size() == 1);
+    assert(gated.x[0] == 5.0f);
+
+    // 体素降采样: 同一体素内的点合并为质心
+    PointCloud dense;
+    dense.push_back(0.1f, 0.1f, 0.1f);
+    dense.push_back(0.3f, 0.3f, 0.3f);
+    dense.push_back(1.5f, 0.1f, 0.1f);
+    PointCloud voxels = PointFilterPipeline().voxelGrid(1.0f).apply(dense);
+    assert(voxels.size() == 2);
+    assert(std::fabs(voxels.x[0] - 0.2f) < 1e-5f);
+    assert(std::fabs(voxels.x[1] - 1.5f) < 1e-5f);
+
+    // 多线程分块与单线程结果一致
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> dist(-40.0f, 40.0f);
+    PointCloud big;
+    for (int i = 0; i < 200000; ++i) {
+        big.push_back(dist(gen), dist(gen), dist(gen) * 0.05f);
+    }
+    PointFilterPipeline pipeline;
+    pipeline.rangeGate(1.0f, 35.0f).voxelGrid(0.5f);
+    PointCloud single = pipeline.threads(1).apply(big);
+    PointCloud multi = pipeline.threads(4, 10000).apply(big);
+    assert(single.size() == multi.size());
+    for (size_t i = 0; i < single.size(); ++i) {
+        assert(std::fabs(single.x[i] - multi.x[i]) < 1e-4f);
+        assert(std::fabs(single.z[i] - multi.z[i]) < 1e-4f);
+    }
+    PointCloud gated_single = PointFilterPipeline().rangeGate(1.0f, 35.0f).apply(big);
+    PointCloud gated_multi = PointFilterPipeline().rangeGate(1.0f, 35.0f).threads(3, 10000).apply(big);
+    assert(gated_single.x == gated_multi.x);
+
+    // 直接处理传感器接口数据
+    LidarAdaptor adaptor("TEST_LIDAR_FILTER");
+    assert(adaptor.init());
+    ScanProjector projector(LidarGeometry::singleRing(360));
+    PointCloud filtered = PointFilterPipeline().rangeGate(0.0f, 50.0f).apply(adaptor.getSensorData(), projector);
+    assert(filtered.size() <= 360);
+    adaptor.stop();
+
+    std::cout << "点云过滤流水线测试通过！" << std::endl;
+}
+
+void testScanCodec() {
+    std::cout << "测试扫描编解码..." << std::endl;
+
+    RangeScan scan;
+    scan.rings = 4;
+    scan.beams = 300;
+    scan.timestamp = 123.5;
+    scan.frame_id = "lidar_codec";
+    std::mt19937 gen(3);
+    std::normal_distribution<float> noise(0.0f, 0.02f);
+    for (int ring = 0; ring < scan.rings; ++ring) {
+        for (int b = 0; b < scan.beams; ++b) {
+            scan.ranges.push_back(10.0f + ring + 3.0f * std::sin(b * 0.05f) + noise(gen));
+        }
+    }
+    scan.ranges[5] = NAN;       // 非法值编码为0
+    scan.ranges[6] = 5000.0f;   // 大跳变走转义路径
+
+    ScanCodecOptions options;
+    options.precision = 0.01f;
+    ScanEncoder encoder(options);
+    std::vector<uint8_t> buffer;
+    size_t frame_size = encoder.encode(scan, buffer);
+    assert(frame_size == buffer.size());
+    assert(frame_size < scan.ranges.size() * sizeof(float) / 2);
+
+    ScanDecoder decoder;
+    RangeScan decoded;
+    assert(decoder.decode(buffer.data(), buffer.size(), decoded) == frame_size);
+    assert(decoded.rings == 4 && decoded.beams == 300);
+    assert(decoded.timestamp == 123.5);
+    assert(decoded.frame_id == "lidar_codec");
+    assert(decoded.ranges[5] == 0.0f);
+    for (size_t i = 0; i < scan.ranges.size(); ++i) {
+        if (i != 5) {
+            assert(std::fabs(decoded.ranges[i] - scan.ranges[i]) <= options.precision * 0.5f + 1e-3f);
+        }
+    }
+
+    // 数据不完整时返回0
+    assert(decoder.decode(buffer.data(), buffer.size() - 1, decoded) == 0);
+
+    // 损坏的帧抛出 runtime_error，而不是按帧头的点数分配内存或越界读
+    std::vector<uint8_t> corrupt = buffer;
+    const uint32_t huge_beams = 0x7fffffff;
+    std::memcpy(corrupt.data() + 12, &huge_beams, sizeof(huge_beams));
+    bool rejected = false;
+    try {
+        decoder.decode(corrupt.data(), corrupt.size(), decoded);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    // 载荷全为1: 每个码都走转义，数据不够时报截断
+    corrupt = buffer;
+    std::fill(corrupt.begin() + 30 + scan.frame_id.size(), corrupt.end(), 0xff);
+    rejected = false;
+    try {
+        decoder.decode(corrupt.data(), corrupt.size(), decoded);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+
+    // 流式读写
+    std::stringstream stream;
+    ScanStreamWriter writer(stream, options);
+    assert(writer.write(scan));
+    assert(writer.write(scan));
+    assert(writer.framesWritten() == 2);
+    ScanStreamReader reader(stream);
+    int frames = 0;
+    while (reader.read(decoded)) {
+        assert(decoded.ranges.size() == scan.ranges.size());
+        ++frames;
+    }
+    assert(frames == 2);
+
+    // 伪造的帧长度: 超过帧头尺寸允许的最大值时在分配前拒绝；
+    // 尺寸本身允许但流被截断时按实际读到的数据报错，不会先按帧长度分配
+    for (uint32_t forged_beams : {300u, 0x7fffffffu}) {
+        std::vector<uint8_t> forged = buffer;
+        const uint32_t forged_size = 0xfffffff0u;
+        std::memcpy(forged.data() + 4, &forged_size, sizeof(forged_size));
+        std::memcpy(forged.data() + 12, &forged_beams, sizeof(forged_beams));
+        std::stringstream forged_stream(std::string(forged.begin(), forged.end()));
+        ScanStreamReader forged_reader(forged_stream);
+        rejected = false;
+        try {
+            forged_reader.read(decoded);
+        } catch (const std::runtime_error& e) {
+            const std::string what = e.what();
+            rejected = what.find(forged_beams == 300u ? "帧头损坏" : "帧数据被截断") != std::string::npos;
+        }
+        assert(rejected);
+    }
+
+    std::cout << "扫描编解码测试通过！" << std::endl;
+}
+
+void testSpatialIndex() {
+    std::cout << "测试空间索引..." << std::endl;
+
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> dist(-20.0f, 20.0f);
+    PointCloud cloud;
+    for (int i = 0; i < 30000; ++i) {
+        cloud.push_back(dist(gen), dist(gen), dist(gen) * 0.1f);
+    }
+
+    KdTree tree(8);
+    tree.build(cloud, 4);
+    HashedGrid grid(1.0f);
+    grid.build(cloud, 4);
+    assert(tree.size() == cloud.size());
+    assert(grid.size() == cloud.size());
+
+    // 与暴力搜索对比
+    std::vector<Neighbor> brute, kd_result, grid_result;
+    for (int q = 0; q < 50; ++q) {
+        float x = dist(gen), y = dist(gen), z = dist(gen) * 0.1f;
+        brute.clear();
+        for (size_t i = 0; i < cloud.size(); ++i) {
+            float dx = cloud.x[i] - x, dy = cloud.y[i] - y, dz = cloud.z[i] - z;
+            brute.push_back({static_cast<uint32_t>(i), dx * dx + dy * dy + dz * dz});
+        }
+        std::sort(brute.begin(), brute.end());
+
+        tree.knn(x, y, z, 5, kd_result);
+        grid.knn(x, y, z, 5, grid_result);
+        assert(kd_result.size() == 5 && grid_result.size() == 5);
+        for (size_t i = 0; i < 5; ++i) {
+            assert(kd_result[i].index == brute[i].index);
+            assert(grid_result[i].index == brute[i].index);
+        }
+
+        size_t inside = 0;
+        while (inside < brute.size() && brute[inside].dist_sq <= 1.5f * 1.5f) {
+            ++inside;
+        }
+        tree.radius(x, y, z, 1.5f, kd_result);
+        grid.radius(x, y, z, 1.5f, grid_result);
+        assert(kd_result.size() == inside);
+        assert(grid_result.size() == inside);
+    }
+
+    Neighbor nearest;
+    assert(tree.nearest(cloud.x[123], cloud.y[123], cloud.z[123], nearest));
+    assert(nearest.index == 123 && nearest.dist_sq == 0.0f);
+
+    // 远离数据的查询只遍历与包围盒相交的环，结果与 KdTree 一致
+    for (float far : {1.0e5f, -3.0e6f, 1.0e9f}) {
+        tree.knn(far, 1.0f, 0.0f, 3, kd_result);
+        grid.knn(far, 1.0f, 0.0f, 3, grid_result);
+        assert(grid_result.size() == 3);
+        for (size_t i = 0; i < 3; ++i) {
+            assert(grid_result[i].index == kd_result[i].index);
+        }
+    }
+
+    // 非有限的点不入索引，非有限的查询没有结果
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    PointCloud dirty = cloud;
+    dirty.push_back(nan, 0.0f, 0.0f);
+    dirty.push_back(0.0f, std::numeric_limits<float>::infinity(), 0.0f);
+    HashedGrid dirty_grid(1.0f);
+    dirty_grid.build(dirty, 4);
+    assert(dirty_grid.size() == cloud.size());
+    dirty_grid.knn(nan, 0.0f, 0.0f, 3, grid_result);
+    assert(grid_result.empty());
+    dirty_grid.radius(0.0f, nan, 0.0f, 1.0f, grid_result);
+    assert(grid_result.empty());
+    assert(dirty_grid.nearest(cloud.x[7], cloud.y[7], cloud.z[7], nearest) && nearest.index == 7);
+
+    // k-d树同样跳过非有限的点: 每三个点一个 NaN，结果与只看有限点的暴力搜索一致，下标仍是原始下标
+    PointCloud holes;
+    for (int i = 0; i < 20000; ++i) {
+        if (i % 3 == 0) {
+            holes.push_back(nan, dist(gen), dist(gen));
+        } else {
+            holes.push_back(dist(gen), dist(gen), dist(gen) * 0.1f);
+        }
+    }
+    KdTree holey_tree(4);
+    holey_tree.build(holes, 4);
+    assert(holey_tree.size() == 20000 - 6667);
+    for (int q = 0; q < 20; ++q) {
+        const float x = q == 0 ? 0.0f : dist(gen), y = q == 0 ? 0.0f : dist(gen), z = q == 0 ? 0.0f : dist(gen) * 0.1f;
+        brute.clear();
+        for (size_t i = 0; i < holes.size(); ++i) {
+            if (i % 3 != 0) {
+                float dx = holes.x[i] - x, dy = holes.y[i] - y, dz = holes.z[i] - z;
+                brute.push_back({static_cast<uint32_t>(i), dx * dx + dy * dy + dz * dz});
+            }
+        }
+        std::sort(brute.begin(), brute.end());
+        holey_tree.knn(x, y, z, 5, kd_result);
+        assert(kd_result.size() == 5);
+        for (size_t i = 0; i < 5; ++i) {
+            assert(kd_result[i].index == brute[i].index && kd_result[i].dist_sq == brute[i].dist_sq);
+        }
+    }
+    holey_tree.knn(nan, 0.0f, 0.0f, 3, kd_result);
+    assert(kd_result.empty());
+    holey_tree.radius(0.0f, 0.0f, nan, 1.0f, kd_result);
+    assert(kd_result.empty());
+
+    KdTree empty_tree;
+    empty_tree.build(PointCloud());
+    assert(!empty_tree.nearest(0.0f, 0.0f, 0.0f, nearest));
+
+    std::cout << "空间索引测试通过！" << std::endl;
+}
+
+// 可控的测试传感器：stalled 为 true 时返回空数据
+class StubSensor : public SensorInterface {
+public:
+    std::atomic<bool> stalled{false};
+
+    bool init() override { return true; }
+    SensorDate getSensorData() override {
+        SensorDate data(std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count(), "stub");
+        if (!stalled) {
+            data.points.assign(10, 1.0);
+        }
+        return data;
+    }
+    void stop() override {}
+    std::string getName() const override { return "stub"; }
+};
+
+void testSensorMonitoring() {
+    std::cout << "测试传感器统计与看门狗..." << std::endl;
+
+    // 直方图分位数误差不超过 1/16
+    LatencyHistogram histogram;
+    for (uint64_t v = 1; v <= 10000; ++v) {
+        histogram.record(v * 1000);
+    }
+    HistogramSnapshot snapshot = histogram.snapshot();
+    assert(snapshot.count == 10000);
+    assert(std::fabs(snapshot.p50_us - 5000.0) <= 5000.0 / 16);
+    assert(std::fabs(snapshot.p99_us - 9900.0) <= 9900.0 / 16);
+    assert(snapshot.max_us == 10000.0);
+
+    auto stub = std::make_unique<StubSensor>();
+    StubSensor* stub_ptr = stub.get();
+    SensorManager manager;
+    SensorOptions options;
+    options.deadline_ms = 30.0;
+    manager.addSensor(std::move(stub), options);
+    assert(manager.initSensors());
+
+    for (int i = 0; i < 5; ++i) {
+        auto frames = manager.acquireAll();
+        assert(frames.size() == 1);
+    }
+    SensorStatsSnapshot stats;
+    assert(manager.getStats("stub", stats));
+    assert(stats.frames == 5);
+    assert(stats.acquisition.count == 5);
+    assert(stats.frame_interval.count == 4);
+    assert(!stats.stalled);
+
+    // 停止出数据后，看门狗应在期限后报告停滞，且只报告一次
+    std::atomic<int> alerts{0};
+    stub_ptr->stalled = true;
+    manager.startWatchdog(5.0, [&alerts](const std::string& name, double silent_ms) {
+        assert(name == "stub");
+        assert(silent_ms > 30.0);
+        ++alerts;
+    });
+    manager.acquireAll();
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    assert(manager.getStats("stub", stats));
+    assert(stats.stalled);
+    assert(stats.stalls == 1);
+    assert(stats.failed_reads == 1);
+    assert(alerts == 1);
+
+    // 恢复后停滞标志清除，并记录一次超期的帧间隔
+    stub_ptr->stalled = false;
+    manager.acquireAll();
+    manager.stopWatchdog();
+    assert(manager.getStats("stub", stats));
+    assert(!stats.stalled);
+    assert(stats.deadline_misses == 1);
+
+    std::ostringstream dump;
+    manager.dumpStats(dump);
+    assert(dump.str().find("[stub]") != std::string::npos);
+
+    std::cout << "传感器统计与看门狗测试通过！" << std::endl;
+}
+
+void testStaticSensorManager() {
+    std::cout << "测试静态传感器管理器..." << std::endl;
+
+    SensorOptions camera_options;
+    camera_options.deadline_ms = 500.0;
+    StaticSensorManager<ModernCamera, LidarAdaptor> manager(
+        {camera_options, SensorOptions()},
+        std::make_tuple(std::string("STATIC_CAMERA"), 64, 48),
+        std::make_tuple(std::string("STATIC_LIDAR")));
+    static_assert(decltype(manager)::size() == 2, "编译期已知传感器数");
+    assert(manager.initSensors());
+
+    auto frames = manager.acquireAll();
+    assert(frames[0].image && frames[0].image->width() == 64);
+    assert(!frames[1].points.empty());
+
+    // acquireEach 拿到具体类型，可直接调用派生类接口
+    size_t lidar_points = 0;
+    int calls = 0;
+    manager.acquireEach([&](auto index, auto& sensor, const SensorInterface::SensorDate& data) {
+        ++calls;
+        if constexpr (decltype(index)::value == 1) {
+            lidar_points = sensor.getPointCloud().size();
+            assert(!data.points.empty());
+        }
+    });
+    assert(calls == 2 && lidar_points > 0);
+
+    assert(manager.getStats<0>().frames == 2);
+    assert(manager.getStats<1>().frame_interval.count == 1);
+    assert(manager.get<0>().getName() == "STATIC_CAMERA");
+    auto all = manager.getStats();
+    assert(all.size() == 2 && all[1].name == "LidarAdaptor_STATIC_LIDAR");
+    manager.resetStats();
+    assert(manager.getStats<0>().frames == 0);
+    manager.stopAllSensors();
+
+    std::cout << "静态传感器管理器测试通过！" << std::endl;
+}
+
+void testImageFrame() {
+    std::cout << "测试图像缓冲与转换..." << std::endl;
+
+    // 行首对齐与平面尺寸
+    ImageFrame yuv = ImageFrame::allocate(101, 51, PixelFormat::YUV420P);
+    assert(yuv.planeCount() == 3);
+    assert(yuv.planeWidth(1) == 51 && yuv.planeHeight(2) == 26);
+    for (int p = 0; p < 3; ++p) {
+        assert(yuv.stride(p) % ImageBufferPool::kAlignment == 0);
+        assert(reinterpret_cast<uintptr_t>(yuv.data(p)) % ImageBufferPool::kAlignment == 0);
+    }
+
+    // 缓冲池复用
+    ImageBufferPool pool;
+    {
+        ImageFrame a = ImageFrame::allocate(640, 480, PixelFormat::RGB8, &pool);
+    }
+    ImageFrame b = ImageFrame::allocate(640, 480, PixelFormat::RGB8, &pool);
+    assert(pool.allocations() == 1 && pool.reuses() == 1);
+
+    // 随机图像，宽度不是16的倍数，覆盖SIMD尾部
+    std::mt19937 gen(9);
+    ImageFrame rgb = ImageFrame::allocate(333, 7, PixelFormat::RGB8);
+    for (int y = 0; y < rgb.height(); ++y) {
+        for (size_t i = 0; i < rgb.rowBytes(0); ++i) {
+            rgb.row(y)[i] = static_cast<uint8_t>(gen());
+        }
+    }
+    auto sameImage = [](const ImageFrame& a, const ImageFrame& b) {
+        if (a.width() != b.width() || a.height() != b.height() || a.format() != b.format()) {
+            return false;
+        }
+        for (int p = 0; p < a.planeCount(); ++p) {
+            for (int y = 0; y < a.planeHeight(p); ++y) {
+                if (std::memcmp(a.row(y, p), b.row(y, p), a.rowBytes(p)) != 0) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    ImageFrame gray_simd = convertImage(rgb, PixelFormat::Gray8);
+    ImageFrame gray_scalar = convertImage(rgb, PixelFormat::Gray8, nullptr, SimdLevel::Scalar);
+    assert(sameImage(gray_simd, gray_scalar));
+    const uint8_t* px = rgb.row(3) + 3 * 100;
+    assert(gray_scalar.row(3)[100] == static_cast<uint8_t>((px[0] * 77 + px[1] * 150 + px[2] * 29 + 128) >> 8));
+
+    ImageFrame bgr = convertImage(rgb, PixelFormat::BGR8);
+    assert(bgr.row(2)[3 * 50] == rgb.row(2)[3 * 50 + 2]);
+    assert(sameImage(convertImage(bgr, PixelFormat::Gray8), gray_scalar));
+    assert(sameImage(convertImage(bgr, PixelFormat::RGB8), rgb));
+
+    ImageFrame planar = convertImage(rgb, PixelFormat::RGB8Planar);
+    assert(planar.row(4, 1)[200] == rgb.row(4)[3 * 200 + 1]);
+    assert(sameImage(convertImage(planar, PixelFormat::RGB8, nullptr, SimdLevel::Scalar), rgb));
+    assert(sameImage(convertImage(planar, PixelFormat::RGB8), rgb));
+
+    // 降采样: SIMD与标量一致
+    ImageFrame big_gray = ImageFrame::allocate(301, 9, PixelFormat::Gray8);
+    for (int y = 0; y < big_gray.height(); ++y) {
+        for (int x = 0; x < big_gray.width(); ++x) {
+            big_gray.row(y)[x] = static_cast<uint8_t>(gen());
+        }
+    }
+    ImageFrame half = downscale2x(big_gray);
+    assert(half.width() == 150 && half.height() == 4);
+    assert(sameImage(half, downscale2x(big_gray, nullptr, SimdLevel::Scalar)));
+    assert(sameImage(half, downscale2x(big_gray, nullptr, SimdLevel::SSE)));
+    const uint8_t* r0 = big_gray.row(2);
+    const uint8_t* r1 = big_gray.row(3);
+    assert(half.row(1)[7] == ((r0[14] + r0[15] + r1[14] + r1[15] + 2) >> 2));
+    assert(downscale2x(rgb).width() == 166);
+
+    bool thrown = false;
+    try {
+        convertImage(gray_scalar, PixelFormat::YUV420P);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 摄像头输出图像帧
+    ModernCamera camera("TEST_CAMERA_IMAGE", 320, 240);
+    assert(camera.init());
+    auto data = camera.getSensorData();
+    assert(data.image && data.image->width() == 320 && data.image->format() == PixelFormat::RGB8);
+    assert(data.points.size() == 100);
+    camera.stop();
+
+    std::cout << "图像缓冲与转换测试通过！" << std::endl;
+}
+
+void testOccupancyGrid() {
+    std::cout << "测试占据栅格..." << std::endl;
+
+    // 单线雷达位于原点，四周 10 米处是一圈墙，正东方向无回波
+    LidarGeometry geometry = LidarGeometry::singleRing(360);
+    RangeScan scan;
+    scan.beams = 360;
+    scan.ranges.assign(360, 10.0f);
+    scan.ranges[0] = 0.0f;
+
+    OccupancyGridConfig config;
+    config.resolution = 0.2f;
+    config.size_cells = 256;
+    OccupancyGrid grid(config);
+    for (int i = 0; i < 3; ++i) {
+        grid.integrate(scan, geometry, Pose2D());
+    }
+    assert(grid.state(0.0f, 10.05f) == CellState::Occupied);
+    assert(grid.isOccupied(-9.9f, 0.05f));
+    assert(grid.isOccupied(7.1f, 7.1f));
+    assert(grid.state(0.0f, 5.0f) == CellState::Free);
+    assert(grid.state(3.5f, -3.5f) == CellState::Free);
+    assert(grid.state(0.0f, 14.0f) == CellState::Unknown);   // 墙后
+    assert(grid.state(12.0f, 0.05f) == CellState::Unknown);  // 无回波方向
+    // 同一帧内每格只更新一次，三帧后达到 3 * hit
+    assert(std::fabs(grid.logOdds(0.0f, 10.05f) - 3 * config.log_odds_hit) < 1e-5f);
+    assert(grid.probability(0.0f, 5.0f) < 0.5f);
+
+    // AVX2 与标量逐位一致（多线点云 + 带航向的位姿）
+    LidarGeometry multi = LidarGeometry::uniform(16, 900, -15.0f, 15.0f);
+    RangeScan scan16;
+    scan16.rings = 16;
+    scan16.beams = 900;
+    std::mt19937 gen(4);
+    std::uniform_real_distribution<float> range(1.0f, 40.0f);
+    for (int i = 0; i < 16 * 900; ++i) {
+        scan16.ranges.push_back(i % 97 == 0 ? 0.0f : range(gen));
+    }
+    Pose2D pose{3.3f, -1.7f, 0.6f};
+    OccupancyGrid simd_grid(config), scalar_grid(config);
+    auto t0 = std::chrono::steady_clock::now();
+    simd_grid.integrate(scan16, multi, pose);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    scalar_grid.integrate(scan16, multi, pose, SimdLevel::Scalar);
+    assert(simd_grid.rawCells() == scalar_grid.rawCells());
+
+    PointCloud cloud = ScanProjector(multi).project(scan16);
+    simd_grid.integrate(cloud, pose, -0.5f, 2.0f);
+    scalar_grid.integrate(cloud, pose, -0.5f, 2.0f, SimdLevel::Scalar);
+    assert(simd_grid.rawCells() == scalar_grid.rawCells());
+
+    // 非有限的点（驱动的无效回波）被丢弃，不影响栅格
+    PointCloud invalid = cloud;
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+    invalid.x[0] = nan;
+    invalid.y[1] = inf;
+    invalid.z[2] = nan;
+    invalid.x[3] = -inf;
+    OccupancyGrid with_invalid(config), reference_grid(config);
+    with_invalid.integrate(invalid, pose, -0.5f, 2.0f);
+    PointCloud valid;
+    for (size_t i = 4; i < cloud.size(); ++i) {
+        valid.x.push_back(cloud.x[i]);
+        valid.y.push_back(cloud.y[i]);
+        valid.z.push_back(cloud.z[i]);
+    }
+    reference_grid.integrate(valid, pose, -0.5f, 2.0f);
+    assert(with_invalid.rawCells() == reference_grid.rawCells());
+
+    // 增量: 清空脏标记后再插入一帧，只有射线经过的 tile 变脏
+    grid.clearDirty();
+    assert(grid.dirtyTiles().empty());
+    RangeScan narrow;
+    narrow.beams = 360;
+    narrow.ranges.assign(360, 0.0f);
+    narrow.ranges[90] = 4.0f;   // 只有正北方向一条射线
+    grid.integrate(narrow, geometry, Pose2D());
+    auto dirty = grid.dirtyTiles();
+    assert(!dirty.empty() && dirty.size() <= 3);
+    for (const auto& tile : dirty) {
+        assert(tile.x == -1 || tile.x == 0);
+    }
+
+    // 滚动: 车辆向东移动 30 米后，原点附近的 tile 移出窗口被清空，
+    // 仍在窗口内的墙保持不变
+    grid.clearDirty();
+    grid.recenter(30.0f, 0.0f);
+    assert(grid.originX() > 0.0);
+    assert(grid.state(-9.9f, 0.05f) == CellState::Unknown);
+    assert(grid.state(0.0f, 5.0f) == CellState::Unknown);
+    assert(grid.isOccupied(7.1f, 7.1f));
+    assert(!grid.dirtyTiles().empty());
+
+    bool thrown = false;
+    try {
+        config.size_cells = 100;
+        OccupancyGrid bad(config);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "占据栅格测试通过！(16x900 扫描插入 " << ms << " ms)" << std::endl;
+}
+
+void testScanDeskew() {
+    std::cout << "测试运动补偿..." << std::endl;
+
+    LidarGeometry geometry = LidarGeometry::uniform(4, 360, -15.0f, 15.0f);
+    RangeScan scan;
+    scan.rings = 4;
+    scan.beams = 360;
+    scan.timestamp = 5.0;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> dist(1.0f, 50.0f);
+    for (int i = 0; i < 4 * 360; ++i) {
+        scan.ranges.push_back(i % 37 == 0 ? 0.0f : dist(rng));
+    }
+    ScanProjector projector(geometry);
+    PointCloud projected = projector.project(scan);
+
+    // 静止时与直接投影一致
+    ScanDeskewer deskewer(geometry);
+    PointCloud still = deskewer.deskew(scan, VehicleMotion(), VehicleMotion());
+    assert(still.size() == projected.size());
+    assert(std::abs(still.timestamp - 5.1) < 1e-9);
+    for (size_t i = 0; i < still.size(); ++i) {
+        assert(still.x[i] == projected.x[i] && still.y[i] == projected.y[i] && still.z[i] == projected.z[i]);
+    }
+
+    // 36 km/h 直行，一圈 0.1 秒移动 1 米；第 b 列距扫描结束还有 (360 - b) / 360 * 0.1 秒
+    VehicleMotion straight{36.0, 0.0};
+    PointCloud moved = deskewer.deskew(scan, straight, straight);
+    assert(std::abs(deskewer.sweepTranslation() - 1.0) < 1e-4);
+    assert(std::abs(deskewer.sweepRotation()) < 1e-6);
+    for (int ring = 0; ring < 4; ++ring) {
+        for (int b : {1, 90, 180, 359}) {
+            const size_t i = static_cast<size_t>(ring) * 360 + b;
+            const float shift = (360 - b) / 360.0f;
+            assert(std::abs(moved.x[i] - (projected.x[i] - shift)) < 1e-4f);
+            assert(std::abs(moved.y[i] - projected.y[i]) < 1e-4f);
+            assert(moved.z[i] == projected.z[i]);
+        }
+    }
+    // 无回波的点不受补偿影响
+    assert(moved.x[0] == 0.0f && moved.y[0] == 0.0f && moved.z[0] == 0.0f);
+
+    // 以扫描开始为参考时，最后一列向前平移
+    DeskewConfig start_cfg;
+    start_cfg.align_to_scan_end = false;
+    ScanDeskewer from_start(geometry, start_cfg);
+    PointCloud forward = from_start.deskew(scan, straight, straight);
+    assert(forward.timestamp == 5.0);
+    assert(std::abs(forward.x[359] - (projected.x[359] + 359 / 360.0f)) < 1e-4f);
+    // 扫描结束时刻相对开始移动整整 1 米，而不是最后一列的 359/360 米
+    assert(std::abs(from_start.sweepTranslation() - 1.0) < 1e-4);
+    from_start.deskew(scan, VehicleMotion{36.0, 10.0}, VehicleMotion{36.0, 10.0});
+    assert(std::abs(from_start.sweepRotation() - 10.0 * std::tan(10.0 * 3.14159265358979323846 / 180.0) / 2.8 * 0.1) < 1e-5);
+
+    // 转弯: 自行车模型横摆角速度 v * tan(δ) / L，开始时刻的朝向相对结束时刻为 -w * T
+    VehicleMotion turning{36.0, 10.0};
+    PointCloud turned = deskewer.deskew(scan, turning, turning);
+    const double w = 10.0 * std::tan(10.0 * 3.14159265358979323846 / 180.0) / 2.8;
+    assert(std::abs(deskewer.sweepRotation() + w * 0.1) < 1e-5);
+    // 最后一列几乎不动
+    assert(std::abs(turned.x[359] - projected.x[359]) < 0.01f && std::abs(turned.y[359] - projected.y[359]) < 0.01f);
+    // 第1列在直行补偿之外还有旋转，远处的点横向偏移明显
+    assert(std::abs(turned.y[1] - moved.y[1]) > 0.01f);
+    assert(turned.z[1] == projected.z[1]);
+
+    // 各指令集、多线程输出逐位相同
+    const SimdLevel levels[] = {SimdLevel::Scalar, SimdLevel::SSE, SimdLevel::AVX2};
+    PointCloud reference;
+    deskewer.deskew(scan, straight, turning, reference, 1, SimdLevel::Scalar);
+    for (SimdLevel level : levels) {
+        for (int threads : {1, 3}) {
+            PointCloud out;
+            deskewer.deskew(scan, straight, turning, out, threads, level);
+            assert(std::memcmp(out.x.data(), reference.x.data(), out.x.size() * sizeof(float)) == 0);
+            assert(std::memcmp(out.y.data(), reference.y.data(), out.y.size() * sizeof(float)) == 0);
+            assert(std::memcmp(out.z.data(), reference.z.data(), out.z.size() * sizeof(float)) == 0);
+        }
+    }
+
+    // 尺寸不一致抛异常
+    RangeScan wrong = scan;
+    wrong.beams = 100;
+    bool thrown = false;
+    try {
+        deskewer.deskew(wrong, straight, straight);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 64 线 x 1800 列，约 11.5 万点
+    LidarGeometry dense = LidarGeometry::uniform(64, 1800, -25.0f, 15.0f);
+    RangeScan big;
+    big.rings = 64;
+    big.beams = 1800;
+    big.ranges.resize(64 * 1800);
+    for (float& r : big.ranges) {
+        r = dist(rng);
+    }
+    ScanDeskewer big_deskewer(dense);
+    PointCloud big_out;
+    big_deskewer.deskew(big, straight, turning, big_out, 0);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; ++i) {
+        big_deskewer.deskew(big, straight, turning, big_out, 0);
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count() / 10;
+
+    std::cout << "运动补偿测试通过！(64x1800 扫描补偿 " << ms << " ms)" << std::endl;
+}
+
+void testShmTransport() {
+    std::cout << "测试共享内存传输..." << std::endl;
+
+    const std::string name = "/duan_test_shm_" + std::to_string(getpid());
+    ShmTransportOptions options;
+    options.slots = 3;
+    options.slot_bytes = 2 * 1024 * 1024;
+    ShmWriter writer(name, options);
+    ShmReader reader(name);
+    ShmFrame frame;
+    assert(!reader.next(frame) && !reader.latest(frame));
+
+    // 距离扫描
+    RangeScan scan;
+    scan.rings = 4;
+    scan.beams = 100;
+    scan.timestamp = 12.5;
+    scan.frame_id = "lidar_top";
+    for (int i = 0; i < 400; ++i) {
+        scan.ranges.push_back(static_cast<float>(i) * 0.25f);
+    }
+    assert(writer.publish(scan) == 0);
+    assert(reader.next(frame));
+    assert(frame.seq() == 0 && frame.info().kind == ShmFrameKind::RangeScan);
+    assert(frame.info().frame_id == "lidar_top" && frame.info().timestamp == 12.5);
+    assert(frame.ranges()[123] == 123 * 0.25f);
+    assert(frame.valid());
+    RangeScan copy = frame.toRangeScan();
+    assert(copy.rings == 4 && copy.beams == 100 && copy.ranges == scan.ranges);
+
+    // 图像: 读者拿到的像素直接指向共享内存
+    ImageFrame rgb = ImageFrame::allocate(321, 200, PixelFormat::RGB8);
+    for (int y = 0; y < rgb.height(); ++y) {
+        for (size_t i = 0; i < rgb.rowBytes(0); ++i) {
+            rgb.row(y)[i] = static_cast<uint8_t>(y * 7 + i);
+        }
+    }
+    rgb.frame_id = "camera_front";
+    writer.publish(rgb);
+    assert(reader.next(frame) && frame.info().kind == ShmFrameKind::Image);
+    auto image = frame.image();
+    assert(image->data(0) == frame.data());
+    assert(image->width() == 321 && image->stride(0) == rgb.stride(0) && image->frame_id == "camera_front");
+    assert(std::memcmp(image->row(150), rgb.row(150), rgb.rowBytes(0)) == 0);
+
+    // 借出槽位原地写入
+    ShmFrameInfo info;
+    info.kind = ShmFrameKind::Image;
+    info.width = 64;
+    info.height = 32;
+    info.format = PixelFormat::Gray8;
+    info.bytes = ImageFrame::requiredBytes(64, 32, PixelFormat::Gray8);
+    ShmLoan loan = writer.loan(info);
+    ImageFrame in_place = loan.image();
+    for (int y = 0; y < 32; ++y) {
+        std::memset(in_place.row(y), y, 64);
+    }
+    writer.commit(loan);
+    assert(reader.next(frame) && frame.image()->row(17)[63] == 17);
+
+    // 写者覆盖后旧帧失效，跟不上的读者记录丢帧
+    ShmFrame held;
+    assert(reader.latest(held) && held.valid());
+    for (int i = 0; i < 5; ++i) {
+        writer.publish(scan);
+    }
+    assert(!held.valid());
+    assert(reader.next(frame) && frame.seq() == 5);
+    assert(reader.dropped() == 2);
+
+    // 超过槽位容量
+    bool thrown = false;
+    try {
+        std::vector<uint8_t> big(options.slot_bytes + 1);
+        writer.publish(big.data(), big.size());
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 损坏的共享内存（写者进程出错或被改写）: 布局不合法时拒绝打开，槽位描述不合法的帧按丢帧处理
+    // 偏移与 shm_transport.cpp 中的段头/槽位头布局一致
+    {
+        const std::string bad_name = name + "_bad";
+        ShmWriter bad_writer(bad_name, options);
+        const int fd = shm_open(bad_name.c_str(), O_RDWR, 0);
+        assert(fd >= 0);
+        struct stat st;
+        assert(fstat(fd, &st) == 0);
+        uint8_t* raw = static_cast<uint8_t*>(mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+        close(fd);
+        assert(raw != MAP_FAILED);
+        constexpr size_t kSegmentHeader = 192;
+        constexpr size_t kSlotHeader = 128;
+        auto rejectsLayout = [&](size_t offset, uint64_t value, size_t width) {
+            uint8_t saved[8];
+            std::memcpy(saved, raw + offset, width);
+            std::memcpy(raw + offset, &value, width);
+            bool rejected = false;
+            try {
+                ShmReader broken(bad_name);
+            } catch (const std::runtime_error&) {
+                rejected = true;
+            }
+            std::memcpy(raw + offset, saved, width);
+            return rejected;
+        };
+        assert(rejectsLayout(8, 0, 4));                            // slots
+        assert(rejectsLayout(8, 100000, 4));                       // 槽位头超出数据区
+        assert(rejectsLayout(16, uint64_t(1) << 40, 8));           // slot_stride 超出映射
+        assert(rejectsLayout(24, static_cast<uint64_t>(st.st_size), 8));  // payload_offset
+        ShmReader bad_reader(bad_name);
+
+        auto forgeSlot = [&](uint64_t seq, size_t offset, uint64_t value, size_t width) {
+            std::memcpy(raw + kSegmentHeader + kSlotHeader * (seq % options.slots) + offset, &value, width);
+        };
+        ShmFrame checked;
+        bad_writer.publish(scan);
+        forgeSlot(0, 32, options.slot_bytes * 4, 8);               // bytes 超过槽位
+        assert(!bad_reader.next(checked));
+        bad_writer.publish(scan);
+        forgeSlot(1, 24, 100000, 4);                               // width * height 超过 bytes
+        assert(!bad_reader.next(checked));
+        bad_writer.publish(rgb);
+        forgeSlot(2, 20, 99, 4);                                   // 未知的像素格式
+        assert(!bad_reader.next(checked) && !bad_reader.latest(checked));
+        bad_writer.publish(rgb);
+        forgeSlot(3, 28, 0x7fffffff, 4);                           // 图像高度远超数据
+        assert(!bad_reader.next(checked));
+        bad_writer.publish(scan);
+        assert(bad_reader.next(checked) && checked.seq() == 4 && checked.valid());
+        assert(bad_reader.dropped() == 4 && bad_reader.slotCount() == options.slots);
+        munmap(raw, static_cast<size_t>(st.st_size));
+    }
+
+    // 没有新帧时等待超时
+    while (reader.next(frame)) {}
+    auto t0 = std::chrono::steady_clock::now();
+    assert(!reader.waitNext(frame, 20.0));
+    assert(std::chrono::steady_clock::now() - t0 >= std::chrono::milliseconds(15));
+
+    // 跨进程: 子进程只读映射并通过 futex 等待，父进程发布 1280x720 图像
+    const std::string cross_name = name + "_cross";
+    ShmTransportOptions cross_options;
+    cross_options.slots = 8;
+    ShmWriter cross_writer(cross_name, cross_options);
+    const int kFrames = 20;
+    // 读端在 fork 之前打开，子进程继承映射，从第一帧开始读，不依赖父进程等待多久
+    ShmReader child(cross_name);
+    pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        int status = 0;
+        try {
+            ShmFrame f;
+            int received = 0;
+            int overwritten = 0;
+            while (received + overwritten + child.dropped() < static_cast<uint64_t>(kFrames) && child.waitNext(f, 2000.0)) {
+                auto img = f.image();
+                const bool intact = img->width() == 1280 && img->row(719)[3 * 1279] == static_cast<uint8_t>(f.seq());
+                // 读的过程中槽位被覆盖是 seqlock 的正常结果，跳过该帧
+                if (!f.valid()) {
+                    ++overwritten;
+                    continue;
+                }
+                if (!intact) {
+                    status = 2;
+                    break;
+                }
+                ++received;
+            }
+            if (status == 0 && received + overwritten + child.dropped() != static_cast<uint64_t>(kFrames)) {
+                status = 3;
+            }
+        } catch (...) {
+            status = 4;
+        }
+        _exit(status);
+    }
+    ImageBufferPool pool;
+    for (int i = 0; i < kFrames; ++i) {
+        ImageFrame hd = ImageFrame::allocate(1280, 720, PixelFormat::RGB8, &pool);
+        for (int y = 0; y < hd.height(); ++y) {
+            std::memset(hd.row(y), i, hd.rowBytes(0));
+        }
+        cross_writer.publish(hd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    int status = -1;
+    waitpid(pid, &status, 0);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    std::cout << "共享内存传输测试通过！" << std::endl;
+}
+
 int main() {
     std::cout << "=== 适配器模式单元测试 ===" << std::endl;
     
     try {
         testLidarAdapter();
         testModernCamera();
+        testScanProjection();
+        testPointFilter();
+        testScanCodec();
+        testSpatialIndex();
+        testSensorMonitoring();
+        testStaticSensorManager();
+        testImageFrame();
+        testShmTransport();
+        testOccupancyGrid();
+        testScanDeskew();
         
         std::cout << "所有测试通过！" << std::endl;
         return 0;
@@ -0,0 +1,113 @@
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "registry.hpp"
+
+using namespace duan;
+
+namespace {
+
+class NullComponent : public Component {
+public:
+    void start() override {}
+    void spinOnce() override {}
+};
+
+// 全部线程共享的同一个组件，只测查找与调用的开销
+const std::shared_ptr<Component> kShared = std::make_shared<NullComponent>();
+
+/*
+以 threads 个线程轮流按名称查找 types，返回每次查找的平均纳秒数
+lookup 返回非空计为命中，防止被优化掉
+*/
+template <typename Lookup>
+double lookupNs(const std::vector<std::string>& types, size_t threads, int rounds, Lookup lookup) {
+    std::atomic<size_t> hits{0};
+    std::vector<std::thread> workers;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            size_t local = 0;
+            for (int r = 0; r < rounds; ++r) {
+                for (size_t i = 0; i < types.size(); ++i) {
+                    local += lookup(types[(i + t * 7) % types.size()]) ? 1 : 0;
+                }
+            }
+            hits.fetch_add(local);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    if (hits.load() != threads * rounds * types.size()) {
+        std::cerr << "查找结果不对" << std::endl;
+    }
+    return ns / static_cast<double>(rounds * types.size());
+}
+
+}
+
+int main() {
+    const size_t hw = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "=== 注册表查找基准 ===" << std::endl;
+    std::cout << "硬件线程数: " << hw << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+
+    const size_t kTypes = 256;
+    std::vector<std::string> types;
+    // 原实现: 加锁的 unordered_map（不加锁时与注册并发不安全）
+    std::unordered_map<std::string, ComponentRegistry::Creator> baseline;
+    std::mutex baseline_mutex;
+    for (size_t i = 0; i < kTypes; ++i) {
+        types.push_back("bench_component_" + std::to_string(i));
+        auto creator = [](const ConfigView&) { return kShared; };
+        ComponentRegistry::Register(types.back(), creator);
+        baseline.emplace(types.back(), creator);
+    }
+    const CompiledConfig compiled = CompiledConfig::compile(nlohmann::json::object());
+    const ConfigView cfg = compiled.root();
+    const int rounds = 4000;
+
+    for (size_t threads : std::set<size_t>{1, hw}) {
+        std::cout << "\n-- " << kTypes << " 个类型, " << threads << " 个线程 (ns/次) --" << std::endl;
+        const double locked = lookupNs(types, threads, rounds, [&](const std::string& type) {
+            std::lock_guard<std::mutex> lock(baseline_mutex);
+            return baseline.find(type) != baseline.end();
+        });
+        std::cout << "查找  加锁 unordered_map  " << std::setw(7) << locked << std::endl;
+        if (!ComponentRegistry::IsSealed()) {
+            const double snapshot = lookupNs(types, threads, rounds, [](const std::string& type) {
+                return ComponentRegistry::Find(type) != nullptr;
+            });
+            std::cout << "查找  快照 unordered_map  " << std::setw(7) << snapshot << std::endl;
+            ComponentRegistry::Seal();
+        }
+        const double sealed = lookupNs(types, threads, rounds, [](const std::string& type) {
+            return ComponentRegistry::Find(type) != nullptr;
+        });
+        std::cout << "查找  封存后完美哈希      " << std::setw(7) << sealed << std::endl;
+
+        const double create = lookupNs(types, threads, rounds, [&](const std::string& type) {
+            return ComponentRegistry::Create(type, cfg) != nullptr;
+        });
+        std::cout << "创建  按名称              " << std::setw(7) << create << std::endl;
+        std::vector<ComponentRegistry::Handle> handles;
+        for (const auto& type : types) {
+            handles.push_back(ComponentRegistry::Find(type));
+        }
+        // type 引用的就是 types 中的元素，据此取对应句柄
+        const double by_handle = lookupNs(types, threads, rounds, [&](const std::string& type) {
+            return ComponentRegistry::Create(handles[static_cast<size_t>(&type - types.data())], cfg) != nullptr;
+        });
+        std::cout << "创建  缓存句柄            " << std::setw(7) << by_handle << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,181 @@
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include "pipeline_executor.hpp"
+#include "registry.hpp"
+#include "thread_pool.hpp"
+#include "work_stealing_scheduler.hpp"
+
+using namespace duan;
+
+namespace {
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void busyWaitUs(int us) {
+    const auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(us);
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+// DAG 基准用组件: 每帧忙等 work_us 微秒，模拟耗时不等的各级处理
+class BenchStage : public Component {
+    int work_us_;
+public:
+    explicit BenchStage(const ConfigView& cfg) : work_us_(cfg.value("work_us", 10)) {}
+    void start() override {}
+    void spinOnce() override { busyWaitUs(work_us_); }
+};
+
+const bool registered = [] {
+    ComponentRegistry::Register("bench_stage", [](const ConfigView& cfg) { return std::make_shared<BenchStage>(cfg); });
+    return true;
+}();
+
+// 外部线程逐个提交空任务，测提交 + 执行的单任务开销
+double externalSpawnNs(TaskScheduler& scheduler, int tasks) {
+    std::atomic<int> done{0};
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < tasks; ++i) {
+        scheduler.schedule([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+    }
+    while (done.load(std::memory_order_acquire) < tasks) {
+        std::this_thread::yield();
+    }
+    return secondsSince(start) * 1e9 / tasks;
+}
+
+// 任务内递归派生二叉树，测工作线程内派生与窃取的开销
+double treeSpawnNs(TaskScheduler& scheduler, int depth) {
+    std::atomic<int> leaves{0};
+    std::function<void(int)> node = [&](int d) {
+        if (d == 0) {
+            leaves.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        scheduler.schedule([&node, d] { node(d - 1); });
+        scheduler.schedule([&node, d] { node(d - 1); });
+    };
+    const int expected = 1 << depth;
+    const auto start = std::chrono::steady_clock::now();
+    scheduler.schedule([&node, depth] { node(depth); });
+    while (leaves.load(std::memory_order_acquire) < expected) {
+        std::this_thread::yield();
+    }
+    return secondsSince(start) * 1e9 / (2 * expected - 1);
+}
+
+/*
+分层 DAG: 4 个源，3 层每层 8 个节点（各依赖上一层的两个节点），1 个汇
+节点耗时 2~40 微秒不等
+*/
+nlohmann::json benchDag() {
+    nlohmann::json config = {{"sensors", nlohmann::json::array()}, {"algorithms", nlohmann::json::array()}};
+    std::vector<std::string> previous;
+    for (int i = 0; i < 4; ++i) {
+        const std::string name = "src" + std::to_string(i);
+        config["sensors"].push_back({{"name", name}, {"type", "bench_stage"}, {"work_us", 5}});
+        previous.push_back(name);
+    }
+    for (int layer = 0; layer < 3; ++layer) {
+        std::vector<std::string> current;
+        for (int i = 0; i < 8; ++i) {
+            const std::string name = "l" + std::to_string(layer) + "_" + std::to_string(i);
+            const std::string a = previous[i % previous.size()];
+            const std::string b = previous[(i * 3 + 1) % previous.size()];
+            nlohmann::json inputs = a == b ? nlohmann::json::array({a}) : nlohmann::json::array({a, b});
+            config["algorithms"].push_back({{"name", name}, {"type", "bench_stage"}, {"input", inputs},
+                                            {"work_us", 2 + (i * 7 + layer * 5) % 39}});
+            current.push_back(name);
+        }
+        previous = current;
+    }
+    config["algorithms"].push_back({{"name", "sink"}, {"type", "bench_stage"}, {"input", previous}, {"work_us", 5}});
+    return config;
+}
+
+double dagFramesPerSecond(SchedulerKind kind, size_t threads, int frames) {
+    ExecutorOptions options;
+    options.threads = threads;
+    options.scheduler = kind;
+    PipelineExecutor executor(benchDag(), options);
+    executor.run(frames / 10); // 预热
+    const auto start = std::chrono::steady_clock::now();
+    executor.run(frames);
+    return frames / secondsSince(start);
+}
+
+/*
+4 条互相独立的线性链，每条 8 个节点（如 filter -> projection -> detector ...），每个节点 2 微秒
+链内每条边在逐节点调度时都要一次就绪计数与调度往返，合并后整条链是一个任务
+*/
+nlohmann::json benchChains() {
+    nlohmann::json config = {{"sensors", nlohmann::json::array()}, {"algorithms", nlohmann::json::array()}};
+    for (int c = 0; c < 4; ++c) {
+        std::string previous = "chain" + std::to_string(c) + "_0";
+        config["sensors"].push_back({{"name", previous}, {"type", "bench_stage"}, {"work_us", 2}});
+        for (int i = 1; i < 8; ++i) {
+            const std::string name = "chain" + std::to_string(c) + "_" + std::to_string(i);
+            config["algorithms"].push_back({{"name", name}, {"type", "bench_stage"}, {"input", {previous}}, {"work_us", 2}});
+            previous = name;
+        }
+    }
+    return config;
+}
+
+double chainFramesPerSecond(bool fuse, size_t threads, int frames) {
+    ExecutorOptions options;
+    options.threads = threads;
+    options.fuse_chains = fuse;
+    PipelineExecutor executor(benchChains(), options);
+    executor.run(frames / 10); // 预热
+    const auto start = std::chrono::steady_clock::now();
+    executor.run(frames);
+    return frames / secondsSince(start);
+}
+
+}
+
+int main() {
+    const size_t hw = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "=== 任务调度器基准: 工作窃取 vs 加锁共享队列 ===" << std::endl;
+    std::cout << "硬件线程数: " << hw << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+
+    for (size_t threads : std::set<size_t>{1, 2, hw}) {
+        ThreadPool pool(threads);
+        WorkStealingOptions ws_options;
+        ws_options.threads = threads;
+        WorkStealingScheduler stealing(ws_options);
+
+        std::cout << "\n-- " << threads << " 个工作线程 --" << std::endl;
+        std::cout << "外部提交 (ns/任务)     共享队列 " << std::setw(8) << externalSpawnNs(pool, 200000)
+                  << "   工作窃取 " << std::setw(8) << externalSpawnNs(stealing, 200000) << std::endl;
+        std::cout << "任务内派生 (ns/任务)   共享队列 " << std::setw(8) << treeSpawnNs(pool, 16)
+                  << "   工作窃取 " << std::setw(8) << treeSpawnNs(stealing, 16) << std::endl;
+        const auto stats = stealing.stats();
+        std::cout << "工作窃取统计: 执行 " << stats.executed << ", 窃取 " << stats.stolen
+                  << ", 注入 " << stats.injected << ", 休眠 " << stats.parks << std::endl;
+
+        const double fifo = dagFramesPerSecond(SchedulerKind::SharedQueue, threads, 2000);
+        const double ws = dagFramesPerSecond(SchedulerKind::WorkStealing, threads, 2000);
+        std::cout << "DAG 吞吐 (帧/秒, 29 节点)  共享队列 " << std::setw(8) << fifo
+                  << "   工作窃取 " << std::setw(8) << ws << "   (" << std::setprecision(2) << ws / fifo << "x)"
+                  << std::setprecision(1) << std::endl;
+
+        const double per_node = chainFramesPerSecond(false, threads, 4000);
+        const double fused = chainFramesPerSecond(true, threads, 4000);
+        std::cout << "线性链吞吐 (帧/秒, 4x8 节点) 逐节点 " << std::setw(8) << per_node << "   合并 " << std::setw(8)
+                  << fused << "   (" << std::setprecision(2) << fused / per_node << "x)" << std::setprecision(1)
+                  << std::endl;
+    }
+    return 0;
+}
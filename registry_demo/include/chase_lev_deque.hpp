@@ -0,0 +1,124 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace duan {
+
+/*
+Chase-Lev 工作窃取双端队列（Lê 等人的 C11 内存模型版本）
+所有者线程在底部 push/pop（LIFO，缓存热），其他线程从顶部 steal（FIFO）
+只有队列剩最后一个元素时所有者和窃取者才会竞争同一个 CAS
+容量不足时扩容为两倍；旧数组可能仍被窃取者读取，保留到析构时释放
+T 必须可平凡复制，通常是指针
+*/
+template <typename T>
+class ChaseLevDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "ChaseLevDeque 只存放可平凡复制的类型");
+
+    struct Array {
+        int64_t capacity;
+        int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+
+        explicit Array(int64_t cap) : capacity(cap), mask(cap - 1), slots(new std::atomic<T>[static_cast<size_t>(cap)]) {}
+        T get(int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, T value) { slots[i & mask].store(value, std::memory_order_relaxed); }
+    };
+
+public:
+    // capacity 会向上取整为2的幂
+    explicit ChaseLevDeque(size_t capacity = 256) {
+        int64_t cap = 2;
+        while (cap < static_cast<int64_t>(capacity)) {
+            cap <<= 1;
+        }
+        arrays_.emplace_back(new Array(cap));
+        array_.store(arrays_.back().get(), std::memory_order_relaxed);
+    }
+
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    // 仅所有者线程调用
+    void push(T value) {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_acquire);
+        Array* a = array_.load(std::memory_order_relaxed);
+        if (b - t > a->capacity - 1) {
+            a = grow(a, t, b);
+        }
+        a->put(b, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // 仅所有者线程调用，取最近 push 的元素
+    bool pop(T& out) {
+        const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Array* a = array_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed); // 已空
+            return false;
+        }
+        out = a->get(b);
+        if (t == b) {
+            // 最后一个元素，与窃取者竞争
+            const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // 任意线程调用，取最早 push 的元素；与其他线程竞争失败时返回false
+    bool steal(T& out) {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) {
+            return false;
+        }
+        Array* a = array_.load(std::memory_order_acquire);
+        T value = a->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        out = value;
+        return true;
+    }
+
+    size_t sizeApprox() const {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+    bool empty() const { return sizeApprox() == 0; }
+    size_t capacity() const { return static_cast<size_t>(array_.load(std::memory_order_relaxed)->capacity); }
+
+private:
+    Array* grow(Array* old, int64_t t, int64_t b) {
+        auto bigger = std::make_unique<Array>(old->capacity * 2);
+        for (int64_t i = t; i < b; ++i) {
+            bigger->put(i, old->get(i));
+        }
+        Array* raw = bigger.get();
+        arrays_.push_back(std::move(bigger));
+        array_.store(raw, std::memory_order_release);
+        return raw;
+    }
+
+    // top_ 与 bottom_ 分属窃取者和所有者，放在不同缓存行
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    alignas(64) std::atomic<Array*> array_{nullptr};
+    std::vector<std::unique_ptr<Array>> arrays_; // 仅所有者线程修改
+};
+
+}
@@ -1,14 +1,88 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 #include <nlohmann/json.hpp>
+#include "message.hpp"
 
 namespace duan{
 
+class ComponentPorts;
+
+// 一次处理调用对应的帧信息
+struct FrameContext {
+    uint64_t frame = 0;        // 调用方的帧号（执行器帧号，或独立运行时的调用次数）
+    size_t batch_index = 0;    // 在本批中的位置
+    size_t batch_size = 1;
+};
+
+// 一帧的输入: 每个输入话题一条消息，顺序与配置中的 "input" 一致
+class Inputs {
+public:
+    Inputs() = default;
+    Inputs(std::vector<MessagePtr> messages, std::vector<bool> updated)
+        : messages_(std::move(messages)), updated_(std::move(updated)) {}
+
+    size_t size() const { return messages_.size(); }
+    // 第 i 个输入的消息，该输入尚未收到过消息时为nullptr
+    const MessagePtr& operator[](size_t i) const { return messages_[i]; }
+    // 第 i 个输入在本帧是否有新消息（否则沿用上一条）
+    bool updated(size_t i) const { return updated_[i]; }
+
+    // 第一条指定类型的输入消息，没有时返回nullptr
+    template <typename T>
+    std::shared_ptr<const T> get() const { return findMessage<T>(messages_); }
+
+private:
+    std::vector<MessagePtr> messages_;
+    std::vector<bool> updated_;
+};
+
+// 一帧的输出，处理结束后由调用方发布到组件的输出话题
+class Outputs {
+public:
+    void publish(MessagePtr msg) { messages_.push_back(std::move(msg)); }
+    const std::vector<MessagePtr>& messages() const { return messages_; }
+    size_t size() const { return messages_.size(); }
+    void clear() { messages_.clear(); }
+
+private:
+    std::vector<MessagePtr> messages_;
+};
+
 // 所有传感器/算法模块的父类接口
 struct Component{
     virtual void start() = 0; // 启动组件
+    virtual void spinOnce() {} // 独立运行时处理一次数据：传感器发布一帧，算法消费输入并发布结果
+
+    // 处理一帧：从 in 读取输入，把结果放入 out；传感器的 in 为空
+    virtual void process(const FrameContext& ctx, const Inputs& in, Outputs& out) {
+        (void)ctx;
+        (void)in;
+        (void)out;
+    }
+
+    // 一次处理多帧，三个数组等长；默认逐帧调用 process，重载后可以摊薄每次调用的固定开销
+    virtual void processBatch(const std::vector<FrameContext>& ctx, const std::vector<Inputs>& in,
+                              std::vector<Outputs>& out) {
+        for (size_t i = 0; i < ctx.size(); ++i) {
+            process(ctx[i], in[i], out[i]);
+        }
+    }
+
+    // 单次 processBatch 最多接受的帧数，1 表示不做批处理
+    virtual size_t maxBatchSize() const { return 1; }
+
+    // 组件在话题总线上的输入输出端口，执行器通过它取输入、发布输出；自行收发的组件返回nullptr
+    virtual ComponentPorts* ports() { return nullptr; }
+
+    // 是否允许执行器把它与上下游合并为一个任务；需要独占线程或自己控制执行时机的组件返回 false
+    // 也可以在配置中用 "fuse": false 关闭
+    virtual bool fusible() const { return true; }
+
     virtual ~Component() = default; // 虚析构函数
 };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,171 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace duan {
+
+namespace config_binary {
+
+constexpr char kMagic[8] = {'D', 'U', 'A', 'N', 'C', 'F', 'G', '1'};
+constexpr uint32_t kFormatVersion = 1;
+
+enum class Type : uint8_t { Null, Boolean, Integer, Unsigned, Float, String, Array, Object };
+
+/*
+编译后配置的布局，全部偏移相对缓冲区起点，可直接 mmap 使用:
+  Header | Node[node_count] | Key[node_count] | 字符串池
+数组/对象的子节点在 Node 表中连续存放；对象成员的键放在 Key 表的同一下标，按键名排序
+*/
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t node_count;
+    uint64_t source_hash;   // 源 JSON 文本的 FNV-1a 64 位哈希
+    uint64_t source_size;
+    uint64_t nodes_offset;
+    uint64_t keys_offset;
+    uint64_t strings_offset;
+    uint64_t total_size;
+};
+
+struct Node {
+    Type type;
+    uint8_t reserved[3];
+    uint32_t count;         // 字符串长度 / 子节点数
+    uint64_t payload;       // 标量值的位模式 / 字符串偏移 / 首个子节点下标
+};
+
+struct Key {
+    uint32_t offset;
+    uint32_t length;
+};
+
+static_assert(sizeof(Node) == 16 && sizeof(Key) == 8, "binary config layout");
+
+}
+
+uint64_t fnv1a64(const void* data, size_t size);
+
+/*
+编译后配置中一个值的只读视图，不分配内存，读取接口与 nlohmann::json 的常用子集一致
+视图只在所属 CompiledConfig 存活期间有效
+*/
+class ConfigView {
+public:
+    using Type = config_binary::Type;
+
+    ConfigView() = default;
+
+    Type type() const { return node_ ? node_->type : Type::Null; }
+    bool isNull() const { return type() == Type::Null; }
+    bool isObject() const { return type() == Type::Object; }
+    bool isArray() const { return type() == Type::Array; }
+    bool isString() const { return type() == Type::String; }
+    bool isNumber() const { return type() == Type::Integer || type() == Type::Unsigned || type() == Type::Float; }
+
+    // 数组/对象的元素数，标量为0
+    size_t size() const;
+    // 数组/对象的第 i 个元素
+    ConfigView operator[](size_t index) const;
+    // 对象第 i 个成员的键
+    std::string_view key(size_t index) const;
+
+    bool contains(std::string_view key) const;
+    // 键不存在或不是对象时抛出 std::out_of_range
+    ConfigView at(std::string_view key) const;
+
+    // 类型不符时抛出 std::invalid_argument
+    bool asBool() const;
+    int64_t asInt() const;
+    uint64_t asUnsigned() const;
+    double asDouble() const;
+    std::string_view asString() const;
+
+    int64_t value(std::string_view key, int64_t fallback) const;
+    double value(std::string_view key, double fallback) const;
+    bool value(std::string_view key, bool fallback) const;
+    std::string_view value(std::string_view key, std::string_view fallback) const;
+    int value(std::string_view key, int fallback) const { return static_cast<int>(value(key, static_cast<int64_t>(fallback))); }
+    std::string_view value(std::string_view key, const char* fallback) const { return value(key, std::string_view(fallback)); }
+
+    // 结构与取值都相同，数值按值比较（与 nlohmann::json 的 == 一致），可以跨两份编译结果比较
+    bool operator==(const ConfigView& other) const;
+    bool operator!=(const ConfigView& other) const { return !(*this == other); }
+
+    // 还原为 nlohmann::json，只在仍需要 DOM 的接口处使用
+    nlohmann::json toJson() const;
+
+private:
+    friend class CompiledConfig;
+    ConfigView(const uint8_t* base, const config_binary::Node* node) : base_(base), node_(node) {}
+
+    const config_binary::Header& header() const { return *reinterpret_cast<const config_binary::Header*>(base_); }
+    const config_binary::Node* nodes() const;
+    const config_binary::Key* keys() const;
+    std::string_view text(uint64_t offset, uint32_t length) const;
+    // 对象中按键二分查找，找不到返回 nullptr
+    const config_binary::Node* find(std::string_view key) const;
+
+    const uint8_t* base_ = nullptr;
+    const config_binary::Node* node_ = nullptr;
+};
+
+/*
+编译后的配置: 来自 mmap 的缓存文件，或刚编译好的内存缓冲区
+*/
+class CompiledConfig {
+public:
+    CompiledConfig() = default;
+    ~CompiledConfig();
+    CompiledConfig(CompiledConfig&& other) noexcept;
+    CompiledConfig& operator=(CompiledConfig&& other) noexcept;
+    CompiledConfig(const CompiledConfig&) = delete;
+    CompiledConfig& operator=(const CompiledConfig&) = delete;
+
+    // 把 JSON 编码为二进制格式，source_hash 记录源文本哈希
+    static CompiledConfig compile(const nlohmann::json& config, uint64_t source_hash = 0, uint64_t source_size = 0);
+    // 映射缓存文件并检查头部与各段边界，文件无效时返回空对象
+    static CompiledConfig map(const std::string& path);
+
+    bool valid() const { return data_ != nullptr; }
+    bool mapped() const { return mapping_ != nullptr; }
+    uint64_t sourceHash() const;
+    uint64_t sourceSize() const;
+    size_t byteSize() const { return size_; }
+    ConfigView root() const;
+
+    // 原子地写入文件（先写临时文件再改名）
+    void save(const std::string& path) const;
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    void* mapping_ = nullptr;           // mmap 的区域
+    std::vector<uint8_t> buffer_;       // 或者自有缓冲区
+};
+
+struct ConfigLoadOptions {
+    std::string cache_path;     // 为空时使用 "<json>.bin"
+    bool write_cache = true;    // 缓存失效时重新编译并写回
+};
+
+/*
+加载流水线配置
+缓存文件存在且记录的源文本哈希与当前 JSON 一致时直接 mmap 使用，不解析 JSON；
+否则解析 JSON、解析话题并校验依赖图（与启动时相同的检查），编译后写回缓存
+缓存中保存的是解析过话题的配置，命中时可以跳过 resolvePipelineTopics
+JSON 无法读取或校验失败时抛出 std::runtime_error
+*/
+class ConfigCache {
+public:
+    static CompiledConfig load(const std::string& json_path, const ConfigLoadOptions& options = ConfigLoadOptions());
+    // 由源文本编译，解析与校验同上
+    static CompiledConfig compileText(const std::string& json_text);
+};
+
+}
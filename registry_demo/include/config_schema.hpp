@@ -0,0 +1,467 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "config_cache.hpp"
+
+namespace duan {
+
+/*
+组件配置结构体的字段描述，由 DUAN_CONFIG_SCHEMA 生成
+member 为成员指针，决定字段的类型；required 的字段缺失时解码失败，其余字段缺失时保留结构体中的默认值
+*/
+template <typename T>
+struct FieldDescriptor {
+    using Member = std::variant<bool T::*, int T::*, unsigned T::*, int64_t T::*, uint64_t T::*, float T::*,
+                                double T::*, std::string T::*, std::vector<std::string> T::*>;
+    const char* name;
+    Member member;
+    bool required;
+};
+
+// 由 DUAN_CONFIG_SCHEMA 特化，提供 fields()
+template <typename T>
+struct ConfigSchema;
+
+template <typename T, typename = void>
+struct HasConfigSchema : std::false_type {};
+template <typename T>
+struct HasConfigSchema<T, std::void_t<decltype(ConfigSchema<T>::fields())>> : std::true_type {};
+
+// 成员可以来自基类，例如各组件配置共用的 PortConfig
+template <typename T, typename M, typename C>
+FieldDescriptor<T> makeField(const char* name, M C::*member, bool required) {
+    static_assert(std::is_base_of<C, T>::value, "字段必须是配置结构体或其基类的成员");
+    return FieldDescriptor<T>{name, static_cast<M T::*>(member), required};
+}
+
+// 把基类的字段描述转换为派生类的
+template <typename T, typename Base>
+std::vector<FieldDescriptor<T>> inheritFields() {
+    std::vector<FieldDescriptor<T>> fields;
+    for (const auto& field : ConfigSchema<Base>::fields()) {
+        std::visit([&](auto member) { fields.push_back(makeField<T>(field.name, member, field.required)); }, field.member);
+    }
+    return fields;
+}
+
+// 一个标量事件
+struct ConfigScalar {
+    enum class Kind { Null, Boolean, Integer, Unsigned, Float, String };
+    Kind kind = Kind::Null;
+    bool boolean = false;
+    int64_t integer = 0;
+    uint64_t unsigned_integer = 0;
+    double number = 0.0;
+    std::string_view text;
+};
+
+namespace config_detail {
+
+inline const char* kindName(ConfigScalar::Kind kind) {
+    switch (kind) {
+    case ConfigScalar::Kind::Null: return "null";
+    case ConfigScalar::Kind::Boolean: return "boolean";
+    case ConfigScalar::Kind::Integer: case ConfigScalar::Kind::Unsigned: return "integer";
+    case ConfigScalar::Kind::Float: return "number";
+    case ConfigScalar::Kind::String: return "string";
+    }
+    return "unknown";
+}
+
+[[noreturn]] inline void typeError(const char* field, const char* expected, const char* actual) {
+    throw std::invalid_argument(std::string("字段 ") + field + " 需要 " + expected + "，实际为 " + actual);
+}
+
+inline void assign(bool& out, const ConfigScalar& v, const char* field) {
+    if (v.kind != ConfigScalar::Kind::Boolean) {
+        typeError(field, "boolean", kindName(v.kind));
+    }
+    out = v.boolean;
+}
+
+template <typename I>
+std::enable_if_t<std::is_integral<I>::value> assign(I& out, const ConfigScalar& v, const char* field) {
+    if (v.kind == ConfigScalar::Kind::Integer) {
+        if (v.integer < static_cast<int64_t>(std::numeric_limits<I>::min()) ||
+            (v.integer > 0 && static_cast<uint64_t>(v.integer) > static_cast<uint64_t>(std::numeric_limits<I>::max()))) {
+            throw std::invalid_argument(std::string("字段 ") + field + " 超出范围: " + std::to_string(v.integer));
+        }
+        out = static_cast<I>(v.integer);
+    } else if (v.kind == ConfigScalar::Kind::Unsigned) {
+        if (v.unsigned_integer > static_cast<uint64_t>(std::numeric_limits<I>::max())) {
+            throw std::invalid_argument(std::string("字段 ") + field + " 超出范围: " + std::to_string(v.unsigned_integer));
+        }
+        out = static_cast<I>(v.unsigned_integer);
+    } else {
+        typeError(field, "integer", kindName(v.kind));
+    }
+}
+
+template <typename F>
+std::enable_if_t<std::is_floating_point<F>::value> assign(F& out, const ConfigScalar& v, const char* field) {
+    switch (v.kind) {
+    case ConfigScalar::Kind::Integer: out = static_cast<F>(v.integer); break;
+    case ConfigScalar::Kind::Unsigned: out = static_cast<F>(v.unsigned_integer); break;
+    case ConfigScalar::Kind::Float: out = static_cast<F>(v.number); break;
+    default: typeError(field, "number", kindName(v.kind));
+    }
+}
+
+inline void assign(std::string& out, const ConfigScalar& v, const char* field) {
+    if (v.kind != ConfigScalar::Kind::String) {
+        typeError(field, "string", kindName(v.kind));
+    }
+    out.assign(v.text.data(), v.text.size());
+}
+
+inline void assign(std::vector<std::string>&, const ConfigScalar& v, const char* field) {
+    typeError(field, "array", kindName(v.kind));
+}
+
+}
+
+/*
+按字段描述把一个 JSON 对象的事件流解码进结构体，事件可以来自
+SAX 解析（decodeConfigText）、已有的 DOM（decodeConfig(json)）或二进制配置（decodeConfig(ConfigView)）
+未声明的字段跳过（同一对象里还有框架读取的字段），类型不符或缺少必填字段时抛出 std::invalid_argument
+*/
+template <typename T>
+class ConfigDecoder {
+public:
+    explicit ConfigDecoder(T& out) : out_(out), seen_(ConfigSchema<T>::fields().size(), false) {}
+
+    void key(std::string_view name) {
+        if (depth_ != 1 || skip_ > 0) {
+            return;
+        }
+        const auto& fields = ConfigSchema<T>::fields();
+        current_ = kNone;
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (name == fields[i].name) {
+                current_ = i;
+                break;
+            }
+        }
+    }
+
+    void scalar(const ConfigScalar& value) {
+        if (skip_ > 0) {
+            return;
+        }
+        if (depth_ == 0) {
+            throw std::invalid_argument("组件配置必须是对象");
+        }
+        if (current_ == kNone) {
+            return;
+        }
+        const auto& field = fieldFor();
+        if (in_list_) {
+            if (value.kind != ConfigScalar::Kind::String) {
+                config_detail::typeError(field.name, "string 数组", config_detail::kindName(value.kind));
+            }
+            auto& list = out_.*std::get<std::vector<std::string> T::*>(field.member);
+            list.emplace_back(value.text);
+            return;
+        }
+        std::visit([&](auto member) { config_detail::assign(out_.*member, value, field.name); }, field.member);
+        seen_[current_] = true;
+    }
+
+    void beginObject() {
+        if (depth_ == 0) {
+            depth_ = 1;
+        } else if (skip_ > 0 || current_ == kNone) {
+            ++skip_;
+        } else {
+            config_detail::typeError(fieldFor().name, expectedName(), "object");
+        }
+    }
+
+    void endObject() {
+        if (skip_ > 0) {
+            --skip_;
+        } else {
+            depth_ = 0;
+            finish();
+        }
+    }
+
+    void beginArray() {
+        if (depth_ == 0) {
+            throw std::invalid_argument("组件配置必须是对象");
+        }
+        if (skip_ > 0 || current_ == kNone) {
+            ++skip_;
+            return;
+        }
+        const auto& field = fieldFor();
+        auto list = std::get_if<std::vector<std::string> T::*>(&field.member);
+        if (in_list_ || !list) {
+            config_detail::typeError(field.name, expectedName(), "array");
+        }
+        (out_.**list).clear();
+        in_list_ = true;
+    }
+
+    void endArray() {
+        if (skip_ > 0) {
+            --skip_;
+            return;
+        }
+        in_list_ = false;
+        seen_[current_] = true;
+    }
+
+private:
+    static constexpr size_t kNone = static_cast<size_t>(-1);
+
+    const FieldDescriptor<T>& fieldFor() const { return ConfigSchema<T>::fields()[current_]; }
+
+    const char* expectedName() const {
+        switch (fieldFor().member.index()) {
+        case 0: return "boolean";
+        case 1: case 2: case 3: case 4: return "integer";
+        case 5: case 6: return "number";
+        case 7: return "string";
+        default: return "string 数组";
+        }
+    }
+
+    void finish() const {
+        const auto& fields = ConfigSchema<T>::fields();
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (fields[i].required && !seen_[i]) {
+                throw std::invalid_argument(std::string("缺少必填字段 ") + fields[i].name);
+            }
+        }
+    }
+
+    T& out_;
+    std::vector<bool> seen_;
+    size_t current_ = kNone;
+    size_t depth_ = 0;      // 0: 还没进入对象；1: 在组件配置对象内
+    size_t skip_ = 0;       // 正在跳过的嵌套层数
+    bool in_list_ = false;
+};
+
+namespace config_detail {
+
+template <typename Sink>
+void walk(const nlohmann::json& value, Sink& sink) {
+    ConfigScalar scalar;
+    switch (value.type()) {
+    case nlohmann::json::value_t::object:
+        sink.beginObject();
+        for (auto it = value.begin(); it != value.end(); ++it) {
+            sink.key(it.key());
+            walk(*it, sink);
+        }
+        sink.endObject();
+        return;
+    case nlohmann::json::value_t::array:
+        sink.beginArray();
+        for (const auto& item : value) {
+            walk(item, sink);
+        }
+        sink.endArray();
+        return;
+    case nlohmann::json::value_t::boolean:
+        scalar.kind = ConfigScalar::Kind::Boolean;
+        scalar.boolean = value.get<bool>();
+        break;
+    case nlohmann::json::value_t::number_integer:
+        scalar.kind = ConfigScalar::Kind::Integer;
+        scalar.integer = value.get<int64_t>();
+        break;
+    case nlohmann::json::value_t::number_unsigned:
+        scalar.kind = ConfigScalar::Kind::Unsigned;
+        scalar.unsigned_integer = value.get<uint64_t>();
+        break;
+    case nlohmann::json::value_t::number_float:
+        scalar.kind = ConfigScalar::Kind::Float;
+        scalar.number = value.get<double>();
+        break;
+    case nlohmann::json::value_t::string:
+        scalar.kind = ConfigScalar::Kind::String;
+        scalar.text = value.get_ref<const std::string&>();
+        break;
+    default:
+        break;
+    }
+    sink.scalar(scalar);
+}
+
+template <typename Sink>
+void walk(const ConfigView& value, Sink& sink) {
+    ConfigScalar scalar;
+    switch (value.type()) {
+    case ConfigView::Type::Object:
+        sink.beginObject();
+        for (size_t i = 0; i < value.size(); ++i) {
+            sink.key(value.key(i));
+            walk(value[i], sink);
+        }
+        sink.endObject();
+        return;
+    case ConfigView::Type::Array:
+        sink.beginArray();
+        for (size_t i = 0; i < value.size(); ++i) {
+            walk(value[i], sink);
+        }
+        sink.endArray();
+        return;
+    case ConfigView::Type::Boolean:
+        scalar.kind = ConfigScalar::Kind::Boolean;
+        scalar.boolean = value.asBool();
+        break;
+    case ConfigView::Type::Integer:
+        scalar.kind = ConfigScalar::Kind::Integer;
+        scalar.integer = value.asInt();
+        break;
+    case ConfigView::Type::Unsigned:
+        scalar.kind = ConfigScalar::Kind::Unsigned;
+        scalar.unsigned_integer = value.asUnsigned();
+        break;
+    case ConfigView::Type::Float:
+        scalar.kind = ConfigScalar::Kind::Float;
+        scalar.number = value.asDouble();
+        break;
+    case ConfigView::Type::String:
+        scalar.kind = ConfigScalar::Kind::String;
+        scalar.text = value.asString();
+        break;
+    case ConfigView::Type::Null:
+        break;
+    }
+    sink.scalar(scalar);
+}
+
+// nlohmann::json 的 SAX 接口转发给解码器，不构建 DOM
+template <typename Sink>
+class SaxAdapter {
+public:
+    explicit SaxAdapter(Sink& sink) : sink_(sink) {}
+
+    bool null() { return emit(ConfigScalar{}); }
+    bool boolean(bool value) {
+        ConfigScalar scalar;
+        scalar.kind = ConfigScalar::Kind::Boolean;
+        scalar.boolean = value;
+        return emit(scalar);
+    }
+    bool number_integer(nlohmann::json::number_integer_t value) {
+        ConfigScalar scalar;
+        scalar.kind = ConfigScalar::Kind::Integer;
+        scalar.integer = value;
+        return emit(scalar);
+    }
+    bool number_unsigned(nlohmann::json::number_unsigned_t value) {
+        ConfigScalar scalar;
+        scalar.kind = ConfigScalar::Kind::Unsigned;
+        scalar.unsigned_integer = value;
+        return emit(scalar);
+    }
+    bool number_float(nlohmann::json::number_float_t value, const std::string&) {
+        ConfigScalar scalar;
+        scalar.kind = ConfigScalar::Kind::Float;
+        scalar.number = value;
+        return emit(scalar);
+    }
+    bool string(std::string& value) {
+        ConfigScalar scalar;
+        scalar.kind = ConfigScalar::Kind::String;
+        scalar.text = value;
+        return emit(scalar);
+    }
+    bool binary(nlohmann::json::binary_t&) { return emit(ConfigScalar{}); }
+    bool start_object(std::size_t) { sink_.beginObject(); return true; }
+    bool key(std::string& name) { sink_.key(name); return true; }
+    bool end_object() { sink_.endObject(); return true; }
+    bool start_array(std::size_t) { sink_.beginArray(); return true; }
+    bool end_array() { sink_.endArray(); return true; }
+    bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& e) {
+        throw std::invalid_argument("配置 JSON 解析失败 (位置 " + std::to_string(position) + "): " + e.what());
+    }
+
+private:
+    bool emit(const ConfigScalar& scalar) {
+        sink_.scalar(scalar);
+        return true;
+    }
+    Sink& sink_;
+};
+
+}
+
+// 从 DOM 解码，用于兼容仍以 nlohmann::json 传递配置的接口
+template <typename T>
+T decodeConfig(const nlohmann::json& cfg) {
+    T out{};
+    ConfigDecoder<T> decoder(out);
+    config_detail::walk(cfg, decoder);
+    return out;
+}
+
+// 直接从编译后的二进制配置解码，不经过 DOM
+template <typename T>
+T decodeConfig(const ConfigView& cfg) {
+    T out{};
+    ConfigDecoder<T> decoder(out);
+    config_detail::walk(cfg, decoder);
+    return out;
+}
+
+// 一遍 SAX 解析 JSON 文本直接写入结构体，不构建 DOM
+template <typename T>
+T decodeConfigText(std::string_view text) {
+    T out{};
+    ConfigDecoder<T> decoder(out);
+    config_detail::SaxAdapter<ConfigDecoder<T>> adapter(decoder);
+    nlohmann::json::sax_parse(text, &adapter);
+    return out;
+}
+
+}
+
+/*
+为配置结构体声明字段:
+  DUAN_CONFIG_SCHEMA(LidarConfig, DUAN_REQUIRED(topic), DUAN_FIELD(rings), DUAN_FIELD(beams))
+DUAN_CONFIG_SCHEMA_EXTENDS 额外带上基类已声明的字段
+需在全局命名空间中使用（特化带 duan:: 限定）
+*/
+#define DUAN_FIELD(member) ::duan::makeField<Self>(#member, &Self::member, false)
+#define DUAN_REQUIRED(member) ::duan::makeField<Self>(#member, &Self::member, true)
+
+#define DUAN_CONFIG_SCHEMA(Type, ...)                                                \
+    template <>                                                                      \
+    struct duan::ConfigSchema<Type> {                                                \
+        using Self = Type;                                                           \
+        static const std::vector<::duan::FieldDescriptor<Self>>& fields() {          \
+            static const std::vector<::duan::FieldDescriptor<Self>> list{__VA_ARGS__}; \
+            return list;                                                             \
+        }                                                                            \
+    };
+
+#define DUAN_CONFIG_SCHEMA_EXTENDS(Type, Base, ...)                                  \
+    template <>                                                                      \
+    struct duan::ConfigSchema<Type> {                                                \
+        using Self = Type;                                                           \
+        static const std::vector<::duan::FieldDescriptor<Self>>& fields() {          \
+            static const std::vector<::duan::FieldDescriptor<Self>> list = [] {      \
+                auto fields = ::duan::inheritFields<Self, Base>();                   \
+                for (auto& field : std::vector<::duan::FieldDescriptor<Self>>{__VA_ARGS__}) { \
+                    fields.push_back(field);                                         \
+                }                                                                    \
+                return fields;                                                       \
+            }();                                                                     \
+            return list;                                                             \
+        }                                                                            \
+    };
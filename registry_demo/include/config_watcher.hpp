@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace duan {
+
+/*
+轮询配置文件是否被修改
+先比较修改时间与大小，变了再读文件比较内容哈希，只 touch 或写回相同内容不算修改
+文件暂时不可读（如编辑器正在替换）时视为未修改，下次轮询再看
+*/
+class ConfigWatcher {
+public:
+    // 记录文件当前的状态，之后的 poll 与它比较
+    explicit ConfigWatcher(std::string path);
+
+    // 内容与上次记录的不同时返回 true 并记下新状态
+    bool poll();
+
+    const std::string& path() const { return path_; }
+    uint64_t contentHash() const { return hash_; }
+
+private:
+    bool stat(int64_t& mtime_ns, uint64_t& size) const;
+
+    std::string path_;
+    int64_t mtime_ns_ = -1;
+    uint64_t size_ = 0;
+    uint64_t hash_ = 0;
+};
+
+}
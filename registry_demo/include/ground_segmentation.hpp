@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "lidar_frame.hpp"
+#include "thread_pool.hpp"
+
+namespace duan {
+
+// 地面分割与障碍物聚类参数
+struct SegmentationConfig {
+    float sensor_height = 1.8f;       // 雷达离地高度 (米)
+    int sectors = 32;                 // 方位角扇区数，也是并行的任务数
+    float bin_size = 1.0f;            // 扇区内按水平距离分桶的步长 (米)
+    float max_range = 120.0f;         // 参与地面拟合的最大水平距离 (米)
+    float ground_threshold = 0.2f;    // 离地面拟合线小于该高度视为地面点 (米)
+    float max_ground_offset = 0.5f;   // 桶内最低点高于理想地面该值时不参与拟合 (米)
+    float max_slope = 0.15f;          // 地面线最大坡度
+    float cluster_tolerance = 0.6f;   // 距离图像上相邻点连通的距离阈值 (米)
+    uint32_t min_cluster_points = 5;  // 点数少于该值的簇被丢弃
+};
+
+enum PointLabel : uint8_t {
+    kLabelInvalid = 0,  // 无回波
+    kLabelGround = 1,
+    kLabelObstacle = 2,
+};
+
+// 障碍物的轴对齐包围盒
+struct ObstacleBox {
+    float min_x, min_y, min_z;
+    float max_x, max_y, max_z;
+    uint32_t num_points;
+};
+
+// 分割结果，各数组与输入帧的距离图像一一对应
+struct SegmentationResult {
+    std::vector<float> x, y, z;
+    std::vector<uint8_t> labels;
+    std::vector<int32_t> cluster_ids;   // 所属障碍物下标，-1 表示不属于任何障碍物
+    std::vector<ObstacleBox> obstacles;
+    size_t ground_points = 0;
+};
+
+/*
+地面分割 + 障碍物聚类
+1. 按方位角把距离图像切成若干扇区，每个扇区内按水平距离分桶取最低点，最小二乘拟合一条地面线
+2. 非地面点在距离图像上做连通域（上下、左右相邻且三维距离小于阈值即连通），并查集实现
+3. 扇区之间相互独立，在线程池上并行；扇区边界的连通关系最后串行合并
+*/
+class GroundObstacleSegmenter {
+public:
+    // pool 为空时串行处理
+    explicit GroundObstacleSegmenter(const SegmentationConfig& config = SegmentationConfig(), ThreadPool* pool = nullptr);
+
+    void process(const LidarFrame& frame, SegmentationResult& out);
+
+    const SegmentationConfig& config() const { return config_; }
+
+private:
+    void updateTables(const LidarFrame& frame);
+    void processSector(const LidarFrame& frame, int begin_col, int end_col, SegmentationResult& out);
+    int32_t find(int32_t i);
+    void unite(int32_t a, int32_t b);
+    bool close(const SegmentationResult& out, int32_t a, int32_t b) const;
+
+    SegmentationConfig config_;
+    ThreadPool* pool_;
+
+    // 三角函数表，几何参数不变时复用
+    int table_rings_ = 0;
+    int table_beams_ = 0;
+    float table_az_start_ = 0.0f;
+    float table_az_step_ = 0.0f;
+    std::vector<float> table_elevations_;
+    std::vector<float> cos_az_, sin_az_, cos_el_, sin_el_;
+
+    // 每帧复用的缓冲区
+    std::vector<int32_t> parent_;
+    std::vector<int32_t> root_cluster_;
+};
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "message.hpp"
+
+namespace duan {
+
+// 一帧激光雷达距离图像（ring 主序: ranges[ring * beams + beam]，0 表示无回波）
+struct LidarFrame : Message {
+    std::string frame_id = "lidar";
+    int rings = 0;
+    int beams = 0;
+    float azimuth_start_deg = 0.0f;
+    float azimuth_step_deg = 0.0f;
+    std::vector<float> elevations_deg;     // 每条ring的俯仰角
+    std::vector<float> ranges;
+
+    size_t size() const { return ranges.size(); }
+};
+
+/*
+生成一帧模拟的多线雷达数据
+场景为高度 -sensor_height 的地面加上若干长方体障碍物，距离叠加少量噪声
+*/
+LidarFrame simulateLidarFrame(int rings, int beams, uint64_t seq, float sensor_height = 1.8f);
+
+}
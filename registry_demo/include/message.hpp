@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace duan {
+
+// 总线上传递的所有消息的基类，发布后不可修改，多个订阅者共享同一份
+struct Message {
+    uint64_t seq = 0;        // 帧序号
+    double timestamp = 0.0;  // 数据时间戳（秒）
+    virtual ~Message() = default;
+};
+
+using MessagePtr = std::shared_ptr<const Message>;
+
+// 在一组消息中找到第一条指定类型的消息
+template <typename T>
+std::shared_ptr<const T> findMessage(const std::vector<MessagePtr>& messages) {
+    for (const auto& msg : messages) {
+        if (auto typed = std::dynamic_pointer_cast<const T>(msg)) {
+            return typed;
+        }
+    }
+    return nullptr;
+}
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "message.hpp"
+#include "lidar_frame.hpp"
+#include "ground_segmentation.hpp"
+
+namespace duan {
+
+// 相机图像，RGB8 交错存储
+struct CameraImage : Message {
+    std::string frame_id = "camera";
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> data;
+};
+
+// GNSS 定位结果
+struct GnssFix : Message {
+    double latitude = 0.0;    // 度
+    double longitude = 0.0;   // 度
+    double altitude = 0.0;    // 米
+    int satellites = 0;
+};
+
+struct Detection {
+    float x, y, width, height;   // 像素坐标下的包围框
+    float score;
+};
+
+// 目标检测结果
+struct DetectionList : Message {
+    uint64_t image_seq = 0;
+    std::vector<Detection> detections;
+};
+
+// 定位结果，局部 ENU 坐标（以第一帧 GNSS 为原点）
+struct PoseEstimate : Message {
+    double x = 0.0, y = 0.0, z = 0.0;
+    double yaw = 0.0;
+};
+
+// 障碍物聚类结果
+struct ObstacleList : Message {
+    std::vector<ObstacleBox> obstacles;
+    size_t ground_points = 0;
+};
+
+// 融合输出
+struct FusedObjects : Message {
+    size_t num_detections = 0;
+    PoseEstimate pose;
+};
+
+}
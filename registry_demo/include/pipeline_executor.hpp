@@ -0,0 +1,285 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "component.hpp"
+#include "config_cache.hpp"
+#include "profiler.hpp"
+#include "registry.hpp"
+#include "task_scheduler.hpp"
+#include "topic_bus.hpp"
+
+namespace duan {
+
+enum class SchedulerKind {
+    WorkStealing,   // 每个线程一个工作窃取队列，默认
+    SharedQueue     // 所有线程共用一个加锁队列（ThreadPool）
+};
+
+struct ExecutorOptions {
+    size_t threads = 0;        // 0 表示硬件并发数
+    SchedulerKind scheduler = SchedulerKind::WorkStealing;
+    bool pin_threads = false;  // 工作线程绑核，仅对工作窃取调度器有效
+    bool profile = false;      // 逐帧记录每个组件的开销，见 Profiler
+    bool fuse_chains = true;   // 把单入单出的线性链合并为一个调度任务，见 fuseLinearChains
+};
+
+// 从配置顶层的 "executor" 读取执行器参数:
+// {"threads": 4, "scheduler": "work_stealing" | "shared_queue", "pin_threads": false, "profile": false,
+//  "fuse_chains": true}
+// 未知的调度器名称抛出 std::runtime_error
+ExecutorOptions executorOptions(const ConfigView& config);
+
+enum class StartupStatus {
+    Pending,
+    Started,
+    Failed,     // start() 抛出异常
+    Skipped     // 有上游未能启动，没有调用 start()
+};
+
+// 一个组件的启动阶段，时间相对 PipelineExecutor::start() 调用时刻 (毫秒)
+struct StartupPhase {
+    std::string name;
+    StartupStatus status = StartupStatus::Pending;
+    double ready_ms = 0.0;   // 全部上游启动完成
+    double begin_ms = 0.0;   // 开始执行 start()
+    double end_ms = 0.0;
+};
+
+struct StartupTimeline {
+    std::vector<StartupPhase> phases;  // 与 PipelineGraph 节点顺序一致
+    double total_ms = 0.0;
+
+    // 所有 start() 耗时之和，即逐个启动需要的时间
+    double sequentialMs() const;
+    // 文本甘特图: '.' 表示等待调度，'#' 表示执行 start()
+    void print(std::ostream& os) const;
+};
+
+// 每个节点的执行统计
+struct NodeStats {
+    uint64_t calls = 0;         // process/processBatch/spinOnce 调用次数
+    uint64_t frames = 0;        // 处理的帧数
+    size_t last_batch = 0;      // 最近一次的批大小，0 表示本帧没有输入
+    size_t max_batch = 0;       // 出现过的最大批大小
+    double frame_cost_us = 0.0; // 单帧处理耗时的滑动平均
+    uint64_t throttled = 0;     // 有输入但下游 block 队列没有额度而推迟的次数
+};
+
+// 一条依赖边（下游的一个输入订阅）的队列状态
+struct EdgeStats {
+    std::string from;          // 上游组件，话题不是由流水线中的组件发布时为空
+    std::string to;
+    std::string topic;
+    QueuePolicy policy = QueuePolicy::KeepLatest;
+    size_t capacity = 0;
+    size_t depth = 0;          // 当前积压
+    size_t peak = 0;           // 出现过的最大积压
+    uint64_t received = 0;
+    uint64_t dropped = 0;
+    uint64_t blocked = 0;      // 发布方因队列满而等待的次数
+};
+
+// 流水线中的一个组件节点
+struct PipelineNode {
+    std::string name;
+    std::string type;
+    ConfigView config;            // 指向构建图的 CompiledConfig，随它失效
+    std::vector<size_t> inputs;   // 上游节点下标，来自配置的 "input"
+    std::vector<size_t> outputs;  // 下游节点下标
+};
+
+/*
+由配置中 "sensors" 与 "algorithms" 的 "input" 构成的有向无环图
+构建时校验: 组件名重复、输入引用不存在的组件、存在环，均抛出 std::runtime_error
+节点只保存配置的视图，图的使用者须保证 config 所属的 CompiledConfig 存活
+*/
+class PipelineGraph {
+public:
+    PipelineGraph() = default;
+    explicit PipelineGraph(const ConfigView& config);
+
+    size_t size() const { return nodes_.size(); }
+    const PipelineNode& node(size_t index) const { return nodes_.at(index); }
+    const std::vector<PipelineNode>& nodes() const { return nodes_; }
+
+    // 按名称查找节点下标，不存在时返回 npos
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    size_t find(const std::string& name) const;
+
+    // 拓扑序，上游总在下游之前；同一层内保持配置顺序
+    const std::vector<size_t>& order() const { return order_; }
+    // 每个节点到源节点的最长距离，传感器为0
+    const std::vector<size_t>& depths() const { return depths_; }
+
+    // 打印每个节点及其输入，用于启动日志
+    void describe(std::ostream& os) const;
+
+private:
+    std::vector<PipelineNode> nodes_;
+    std::vector<size_t> order_;
+    std::vector<size_t> depths_;
+};
+
+/*
+运行中的图与新配置之间的结构差异，按新图的拓扑序列出组件名
+配置（含解析出的话题）完全相同、且没有任何上游被重建的组件保留原实例继续运行，
+其余组件重建: 新增的、配置改变的，以及依赖它们的下游（上游换了实例，订阅要重新建立）
+*/
+struct ReloadPlan {
+    std::vector<std::string> kept;
+    std::vector<std::string> added;
+    std::vector<std::string> changed;
+    std::vector<std::string> downstream;  // 自身配置未变，因上游重建而重建
+    std::vector<std::string> removed;     // 按旧图的顺序
+
+    // 没有任何组件需要创建或销毁
+    bool empty() const { return added.empty() && changed.empty() && downstream.empty() && removed.empty(); }
+    size_t rebuilt() const { return added.size() + changed.size() + downstream.size(); }
+    void print(std::ostream& os) const;
+};
+
+ReloadPlan diffPipeline(const PipelineGraph& running, const PipelineGraph& next);
+
+/*
+图优化: 找出单入单出的线性链（如 filter -> projection -> detector），每条链作为一个调度任务，
+在同一线程上依次执行，省去链内每条边的就绪计数与调度往返，上游刚写出的数据仍在缓存中
+链首可以有多个输入、链尾可以有多个输出；fusible[i] 为 false 的节点不与前后合并
+返回按拓扑序排列的任务，每个任务是按执行顺序排列的节点下标，覆盖全部节点
+*/
+std::vector<std::vector<size_t>> fuseLinearChains(const PipelineGraph& graph, const std::vector<bool>& fusible);
+
+/*
+按依赖图调度组件的执行器
+每一帧里没有输入的节点（传感器）先并行执行，
+某个节点的全部上游在本帧完成后，它立即被提交到调度器，
+互不依赖的分支（如 yolox 与 ekf）在不同线程上同时运行
+调度的单位是 fuseLinearChains 合并出的任务: 线性链整条在一个线程上执行，Profiler 仍按组件记录
+组件在一帧内最多执行一次，帧与帧之间串行，组件自身不需要加锁
+
+有话题端口的组件由执行器取输入、调用 process/processBatch、发布输出，
+批大小按输入积压自适应: 积压1帧时逐帧处理保证延迟，积压多时一次处理多帧提高吞吐，
+上限为组件的 maxBatchSize()；配置了 "batch_latency_ms" 时再按单帧耗时估算，
+保证一批的处理时间不超过该值
+
+下游以 "queue_policy": "block" 订阅时按额度（credit）做流控: 一个节点本帧最多处理
+下游 block 队列剩余空位数的帧，没有额度就推迟到之后的帧，输入留在自己的队列里；
+自己的输入队列满了又会耗尽上游的额度，背压就这样沿图逐级传回传感器。
+执行线程从不因队列满而等待；不希望被拖慢的传感器对下游使用 keep_latest 即可
+*/
+class PipelineExecutor {
+public:
+    // 构建依赖图并通过 ComponentRegistry 创建全部组件，类型未注册时抛出 std::runtime_error
+    // 执行器持有 config，组件直接从它的视图解码，不经过 DOM
+    PipelineExecutor(std::shared_ptr<const CompiledConfig> config, const ExecutorOptions& options);
+    // num_threads 为0时使用硬件并发数
+    explicit PipelineExecutor(std::shared_ptr<const CompiledConfig> config, size_t num_threads = 0);
+    // 程序里拼出的配置（测试、工具）先编译为 CompiledConfig
+    PipelineExecutor(const nlohmann::json& config, const ExecutorOptions& options);
+    explicit PipelineExecutor(const nlohmann::json& config, size_t num_threads = 0);
+    ~PipelineExecutor();
+
+    PipelineExecutor(const PipelineExecutor&) = delete;
+    PipelineExecutor& operator=(const PipelineExecutor&) = delete;
+
+    /*
+    并行启动组件: 没有输入的组件立即启动，其余组件在全部上游启动完成后立即启动，
+    互不依赖的组件在不同线程上同时执行 start()，可并行数受执行器线程数限制
+    某个组件启动失败时，依赖它的组件不再启动，第一个异常在全部结束后重新抛出
+    */
+    StartupTimeline start();
+    // 最近一次 start() 的结果，reload 不更新
+    const StartupTimeline& startupTimeline() const { return startup_; }
+
+    /*
+    热加载: 与当前图比较，只创建并启动需要重建的组件，保留的组件（及其统计）不受影响
+    新组件全部创建并启动成功后才替换，任何一步失败都抛出异常并保持原流水线不变
+    新组件按拓扑序逐个启动，旧实例在替换后析构（取消订阅）
+    只能在两帧之间、由驱动 runFrame 的线程调用；"executor" 段的线程与调度器参数不重新加载
+    reload 在调用线程上完成创建与启动，帧循环里用 beginReload/pollReload，不让慢的 start() 推迟帧
+    */
+    ReloadPlan reload(std::shared_ptr<const CompiledConfig> config);
+    ReloadPlan reload(const nlohmann::json& config);
+
+    // 后台热加载: 在单独的线程上调用 load 取得新配置（可在其中加载插件），再创建并启动需要重建的组件，
+    // 期间帧照常运行；已有未完成的热加载时抛出 std::runtime_error
+    void beginReload(std::function<std::shared_ptr<const CompiledConfig>()> load);
+    void beginReload(std::shared_ptr<const CompiledConfig> config);
+    bool reloading() const { return pending_reload_.valid(); }
+    // 在两帧之间调用: 后台未完成时返回空；完成时替换组件并返回结果；
+    // 后台失败时重新抛出其异常，原流水线不变，之后可以再次 beginReload
+    std::optional<ReloadPlan> pollReload();
+    // 当前生效的配置，reload 成功后更新
+    const std::shared_ptr<const CompiledConfig>& config() const { return config_; }
+
+    // 执行一帧，所有节点完成后返回；组件抛出的第一个异常在这里重新抛出
+    void runFrame();
+    void run(int frames);
+
+    // 开始按组件记录墙钟时间、CPU 时间、排队等待与分配次数，并逐帧求关键路径
+    void enableProfiling(size_t trace_frames = 256);
+    // 未开启时为 nullptr
+    const Profiler* profiler() const { return profiler_.get(); }
+
+    const PipelineGraph& graph() const { return graph_; }
+    // 调度任务，每个是合并后的一条链（未合并的节点单独成链）
+    const std::vector<std::vector<size_t>>& tasks() const { return tasks_; }
+    std::shared_ptr<Component> component(const std::string& name) const;
+    size_t threads() const { return scheduler_->size(); }
+    TaskScheduler& scheduler() { return *scheduler_; }
+    uint64_t frames() const { return frames_; }
+    const NodeStats& stats(const std::string& name) const;
+    // 每条边的队列深度与丢弃数，按下游节点顺序
+    std::vector<EdgeStats> edgeStats() const;
+    void printEdgeStats(std::ostream& os) const;
+
+private:
+    struct RunState;
+    // 按依赖顺序对每个节点执行一次 action，全部完成后返回第一个异常
+    std::exception_ptr runGraph(std::function<void(size_t)> action, Profiler* profiler = nullptr);
+    void runTask(const std::shared_ptr<RunState>& state, size_t task);
+    // 图或组件变化后重新划分调度任务
+    void planTasks();
+    void execute(size_t index);
+    size_t chooseBatch(size_t index, size_t pending) const;
+    // 解码并检查节点配置（only 为空时处理全部），一次报告所有错误；返回各节点的创建函数
+    static std::vector<ComponentRegistry::Factory> prepareNodes(const PipelineGraph& graph, const std::vector<bool>& only);
+    static std::shared_ptr<Component> createNode(const PipelineNode& node, const ComponentRegistry::Factory& factory);
+
+    // 热加载中已创建并启动、尚未替换进来的组件
+    struct PreparedReload {
+        std::shared_ptr<const CompiledConfig> config;
+        PipelineGraph graph;
+        ReloadPlan plan;
+        std::vector<bool> rebuild;
+        std::vector<std::shared_ptr<Component>> fresh;
+    };
+    // 不修改执行器，可在后台线程上与 runFrame 并行
+    PreparedReload prepareReload(std::shared_ptr<const CompiledConfig> config) const;
+    ReloadPlan applyReload(PreparedReload prepared);
+
+    std::shared_ptr<const CompiledConfig> config_;  // graph_ 的节点配置指向它
+    PipelineGraph graph_;
+    std::vector<std::shared_ptr<Component>> components_;
+    bool fuse_chains_ = true;
+    std::vector<std::vector<size_t>> tasks_;
+    std::vector<size_t> task_of_;        // 节点所在的任务
+    std::vector<size_t> source_tasks_;   // 链首没有输入的任务，每次遍历从它们开始
+    std::vector<NodeStats> stats_;
+    std::vector<double> latency_budget_us_;   // 每个节点一批的耗时上限，0 表示不限制
+    uint64_t frames_ = 0;
+    StartupTimeline startup_;
+    std::unique_ptr<Profiler> profiler_;
+    std::unique_ptr<TaskScheduler> scheduler_; // 析构时先停止工作线程
+    std::future<PreparedReload> pending_reload_; // 最后声明，析构时先等后台热加载结束
+};
+
+}
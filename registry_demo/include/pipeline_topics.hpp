@@ -0,0 +1,125 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "component.hpp"
+#include "config_cache.hpp"
+#include "config_schema.hpp"
+#include "topic_bus.hpp"
+
+namespace duan {
+
+// 组件配置中与话题图相关的公共字段，各组件的配置结构体从它派生
+struct PortConfig {
+    std::string name;
+    std::string topic;                      // 为空时为 "/<name>"
+    std::vector<std::string> input;         // 上游组件名
+    std::vector<std::string> input_topics;  // resolvePipelineTopics 写入
+    uint64_t queue_depth = 4;
+    std::string queue_policy = "keep_latest";
+};
+
+}
+
+DUAN_CONFIG_SCHEMA(duan::PortConfig,
+    DUAN_FIELD(name),
+    DUAN_FIELD(topic),
+    DUAN_FIELD(input),
+    DUAN_FIELD(input_topics),
+    DUAN_FIELD(queue_depth),
+    DUAN_FIELD(queue_policy))
+
+namespace duan {
+
+/*
+把配置中的组件连成话题图:
+传感器发布到自己的 "topic"，算法没有配置 topic 时发布到 "/<name>"
+算法的 "input" 写的是上游组件名，这里解析为上游的话题名并写入 "input_topics"
+输入引用了不存在的组件时抛出 std::runtime_error
+*/
+void resolvePipelineTopics(nlohmann::json& config);
+
+// 组件的输出话题: 优先 "topic"，否则为 "/<name>"
+std::string outputTopic(const PortConfig& cfg);
+std::string outputTopic(const nlohmann::json& cfg);
+std::string outputTopic(const ConfigView& cfg);
+
+// 组件的输入话题: 优先 "input_topics"，否则把 "input" 中的每个组件名映射为 "/<name>"
+std::vector<std::string> inputTopics(const PortConfig& cfg);
+std::vector<std::string> inputTopics(const ConfigView& cfg);
+
+// 从 "queue_depth" / "queue_policy" (keep_latest | drop_oldest | drop_newest | block) 读取订阅参数
+// drop_oldest 与 keep_latest 相同；keep_latest 配合 queue_depth 1 即只处理最新一帧
+SubscriptionOptions subscriptionOptions(const PortConfig& cfg);
+SubscriptionOptions subscriptionOptions(const ConfigView& cfg);
+
+/*
+组件在话题总线上的端口: 订阅全部输入话题，并在组件的输出话题上发布
+每个输入记住最近一条消息，某个输入没有新消息时沿用它
+析构时取消订阅，热加载替换掉的组件不再占用话题的订阅名额
+*/
+class ComponentPorts {
+public:
+    ComponentPorts(const PortConfig& cfg, TopicBus& bus);
+    ComponentPorts(const ConfigView& cfg, TopicBus& bus) : ComponentPorts(decodeConfig<PortConfig>(cfg), bus) {}
+    ~ComponentPorts();
+
+    ComponentPorts(const ComponentPorts&) = delete;
+    ComponentPorts& operator=(const ComponentPorts&) = delete;
+
+    bool isSource() const { return subs_.empty(); }
+
+    // 可以处理的帧数: 各输入中积压消息数的最大值；没有输入的组件（传感器）每次都能产出一帧
+    size_t pending() const;
+
+    /*
+    取出至多 max_frames 帧输入追加到 frames，返回帧数，没有新输入时返回0
+    积压超过 max_frames 时丢弃较旧的消息，只处理最新的 max_frames 帧（与 keep_latest 一致，偏向低延迟）；
+    block 策略的输入不丢弃，只取最旧的 max_frames 条
+    第 k 帧中每个输入取其队列里的第 k 条消息，队列不够长时沿用该输入的上一条
+    */
+    size_t collect(size_t max_frames, std::vector<Inputs>& frames);
+
+    // 发布一帧的输出，返回送达的订阅者总数
+    size_t publish(const Outputs& out);
+    // 下游 Block 队列的剩余额度，执行器据此限制本次处理的帧数；下游都不是 Block 时为 SIZE_MAX
+    size_t credits() const;
+
+    const std::vector<std::string>& inputTopics() const { return topics_; }
+    const std::string& outputTopic() const { return pub_.topic(); }
+    const std::vector<std::shared_ptr<Subscription>>& subscriptions() const { return subs_; }
+
+private:
+    TopicBus& bus_;
+    std::vector<std::string> topics_;
+    std::vector<std::shared_ptr<Subscription>> subs_;
+    std::vector<MessagePtr> latest_;
+    std::vector<std::vector<MessagePtr>> queued_; // collect 复用的缓冲
+    Publisher pub_;
+};
+
+/*
+从端口取出至多 max_frames 帧交给组件处理并发布结果，返回处理的帧数
+只有一帧时调用 process，否则调用 processBatch
+*/
+size_t runComponent(Component& component, ComponentPorts& ports, uint64_t frame, size_t max_frames);
+
+// 通过话题收发数据的组件基类，派生类只需实现 process（以及可选的 processBatch）
+class TopicComponent : public Component {
+public:
+    explicit TopicComponent(const PortConfig& cfg, TopicBus& bus = TopicBus::global())
+        : ports_(cfg, bus) {}
+    explicit TopicComponent(const ConfigView& cfg, TopicBus& bus = TopicBus::global())
+        : ports_(cfg, bus) {}
+
+    // 独立运行: 处理最新的一帧输入
+    void spinOnce() override { runComponent(*this, ports_, spins_++, 1); }
+    ComponentPorts* ports() override { return &ports_; }
+
+protected:
+    ComponentPorts ports_;
+    uint64_t spins_ = 0;
+};
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "registry.hpp"
+
+namespace duan {
+
+// 插件接口版本，Component / 注册接口发生不兼容变化时递增
+// 3: 组件配置由 nlohmann::json 改为 ConfigView，注册单元改为 Preparer
+constexpr uint32_t kPluginApiVersion = 3;
+
+// 组件库通过它登记自己提供的组件类型
+class PluginRegistrar {
+public:
+    virtual ~PluginRegistrar() = default;
+    virtual void addPreparer(const std::string& type, ComponentRegistry::Preparer preparer) = 0;
+
+    // 见 ComponentRegistry::Register
+    void add(const std::string& type, ComponentRegistry::Creator creator,
+             ComponentRegistry::Validator validator = nullptr) {
+        addPreparer(type, ComponentRegistry::untypedPreparer(std::move(creator), std::move(validator)));
+    }
+
+    // 见 ComponentRegistry::RegisterTyped
+    template <typename Config, typename Factory>
+    void addTyped(const std::string& type, Factory factory) {
+        addPreparer(type, ComponentRegistry::typedPreparer<Config>(std::move(factory)));
+    }
+};
+
+// 组件库导出的描述，入口函数名见 kPluginEntryPoint
+struct PluginDescriptor {
+    uint32_t api_version;     // 编译插件时的 kPluginApiVersion
+    const char* name;
+    void (*register_components)(PluginRegistrar& registrar);
+};
+
+using PluginEntryFn = const PluginDescriptor* (*)();
+constexpr const char* kPluginEntryPoint = "duan_plugin_descriptor";
+
+// 直接写入 ComponentRegistry，静态链接组件库时使用
+class RegistryRegistrar : public PluginRegistrar {
+public:
+    void addPreparer(const std::string& type, ComponentRegistry::Preparer preparer) override {
+        ComponentRegistry::RegisterPreparer(type, std::move(preparer));
+    }
+};
+
+}
+
+/*
+声明一个组件库，fn 为 void(duan::PluginRegistrar&)
+编译为插件 (定义了 DUAN_BUILDING_PLUGIN) 时导出带版本号的入口函数，由 PluginLoader 加载后调用；
+静态链接进程序时在启动阶段直接注册
+*/
+#ifdef DUAN_BUILDING_PLUGIN
+#define DUAN_COMPONENT_LIBRARY(library_name, fn)                                                  \
+    extern "C" __attribute__((visibility("default"))) const duan::PluginDescriptor*             \
+    duan_plugin_descriptor() {                                                                    \
+        static const duan::PluginDescriptor descriptor{duan::kPluginApiVersion, library_name, fn}; \
+        return &descriptor;                                                                       \
+    }
+#else
+#define DUAN_COMPONENT_LIBRARY(library_name, fn) \
+    namespace {                                  \
+    const bool duan_library_registered = [] {    \
+        duan::RegistryRegistrar registrar;       \
+        fn(registrar);                           \
+        return true;                             \
+    }();                                         \
+    }
+#endif
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "config_cache.hpp"
+
+namespace duan {
+
+/*
+按需加载组件库
+配置中的 "plugins" 清单声明每个库提供哪些组件类型:
+  "plugins": [{"library": "libduan_sensor.so", "types": ["robosense", "hikvision"]}]
+只有配置里实际用到、且尚未注册的类型才会触发 dlopen（RTLD_LAZY，符号在首次调用时解析），
+每个库最多加载一次；库通过带版本号的入口函数注册到 ComponentRegistry
+已加载的库不会卸载: 注册表里的创建函数和已创建的组件都指向库内代码
+*/
+class PluginLoader {
+public:
+    // 库名不含 '/' 时依次在 search_paths 中查找
+    explicit PluginLoader(std::vector<std::string> search_paths = {});
+
+    PluginLoader(const PluginLoader&) = delete;
+    PluginLoader& operator=(const PluginLoader&) = delete;
+
+    // 读取配置中的 "plugins" 清单，只记录类型与库的对应关系，不加载
+    void addManifest(const ConfigView& config);
+    void addLibrary(const std::string& library, const std::vector<std::string>& types);
+
+    /*
+    确保类型可用: 已注册返回true；否则加载声明提供它的库
+    没有库声明该类型时返回false
+    库打开失败、缺少入口、接口版本不符、或加载后没有注册声明的类型时抛出 std::runtime_error
+    */
+    bool ensureType(const std::string& type);
+
+    // 为配置中 "sensors" / "algorithms" 用到的全部类型加载所需的库，返回本次新加载的库数
+    size_t loadFor(const ConfigView& config);
+
+    bool isLoaded(const std::string& library) const;
+    std::vector<std::string> loadedLibraries() const;
+
+private:
+    void load(const std::string& library);
+    std::string resolve(const std::string& library) const;
+
+    std::vector<std::string> search_paths_;
+    std::unordered_map<std::string, std::string> provider_;             // 类型 -> 库
+    std::unordered_map<std::string, std::vector<std::string>> declared_; // 库 -> 声明的类型
+    std::unordered_map<std::string, void*> handles_;                    // 已加载的库
+    std::vector<std::string> load_order_;
+    mutable std::mutex mutex_;
+};
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <pthread.h>
+#include <system_error>
+
+namespace duan {
+
+/*
+带优先级继承（PTHREAD_PRIO_INHERIT）的互斥量，满足 Lockable，配合 std::condition_variable_any 使用
+低优先级线程（如 SCHED_IDLE 的后台线程）持锁时被抢占，等锁的 SCHED_FIFO 线程会把优先级借给它，
+锁很快释放，不会因为中间优先级的线程占着 CPU 而无限期等待（优先级反转）
+平台不支持该协议时退化为普通互斥量
+*/
+class PriorityInheritMutex {
+public:
+    PriorityInheritMutex() {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+        const int rc = pthread_mutex_init(&mutex_, &attr);
+        pthread_mutexattr_destroy(&attr);
+        if (rc != 0) {
+            throw std::system_error(rc, std::generic_category(), "pthread_mutex_init");
+        }
+    }
+    ~PriorityInheritMutex() { pthread_mutex_destroy(&mutex_); }
+
+    PriorityInheritMutex(const PriorityInheritMutex&) = delete;
+    PriorityInheritMutex& operator=(const PriorityInheritMutex&) = delete;
+
+    void lock() {
+        const int rc = pthread_mutex_lock(&mutex_);
+        if (rc != 0) {
+            throw std::system_error(rc, std::generic_category(), "pthread_mutex_lock");
+        }
+    }
+    bool try_lock() { return pthread_mutex_trylock(&mutex_) == 0; }
+    void unlock() { pthread_mutex_unlock(&mutex_); }
+
+private:
+    pthread_mutex_t mutex_;
+};
+
+}
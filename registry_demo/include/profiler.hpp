@@ -0,0 +1,154 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace duan {
+
+class PipelineGraph;
+
+// 当前线程累计的 operator new 次数，全局 operator new 在 allocation_counter.cpp 中替换
+uint64_t threadAllocationCount();
+// 当前线程消耗的 CPU 时间（纳秒）
+int64_t threadCpuTimeNs();
+// 当前线程的编号，从1开始按首次调用分配，用于 trace 中区分执行线程
+uint32_t profilerThreadId();
+
+/*
+对数分桶直方图: 每个 2 的幂区间均分为 8 个子桶，分位数的相对误差不超过 1/8
+记录是 O(1) 的数组自增，不分配内存
+*/
+class Histogram {
+public:
+    void record(uint64_t value);
+
+    uint64_t count() const { return count_; }
+    uint64_t sum() const { return sum_; }
+    uint64_t min() const { return count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0; }
+    // p 取 [0, 100]，返回所在桶的中点，并限制在 [min, max] 内；最后一名直接返回 max
+    uint64_t percentile(double p) const;
+
+private:
+    static constexpr int kSubBits = 3;
+    static constexpr int kBuckets = (64 - kSubBits + 1) << kSubBits;
+    static size_t bucketOf(uint64_t value);
+    static uint64_t bucketLow(size_t bucket);
+
+    std::array<uint64_t, kBuckets> counts_{};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t min_ = UINT64_MAX;
+    uint64_t max_ = 0;
+};
+
+// 一个组件在一帧中的一次执行，时间相对 Profiler 创建时刻（纳秒）
+struct ComponentSpan {
+    size_t component = 0;      // Profiler::components() 的下标
+    uint32_t thread = 0;
+    int64_t ready_ns = 0;      // 全部上游在本帧完成
+    int64_t begin_ns = 0;
+    int64_t end_ns = 0;
+    int64_t cpu_ns = 0;
+    uint64_t allocations = 0;
+    size_t frames = 0;         // 处理的帧数，0 表示本帧没有新输入
+    bool executed = false;
+    bool critical = false;     // 在本帧关键路径上
+};
+
+struct FrameProfile {
+    uint64_t frame = 0;
+    int64_t begin_ns = 0;
+    int64_t end_ns = 0;
+    std::vector<ComponentSpan> spans;      // 按节点下标
+    std::vector<size_t> critical_path;     // 组件下标，从源到最后完成的节点
+};
+
+// 一个组件的累计统计
+struct ComponentProfile {
+    std::string name;
+    uint64_t idle = 0;              // 没有新输入、直接返回的调用
+    Histogram wall_ns;
+    Histogram cpu_ns;
+    Histogram queue_wait_ns;        // 就绪到开始执行（等待调度线程）
+    Histogram allocations;
+    uint64_t critical_frames = 0;   // 出现在关键路径上的帧数
+    uint64_t critical_ns = 0;       // 在关键路径上贡献的时间之和
+};
+
+/*
+按组件统计执行开销，并逐帧求依赖图上的关键路径
+关键路径从本帧最后完成的节点回溯，每一步走最晚完成的上游（正是它让当前节点就绪），
+路径上每个节点的贡献 = 它的完成时刻 - 上一节点的完成时刻（含排队与执行）
+由 PipelineExecutor 驱动: beginFrame / markReady / ProfileScope / endFrame
+同一帧内每个节点只由执行它的线程写自己的槽位，帧之间串行，不需要加锁
+*/
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // 保留最近 trace_frames 帧的明细用于 Chrome trace，统计不受影响
+    explicit Profiler(size_t trace_frames = 256);
+
+    // 图构建或热加载后调用，按名称对应组件，已有的统计保留
+    void bind(const PipelineGraph& graph);
+
+    void beginFrame(uint64_t frame);
+    // 节点的全部上游已完成
+    void markReady(size_t node);
+    void record(size_t node, const ComponentSpan& span);
+    void endFrame(const PipelineGraph& graph);
+
+    int64_t now() const { return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch_).count(); }
+
+    const std::vector<ComponentProfile>& components() const { return components_; }
+    // 不存在时返回 nullptr
+    const ComponentProfile* component(const std::string& name) const;
+    const std::deque<FrameProfile>& frames() const { return frames_; }
+    uint64_t frameCount() const { return frame_ns_.count(); }
+    const Histogram& frameLatency() const { return frame_ns_; }
+    // 出现次数最多的关键路径（组件名）及其帧数
+    std::vector<std::string> dominantPath(uint64_t* frames = nullptr) const;
+
+    // 文本汇总: 每个组件的耗时分布与关键路径占比
+    void print(std::ostream& os) const;
+    // Chrome trace-event JSON，可用 chrome://tracing 或 Perfetto 打开
+    void writeChromeTrace(std::ostream& os) const;
+
+private:
+    Clock::time_point epoch_;
+    size_t trace_frames_;
+    std::vector<ComponentProfile> components_;
+    std::vector<size_t> binding_;          // 节点下标 -> 组件下标
+    FrameProfile current_;
+    std::deque<FrameProfile> frames_;
+    Histogram frame_ns_;
+    std::map<std::vector<size_t>, uint64_t> paths_;
+};
+
+// 记录一次组件执行，析构时（含异常退出）写入 Profiler
+class ProfileScope {
+public:
+    ProfileScope(Profiler& profiler, size_t node);
+    ~ProfileScope();
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    size_t frames = 1;
+
+private:
+    Profiler& profiler_;
+    size_t node_;
+    int64_t begin_ns_;
+    int64_t cpu_ns_;
+    uint64_t allocations_;
+};
+
+}
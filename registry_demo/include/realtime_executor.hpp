@@ -0,0 +1,146 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "component.hpp"
+#include "config_cache.hpp"
+#include "config_schema.hpp"
+#include "pipeline_executor.hpp"
+#include "priority_inherit_mutex.hpp"
+#include "profiler.hpp"
+
+namespace duan {
+
+enum class RtPolicy {
+    EarliestDeadlineFirst,  // 已释放的作业中绝对截止时间最早的先执行
+    FixedPriority           // priority 高的先执行，相同时截止时间早的先执行
+};
+
+struct RealtimeOptions {
+    RtPolicy policy = RtPolicy::EarliestDeadlineFirst;
+    size_t workers = 1;              // 实时线程数，只执行 priority > 0 的组件
+    // 后台线程数，只执行 priority <= 0 的组件，以 SCHED_IDLE 运行；
+    // 为0时后台组件在实时线程上执行，排在全部实时作业之后，但一旦开始就会占住线程直到完成
+    size_t background_workers = 1;
+    bool pin_threads = false;        // 实时线程从 0 号核起绑核，后台线程从最后一个核倒着绑，核够用时互不重叠
+    bool sched_fifo = false;         // 实时线程尝试 SCHED_FIFO，没有权限（EPERM）时保持普通调度
+    int fifo_priority = 80;
+};
+
+// 从配置顶层的 "realtime" 读取:
+// {"policy": "edf" | "fixed_priority", "workers": 1, "background_workers": 1, "pin_threads": false,
+//  "sched_fifo": false, "fifo_priority": 80}
+// 未知的策略名抛出 std::runtime_error
+RealtimeOptions realtimeOptions(const ConfigView& config);
+
+// 组件配置中的实时参数
+struct RealtimeParams {
+    double period_ms = 0.0;     // 释放周期；后台组件为0时连续执行
+    double deadline_ms = 0.0;   // 相对释放时刻的截止时间，0 表示等于周期
+    int priority = 0;           // > 0 为实时组件，数值越大越优先；<= 0 为后台组件
+};
+
+}
+
+DUAN_CONFIG_SCHEMA(duan::RealtimeParams,
+    DUAN_FIELD(period_ms),
+    DUAN_FIELD(deadline_ms),
+    DUAN_FIELD(priority))
+
+namespace duan {
+
+struct RealtimeStats {
+    uint64_t releases = 0;          // 释放的作业数
+    uint64_t completed = 0;
+    uint64_t deadline_misses = 0;   // 完成时刻晚于截止时间
+    uint64_t skipped = 0;           // 上一个作业拖太久而错过的释放，同样计入 deadline_misses
+    uint64_t errors = 0;            // 组件抛出异常的作业
+    Histogram start_delay_ns;       // 释放到开始执行
+    Histogram response_ns;          // 释放到完成
+    int64_t max_lateness_ns = 0;    // 完成时刻 - 截止时间 的最大值，负数表示始终提前完成
+};
+
+/*
+按周期、截止时间与优先级调度组件的实时执行器
+与 PipelineExecutor 的逐帧 DAG 不同，每个组件按自己的 period_ms 独立释放作业，
+作业从输入话题取当前积压的消息（与 ROS 定时器相同），依赖只用于连接话题和启动顺序
+
+作业不可抢占（组件的 process 不能中途打断），所以隔离靠线程划分:
+实时组件只在实时线程上执行，后台组件只在后台线程上执行，
+后台线程为 SCHED_IDLE，与实时线程同核时也会让出 CPU，后台组件再多也不会推迟实时组件
+实时线程之间按 EDF 或固定优先级挑选已释放的作业
+两类线程共用的调度锁带优先级继承，后台线程持锁时被抢占不会让等锁的 SCHED_FIFO 线程无限期等待
+
+统计由工作线程在锁内更新，stats() 返回拷贝，运行中也可以读取
+*/
+class RealtimeExecutor {
+public:
+    // 构建依赖图并创建全部组件；组件配置不合法、实时组件缺少 period_ms 时抛出 std::runtime_error
+    // 执行器持有 config，组件直接从它的视图解码
+    RealtimeExecutor(std::shared_ptr<const CompiledConfig> config, const RealtimeOptions& options);
+    // 程序里拼出的配置（测试、工具）先编译为 CompiledConfig
+    RealtimeExecutor(const nlohmann::json& config, const RealtimeOptions& options);
+    ~RealtimeExecutor();
+
+    RealtimeExecutor(const RealtimeExecutor&) = delete;
+    RealtimeExecutor& operator=(const RealtimeExecutor&) = delete;
+
+    // 按拓扑序逐个启动组件
+    void start();
+    // 启动工作线程运行 duration 后停止，所有组件在开始时同时首次释放；
+    // 组件抛出的异常计入 errors 不中断调度，第一个异常在停止后重新抛出
+    void runFor(std::chrono::milliseconds duration);
+
+    const PipelineGraph& graph() const { return graph_; }
+    std::shared_ptr<Component> component(const std::string& name) const;
+    const RealtimeParams& params(const std::string& name) const;
+    RealtimeStats stats(const std::string& name) const;
+    // 至少一个实时线程成功切换到 SCHED_FIFO
+    bool fifoActive() const { return fifo_active_.load(std::memory_order_relaxed); }
+
+    void print(std::ostream& os) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Task {
+        std::shared_ptr<Component> component;
+        RealtimeParams params;
+        Clock::duration period{};
+        Clock::duration deadline{};
+        bool background = false;
+        bool running = false;
+        Clock::time_point next_release;
+        uint64_t jobs = 0;
+        RealtimeStats stats;
+    };
+
+    size_t index(const std::string& name) const;
+    void worker(size_t id, bool background);
+    // 调用方持有 mutex_；没有可执行的作业时返回 npos，wake 为下一次释放时刻
+    size_t pick(bool background, Clock::time_point now, Clock::time_point& wake) const;
+    void runJob(Task& task);
+
+    std::shared_ptr<const CompiledConfig> config_;  // graph_ 的节点配置指向它
+    PipelineGraph graph_;
+    RealtimeOptions options_;
+    std::vector<Task> tasks_;
+    std::atomic<bool> fifo_active_{false};
+
+    mutable PriorityInheritMutex mutex_;
+    std::condition_variable_any wakeup_;
+    bool stopping_ = false;
+    size_t ready_ = 0;              // 已设置好调度策略的工作线程数
+    std::exception_ptr error_;
+};
+
+}
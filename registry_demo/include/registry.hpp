@@ -1,34 +1,106 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <string_view>
 #include <functional>
-#include <unordered_map>
-#include <nlohmann/json.hpp>
+#include <vector>
 #include "component.hpp"
+#include "config_cache.hpp"
+#include "config_schema.hpp"
 
 namespace duan {
 
 // 通用注册表
 class ComponentRegistry {
 public:
-    using Creator = std::function<std::shared_ptr<Component>(const nlohmann::json&)>;
-    
-    static void Register(const std::string& type, Creator creator) {
-        getMap()[type] = creator;
+    using Creator = std::function<std::shared_ptr<Component>(const ConfigView&)>;
+    // 检查组件配置，不合法时抛出异常；不创建组件
+    using Validator = std::function<void(const ConfigView&)>;
+    // 配置已解码并检查过，调用即创建组件
+    using Factory = std::function<std::shared_ptr<Component>()>;
+    // 解码并检查配置（不合法时抛出异常），返回创建函数；配置只解码这一次
+    using Preparer = std::function<Factory(const ConfigView&)>;
+
+    // 一个已注册的类型，注册后地址不变，进程结束前不释放
+    struct Entry {
+        std::string type;
+        Preparer prepare;
+    };
+    // Find 的结果，可以缓存下来反复创建，省去按名称查找
+    using Handle = const Entry*;
+
+    static void Register(const std::string& type, Creator creator, Validator validator = nullptr);
+    static void RegisterPreparer(const std::string& type, Preparer preparer);
+
+    // 组件以声明了字段的配置结构体构造，factory 为 std::shared_ptr<Component>(const Config&)
+    template <typename Config, typename TypedFactory>
+    static void RegisterTyped(const std::string& type, TypedFactory factory) {
+        RegisterPreparer(type, typedPreparer<Config>(std::move(factory)));
     }
 
-    static std::shared_ptr<Component> Create(const std::string& type, const nlohmann::json& cfg) {
-        auto it = getMap().find(type);
-        if (it != getMap().end()) {
-            return it->second(cfg);
-        }
-        return nullptr; // 或者抛出异常
+    // 没有配置结构的类型: 检查交给 validator，创建时组件自己读配置
+    // 在头文件中实现，插件里的 PluginRegistrar::add 也能用，不依赖宿主导出符号
+    static Preparer untypedPreparer(Creator creator, Validator validator) {
+        return [creator = std::move(creator), validator = std::move(validator)](const ConfigView& cfg) {
+            if (validator) {
+                validator(cfg);
+            }
+            return Factory([creator, cfg] { return creator(cfg); });
+        };
     }
-private:
-    static std::unordered_map<std::string, Creator>& getMap(){
-        static std::unordered_map<std::string, Creator> map;
-        return map;
+
+    // 检查时解码出的 Config 由创建函数持有，创建时不再读配置
+    template <typename Config, typename TypedFactory>
+    static Preparer typedPreparer(TypedFactory factory) {
+        return [factory](const ConfigView& cfg) -> Factory {
+            return [factory, config = decodeConfig<Config>(cfg)]() -> std::shared_ptr<Component> {
+                return factory(config);
+            };
+        };
+    }
+
+    // 未注册时返回 nullptr
+    static Handle Find(std::string_view type);
+
+    // 类型未注册时返回空的 Factory；返回的 Factory 可能引用 cfg，须在配置存活期间调用
+    static Factory Prepare(Handle entry, const ConfigView& cfg) {
+        return entry ? entry->prepare(cfg) : Factory();
+    }
+
+    static std::shared_ptr<Component> Create(const std::string& type, const ConfigView& cfg) {
+        return Create(Find(type), cfg);
+    }
+
+    static std::shared_ptr<Component> Create(Handle entry, const ConfigView& cfg) {
+        Factory factory = Prepare(entry, cfg);
+        return factory ? factory() : nullptr; // 或者抛出异常
     }
+
+    // 按类型声明的配置结构检查配置，类型未注册或没有声明结构时不检查
+    static void Validate(const std::string& type, const ConfigView& cfg) {
+        Prepare(Find(type), cfg);
+    }
+
+    static bool Contains(const std::string& type) {
+        return Find(type) != nullptr;
+    }
+
+    /*
+    封存: 之后的快照用完美哈希代替 unordered_map 查找
+    封存后仍可注册（如运行中加载的插件），每次注册重建完美哈希
+    */
+    static void Seal();
+    static bool IsSealed();
+
+    // 当前快照中的全部类型，按首次注册的顺序
+    static std::vector<std::string> Types();
+
+private:
+    struct Snapshot;
+    struct State;
+    static State& state();
+    static const Snapshot* snapshot();
+    static void publish(State& s);
 };
 
 }
@@ -36,16 +108,30 @@ private:
 /*
 类型别名定义
 定义创建函数的统一接口
-using Creator = std::function<std::shared_ptr<Component>(const nlohmann::json&)>;
+using Creator = std::function<std::shared_ptr<Component>(const ConfigView&)>;
+组件直接读取编译后配置的视图，不经过 nlohmann::json
 
 注册函数
-将组件类型名称与其创建函数关联
-static void Register(const std::string& type, Creator creator)；
+将组件类型名称与其创建函数关联，validator 可选，用于启动前统一检查配置
+同名类型再次注册时替换
+static void Register(const std::string& type, Creator creator, Validator validator = nullptr)；
+
+按配置结构体注册: 把配置视图解码为 Config（类型不符、缺少必填字段时抛出），再交给 factory
+template <typename Config, typename TypedFactory> static void RegisterTyped(const std::string& type, TypedFactory factory);
+
+两步创建: Prepare 解码并检查配置，返回的 Factory 再创建组件
+执行器先 Prepare 全部节点、一次报告所有错误，再逐个调用 Factory，每个节点的配置只解码一次
+static Factory Prepare(Handle entry, const ConfigView& cfg);
 
 作用：根据类型名称查找并调用对应的创建函数
 返回：创建的组件实例，如果类型未注册则返回 nullptr
-static std::shared_ptr<Component> Create(const std::string& type, const nlohmann::json& cfg);
+static std::shared_ptr<Component> Create(const std::string& type, const ConfigView& cfg);
+
+类型是否已注册，PluginLoader 据此决定是否需要加载组件库
+static bool Contains(const std::string& type);
 
-存储类型名称到创建函数的映射关系
-static std::unordered_map<std::string, Creator>& getMap();
-*/
\ No newline at end of file
+并发: 读（Find/Create/Contains）不加锁，只原子地读取当前快照指针；
+写（Register/Seal）在互斥锁下复制出新快照再原子发布（copy-on-write），
+与读并发时读者看到的要么是旧快照要么是新快照
+旧快照不回收（读者可能仍在使用），注册只发生在启动和加载插件时，数量有限
+*/
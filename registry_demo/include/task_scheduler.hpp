@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+namespace duan {
+
+// 任务调度器接口，执行器通过它把组件任务交给线程执行
+class TaskScheduler {
+public:
+    using Task = std::function<void()>;
+
+    virtual ~TaskScheduler() = default;
+
+    // 提交一个任务，不等待完成；任务不能抛出异常
+    virtual void schedule(Task task) = 0;
+
+    // 工作线程数
+    virtual size_t size() const = 0;
+};
+
+}
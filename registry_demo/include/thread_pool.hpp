@@ -0,0 +1,64 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "task_scheduler.hpp"
+
+namespace duan {
+
+// 固定大小的任务线程池，供组件内部做数据并行；所有线程共用一个加锁的FIFO队列
+class ThreadPool : public TaskScheduler {
+public:
+    // num_threads 为0时使用硬件并发数
+    explicit ThreadPool(size_t num_threads = 0);
+    ~ThreadPool() override;
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const override { return workers_.size(); }
+
+    void schedule(Task task) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.emplace(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+    // 提交任务，返回future
+    template <typename F>
+    auto submit(F&& task) -> std::future<std::invoke_result_t<F>> {
+        using R = std::invoke_result_t<F>;
+        auto packaged = std::make_shared<std::packaged_task<R()>>(std::forward<F>(task));
+        std::future<R> result = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.emplace([packaged] { (*packaged)(); });
+        }
+        cv_.notify_one();
+        return result;
+    }
+
+    // 对 [0, n) 的每个下标执行 fn(i)，调用线程也参与执行，全部完成后返回
+    // 不要在本线程池的任务里嵌套调用，否则可能因工作线程全部等待而死锁
+    void parallelFor(size_t n, const std::function<void(size_t)>& fn);
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
+
+}
@@ -0,0 +1,160 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "bounded_queue.hpp"
+#include "message.hpp"
+
+namespace duan {
+
+// 订阅队列满时的处理策略
+enum class QueuePolicy {
+    KeepLatest,   // 丢弃最旧的消息，保证订阅者总能拿到最新数据；深度为1时只保留最新一条
+    DropNewest,   // 丢弃新到达的消息，已排队的消息不受影响
+    Block         // 不丢消息: 发布方等待空位，执行器按剩余额度（credits）推迟上游，不会真的等待
+};
+
+struct SubscriptionOptions {
+    size_t depth = 4;                          // 队列深度（最多缓存的消息数）
+    QueuePolicy policy = QueuePolicy::KeepLatest;
+    // Block 策略下发布方最多等待的时间，超时后丢弃这条消息，避免与同线程的消费者互相等待
+    std::chrono::milliseconds block_timeout{100};
+};
+
+/*
+一个订阅者的接收端
+发布方只拷贝 MessagePtr（引用计数+1），消息本体不复制
+投递和取出都不加锁，发布线程与订阅线程可以并发
+*/
+class Subscription {
+public:
+    Subscription(std::string topic, const SubscriptionOptions& options);
+
+    // 非阻塞地取出最旧的一条消息，队列为空返回false
+    bool take(MessagePtr& out);
+    // 取出队列中全部消息，只返回最新的一条，没有新消息时返回nullptr
+    MessagePtr takeLatest();
+
+    size_t pending() const { return count_.load(std::memory_order_relaxed); }
+    // 还能无等待地接收的消息数
+    size_t credits() const {
+        const size_t used = pending();
+        return used < options_.depth ? options_.depth - used : 0;
+    }
+    // 出现过的最大积压
+    size_t peak() const { return peak_.load(std::memory_order_relaxed); }
+    uint64_t received() const { return received_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    // Block 策略下发布方因队列满而等待的次数
+    uint64_t blocked() const { return blocked_.load(std::memory_order_relaxed); }
+    bool active() const { return active_.load(std::memory_order_acquire); }
+    // 暂停的订阅占用名额，但发布方跳过它: 不入队，也不计入 Publisher::credits
+    bool paused() const { return paused_.load(std::memory_order_acquire); }
+    void resume() { paused_.store(false, std::memory_order_release); }
+
+    const std::string& topic() const { return topic_; }
+    const SubscriptionOptions& options() const { return options_; }
+
+private:
+    friend class Publisher;
+    friend class TopicBus;
+
+    bool deliver(const MessagePtr& msg);
+
+    std::string topic_;
+    SubscriptionOptions options_;
+    BoundedQueue<MessagePtr> queue_;
+    // 已占用的名额，保证队列长度严格不超过 depth
+    std::atomic<size_t> count_{0};
+    std::atomic<size_t> peak_{0};
+    std::atomic<uint64_t> received_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> blocked_{0};
+    std::atomic<bool> active_{true};
+    std::atomic<bool> paused_{false};
+};
+
+/*
+作用域内当前线程新建的订阅处于暂停状态，直到调用 Subscription::resume
+热加载在后台创建替换组件时使用: 新组件切换进来之前不接收消息，
+它的 block 队列也不会占满而拖慢保留下来的上游
+*/
+class PausedSubscriptionScope {
+public:
+    PausedSubscriptionScope();
+    ~PausedSubscriptionScope();
+    PausedSubscriptionScope(const PausedSubscriptionScope&) = delete;
+    PausedSubscriptionScope& operator=(const PausedSubscriptionScope&) = delete;
+
+    static bool active();
+};
+
+namespace detail {
+struct Topic;
+}
+
+// 某个话题的发布端，由 TopicBus::advertise 获得，可以拷贝
+class Publisher {
+public:
+    Publisher() = default;
+
+    // 投递给当前全部订阅者，返回成功入队的订阅者数
+    size_t publish(MessagePtr msg) const;
+
+    // Block 策略的订阅者中最少的剩余额度，即还能发布多少条而不需要等待；没有这类订阅者时为 SIZE_MAX
+    size_t credits() const;
+
+    const std::string& topic() const;
+    uint64_t published() const;
+    explicit operator bool() const { return topic_ != nullptr; }
+
+private:
+    friend class TopicBus;
+    explicit Publisher(std::shared_ptr<detail::Topic> topic) : topic_(std::move(topic)) {}
+
+    std::shared_ptr<detail::Topic> topic_;
+};
+
+/*
+进程内零拷贝话题总线
+话题按名字索引（即配置文件中的 topic），发布/订阅的先后顺序不限
+advertise/subscribe 会加锁，publish 和 take 的热路径无锁
+*/
+class TopicBus {
+public:
+    static constexpr size_t kMaxSubscribers = 64;   // 单个话题的订阅者上限
+
+    TopicBus() = default;
+    TopicBus(const TopicBus&) = delete;
+    TopicBus& operator=(const TopicBus&) = delete;
+
+    // 进程内默认的总线，组件之间通过它互联
+    static TopicBus& global();
+
+    Publisher advertise(const std::string& topic);
+    std::shared_ptr<Subscription> subscribe(const std::string& topic,
+                                            const SubscriptionOptions& options = SubscriptionOptions());
+    // 取消订阅后不再收到新消息，已排队的消息随即释放；
+    // 总线对订阅对象的引用在没有发布方正在投递时释放，热加载反复替换组件也不会累积
+    void unsubscribe(const std::shared_ptr<Subscription>& sub);
+
+    std::vector<std::string> topics() const;
+    size_t subscriberCount(const std::string& topic) const;
+    // 话题仍持有的订阅对象数，含已取消、等待发布方退出后回收的
+    size_t retainedCount(const std::string& topic) const;
+
+private:
+    std::shared_ptr<detail::Topic> getOrCreate(const std::string& topic);
+    // 回收已取消的订阅
+    static void release(detail::Topic& t);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<detail::Topic>> topics_;
+};
+
+}
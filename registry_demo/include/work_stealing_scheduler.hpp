@@ -0,0 +1,83 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "chase_lev_deque.hpp"
+#include "task_scheduler.hpp"
+
+namespace duan {
+
+struct WorkStealingOptions {
+    size_t threads = 0;        // 0 表示硬件并发数
+    bool pin_threads = false;  // 第 i 个工作线程绑定到第 i % CPU数 个核
+    int spin_rounds = 64;      // 找不到任务时先自旋窃取的轮数，之后才休眠
+};
+
+/*
+工作窃取调度器
+每个工作线程有自己的 Chase-Lev 双端队列: 工作线程内提交的任务压入自己队列底部并优先执行，
+数据留在缓存里；空闲线程从其他线程队列顶部窃取最早的任务
+外部线程提交的任务进入一个共享注入队列
+找不到任务的线程自旋若干轮后休眠，提交任务时只在有线程休眠时才加锁唤醒
+*/
+class WorkStealingScheduler : public TaskScheduler {
+public:
+    struct Stats {
+        uint64_t executed = 0;  // 执行的任务数
+        uint64_t stolen = 0;    // 其中从其他线程窃取的
+        uint64_t injected = 0;  // 其中来自注入队列的
+        uint64_t parks = 0;     // 休眠次数
+    };
+
+    explicit WorkStealingScheduler(const WorkStealingOptions& options = WorkStealingOptions());
+    // 等待已提交的任务全部执行完后停止
+    ~WorkStealingScheduler() override;
+
+    WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+    void schedule(Task task) override;
+    size_t size() const override { return workers_.size(); }
+
+    Stats stats() const;
+    // 当前线程在本调度器中的工作线程编号，不是工作线程时返回-1
+    int currentWorker() const;
+
+private:
+    struct alignas(64) Worker {
+        ChaseLevDeque<Task*> deque;
+        std::atomic<uint64_t> executed{0};
+        std::atomic<uint64_t> stolen{0};
+        std::atomic<uint64_t> injected{0};
+        std::atomic<uint64_t> parks{0};
+        std::thread thread;
+    };
+
+    void workerLoop(size_t index);
+    Task* findTask(size_t index, uint64_t& rng);
+    Task* takeInjected();
+    bool hasWork() const;
+    void wakeOne();
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    int spin_rounds_;
+
+    std::mutex inject_mutex_;
+    std::deque<Task*> injected_;
+    std::atomic<size_t> injected_count_{0};
+
+    std::atomic<uint64_t> epoch_{0};     // 每次提交递增，休眠线程据此判断是否有新任务
+    std::atomic<int> sleepers_{0};
+    std::atomic<int64_t> outstanding_{0}; // 已提交未完成的任务数
+    std::mutex park_mutex_;
+    std::condition_variable park_cv_;
+    std::atomic<bool> stopping_{false};
+};
+
+}
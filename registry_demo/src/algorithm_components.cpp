@@ -1,62 +1,208 @@
 #include "component.hpp"
-#include "registry.hpp"
+#include "plugin_api.hpp"
+#include "messages.hpp"
+#include "pipeline_topics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
 namespace duan {
 
+struct YoloXConfig : PortConfig {
+    uint64_t max_batch = 8;   // processBatch 一次最多处理的帧数
+};
+
+}
+
+DUAN_CONFIG_SCHEMA_EXTENDS(duan::YoloXConfig, duan::PortConfig, DUAN_FIELD(max_batch))
+
+namespace duan {
+
 // YOLOX目标检测算法
-class YoloX_Detector : public Component {
+class YoloX_Detector : public TopicComponent {
     std::vector<std::string> input_;
+    size_t max_batch_;
+    uint64_t seq_ = 0;
+    std::vector<uint32_t> cell_sums_; // 批处理时复用，每帧 8x6 个网格
+
+    static constexpr int kCellsX = 8;
+    static constexpr int kCellsY = 6;
+
+    // 按行累加各网格的采样亮度，一批图像共用同一份累加缓冲
+    static void accumulateCells(const CameraImage& image, uint32_t* sums) {
+        const int cell_w = image.width / kCellsX;
+        const int cell_h = image.height / kCellsY;
+        for (int cy = 0; cy < kCellsY; ++cy) {
+            for (int y = cy * cell_h; y < (cy + 1) * cell_h; y += 4) {
+                const uint8_t* row = image.data.data() + static_cast<size_t>(y) * image.width * 3;
+                for (int cx = 0; cx < kCellsX; ++cx) {
+                    uint32_t sum = 0;
+                    for (int x = cx * cell_w; x < (cx + 1) * cell_w; x += 4) {
+                        sum += row[x * 3 + 1];
+                    }
+                    sums[cy * kCellsX + cx] += sum;
+                }
+            }
+        }
+    }
+
+    std::shared_ptr<DetectionList> detections(const CameraImage& image, const uint32_t* sums) {
+        auto out = std::make_shared<DetectionList>();
+        out->seq = seq_++;
+        out->timestamp = image.timestamp;
+        out->image_seq = image.seq;
+        const int cell_w = image.width / kCellsX;
+        const int cell_h = image.height / kCellsY;
+        const uint64_t samples = static_cast<uint64_t>((cell_h + 3) / 4) * ((cell_w + 3) / 4);
+        for (int cy = 0; cy < kCellsY; ++cy) {
+            for (int cx = 0; cx < kCellsX; ++cx) {
+                const float mean = static_cast<float>(sums[cy * kCellsX + cx]) / static_cast<float>(samples);
+                if (mean > 128.0f) {
+                    out->detections.push_back({static_cast<float>(cx * cell_w), static_cast<float>(cy * cell_h),
+                                               static_cast<float>(cell_w), static_cast<float>(cell_h), mean / 255.0f});
+                }
+            }
+        }
+        return out;
+    }
+
+    static std::shared_ptr<const CameraImage> usableImage(const Inputs& in) {
+        auto image = in.get<CameraImage>();
+        if (!image || image->width < kCellsX || image->height < kCellsY) return nullptr;
+        return image;
+    }
+
 public:
-    YoloX_Detector(const nlohmann::json& cfg) : input_(cfg.at("input").get<std::vector<std::string>>()) {}
+    explicit YoloX_Detector(const YoloXConfig& cfg)
+        : TopicComponent(cfg),
+          input_(cfg.input),
+          max_batch_(std::max<size_t>(1, cfg.max_batch)) {}
     void start() override {
         std::cout << "[YOLOX] Object detector with input: ";
         for (auto& in : input_) std::cout << in << " ";
         std::cout << std::endl;
     }
+
+    // 用网格亮度代替网络推理：平均亮度高的网格视为一个目标
+    void process(const FrameContext&, const Inputs& in, Outputs& out) override {
+        auto image = usableImage(in);
+        if (!image) return;
+        uint32_t sums[kCellsX * kCellsY] = {};
+        accumulateCells(*image, sums);
+        out.publish(detections(*image, sums));
+    }
+
+    // 整批先累加再统一出结果，相当于把一批图像当作一次推理的输入
+    void processBatch(const std::vector<FrameContext>& ctx, const std::vector<Inputs>& in,
+                      std::vector<Outputs>& out) override {
+        cell_sums_.assign(ctx.size() * kCellsX * kCellsY, 0);
+        std::vector<std::shared_ptr<const CameraImage>> images(ctx.size());
+        for (size_t i = 0; i < ctx.size(); ++i) {
+            images[i] = usableImage(in[i]);
+            if (images[i]) accumulateCells(*images[i], cell_sums_.data() + i * kCellsX * kCellsY);
+        }
+        for (size_t i = 0; i < ctx.size(); ++i) {
+            if (images[i]) out[i].publish(detections(*images[i], cell_sums_.data() + i * kCellsX * kCellsY));
+        }
+    }
+
+    size_t maxBatchSize() const override { return max_batch_; }
 };
 
 // EKF定位算法
-class EKF_Localizer : public Component {
+class EKF_Localizer : public TopicComponent {
     std::vector<std::string> input_;
+    uint64_t seq_ = 0;
+    uint64_t last_fix_seq_ = UINT64_MAX;
+    bool has_origin_ = false;
+    double origin_lat_ = 0.0, origin_lon_ = 0.0;
+    PoseEstimate state_;
 public:
-    EKF_Localizer(const nlohmann::json& cfg) : input_(cfg.at("input").get<std::vector<std::string>>()) {}
+    explicit EKF_Localizer(const PortConfig& cfg)
+        : TopicComponent(cfg),
+          input_(cfg.input) {}
     void start() override {
         std::cout << "[EKF] Localization with input: ";
         for (auto& in : input_) std::cout << in << " ";
         std::cout << std::endl;
     }
+
+    // 简化的滤波：GNSS 转局部坐标后做一阶平滑，航向取位移方向
+    void process(const FrameContext&, const Inputs& in, Outputs& out) override {
+        auto fix = in.get<GnssFix>();
+        if (!fix || fix->seq == last_fix_seq_) return;
+        last_fix_seq_ = fix->seq;
+
+        constexpr double kEarthRadius = 6378137.0;
+        constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+        if (!has_origin_) {
+            origin_lat_ = fix->latitude;
+            origin_lon_ = fix->longitude;
+            has_origin_ = true;
+        }
+        const double east = (fix->longitude - origin_lon_) * kDegToRad * kEarthRadius * std::cos(origin_lat_ * kDegToRad);
+        const double north = (fix->latitude - origin_lat_) * kDegToRad * kEarthRadius;
+
+        constexpr double kGain = 0.5;
+        const double dx = east - state_.x;
+        const double dy = north - state_.y;
+        state_.x += kGain * dx;
+        state_.y += kGain * dy;
+        state_.z = fix->altitude;
+        if (dx * dx + dy * dy > 1e-6) {
+            state_.yaw = std::atan2(dy, dx);
+        }
+
+        auto pose = std::make_shared<PoseEstimate>(state_);
+        pose->seq = seq_++;
+        // 有雷达帧时以雷达时间为准，和感知结果对齐
+        auto lidar = in.get<LidarFrame>();
+        pose->timestamp = lidar ? lidar->timestamp : fix->timestamp;
+        out.publish(std::move(pose));
+    }
 };
 
 // 融合算法FusionV2
-class FusionV2 : public Component {
+class FusionV2 : public TopicComponent {
     std::vector<std::string> input_;
+    uint64_t seq_ = 0;
 public:
-    FusionV2(const nlohmann::json& cfg) : input_(cfg.at("input").get<std::vector<std::string>>()) {}
+    explicit FusionV2(const PortConfig& cfg)
+        : TopicComponent(cfg),
+          input_(cfg.input) {}
     void start() override {
         std::cout << "[FusionV2] Sensor Fusion with input: ";
         for (auto& in : input_) std::cout << in << " ";
         std::cout << std::endl;
     }
+
+    void process(const FrameContext&, const Inputs& in, Outputs& out) override {
+        auto detections = in.get<DetectionList>();
+        auto pose = in.get<PoseEstimate>();
+        if (!detections || !pose) return;
+
+        auto fused = std::make_shared<FusedObjects>();
+        fused->seq = seq_++;
+        fused->timestamp = detections->timestamp;
+        fused->num_detections = detections->detections.size();
+        fused->pose = *pose;
+        std::cout << "[FusionV2] frame " << fused->seq << ": " << fused->num_detections
+                  << " objects @ (" << fused->pose.x << ", " << fused->pose.y << ")" << std::endl;
+        out.publish(std::move(fused));
+    }
 };
 
 }
 
-using ComponentRegistry = duan::ComponentRegistry;
-
-// 自动注册
+// 组件库注册: 静态链接时启动即注册，编译为插件时由 PluginLoader 按需加载
 namespace {
-    const bool reg1 = []{
-        ComponentRegistry::Register("yolox", [](const nlohmann::json& cfg){ return std::make_shared<duan::YoloX_Detector>(cfg); });
-        return true;
-    }();
-    const bool reg2 = []{
-        ComponentRegistry::Register("ekf", [](const nlohmann::json& cfg){ return std::make_shared<duan::EKF_Localizer>(cfg); });
-        return true;
-    }();
-    const bool reg3 = []{
-        ComponentRegistry::Register("fusion_v2", [](const nlohmann::json& cfg){ return std::make_shared<duan::FusionV2>(cfg); });
-        return true;
-    }();
-}
\ No newline at end of file
+    void registerAlgorithms(duan::PluginRegistrar& registrar) {
+        registrar.addTyped<duan::YoloXConfig>("yolox", [](const duan::YoloXConfig& cfg){ return std::make_shared<duan::YoloX_Detector>(cfg); });
+        registrar.addTyped<duan::PortConfig>("ekf", [](const duan::PortConfig& cfg){ return std::make_shared<duan::EKF_Localizer>(cfg); });
+        registrar.addTyped<duan::PortConfig>("fusion_v2", [](const duan::PortConfig& cfg){ return std::make_shared<duan::FusionV2>(cfg); });
+    }
+}
+
+DUAN_COMPONENT_LIBRARY("algorithms", registerAlgorithms)
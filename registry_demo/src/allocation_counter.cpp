@@ -0,0 +1,45 @@
+#include "profiler.hpp"
+#include <cstdlib>
+#include <new>
+
+/*
+替换全局 operator new/delete，按线程统计分配次数供 Profiler 使用
+数组与 nothrow 版本在标准库中转调这里；对齐版本不计数
+*/
+
+namespace {
+thread_local uint64_t t_allocations = 0;
+}
+
+namespace duan {
+
+uint64_t threadAllocationCount() {
+    return t_allocations;
+}
+
+}
+
+void* operator new(std::size_t size) {
+    ++t_allocations;
+    if (size == 0) {
+        size = 1;
+    }
+    for (;;) {
+        if (void* p = std::malloc(size)) {
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
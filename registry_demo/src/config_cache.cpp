@@ -0,0 +1,525 @@
+#include "config_cache.hpp"
+#include "pipeline_executor.hpp"
+#include "pipeline_topics.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace duan {
+
+using namespace config_binary;
+
+uint64_t fnv1a64(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+namespace {
+
+const char* typeName(Type type) {
+    switch (type) {
+    case Type::Null: return "null";
+    case Type::Boolean: return "boolean";
+    case Type::Integer: case Type::Unsigned: case Type::Float: return "number";
+    case Type::String: return "string";
+    case Type::Array: return "array";
+    case Type::Object: return "object";
+    }
+    return "unknown";
+}
+
+template <typename T>
+uint64_t bitsOf(T value) {
+    static_assert(sizeof(T) == sizeof(uint64_t), "64-bit scalar");
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+template <typename T>
+T fromBits(uint64_t bits) {
+    T value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// 把 JSON 树展开为 Node/Key 表，数组/对象的子节点连续存放，相同字符串只存一份
+class Encoder {
+public:
+    void place(const nlohmann::json& value, size_t index) {
+        Node node{};
+        switch (value.type()) {
+        case nlohmann::json::value_t::null:
+        case nlohmann::json::value_t::discarded:
+            node.type = Type::Null;
+            break;
+        case nlohmann::json::value_t::boolean:
+            node.type = Type::Boolean;
+            node.payload = value.get<bool>() ? 1 : 0;
+            break;
+        case nlohmann::json::value_t::number_integer:
+            node.type = Type::Integer;
+            node.payload = bitsOf(value.get<int64_t>());
+            break;
+        case nlohmann::json::value_t::number_unsigned:
+            node.type = Type::Unsigned;
+            node.payload = value.get<uint64_t>();
+            break;
+        case nlohmann::json::value_t::number_float:
+            node.type = Type::Float;
+            node.payload = bitsOf(value.get<double>());
+            break;
+        case nlohmann::json::value_t::string: {
+            const auto& text = value.get_ref<const std::string&>();
+            node.type = Type::String;
+            node.count = static_cast<uint32_t>(text.size());
+            node.payload = intern(text);
+            break;
+        }
+        case nlohmann::json::value_t::binary:
+            throw std::invalid_argument("配置中不支持二进制值");
+        case nlohmann::json::value_t::array:
+        case nlohmann::json::value_t::object: {
+            // 先给全部子节点占位，保证它们连续
+            const size_t first = nodes.size();
+            node.type = value.is_array() ? Type::Array : Type::Object;
+            node.count = static_cast<uint32_t>(value.size());
+            node.payload = first;
+            nodes.resize(first + value.size());
+            keys.resize(first + value.size());
+            size_t i = first;
+            // nlohmann::json 的对象按键排序遍历，正好满足二分查找的要求
+            for (auto it = value.begin(); it != value.end(); ++it, ++i) {
+                if (value.is_object()) {
+                    keys[i] = Key{intern(it.key()), static_cast<uint32_t>(it.key().size())};
+                }
+                place(*it, i);
+            }
+            break;
+        }
+        }
+        nodes[index] = node;
+    }
+
+    uint32_t intern(const std::string& text) {
+        auto it = offsets_.find(text);
+        if (it != offsets_.end()) {
+            return it->second;
+        }
+        const auto offset = static_cast<uint32_t>(strings.size());
+        strings.insert(strings.end(), text.begin(), text.end());
+        strings.push_back('\0');
+        offsets_.emplace(text, offset);
+        return offset;
+    }
+
+    std::vector<Node> nodes;
+    std::vector<Key> keys;
+    std::vector<char> strings;
+
+private:
+    std::unordered_map<std::string, uint32_t> offsets_;
+};
+
+// 检查头部与各段是否落在缓冲区内，防止截断或损坏的缓存文件导致越界读
+bool checkLayout(const uint8_t* data, size_t size) {
+    if (size < sizeof(Header)) {
+        return false;
+    }
+    const auto& header = *reinterpret_cast<const Header*>(data);
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kFormatVersion ||
+        header.total_size != size || header.node_count == 0) {
+        return false;
+    }
+    // 偏移来自文件，一律写成 "a > b || n > b - a" 的形式比较，避免 a + n 回绕后通过检查
+    const uint64_t node_bytes = uint64_t(header.node_count) * sizeof(Node);
+    const uint64_t key_bytes = uint64_t(header.node_count) * sizeof(Key);
+    if (header.nodes_offset % alignof(Node) != 0 || header.keys_offset % alignof(Key) != 0 ||
+        header.nodes_offset < sizeof(Header) || header.strings_offset > size ||
+        header.keys_offset > header.strings_offset || key_bytes > header.strings_offset - header.keys_offset ||
+        header.nodes_offset > header.keys_offset || node_bytes > header.keys_offset - header.nodes_offset) {
+        return false;
+    }
+    // 子节点与字符串引用也不能越界，之后的访问就不再检查
+    const auto* nodes = reinterpret_cast<const Node*>(data + header.nodes_offset);
+    const auto* keys = reinterpret_cast<const Key*>(data + header.keys_offset);
+    const uint64_t string_bytes = size - header.strings_offset;
+    for (uint32_t i = 0; i < header.node_count; ++i) {
+        const Node& node = nodes[i];
+        if (node.type > Type::Object) {
+            return false;
+        }
+        if (node.type == Type::String && (node.payload > string_bytes || node.count > string_bytes - node.payload)) {
+            return false;
+        }
+        if (node.type == Type::Array || node.type == Type::Object) {
+            if (node.payload <= i || node.payload > header.node_count ||
+                node.count > header.node_count - node.payload) {
+                return false;
+            }
+            for (uint32_t k = 0; node.type == Type::Object && k < node.count; ++k) {
+                const Key& key = keys[node.payload + k];
+                if (key.offset > string_bytes || key.length > string_bytes - key.offset) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+}
+
+// ---------------------------------------------------------------- ConfigView
+
+const Node* ConfigView::nodes() const {
+    return reinterpret_cast<const Node*>(base_ + header().nodes_offset);
+}
+
+const Key* ConfigView::keys() const {
+    return reinterpret_cast<const Key*>(base_ + header().keys_offset);
+}
+
+std::string_view ConfigView::text(uint64_t offset, uint32_t length) const {
+    return std::string_view(reinterpret_cast<const char*>(base_ + header().strings_offset + offset), length);
+}
+
+size_t ConfigView::size() const {
+    return isArray() || isObject() ? node_->count : 0;
+}
+
+ConfigView ConfigView::operator[](size_t index) const {
+    if (index >= size()) {
+        throw std::out_of_range("配置下标越界: " + std::to_string(index));
+    }
+    return ConfigView(base_, nodes() + node_->payload + index);
+}
+
+std::string_view ConfigView::key(size_t index) const {
+    if (!isObject() || index >= size()) {
+        throw std::out_of_range("配置对象没有第 " + std::to_string(index) + " 个成员");
+    }
+    const Key& k = keys()[node_->payload + index];
+    return text(k.offset, k.length);
+}
+
+const Node* ConfigView::find(std::string_view key) const {
+    if (!isObject()) {
+        return nullptr;
+    }
+    const Key* first = keys() + node_->payload;
+    const Key* last = first + node_->count;
+    const Key* it = std::lower_bound(first, last, key, [this](const Key& k, std::string_view wanted) {
+        return text(k.offset, k.length) < wanted;
+    });
+    if (it == last || text(it->offset, it->length) != key) {
+        return nullptr;
+    }
+    return nodes() + (it - keys());
+}
+
+bool ConfigView::contains(std::string_view key) const {
+    return find(key) != nullptr;
+}
+
+ConfigView ConfigView::at(std::string_view key) const {
+    const Node* node = find(key);
+    if (!node) {
+        throw std::out_of_range("配置缺少字段: " + std::string(key));
+    }
+    return ConfigView(base_, node);
+}
+
+bool ConfigView::asBool() const {
+    if (type() != Type::Boolean) {
+        throw std::invalid_argument(std::string("配置值类型为 ") + typeName(type()) + "，需要 boolean");
+    }
+    return node_->payload != 0;
+}
+
+int64_t ConfigView::asInt() const {
+    switch (type()) {
+    case Type::Integer: return fromBits<int64_t>(node_->payload);
+    case Type::Unsigned: return static_cast<int64_t>(node_->payload);
+    case Type::Float: return static_cast<int64_t>(fromBits<double>(node_->payload));
+    default: throw std::invalid_argument(std::string("配置值类型为 ") + typeName(type()) + "，需要 number");
+    }
+}
+
+uint64_t ConfigView::asUnsigned() const {
+    return type() == Type::Unsigned ? node_->payload : static_cast<uint64_t>(asInt());
+}
+
+double ConfigView::asDouble() const {
+    switch (type()) {
+    case Type::Integer: return static_cast<double>(fromBits<int64_t>(node_->payload));
+    case Type::Unsigned: return static_cast<double>(node_->payload);
+    case Type::Float: return fromBits<double>(node_->payload);
+    default: throw std::invalid_argument(std::string("配置值类型为 ") + typeName(type()) + "，需要 number");
+    }
+}
+
+std::string_view ConfigView::asString() const {
+    if (type() != Type::String) {
+        throw std::invalid_argument(std::string("配置值类型为 ") + typeName(type()) + "，需要 string");
+    }
+    return text(node_->payload, node_->count);
+}
+
+int64_t ConfigView::value(std::string_view key, int64_t fallback) const {
+    const Node* node = find(key);
+    return node ? ConfigView(base_, node).asInt() : fallback;
+}
+
+double ConfigView::value(std::string_view key, double fallback) const {
+    const Node* node = find(key);
+    return node ? ConfigView(base_, node).asDouble() : fallback;
+}
+
+bool ConfigView::value(std::string_view key, bool fallback) const {
+    const Node* node = find(key);
+    return node ? ConfigView(base_, node).asBool() : fallback;
+}
+
+std::string_view ConfigView::value(std::string_view key, std::string_view fallback) const {
+    const Node* node = find(key);
+    return node ? ConfigView(base_, node).asString() : fallback;
+}
+
+bool ConfigView::operator==(const ConfigView& other) const {
+    if (type() != other.type()) {
+        if (!isNumber() || !other.isNumber()) {
+            return false;
+        }
+        if (type() == Type::Float || other.type() == Type::Float) {
+            return asDouble() == other.asDouble();
+        }
+        // 一个 Integer 一个 Unsigned: Integer 为负时必然不等
+        const ConfigView& sign = type() == Type::Integer ? *this : other;
+        const ConfigView& unsign = type() == Type::Integer ? other : *this;
+        return sign.asInt() >= 0 && static_cast<uint64_t>(sign.asInt()) == unsign.asUnsigned();
+    }
+    switch (type()) {
+    case Type::Null: return true;
+    case Type::Boolean: case Type::Integer: case Type::Unsigned: return node_->payload == other.node_->payload;
+    case Type::Float: return asDouble() == other.asDouble();
+    case Type::String: return asString() == other.asString();
+    case Type::Array:
+    case Type::Object:
+        if (size() != other.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < size(); ++i) {
+            if ((isObject() && key(i) != other.key(i)) || (*this)[i] != other[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+nlohmann::json ConfigView::toJson() const {
+    switch (type()) {
+    case Type::Null: return nullptr;
+    case Type::Boolean: return asBool();
+    case Type::Integer: return fromBits<int64_t>(node_->payload);
+    case Type::Unsigned: return node_->payload;
+    case Type::Float: return fromBits<double>(node_->payload);
+    case Type::String: return std::string(asString());
+    case Type::Array: {
+        nlohmann::json array = nlohmann::json::array();
+        for (size_t i = 0; i < size(); ++i) {
+            array.push_back((*this)[i].toJson());
+        }
+        return array;
+    }
+    case Type::Object: {
+        nlohmann::json object = nlohmann::json::object();
+        for (size_t i = 0; i < size(); ++i) {
+            object.emplace(std::string(key(i)), (*this)[i].toJson());
+        }
+        return object;
+    }
+    }
+    return nullptr;
+}
+
+// ------------------------------------------------------------ CompiledConfig
+
+CompiledConfig::~CompiledConfig() {
+    if (mapping_) {
+        munmap(mapping_, size_);
+    }
+}
+
+CompiledConfig::CompiledConfig(CompiledConfig&& other) noexcept {
+    *this = std::move(other);
+}
+
+CompiledConfig& CompiledConfig::operator=(CompiledConfig&& other) noexcept {
+    if (this != &other) {
+        if (mapping_) {
+            munmap(mapping_, size_);
+        }
+        // vector 移动后数据指针不变
+        buffer_ = std::move(other.buffer_);
+        data_ = other.data_;
+        size_ = other.size_;
+        mapping_ = other.mapping_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.mapping_ = nullptr;
+    }
+    return *this;
+}
+
+CompiledConfig CompiledConfig::compile(const nlohmann::json& config, uint64_t source_hash, uint64_t source_size) {
+    Encoder encoder;
+    encoder.nodes.resize(1);
+    encoder.keys.resize(1);
+    encoder.place(config, 0);
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.node_count = static_cast<uint32_t>(encoder.nodes.size());
+    header.source_hash = source_hash;
+    header.source_size = source_size;
+    header.nodes_offset = alignUp(sizeof(Header), alignof(Node));
+    header.keys_offset = header.nodes_offset + encoder.nodes.size() * sizeof(Node);
+    header.strings_offset = header.keys_offset + encoder.keys.size() * sizeof(Key);
+    header.total_size = header.strings_offset + encoder.strings.size();
+
+    CompiledConfig compiled;
+    compiled.buffer_.resize(header.total_size);
+    uint8_t* out = compiled.buffer_.data();
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + header.nodes_offset, encoder.nodes.data(), encoder.nodes.size() * sizeof(Node));
+    std::memcpy(out + header.keys_offset, encoder.keys.data(), encoder.keys.size() * sizeof(Key));
+    std::memcpy(out + header.strings_offset, encoder.strings.data(), encoder.strings.size());
+    compiled.data_ = out;
+    compiled.size_ = compiled.buffer_.size();
+    return compiled;
+}
+
+CompiledConfig CompiledConfig::map(const std::string& path) {
+    CompiledConfig compiled;
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return compiled;
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(fd);
+        return compiled;
+    }
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return compiled;
+    }
+    if (!checkLayout(static_cast<const uint8_t*>(mapping), size)) {
+        munmap(mapping, size);
+        return compiled;
+    }
+    compiled.mapping_ = mapping;
+    compiled.data_ = static_cast<const uint8_t*>(mapping);
+    compiled.size_ = size;
+    return compiled;
+}
+
+uint64_t CompiledConfig::sourceHash() const {
+    return data_ ? reinterpret_cast<const Header*>(data_)->source_hash : 0;
+}
+
+uint64_t CompiledConfig::sourceSize() const {
+    return data_ ? reinterpret_cast<const Header*>(data_)->source_size : 0;
+}
+
+ConfigView CompiledConfig::root() const {
+    if (!data_) {
+        return ConfigView();
+    }
+    const auto& header = *reinterpret_cast<const Header*>(data_);
+    return ConfigView(data_, reinterpret_cast<const Node*>(data_ + header.nodes_offset));
+}
+
+void CompiledConfig::save(const std::string& path) const {
+    const std::string tmp = path + ".tmp." + std::to_string(::getpid());
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(data_), static_cast<std::streamsize>(size_));
+        if (!out) {
+            std::remove(tmp.c_str());
+            throw std::runtime_error("写入配置缓存失败: " + tmp);
+        }
+    }
+    // 改名是原子的，其他进程要么看到旧文件要么看到完整的新文件
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        throw std::runtime_error("写入配置缓存失败: " + path);
+    }
+}
+
+// --------------------------------------------------------------- ConfigCache
+
+CompiledConfig ConfigCache::compileText(const std::string& json_text) {
+    nlohmann::json config;
+    try {
+        config = nlohmann::json::parse(json_text);
+    } catch (const nlohmann::json::parse_error& e) {
+        throw std::runtime_error(std::string("配置 JSON 解析失败: ") + e.what());
+    }
+    // 与启动时相同的检查: 组件名、输入、依赖环
+    resolvePipelineTopics(config);
+    CompiledConfig compiled = CompiledConfig::compile(config, fnv1a64(json_text.data(), json_text.size()), json_text.size());
+    PipelineGraph graph(compiled.root());
+    return compiled;
+}
+
+CompiledConfig ConfigCache::load(const std::string& json_path, const ConfigLoadOptions& options) {
+    std::ifstream in(json_path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("无法打开配置文件: " + json_path);
+    }
+    const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    const std::string cache_path = options.cache_path.empty() ? json_path + ".bin" : options.cache_path;
+    const uint64_t hash = fnv1a64(text.data(), text.size());
+    CompiledConfig cached = CompiledConfig::map(cache_path);
+    if (cached.valid() && cached.sourceHash() == hash && cached.sourceSize() == text.size()) {
+        return cached;
+    }
+
+    CompiledConfig compiled = compileText(text);
+    if (options.write_cache) {
+        try {
+            compiled.save(cache_path);
+        } catch (const std::exception&) {
+            // 目录不可写时只是失去缓存，本次照常使用
+        }
+    }
+    return compiled;
+}
+
+}
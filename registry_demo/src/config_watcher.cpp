@@ -0,0 +1,58 @@
+#include "config_watcher.hpp"
+#include "config_cache.hpp"
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+
+namespace duan {
+
+namespace {
+
+bool readHash(const std::string& path, uint64_t& hash) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    hash = fnv1a64(text.data(), text.size());
+    return true;
+}
+
+}
+
+ConfigWatcher::ConfigWatcher(std::string path) : path_(std::move(path)) {
+    if (stat(mtime_ns_, size_)) {
+        readHash(path_, hash_);
+    }
+}
+
+bool ConfigWatcher::stat(int64_t& mtime_ns, uint64_t& size) const {
+    struct ::stat st;
+    if (::stat(path_.c_str(), &st) != 0) {
+        return false;
+    }
+    mtime_ns = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    size = static_cast<uint64_t>(st.st_size);
+    return true;
+}
+
+bool ConfigWatcher::poll() {
+    int64_t mtime_ns = 0;
+    uint64_t size = 0;
+    if (!stat(mtime_ns, size) || (mtime_ns == mtime_ns_ && size == size_)) {
+        return false;
+    }
+    uint64_t hash = 0;
+    if (!readHash(path_, hash)) {
+        return false;
+    }
+    mtime_ns_ = mtime_ns;
+    size_ = size;
+    if (hash == hash_) {
+        return false;
+    }
+    hash_ = hash;
+    return true;
+}
+
+}
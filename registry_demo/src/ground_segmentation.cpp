@@ -0,0 +1,256 @@
+#include "ground_segmentation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace duan {
+
+GroundObstacleSegmenter::GroundObstacleSegmenter(const SegmentationConfig& config, ThreadPool* pool)
+    : config_(config), pool_(pool) {
+    if (config_.sectors <= 0 || config_.bin_size <= 0.0f) {
+        throw std::invalid_argument("GroundObstacleSegmenter: invalid config");
+    }
+}
+
+void GroundObstacleSegmenter::updateTables(const LidarFrame& frame) {
+    if (frame.rings == table_rings_ && frame.beams == table_beams_ &&
+        frame.azimuth_start_deg == table_az_start_ && frame.azimuth_step_deg == table_az_step_ &&
+        frame.elevations_deg == table_elevations_) {
+        return;
+    }
+    constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+    cos_az_.resize(frame.beams);
+    sin_az_.resize(frame.beams);
+    for (int b = 0; b < frame.beams; ++b) {
+        double az = (frame.azimuth_start_deg + static_cast<double>(b) * frame.azimuth_step_deg) * kDegToRad;
+        cos_az_[b] = static_cast<float>(std::cos(az));
+        sin_az_[b] = static_cast<float>(std::sin(az));
+    }
+    cos_el_.resize(frame.rings);
+    sin_el_.resize(frame.rings);
+    for (int r = 0; r < frame.rings; ++r) {
+        double el = frame.elevations_deg[r] * kDegToRad;
+        cos_el_[r] = static_cast<float>(std::cos(el));
+        sin_el_[r] = static_cast<float>(std::sin(el));
+    }
+    table_rings_ = frame.rings;
+    table_beams_ = frame.beams;
+    table_az_start_ = frame.azimuth_start_deg;
+    table_az_step_ = frame.azimuth_step_deg;
+    table_elevations_ = frame.elevations_deg;
+}
+
+int32_t GroundObstacleSegmenter::find(int32_t i) {
+    while (parent_[i] != i) {
+        parent_[i] = parent_[parent_[i]]; // 路径减半
+        i = parent_[i];
+    }
+    return i;
+}
+
+void GroundObstacleSegmenter::unite(int32_t a, int32_t b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) {
+        return;
+    }
+    // 下标小的作为根，结果与合并顺序无关
+    if (a < b) {
+        parent_[b] = a;
+    } else {
+        parent_[a] = b;
+    }
+}
+
+bool GroundObstacleSegmenter::close(const SegmentationResult& out, int32_t a, int32_t b) const {
+    if (out.labels[a] != kLabelObstacle || out.labels[b] != kLabelObstacle) {
+        return false;
+    }
+    const float dx = out.x[a] - out.x[b];
+    const float dy = out.y[a] - out.y[b];
+    const float dz = out.z[a] - out.z[b];
+    return dx * dx + dy * dy + dz * dz < config_.cluster_tolerance * config_.cluster_tolerance;
+}
+
+void GroundObstacleSegmenter::processSector(const LidarFrame& frame, int begin_col, int end_col, SegmentationResult& out) {
+    const int beams = frame.beams;
+    const int num_bins = static_cast<int>(config_.max_range / config_.bin_size) + 1;
+    const float ideal_ground = -config_.sensor_height;
+
+    // 1. 投影，并记录每个距离桶的最低点
+    std::vector<float> bin_z(num_bins, std::numeric_limits<float>::max());
+    std::vector<float> bin_d(num_bins, 0.0f);
+    for (int r = 0; r < frame.rings; ++r) {
+        const float ce = cos_el_[r];
+        const float se = sin_el_[r];
+        for (int c = begin_col; c < end_col; ++c) {
+            const int32_t i = r * beams + c;
+            const float range = frame.ranges[i];
+            if (!(range > 0.0f)) {
+                out.labels[i] = kLabelInvalid;
+                out.x[i] = out.y[i] = out.z[i] = 0.0f;
+                continue;
+            }
+            const float planar = range * ce;
+            out.x[i] = planar * cos_az_[c];
+            out.y[i] = planar * sin_az_[c];
+            out.z[i] = range * se;
+            out.labels[i] = kLabelObstacle;
+            const int bin = std::min(num_bins - 1, static_cast<int>(planar / config_.bin_size));
+            if (out.z[i] < bin_z[bin]) {
+                bin_z[bin] = out.z[i];
+                bin_d[bin] = planar;
+            }
+        }
+    }
+
+    // 2. 最小二乘拟合地面线 z = a * d + b
+    double sd = 0.0, sz = 0.0, sdd = 0.0, sdz = 0.0;
+    int count = 0;
+    for (int bin = 0; bin < num_bins; ++bin) {
+        if (bin_z[bin] < ideal_ground + config_.max_ground_offset) {
+            sd += bin_d[bin];
+            sz += bin_z[bin];
+            sdd += static_cast<double>(bin_d[bin]) * bin_d[bin];
+            sdz += static_cast<double>(bin_d[bin]) * bin_z[bin];
+            ++count;
+        }
+    }
+    float slope = 0.0f;
+    float intercept = ideal_ground;
+    const double denom = count * sdd - sd * sd;
+    if (count >= 2 && std::fabs(denom) > 1e-6) {
+        slope = static_cast<float>((count * sdz - sd * sz) / denom);
+        slope = std::max(-config_.max_slope, std::min(config_.max_slope, slope));
+        intercept = static_cast<float>((sz - slope * sd) / count);
+    } else if (count == 1) {
+        intercept = static_cast<float>(sz);
+    }
+
+    // 3. 地面标记
+    for (int r = 0; r < frame.rings; ++r) {
+        for (int c = begin_col; c < end_col; ++c) {
+            const int32_t i = r * beams + c;
+            if (out.labels[i] != kLabelObstacle) {
+                continue;
+            }
+            const float planar = std::sqrt(out.x[i] * out.x[i] + out.y[i] * out.y[i]);
+            if (std::fabs(out.z[i] - (slope * planar + intercept)) < config_.ground_threshold) {
+                out.labels[i] = kLabelGround;
+            }
+        }
+    }
+
+    // 4. 扇区内的连通域，只会修改本扇区内的并查集节点
+    for (int r = 0; r < frame.rings; ++r) {
+        for (int c = begin_col; c < end_col; ++c) {
+            const int32_t i = r * beams + c;
+            parent_[i] = i;
+        }
+    }
+    for (int r = 0; r < frame.rings; ++r) {
+        for (int c = begin_col; c < end_col; ++c) {
+            const int32_t i = r * beams + c;
+            if (out.labels[i] != kLabelObstacle) {
+                continue;
+            }
+            if (c + 1 < end_col && close(out, i, i + 1)) {
+                unite(i, i + 1);
+            }
+            if (r + 1 < frame.rings && close(out, i, i + beams)) {
+                unite(i, i + beams);
+            }
+        }
+    }
+}
+
+void GroundObstacleSegmenter::process(const LidarFrame& frame, SegmentationResult& out) {
+    const size_t n = frame.ranges.size();
+    if (frame.rings <= 0 || frame.beams <= 0 || n != static_cast<size_t>(frame.rings) * frame.beams ||
+        frame.elevations_deg.size() != static_cast<size_t>(frame.rings)) {
+        throw std::invalid_argument("GroundObstacleSegmenter: invalid frame");
+    }
+    updateTables(frame);
+    out.x.resize(n);
+    out.y.resize(n);
+    out.z.resize(n);
+    out.labels.resize(n);
+    out.cluster_ids.assign(n, -1);
+    out.obstacles.clear();
+    parent_.resize(n);
+
+    const int sectors = std::min(config_.sectors, frame.beams);
+    auto sectorBegin = [&](int s) { return static_cast<int>(static_cast<int64_t>(s) * frame.beams / sectors); };
+    auto runSector = [&](size_t s) {
+        processSector(frame, sectorBegin(static_cast<int>(s)), sectorBegin(static_cast<int>(s) + 1), out);
+    };
+    if (pool_) {
+        pool_->parallelFor(static_cast<size_t>(sectors), runSector);
+    } else {
+        for (int s = 0; s < sectors; ++s) {
+            runSector(static_cast<size_t>(s));
+        }
+    }
+
+    // 合并扇区边界（最后一个扇区与第一个扇区首尾相接）
+    for (int s = 0; s < sectors; ++s) {
+        const int last_col = sectorBegin(s + 1) - 1;
+        const int next_col = sectorBegin(s + 1) % frame.beams;
+        if (sectors == 1 && frame.beams == 1) {
+            break;
+        }
+        for (int r = 0; r < frame.rings; ++r) {
+            const int32_t a = r * frame.beams + last_col;
+            const int32_t b = r * frame.beams + next_col;
+            if (close(out, a, b)) {
+                unite(a, b);
+            }
+        }
+    }
+
+    // 汇总包围盒
+    root_cluster_.assign(n, -1);
+    std::vector<ObstacleBox> boxes;
+    out.ground_points = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (out.labels[i] == kLabelGround) {
+            ++out.ground_points;
+            continue;
+        }
+        if (out.labels[i] != kLabelObstacle) {
+            continue;
+        }
+        const int32_t root = find(static_cast<int32_t>(i));
+        int32_t& id = root_cluster_[root];
+        if (id < 0) {
+            id = static_cast<int32_t>(boxes.size());
+            boxes.push_back({out.x[i], out.y[i], out.z[i], out.x[i], out.y[i], out.z[i], 0});
+        }
+        ObstacleBox& box = boxes[id];
+        box.min_x = std::min(box.min_x, out.x[i]);
+        box.min_y = std::min(box.min_y, out.y[i]);
+        box.min_z = std::min(box.min_z, out.z[i]);
+        box.max_x = std::max(box.max_x, out.x[i]);
+        box.max_y = std::max(box.max_y, out.y[i]);
+        box.max_z = std::max(box.max_z, out.z[i]);
+        ++box.num_points;
+        out.cluster_ids[i] = id;
+    }
+
+    // 去掉过小的簇并重新编号
+    std::vector<int32_t> remap(boxes.size(), -1);
+    for (size_t c = 0; c < boxes.size(); ++c) {
+        if (boxes[c].num_points >= config_.min_cluster_points) {
+            remap[c] = static_cast<int32_t>(out.obstacles.size());
+            out.obstacles.push_back(boxes[c]);
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (out.cluster_ids[i] >= 0) {
+            out.cluster_ids[i] = remap[out.cluster_ids[i]];
+        }
+    }
+}
+
+}
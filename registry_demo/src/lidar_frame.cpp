@@ -0,0 +1,91 @@
+#include "lidar_frame.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+namespace duan {
+
+namespace {
+
+struct Box {
+    float min[3];
+    float max[3];
+};
+
+// 射线与轴对齐包围盒求交 (slab法)，返回进入距离，未命中返回-1
+float intersect(const float dir[3], const Box& box) {
+    float t_near = 0.0f;
+    float t_far = 1e9f;
+    for (int a = 0; a < 3; ++a) {
+        if (std::fabs(dir[a]) < 1e-9f) {
+            if (box.min[a] > 0.0f || box.max[a] < 0.0f) {
+                return -1.0f;
+            }
+            continue;
+        }
+        float t0 = box.min[a] / dir[a];
+        float t1 = box.max[a] / dir[a];
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        t_near = std::max(t_near, t0);
+        t_far = std::min(t_far, t1);
+        if (t_near > t_far) {
+            return -1.0f;
+        }
+    }
+    return t_near;
+}
+
+}
+
+LidarFrame simulateLidarFrame(int rings, int beams, uint64_t seq, float sensor_height) {
+    constexpr float kDegToRad = 3.14159265f / 180.0f;
+    constexpr float kMaxRange = 120.0f;
+
+    LidarFrame frame;
+    frame.seq = seq;
+    frame.timestamp = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    frame.rings = rings;
+    frame.beams = beams;
+    frame.azimuth_start_deg = 0.0f;
+    frame.azimuth_step_deg = 360.0f / beams;
+    frame.elevations_deg.resize(rings);
+    for (int r = 0; r < rings; ++r) {
+        frame.elevations_deg[r] = rings > 1 ? -24.8f + 26.8f * r / (rings - 1) : 0.0f;
+    }
+
+    // 障碍物随帧号缓慢移动
+    const float shift = static_cast<float>(seq % 100) * 0.1f;
+    const float ground = -sensor_height;
+    const std::vector<Box> boxes = {
+        {{8.0f + shift, -1.0f, ground}, {12.5f + shift, 1.0f, ground + 1.6f}},
+        {{-20.0f, 4.0f, ground}, {-15.5f, 6.0f, ground + 1.5f}},
+        {{3.0f, -9.0f, ground}, {3.6f, -8.4f, ground + 1.8f}},
+        {{25.0f, 10.0f, ground}, {37.0f, 12.5f, ground + 3.5f}},
+        {{-6.0f, -14.0f, ground}, {-5.5f, -13.5f, ground + 1.7f}},
+    };
+
+    std::mt19937 gen(static_cast<uint32_t>(seq));
+    std::normal_distribution<float> noise(0.0f, 0.01f);
+    frame.ranges.resize(static_cast<size_t>(rings) * beams);
+    for (int r = 0; r < rings; ++r) {
+        const float el = frame.elevations_deg[r] * kDegToRad;
+        for (int b = 0; b < beams; ++b) {
+            const float az = (frame.azimuth_start_deg + b * frame.azimuth_step_deg) * kDegToRad;
+            const float dir[3] = {std::cos(el) * std::cos(az), std::cos(el) * std::sin(az), std::sin(el)};
+            float t = dir[2] < 0.0f ? ground / dir[2] : kMaxRange + 1.0f;
+            for (const Box& box : boxes) {
+                float hit = intersect(dir, box);
+                if (hit > 0.0f) {
+                    t = std::min(t, hit);
+                }
+            }
+            frame.ranges[static_cast<size_t>(r) * beams + b] = t <= kMaxRange ? t + noise(gen) : 0.0f;
+        }
+    }
+    return frame;
+}
+
+}
@@ -1,42 +1,131 @@
 #include "component.hpp"
+#include "config_cache.hpp"
+#include "config_watcher.hpp"
 #include "registry.hpp"
+#include "pipeline_executor.hpp"
+#include "pipeline_topics.hpp"
+#include "plugin_loader.hpp"
+#include "realtime_executor.hpp"
+#include <chrono>
 #include <fstream>
 #include <iostream>
-#include <vector>
-#include "nlohmann/json.hpp"
+#include <memory>
 
 int main(){
-    std::ifstream fin("../config/pipeline_config.json");
-    if(!fin){
-        std::cerr << "Config file open failed!" << std::endl;
+    // 配置未改动时直接映射上次编译的二进制缓存，跳过 JSON 解析与校验；
+    // 缓存里已经解析好话题，组件构造时据此发布/订阅
+    const std::string config_path = "../config/pipeline_config.json";
+    duan::ConfigLoadOptions cache_options;
+    cache_options.cache_path = "pipeline_config.bin";
+    // 组件直接从映射的配置解码，执行器持有它，启动时不构建 DOM
+    std::shared_ptr<const duan::CompiledConfig> compiled;
+    try {
+        compiled = std::make_shared<const duan::CompiledConfig>(duan::ConfigCache::load(config_path, cache_options));
+    } catch (const std::exception& e) {
+        std::cerr << "Pipeline config invalid: " << e.what() << std::endl;
+        return 1;
     }
+    std::cout << "Config " << (compiled->mapped() ? "cache hit" : "compiled") << " ("
+              << compiled->byteSize() << " bytes)" << std::endl;
+    const duan::ConfigView config = compiled->root();
 
-    nlohmann::json config;
-    fin >> config;
-
-    std::vector<std::shared_ptr<duan::Component>> sensors;
-    std::vector<std::shared_ptr<duan::Component>> algos;
+    // 只加载配置中用到的组件类型所在的库
+    duan::PluginLoader plugins({"./plugins", DUAN_PLUGIN_DIR});
+    try {
+        plugins.addManifest(config);
+        plugins.loadFor(config);
+    } catch (const std::exception& e) {
+        std::cerr << "Plugin load failed: " << e.what() << std::endl;
+        return 1;
+    }
+    // 注册到此结束，之后按类型创建组件走完美哈希
+    duan::ComponentRegistry::Seal();
+    std::cout << "Loaded component libraries:";
+    for (const auto& library : plugins.loadedLibraries()) {
+        std::cout << " " << library;
+    }
+    std::cout << std::endl;
 
-    // 创建所有传感器对象并启动
-    for(const auto& sn : config["sensors"]){
-        auto inst = duan::ComponentRegistry::Create(sn.at("type"), sn);
-        if(inst){
-            sensors.push_back(inst);
-            inst->start();
-        } else {
-            std::cerr << "Sensor create failed" << sn["type"] << std::endl;
+    // 按 "input" 构建依赖图并创建全部组件
+    std::unique_ptr<duan::PipelineExecutor> executor;
+    try {
+        executor = std::make_unique<duan::PipelineExecutor>(compiled, duan::executorOptions(config));
+    } catch (const std::exception& e) {
+        std::cerr << "Pipeline build failed: " << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "Pipeline graph (" << executor->threads() << " threads):" << std::endl;
+    executor->graph().describe(std::cout);
+    // 单入单出的线性链合并为一个调度任务
+    for (const auto& task : executor->tasks()) {
+        if (task.size() > 1) {
+            std::cout << "  fused:";
+            for (size_t i = 0; i < task.size(); ++i) {
+                std::cout << (i ? " -> " : " ") << executor->graph().node(task[i]).name;
+            }
+            std::cout << std::endl;
         }
     }
+    // 组件在上游启动完成后立即启动，互不依赖的并行启动
+    try {
+        executor->start().print(std::cout);
+    } catch (const std::exception& e) {
+        executor->startupTimeline().print(std::cerr);
+        std::cerr << "Pipeline start failed: " << e.what() << std::endl;
+        return 1;
+    }
 
-    // 创建所有算法对象并启动
-    for (const auto& algo : config["algorithms"]) {
-        auto inst = duan::ComponentRegistry::Create(algo["type"], algo);
-        if (inst) {
-            algos.push_back(inst);
-            inst->start();
+    // 驱动几帧数据：每个组件在上游完成本帧后立即执行，独立分支并行
+    // 帧间检查配置文件，改动后只重建变化的组件及其下游，其余组件（尤其是传感器）不中断；
+    // 读配置、加载插件和新组件的 start() 在后台线程进行，就绪后才在两帧之间替换
+    duan::ConfigWatcher watcher(config_path);
+    const int frames = config.value("demo_frames", 5);
+    for (int i = 0; i < frames; ++i) {
+        try {
+            if (auto plan = executor->pollReload()) {
+                plan->print(std::cout);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Pipeline reload failed, keeping current pipeline: " << e.what() << std::endl;
+        }
+        // 后台热加载期间的改动留到它结束后再检查
+        if (!executor->reloading() && watcher.poll()) {
+            executor->beginReload([&] {
+                auto next = std::make_shared<const duan::CompiledConfig>(duan::ConfigCache::load(config_path, cache_options));
+                plugins.addManifest(next->root());
+                plugins.loadFor(next->root());
+                return next;
+            });
         }
-        else {
-            std::cout << "Algo create failed: " << algo["type"] << std::endl;
+        executor->runFrame();
+    }
+
+    // 每条边的队列积压与丢弃数
+    executor->printEdgeStats(std::cout);
+
+    // "executor": {"profile": true} 时输出各组件开销、关键路径和可在 chrome://tracing 查看的时间线
+    if (const duan::Profiler* profiler = executor->profiler()) {
+        profiler->print(std::cout);
+        std::ofstream trace("pipeline_trace.json");
+        profiler->writeChromeTrace(trace);
+        std::cout << "Trace written to pipeline_trace.json" << std::endl;
+    }
+
+    // 配置了 "realtime" 时再由实时执行器按各组件的周期、截止时间与优先级运行一段时间，
+    // 统计截止时间错过次数；priority 为0的组件（如 obstacle_clustering）只在后台线程上执行，不会推迟 ekf
+    // 使用最后一次成功热加载的配置，而不是启动时的
+    const std::shared_ptr<const duan::CompiledConfig> applied = executor->config();
+    const duan::ConfigView current = applied->root();
+    if (current.contains("realtime")) {
+        executor.reset(); // 先释放帧驱动的组件及其订阅（会等未完成的后台热加载结束）
+        try {
+            duan::RealtimeExecutor realtime(applied, duan::realtimeOptions(current));
+            realtime.start();
+            realtime.runFor(std::chrono::milliseconds(current.at("realtime").value("duration_ms", 300)));
+            realtime.print(std::cout);
+        } catch (const std::exception& e) {
+            std::cerr << "Realtime run failed: " << e.what() << std::endl;
+            return 1;
         }
     }
 
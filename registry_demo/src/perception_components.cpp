@@ -0,0 +1,77 @@
+#include "component.hpp"
+#include "plugin_api.hpp"
+#include "ground_segmentation.hpp"
+#include "messages.hpp"
+#include "pipeline_topics.hpp"
+#include <iostream>
+#include <memory>
+
+namespace duan {
+
+struct GroundClusterConfig : PortConfig, SegmentationConfig {
+    unsigned threads = 0;   // 0 表示硬件并发数
+};
+
+}
+
+DUAN_CONFIG_SCHEMA_EXTENDS(duan::GroundClusterConfig, duan::PortConfig,
+    DUAN_FIELD(sensor_height),
+    DUAN_FIELD(sectors),
+    DUAN_FIELD(ground_threshold),
+    DUAN_FIELD(cluster_tolerance),
+    DUAN_FIELD(min_cluster_points),
+    DUAN_FIELD(threads))
+
+namespace duan {
+
+// 地面分割 + 障碍物聚类
+class GroundClusterStage : public TopicComponent {
+    std::vector<std::string> input_;
+    std::unique_ptr<ThreadPool> pool_;
+    GroundObstacleSegmenter segmenter_;
+    SegmentationResult result_;
+    uint64_t seq_ = 0;
+
+public:
+    explicit GroundClusterStage(const GroundClusterConfig& cfg)
+        : TopicComponent(cfg),
+          input_(cfg.input),
+          pool_(std::make_unique<ThreadPool>(cfg.threads)),
+          segmenter_(cfg, pool_.get()) {}
+
+    void start() override {
+        std::cout << "[GroundCluster] Obstacle segmentation (" << segmenter_.config().sectors
+                  << " sectors, " << pool_->size() << " threads) with input: ";
+        for (auto& in : input_) std::cout << in << " ";
+        std::cout << std::endl;
+    }
+
+    const SegmentationResult& segment(const LidarFrame& frame) {
+        segmenter_.process(frame, result_);
+        return result_;
+    }
+
+    void process(const FrameContext&, const Inputs& in, Outputs& out) override {
+        auto frame = in.get<LidarFrame>();
+        if (!frame) return;
+
+        segment(*frame);
+        auto obstacles = std::make_shared<ObstacleList>();
+        obstacles->seq = seq_++;
+        obstacles->timestamp = frame->timestamp;
+        obstacles->obstacles = result_.obstacles;
+        obstacles->ground_points = result_.ground_points;
+        out.publish(std::move(obstacles));
+    }
+};
+
+}
+
+// 组件库注册: 静态链接时启动即注册，编译为插件时由 PluginLoader 按需加载
+namespace {
+    void registerPerception(duan::PluginRegistrar& registrar) {
+        registrar.addTyped<duan::GroundClusterConfig>("ground_cluster", [](const duan::GroundClusterConfig& cfg){ return std::make_shared<duan::GroundClusterStage>(cfg); });
+    }
+}
+
+DUAN_COMPONENT_LIBRARY("perception", registerPerception)
@@ -0,0 +1,705 @@
+#include "pipeline_executor.hpp"
+#include "pipeline_topics.hpp"
+#include "registry.hpp"
+#include "thread_pool.hpp"
+#include "work_stealing_scheduler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace duan {
+
+PipelineGraph::PipelineGraph(const ConfigView& config) {
+    std::unordered_map<std::string, size_t> index_of;
+    for (const char* section : {"sensors", "algorithms"}) {
+        if (!config.contains(section)) {
+            continue;
+        }
+        const ConfigView list = config.at(section);
+        for (size_t k = 0; k < list.size(); ++k) {
+            const ConfigView comp = list[k];
+            PipelineNode node;
+            node.name = std::string(comp.at("name").asString());
+            node.type = std::string(comp.at("type").asString());
+            node.config = comp;
+            if (!index_of.emplace(node.name, nodes_.size()).second) {
+                throw std::runtime_error("组件名重复: " + node.name);
+            }
+            nodes_.push_back(std::move(node));
+        }
+    }
+
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        const ConfigView& cfg = nodes_[i].config;
+        if (!cfg.contains("input")) {
+            continue;
+        }
+        const ConfigView input = cfg.at("input");
+        for (size_t k = 0; k < input.size(); ++k) {
+            const std::string upstream(input[k].asString());
+            auto it = index_of.find(upstream);
+            if (it == index_of.end()) {
+                throw std::runtime_error("组件 " + nodes_[i].name + " 的输入不存在: " + upstream);
+            }
+            if (std::find(nodes_[i].inputs.begin(), nodes_[i].inputs.end(), it->second) != nodes_[i].inputs.end()) {
+                continue; // 重复的输入只算一条边
+            }
+            nodes_[i].inputs.push_back(it->second);
+            nodes_[it->second].outputs.push_back(i);
+        }
+    }
+
+    // Kahn 拓扑排序，按层推进，同层保持配置顺序
+    std::vector<size_t> pending(nodes_.size());
+    depths_.assign(nodes_.size(), 0);
+    std::vector<size_t> layer;
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        pending[i] = nodes_[i].inputs.size();
+        if (pending[i] == 0) {
+            layer.push_back(i);
+        }
+    }
+    while (!layer.empty()) {
+        std::vector<size_t> next;
+        for (size_t i : layer) {
+            order_.push_back(i);
+            for (size_t out : nodes_[i].outputs) {
+                depths_[out] = std::max(depths_[out], depths_[i] + 1);
+                if (--pending[out] == 0) {
+                    next.push_back(out);
+                }
+            }
+        }
+        std::sort(next.begin(), next.end());
+        layer.swap(next);
+    }
+    if (order_.size() != nodes_.size()) {
+        std::string cycle;
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            if (pending[i] != 0) {
+                cycle += (cycle.empty() ? "" : ", ") + nodes_[i].name;
+            }
+        }
+        throw std::runtime_error("组件依赖存在环: " + cycle);
+    }
+}
+
+size_t PipelineGraph::find(const std::string& name) const {
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        if (nodes_[i].name == name) {
+            return i;
+        }
+    }
+    return npos;
+}
+
+void PipelineGraph::describe(std::ostream& os) const {
+    for (size_t i : order_) {
+        const PipelineNode& node = nodes_[i];
+        os << "  [" << depths_[i] << "] " << node.name << " (" << node.type << ")";
+        if (!node.inputs.empty()) {
+            os << " <-";
+            for (size_t in : node.inputs) {
+                os << " " << nodes_[in].name;
+            }
+        }
+        os << "\n";
+    }
+}
+
+double StartupTimeline::sequentialMs() const {
+    double sum = 0.0;
+    for (const auto& phase : phases) {
+        if (phase.status == StartupStatus::Started || phase.status == StartupStatus::Failed) {
+            sum += phase.end_ms - phase.begin_ms;
+        }
+    }
+    return sum;
+}
+
+void StartupTimeline::print(std::ostream& os) const {
+    constexpr int kWidth = 40;
+    const double scale = total_ms > 0.0 ? kWidth / total_ms : 0.0;
+    std::ios saved(nullptr);
+    saved.copyfmt(os);
+    os << "Startup timeline: " << std::fixed << std::setprecision(2) << total_ms << " ms (sequential "
+       << sequentialMs() << " ms)\n";
+    for (const auto& phase : phases) {
+        os << "  " << std::left << std::setw(22) << phase.name << std::right;
+        if (phase.status == StartupStatus::Skipped || phase.status == StartupStatus::Pending) {
+            os << " skipped\n";
+            continue;
+        }
+        // '.' 等待上游，'#' 执行 start()
+        const int ready = static_cast<int>(phase.ready_ms * scale);
+        const int begin = std::max(ready, static_cast<int>(phase.begin_ms * scale));
+        const int end = std::max(begin + 1, static_cast<int>(phase.end_ms * scale));
+        os << " |" << std::string(ready, ' ') << std::string(begin - ready, '.') << std::string(end - begin, '#')
+           << std::string(std::max(0, kWidth + 1 - end), ' ') << "| " << std::setw(7) << phase.begin_ms << " -> "
+           << std::setw(7) << phase.end_ms << " ms" << (phase.status == StartupStatus::Failed ? "  FAILED" : "") << "\n";
+    }
+    os.copyfmt(saved);
+}
+
+ReloadPlan diffPipeline(const PipelineGraph& running, const PipelineGraph& next) {
+    ReloadPlan plan;
+    std::vector<bool> rebuild(next.size(), false);
+    for (size_t i : next.order()) {
+        const PipelineNode& node = next.node(i);
+        const size_t old = running.find(node.name);
+        if (old == PipelineGraph::npos) {
+            plan.added.push_back(node.name);
+            rebuild[i] = true;
+        } else if (running.node(old).config != node.config) {
+            plan.changed.push_back(node.name);
+            rebuild[i] = true;
+        } else if (std::any_of(node.inputs.begin(), node.inputs.end(), [&](size_t in) { return rebuild[in]; })) {
+            // 拓扑序保证上游已经判定过
+            plan.downstream.push_back(node.name);
+            rebuild[i] = true;
+        } else {
+            plan.kept.push_back(node.name);
+        }
+    }
+    for (const PipelineNode& node : running.nodes()) {
+        if (next.find(node.name) == PipelineGraph::npos) {
+            plan.removed.push_back(node.name);
+        }
+    }
+    return plan;
+}
+
+void ReloadPlan::print(std::ostream& os) const {
+    auto line = [&os](const char* label, const std::vector<std::string>& names) {
+        if (names.empty()) {
+            return;
+        }
+        os << "  " << label << ":";
+        for (const auto& name : names) {
+            os << " " << name;
+        }
+        os << "\n";
+    };
+    os << "Reload: " << rebuilt() << " rebuilt, " << removed.size() << " removed, " << kept.size() << " kept\n";
+    line("added", added);
+    line("changed", changed);
+    line("downstream", downstream);
+    line("removed", removed);
+    line("kept", kept);
+}
+
+std::vector<std::vector<size_t>> fuseLinearChains(const PipelineGraph& graph, const std::vector<bool>& fusible) {
+    // 节点接在唯一上游之后的条件: 自己只有这一个输入、上游只有自己这一个输出，且两者都允许合并
+    auto joinsUpstream = [&](size_t i) {
+        const PipelineNode& node = graph.node(i);
+        return node.inputs.size() == 1 && graph.node(node.inputs[0]).outputs.size() == 1 && fusible[i] &&
+               fusible[node.inputs[0]];
+    };
+    std::vector<std::vector<size_t>> chains;
+    for (size_t i : graph.order()) {
+        if (joinsUpstream(i)) {
+            continue;
+        }
+        std::vector<size_t> chain{i};
+        while (graph.node(chain.back()).outputs.size() == 1 && joinsUpstream(graph.node(chain.back()).outputs[0])) {
+            chain.push_back(graph.node(chain.back()).outputs[0]);
+        }
+        chains.push_back(std::move(chain));
+    }
+    return chains;
+}
+
+// 一次图遍历（一帧或一次启动）的调度状态，由本次所有任务共享
+struct PipelineExecutor::RunState {
+    std::function<void(size_t)> action;
+    std::unique_ptr<std::atomic<size_t>[]> waiting; // 每个节点尚未完成的上游数
+    Profiler* profiler = nullptr;                   // 非空时记录每个节点的就绪时刻
+    std::atomic<size_t> remaining{0};
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr error;
+};
+
+ExecutorOptions executorOptions(const ConfigView& config) {
+    ExecutorOptions options;
+    if (!config.contains("executor")) {
+        return options;
+    }
+    const ConfigView cfg = config.at("executor");
+    options.threads = static_cast<size_t>(cfg.value("threads", static_cast<int64_t>(options.threads)));
+    options.pin_threads = cfg.value("pin_threads", options.pin_threads);
+    options.profile = cfg.value("profile", options.profile);
+    options.fuse_chains = cfg.value("fuse_chains", options.fuse_chains);
+    const std::string scheduler(cfg.value("scheduler", "work_stealing"));
+    if (scheduler == "work_stealing") {
+        options.scheduler = SchedulerKind::WorkStealing;
+    } else if (scheduler == "shared_queue") {
+        options.scheduler = SchedulerKind::SharedQueue;
+    } else {
+        throw std::runtime_error("未知的调度器: " + scheduler);
+    }
+    return options;
+}
+
+PipelineExecutor::PipelineExecutor(std::shared_ptr<const CompiledConfig> config, size_t num_threads)
+    : PipelineExecutor(std::move(config), ExecutorOptions{num_threads, SchedulerKind::WorkStealing, false}) {}
+
+PipelineExecutor::PipelineExecutor(const nlohmann::json& config, size_t num_threads)
+    : PipelineExecutor(std::make_shared<const CompiledConfig>(CompiledConfig::compile(config)), num_threads) {}
+
+PipelineExecutor::PipelineExecutor(const nlohmann::json& config, const ExecutorOptions& options)
+    : PipelineExecutor(std::make_shared<const CompiledConfig>(CompiledConfig::compile(config)), options) {}
+
+PipelineExecutor::PipelineExecutor(std::shared_ptr<const CompiledConfig> config, const ExecutorOptions& options)
+    : config_(std::move(config)), graph_(config_->root()) {
+    // 创建任何组件前先解码并检查全部节点，一次报告所有错误
+    const std::vector<ComponentRegistry::Factory> factories = prepareNodes(graph_, {});
+
+    components_.resize(graph_.size());
+    stats_.resize(graph_.size());
+    latency_budget_us_.resize(graph_.size());
+    for (size_t i = 0; i < graph_.size(); ++i) {
+        const PipelineNode& node = graph_.node(i);
+        latency_budget_us_[i] = node.config.value("batch_latency_ms", 0.0) * 1000.0;
+        components_[i] = createNode(node, factories[i]);
+    }
+    fuse_chains_ = options.fuse_chains;
+    planTasks();
+
+    if (options.scheduler == SchedulerKind::SharedQueue) {
+        scheduler_ = std::make_unique<ThreadPool>(options.threads);
+    } else {
+        WorkStealingOptions ws;
+        ws.threads = options.threads;
+        ws.pin_threads = options.pin_threads;
+        scheduler_ = std::make_unique<WorkStealingScheduler>(ws);
+    }
+    if (options.profile) {
+        enableProfiling();
+    }
+}
+
+PipelineExecutor::~PipelineExecutor() = default;
+
+std::vector<ComponentRegistry::Factory> PipelineExecutor::prepareNodes(const PipelineGraph& graph,
+                                                                      const std::vector<bool>& only) {
+    std::string errors;
+    std::vector<ComponentRegistry::Factory> factories(graph.size());
+    for (size_t i = 0; i < graph.size(); ++i) {
+        if (!only.empty() && !only[i]) {
+            continue;
+        }
+        const PipelineNode& node = graph.node(i);
+        try {
+            // 未注册的类型得到空的 Factory，由 createNode 报告
+            factories[i] = ComponentRegistry::Prepare(ComponentRegistry::Find(node.type), node.config);
+        } catch (const std::exception& e) {
+            errors += "\n  " + node.name + " (" + node.type + "): " + e.what();
+        }
+    }
+    if (!errors.empty()) {
+        throw std::runtime_error("组件配置不合法:" + errors);
+    }
+    return factories;
+}
+
+std::shared_ptr<Component> PipelineExecutor::createNode(const PipelineNode& node, const ComponentRegistry::Factory& factory) {
+    std::shared_ptr<Component> component = factory ? factory() : nullptr;
+    if (!component) {
+        throw std::runtime_error("未注册的组件类型: " + node.type + " (" + node.name + ")");
+    }
+    return component;
+}
+
+StartupTimeline PipelineExecutor::start() {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point t0 = Clock::now();
+    auto ms = [t0](Clock::time_point t) { return std::chrono::duration<double, std::milli>(t - t0).count(); };
+
+    StartupTimeline timeline;
+    timeline.phases.resize(graph_.size());
+    // 每个节点只写自己的槽位；上游的结果经 waiting 计数的 acq_rel 对下游可见
+    std::vector<StartupPhase>& phases = timeline.phases;
+    for (size_t i = 0; i < graph_.size(); ++i) {
+        phases[i].name = graph_.node(i).name;
+    }
+
+    std::exception_ptr error = runGraph([&](size_t index) {
+        StartupPhase& phase = phases[index];
+        for (size_t in : graph_.node(index).inputs) {
+            if (phases[in].status != StartupStatus::Started) {
+                phase.status = StartupStatus::Skipped; // 上游没起来，不启动
+                return;
+            }
+        }
+        const Clock::time_point begin = Clock::now();
+        phase.ready_ms = 0.0;
+        for (size_t in : graph_.node(index).inputs) {
+            phase.ready_ms = std::max(phase.ready_ms, phases[in].end_ms);
+        }
+        phase.begin_ms = ms(begin);
+        try {
+            components_[index]->start();
+        } catch (...) {
+            phase.end_ms = ms(Clock::now());
+            phase.status = StartupStatus::Failed;
+            throw;
+        }
+        phase.end_ms = ms(Clock::now());
+        phase.status = StartupStatus::Started;
+    });
+    timeline.total_ms = ms(Clock::now());
+    startup_ = timeline;
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return timeline;
+}
+
+size_t PipelineExecutor::chooseBatch(size_t index, size_t pending) const {
+    size_t limit = std::max<size_t>(1, components_[index]->maxBatchSize());
+    const NodeStats& stats = stats_[index];
+    if (latency_budget_us_[index] > 0.0 && stats.frame_cost_us > 0.0) {
+        const double fit = latency_budget_us_[index] / stats.frame_cost_us;
+        limit = std::min(limit, static_cast<size_t>(std::max(1.0, fit)));
+    }
+    return std::min(pending, limit);
+}
+
+void PipelineExecutor::execute(size_t index) {
+    Component& component = *components_[index];
+    NodeStats& stats = stats_[index];
+    ComponentPorts* ports = component.ports();
+    if (!ports) {
+        component.spinOnce();
+        ++stats.calls;
+        ++stats.frames;
+        stats.last_batch = 1;
+        stats.max_batch = std::max<size_t>(stats.max_batch, 1);
+        return;
+    }
+
+    const size_t pending = ports->pending();
+    stats.last_batch = 0;
+    if (pending == 0) {
+        return;
+    }
+    const size_t batch = std::min(chooseBatch(index, pending), ports->credits());
+    if (batch == 0) {
+        ++stats.throttled; // 下游 block 队列已满，输入留到之后的帧
+        return;
+    }
+    const auto begin = std::chrono::steady_clock::now();
+    const size_t frames = runComponent(component, *ports, frames_, batch);
+    if (frames == 0) {
+        return;
+    }
+    const double cost_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() /
+                           static_cast<double>(frames);
+    constexpr double kAlpha = 0.2;
+    stats.frame_cost_us = stats.calls == 0 ? cost_us : stats.frame_cost_us + kAlpha * (cost_us - stats.frame_cost_us);
+    ++stats.calls;
+    stats.frames += frames;
+    stats.last_batch = frames;
+    stats.max_batch = std::max(stats.max_batch, frames);
+}
+
+void PipelineExecutor::runTask(const std::shared_ptr<RunState>& state, size_t task) {
+    for (;;) {
+        // 合并的链在当前线程依次执行，链内不经过调度器；组件抛出异常时链上后续组件照常执行
+        const std::vector<size_t>& chain = tasks_[task];
+        for (size_t k = 0; k < chain.size(); ++k) {
+            if (k > 0 && state->profiler) {
+                state->profiler->markReady(chain[k]);
+            }
+            try {
+                state->action(chain[k]);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->error) {
+                    state->error = std::current_exception();
+                }
+            }
+        }
+
+        // 释放下游；就绪的第一个下游留在当前线程继续执行，省一次调度往返，
+        // 其余的提交到调度器（工作窃取时进入本线程队列，由空闲线程窃取）
+        size_t follow = PipelineGraph::npos;
+        for (size_t out : graph_.node(chain.back()).outputs) {
+            const size_t next = task_of_[out];
+            if (state->waiting[next].fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                continue;
+            }
+            if (state->profiler) {
+                state->profiler->markReady(out);
+            }
+            if (follow == PipelineGraph::npos) {
+                follow = next;
+            } else {
+                scheduler_->schedule([this, state, next] { runTask(state, next); });
+            }
+        }
+
+        if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->done.notify_all();
+        }
+        if (follow == PipelineGraph::npos) {
+            return;
+        }
+        task = follow;
+    }
+}
+
+std::exception_ptr PipelineExecutor::runGraph(std::function<void(size_t)> action, Profiler* profiler) {
+    if (tasks_.empty()) {
+        return nullptr;
+    }
+    auto state = std::make_shared<RunState>();
+    state->action = std::move(action);
+    state->profiler = profiler;
+    // 任务的上游数即链首节点的输入数，链首的每个输入都是另一条链的链尾
+    state->waiting.reset(new std::atomic<size_t>[tasks_.size()]);
+    for (size_t t = 0; t < tasks_.size(); ++t) {
+        state->waiting[t].store(graph_.node(tasks_[t].front()).inputs.size(), std::memory_order_relaxed);
+    }
+    state->remaining.store(tasks_.size(), std::memory_order_relaxed);
+
+    for (size_t t : source_tasks_) {
+        scheduler_->schedule([this, state, t] { runTask(state, t); });
+    }
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state] { return state->remaining.load(std::memory_order_acquire) == 0; });
+    return state->error;
+}
+
+void PipelineExecutor::planTasks() {
+    std::vector<bool> fusible(graph_.size(), fuse_chains_);
+    for (size_t i = 0; i < graph_.size() && fuse_chains_; ++i) {
+        fusible[i] = graph_.node(i).config.value("fuse", true) && components_[i]->fusible();
+    }
+    tasks_ = fuseLinearChains(graph_, fusible);
+    task_of_.assign(graph_.size(), 0);
+    source_tasks_.clear();
+    for (size_t t = 0; t < tasks_.size(); ++t) {
+        for (size_t i : tasks_[t]) {
+            task_of_[i] = t;
+        }
+        if (graph_.node(tasks_[t].front()).inputs.empty()) {
+            source_tasks_.push_back(t);
+        }
+    }
+}
+
+ReloadPlan PipelineExecutor::reload(const nlohmann::json& config) {
+    return reload(std::make_shared<const CompiledConfig>(CompiledConfig::compile(config)));
+}
+
+ReloadPlan PipelineExecutor::reload(std::shared_ptr<const CompiledConfig> config) {
+    if (reloading()) {
+        throw std::runtime_error("已有未完成的后台热加载");
+    }
+    return applyReload(prepareReload(std::move(config)));
+}
+
+void PipelineExecutor::beginReload(std::function<std::shared_ptr<const CompiledConfig>()> load) {
+    if (reloading()) {
+        throw std::runtime_error("已有未完成的后台热加载");
+    }
+    // 后台线程只读 graph_，它只在帧线程的 applyReload 中改变，而那要等这里完成
+    pending_reload_ = std::async(std::launch::async, [this, load = std::move(load)] { return prepareReload(load()); });
+}
+
+void PipelineExecutor::beginReload(std::shared_ptr<const CompiledConfig> config) {
+    beginReload([config = std::move(config)] { return config; });
+}
+
+std::optional<ReloadPlan> PipelineExecutor::pollReload() {
+    if (!reloading() || pending_reload_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return std::nullopt;
+    }
+    // get() 之后 future 失效，失败时下次可以重新开始
+    return applyReload(pending_reload_.get());
+}
+
+PipelineExecutor::PreparedReload PipelineExecutor::prepareReload(std::shared_ptr<const CompiledConfig> config) const {
+    PreparedReload prepared;
+    prepared.graph = PipelineGraph(config->root());
+    prepared.plan = diffPipeline(graph_, prepared.graph);
+    prepared.config = std::move(config);
+    if (prepared.plan.empty()) {
+        return prepared;
+    }
+
+    const PipelineGraph& next = prepared.graph;
+    prepared.rebuild.assign(next.size(), true);
+    for (const auto& name : prepared.plan.kept) {
+        prepared.rebuild[next.find(name)] = false;
+    }
+    const std::vector<ComponentRegistry::Factory> factories = prepareNodes(next, prepared.rebuild);
+
+    // 先创建并启动全部新组件，失败时它们随 prepared 一起析构，原流水线不受影响；
+    // 新组件的订阅在替换前暂停，不接收消息，也不占用保留的上游的额度
+    PausedSubscriptionScope paused;
+    prepared.fresh.resize(next.size());
+    for (size_t i : next.order()) {
+        if (prepared.rebuild[i]) {
+            prepared.fresh[i] = createNode(next.node(i), factories[i]);
+        }
+    }
+    for (size_t i : next.order()) {
+        if (prepared.rebuild[i]) {
+            prepared.fresh[i]->start();
+        }
+    }
+    return prepared;
+}
+
+ReloadPlan PipelineExecutor::applyReload(PreparedReload prepared) {
+    if (prepared.plan.empty()) {
+        // 图的节点仍指向旧配置，两份内容相同，不必切换
+        return std::move(prepared.plan);
+    }
+
+    // 替换: 保留的组件连同统计移到新下标，旧图中其余的组件在 retired 析构时取消订阅
+    PipelineGraph& next = prepared.graph;
+    std::vector<std::shared_ptr<Component>> retired;
+    retired.swap(components_);
+    std::vector<NodeStats> old_stats;
+    old_stats.swap(stats_);
+    components_.resize(next.size());
+    stats_.resize(next.size());
+    latency_budget_us_.assign(next.size(), 0.0);
+    for (size_t i = 0; i < next.size(); ++i) {
+        const PipelineNode& node = next.node(i);
+        if (prepared.rebuild[i]) {
+            components_[i] = std::move(prepared.fresh[i]);
+            if (ComponentPorts* ports = components_[i]->ports()) {
+                for (const auto& sub : ports->subscriptions()) {
+                    sub->resume();
+                }
+            }
+        } else {
+            const size_t old = graph_.find(node.name);
+            components_[i] = std::move(retired[old]);
+            stats_[i] = old_stats[old];
+        }
+        latency_budget_us_[i] = node.config.value("batch_latency_ms", 0.0) * 1000.0;
+    }
+    graph_ = std::move(next);
+    config_ = std::move(prepared.config);
+    planTasks();
+    if (profiler_) {
+        profiler_->bind(graph_);
+    }
+    return std::move(prepared.plan);
+}
+
+void PipelineExecutor::runFrame() {
+    if (!profiler_) {
+        std::exception_ptr error = runGraph([this](size_t index) { execute(index); });
+        ++frames_;
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return;
+    }
+    profiler_->beginFrame(frames_);
+    std::exception_ptr error = runGraph(
+        [this](size_t index) {
+            ProfileScope scope(*profiler_, index);
+            execute(index);
+            scope.frames = stats_[index].last_batch;
+        },
+        profiler_.get());
+    profiler_->endFrame(graph_);
+    ++frames_;
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void PipelineExecutor::run(int frames) {
+    for (int i = 0; i < frames; ++i) {
+        runFrame();
+    }
+}
+
+void PipelineExecutor::enableProfiling(size_t trace_frames) {
+    if (!profiler_) {
+        profiler_ = std::make_unique<Profiler>(trace_frames);
+        profiler_->bind(graph_);
+    }
+}
+
+const NodeStats& PipelineExecutor::stats(const std::string& name) const {
+    const size_t index = graph_.find(name);
+    if (index == PipelineGraph::npos) {
+        throw std::invalid_argument("不存在的组件: " + name);
+    }
+    return stats_[index];
+}
+
+std::vector<EdgeStats> PipelineExecutor::edgeStats() const {
+    std::vector<EdgeStats> edges;
+    for (size_t i : graph_.order()) {
+        ComponentPorts* ports = components_[i]->ports();
+        if (!ports) {
+            continue;
+        }
+        for (const auto& sub : ports->subscriptions()) {
+            EdgeStats edge;
+            edge.to = graph_.node(i).name;
+            edge.topic = sub->topic();
+            for (size_t in : graph_.node(i).inputs) {
+                if (graph_.node(in).config.value("topic", "") == sub->topic()) {
+                    edge.from = graph_.node(in).name;
+                    break;
+                }
+            }
+            edge.policy = sub->options().policy;
+            edge.capacity = sub->options().depth;
+            edge.depth = sub->pending();
+            edge.peak = sub->peak();
+            edge.received = sub->received();
+            edge.dropped = sub->dropped();
+            edge.blocked = sub->blocked();
+            edges.push_back(std::move(edge));
+        }
+    }
+    return edges;
+}
+
+void PipelineExecutor::printEdgeStats(std::ostream& os) const {
+    static const char* const kPolicy[] = {"keep_latest", "drop_newest", "block"};
+    os << "Edge queues:\n";
+    for (const EdgeStats& edge : edgeStats()) {
+        os << "  " << std::left << std::setw(34) << ((edge.from.empty() ? edge.topic : edge.from) + " -> " + edge.to)
+           << std::right << " " << std::setw(11) << kPolicy[static_cast<int>(edge.policy)] << "  depth " << edge.depth
+           << "/" << edge.capacity << " peak " << edge.peak << "  received " << edge.received << " dropped "
+           << edge.dropped;
+        if (edge.policy == QueuePolicy::Block) {
+            os << " blocked " << edge.blocked;
+            if (!edge.from.empty()) {
+                os << "  upstream throttled " << stats(edge.from).throttled;
+            }
+        }
+        os << "\n";
+    }
+}
+
+std::shared_ptr<Component> PipelineExecutor::component(const std::string& name) const {
+    const size_t index = graph_.find(name);
+    return index == PipelineGraph::npos ? nullptr : components_[index];
+}
+
+}
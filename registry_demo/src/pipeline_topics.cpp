@@ -0,0 +1,208 @@
+#include "pipeline_topics.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace duan {
+
+std::string outputTopic(const PortConfig& cfg) {
+    if (!cfg.topic.empty()) {
+        return cfg.topic;
+    }
+    if (cfg.name.empty()) {
+        throw std::invalid_argument("组件配置缺少 name 或 topic");
+    }
+    return "/" + cfg.name;
+}
+
+std::string outputTopic(const nlohmann::json& cfg) {
+    return outputTopic(decodeConfig<PortConfig>(cfg));
+}
+
+std::string outputTopic(const ConfigView& cfg) {
+    return outputTopic(decodeConfig<PortConfig>(cfg));
+}
+
+std::vector<std::string> inputTopics(const PortConfig& cfg) {
+    if (!cfg.input_topics.empty() || cfg.input.empty()) {
+        return cfg.input_topics;
+    }
+    std::vector<std::string> topics;
+    for (const auto& in : cfg.input) {
+        topics.push_back("/" + in);
+    }
+    return topics;
+}
+
+std::vector<std::string> inputTopics(const ConfigView& cfg) {
+    return inputTopics(decodeConfig<PortConfig>(cfg));
+}
+
+SubscriptionOptions subscriptionOptions(const PortConfig& cfg) {
+    SubscriptionOptions options;
+    options.depth = cfg.queue_depth;
+    if (cfg.queue_policy == "keep_latest" || cfg.queue_policy == "drop_oldest") {
+        options.policy = QueuePolicy::KeepLatest;
+    } else if (cfg.queue_policy == "drop_newest") {
+        options.policy = QueuePolicy::DropNewest;
+    } else if (cfg.queue_policy == "block") {
+        options.policy = QueuePolicy::Block;
+    } else {
+        throw std::runtime_error("未知的队列策略: " + cfg.queue_policy);
+    }
+    return options;
+}
+
+SubscriptionOptions subscriptionOptions(const ConfigView& cfg) {
+    return subscriptionOptions(decodeConfig<PortConfig>(cfg));
+}
+
+void resolvePipelineTopics(nlohmann::json& config) {
+    std::unordered_map<std::string, std::string> topic_of;
+    for (const char* section : {"sensors", "algorithms"}) {
+        if (!config.contains(section)) {
+            continue;
+        }
+        for (auto& comp : config[section]) {
+            const std::string name = comp.at("name").get<std::string>();
+            const std::string topic = outputTopic(comp);
+            if (!topic_of.emplace(name, topic).second) {
+                throw std::runtime_error("组件名重复: " + name);
+            }
+            comp["topic"] = topic;
+        }
+    }
+
+    if (!config.contains("algorithms")) {
+        return;
+    }
+    for (auto& algo : config["algorithms"]) {
+        nlohmann::json topics = nlohmann::json::array();
+        for (const auto& in : algo.value("input", nlohmann::json::array())) {
+            auto it = topic_of.find(in.get<std::string>());
+            if (it == topic_of.end()) {
+                throw std::runtime_error("组件 " + algo.at("name").get<std::string>() +
+                                         " 的输入不存在: " + in.get<std::string>());
+            }
+            topics.push_back(it->second);
+        }
+        algo["input_topics"] = topics;
+    }
+}
+
+ComponentPorts::ComponentPorts(const PortConfig& cfg, TopicBus& bus)
+    : bus_(bus), topics_(duan::inputTopics(cfg)), pub_(bus.advertise(duan::outputTopic(cfg))) {
+    const SubscriptionOptions options = subscriptionOptions(cfg);
+    for (const auto& topic : topics_) {
+        subs_.push_back(bus.subscribe(topic, options));
+    }
+    latest_.resize(subs_.size());
+    queued_.resize(subs_.size());
+}
+
+ComponentPorts::~ComponentPorts() {
+    for (const auto& sub : subs_) {
+        bus_.unsubscribe(sub);
+    }
+}
+
+size_t ComponentPorts::pending() const {
+    if (subs_.empty()) {
+        return 1;
+    }
+    size_t most = 0;
+    for (const auto& sub : subs_) {
+        most = std::max(most, sub->pending());
+    }
+    return most;
+}
+
+size_t ComponentPorts::collect(size_t max_frames, std::vector<Inputs>& frames) {
+    if (max_frames == 0) {
+        return 0;
+    }
+    if (subs_.empty()) {
+        frames.emplace_back();
+        return 1;
+    }
+
+    // 先把各输入的积压取出，再按帧对齐；Block 输入不丢消息，最多取 max_frames 条，其余留到下一次
+    std::vector<std::vector<MessagePtr>>& queued = queued_;
+    size_t count = 0;
+    for (size_t i = 0; i < subs_.size(); ++i) {
+        const size_t limit = subs_[i]->options().policy == QueuePolicy::Block ? max_frames : SIZE_MAX;
+        MessagePtr msg;
+        while (queued[i].size() < limit && subs_[i]->take(msg)) {
+            queued[i].push_back(std::move(msg));
+        }
+        count = std::max(count, queued[i].size());
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    // 各输入的队列按末尾对齐，较短的队列对应较新的几帧；位置 < skipped 的帧被丢弃，
+    // 但其中最新的消息仍作为该输入的"上一条"
+    const size_t frames_out = std::min(count, max_frames);
+    const size_t skipped = count - frames_out;
+    for (size_t i = 0; i < subs_.size(); ++i) {
+        const size_t offset = count - queued[i].size();
+        if (skipped > offset) {
+            latest_[i] = queued[i][skipped - 1 - offset];
+        }
+    }
+    for (size_t k = skipped; k < count; ++k) {
+        std::vector<bool> updated(subs_.size(), false);
+        for (size_t i = 0; i < subs_.size(); ++i) {
+            const size_t offset = count - queued[i].size();
+            if (k >= offset) {
+                latest_[i] = queued[i][k - offset];
+                updated[i] = true;
+            }
+        }
+        frames.emplace_back(latest_, std::move(updated));
+    }
+    for (auto& q : queued) {
+        q.clear(); // 保留容量，不再持有消息
+    }
+    return frames_out;
+}
+
+size_t ComponentPorts::credits() const {
+    return pub_.credits();
+}
+
+size_t ComponentPorts::publish(const Outputs& out) {
+    size_t delivered = 0;
+    for (const auto& msg : out.messages()) {
+        delivered += pub_.publish(msg);
+    }
+    return delivered;
+}
+
+size_t runComponent(Component& component, ComponentPorts& ports, uint64_t frame, size_t max_frames) {
+    std::vector<Inputs> inputs;
+    const size_t n = ports.collect(max_frames, inputs);
+    if (n == 0) {
+        return 0;
+    }
+    std::vector<FrameContext> ctx(n);
+    for (size_t i = 0; i < n; ++i) {
+        ctx[i].frame = frame;
+        ctx[i].batch_index = i;
+        ctx[i].batch_size = n;
+    }
+    std::vector<Outputs> outputs(n);
+    if (n == 1) {
+        component.process(ctx[0], inputs[0], outputs[0]);
+    } else {
+        component.processBatch(ctx, inputs, outputs);
+    }
+    for (const auto& out : outputs) {
+        ports.publish(out);
+    }
+    return n;
+}
+
+}
@@ -0,0 +1,154 @@
+#include "plugin_loader.hpp"
+#include "plugin_api.hpp"
+#include <dlfcn.h>
+#include <fstream>
+#include <stdexcept>
+
+namespace duan {
+
+namespace {
+
+std::string dlErrorText() {
+    const char* error = dlerror();
+    return error ? error : "未知错误";
+}
+
+}
+
+PluginLoader::PluginLoader(std::vector<std::string> search_paths) : search_paths_(std::move(search_paths)) {}
+
+void PluginLoader::addManifest(const ConfigView& config) {
+    if (!config.contains("plugins")) {
+        return;
+    }
+    const ConfigView plugins = config.at("plugins");
+    for (size_t i = 0; i < plugins.size(); ++i) {
+        const ConfigView entry = plugins[i];
+        if (!entry.contains("library")) {
+            throw std::invalid_argument("插件清单缺少 library 字段");
+        }
+        std::vector<std::string> types;
+        if (entry.contains("types")) {
+            const ConfigView list = entry.at("types");
+            for (size_t k = 0; k < list.size(); ++k) {
+                types.emplace_back(list[k].asString());
+            }
+        }
+        addLibrary(std::string(entry.at("library").asString()), types);
+    }
+}
+
+void PluginLoader::addLibrary(const std::string& library, const std::vector<std::string>& types) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& type : types) {
+        auto it = provider_.find(type);
+        if (it != provider_.end() && it->second != library) {
+            throw std::invalid_argument("组件类型 " + type + " 同时由 " + it->second + " 和 " + library + " 提供");
+        }
+        provider_[type] = library;
+    }
+    auto& declared = declared_[library];
+    declared.insert(declared.end(), types.begin(), types.end());
+}
+
+bool PluginLoader::ensureType(const std::string& type) {
+    if (ComponentRegistry::Contains(type)) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = provider_.find(type);
+    if (it == provider_.end()) {
+        return false;
+    }
+    // 加锁后再查一次，另一个线程可能刚加载完
+    if (!ComponentRegistry::Contains(type)) {
+        load(it->second);
+    }
+    return true;
+}
+
+size_t PluginLoader::loadFor(const ConfigView& config) {
+    size_t before = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        before = load_order_.size();
+    }
+    for (const char* section : {"sensors", "algorithms"}) {
+        if (!config.contains(section)) {
+            continue;
+        }
+        const ConfigView list = config.at(section);
+        for (size_t i = 0; i < list.size(); ++i) {
+            // 清单里没有的类型留给 PipelineExecutor 报告"未知组件类型"
+            ensureType(std::string(list[i].value("type", "")));
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return load_order_.size() - before;
+}
+
+bool PluginLoader::isLoaded(const std::string& library) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return handles_.count(library) > 0;
+}
+
+std::vector<std::string> PluginLoader::loadedLibraries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return load_order_;
+}
+
+std::string PluginLoader::resolve(const std::string& library) const {
+    if (library.find('/') != std::string::npos) {
+        return library;
+    }
+    for (const auto& dir : search_paths_) {
+        const std::string path = dir + "/" + library;
+        if (std::ifstream(path).good()) {
+            return path;
+        }
+    }
+    // 交给 dlopen 按 LD_LIBRARY_PATH 等系统规则查找
+    return library;
+}
+
+// 调用方持有 mutex_
+void PluginLoader::load(const std::string& library) {
+    if (handles_.count(library)) {
+        return;
+    }
+    const std::string path = resolve(library);
+    // RTLD_LAZY: 函数符号首次调用时才解析；RTLD_LOCAL: 插件符号不污染全局命名空间
+    void* handle = dlopen(path.c_str(), RTLD_LAZY | RTLD_LOCAL);
+    if (!handle) {
+        throw std::runtime_error("加载组件库失败: " + dlErrorText());
+    }
+
+    dlerror();
+    auto entry = reinterpret_cast<PluginEntryFn>(dlsym(handle, kPluginEntryPoint));
+    if (!entry) {
+        const std::string error = dlErrorText();
+        dlclose(handle);
+        throw std::runtime_error("组件库 " + library + " 缺少入口 " + kPluginEntryPoint + ": " + error);
+    }
+    const PluginDescriptor* descriptor = entry();
+    if (!descriptor || descriptor->api_version != kPluginApiVersion || !descriptor->register_components) {
+        const uint32_t version = descriptor ? descriptor->api_version : 0;
+        dlclose(handle);
+        throw std::runtime_error("组件库 " + library + " 接口版本为 " + std::to_string(version) +
+                                 "，程序需要 " + std::to_string(kPluginApiVersion));
+    }
+
+    RegistryRegistrar registrar;
+    descriptor->register_components(registrar);
+    // 注册后库里的代码已被注册表引用，出错也不再卸载
+    handles_[library] = handle;
+    load_order_.push_back(library);
+
+    for (const auto& type : declared_[library]) {
+        if (!ComponentRegistry::Contains(type)) {
+            throw std::runtime_error("组件库 " + library + " 没有注册清单中声明的类型 " + type);
+        }
+    }
+}
+
+}
@@ -0,0 +1,297 @@
+#include "profiler.hpp"
+#include "pipeline_executor.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <nlohmann/json.hpp>
+
+namespace duan {
+
+int64_t threadCpuTimeNs() {
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+uint32_t profilerThreadId() {
+    static std::atomic<uint32_t> next{1};
+    thread_local const uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+size_t Histogram::bucketOf(uint64_t value) {
+    if (value < (1u << kSubBits)) {
+        return static_cast<size_t>(value);
+    }
+    const int msb = 63 - __builtin_clzll(value);
+    const uint64_t sub = (value >> (msb - kSubBits)) & ((1u << kSubBits) - 1);
+    return (static_cast<size_t>(msb - kSubBits + 1) << kSubBits) + sub;
+}
+
+uint64_t Histogram::bucketLow(size_t bucket) {
+    if (bucket < (1u << kSubBits)) {
+        return bucket;
+    }
+    const int msb = static_cast<int>(bucket >> kSubBits) + kSubBits - 1;
+    const uint64_t sub = bucket & ((1u << kSubBits) - 1);
+    return ((uint64_t{1} << kSubBits) + sub) << (msb - kSubBits);
+}
+
+void Histogram::record(uint64_t value) {
+    ++counts_[bucketOf(value)];
+    ++count_;
+    sum_ += value;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+}
+
+uint64_t Histogram::percentile(double p) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    p = std::min(100.0, std::max(0.0, p));
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(count_))));
+    if (rank >= count_) {
+        return max_;
+    }
+    uint64_t seen = 0;
+    for (size_t b = 0; b < counts_.size(); ++b) {
+        seen += counts_[b];
+        if (seen >= rank) {
+            const uint64_t low = bucketLow(b);
+            const uint64_t high = b + 1 < counts_.size() ? bucketLow(b + 1) : max_;
+            const uint64_t mid = low + (high - low) / 2;
+            return std::min(max_, std::max(min(), mid));
+        }
+    }
+    return max_;
+}
+
+Profiler::Profiler(size_t trace_frames) : epoch_(Clock::now()), trace_frames_(trace_frames) {}
+
+void Profiler::bind(const PipelineGraph& graph) {
+    binding_.assign(graph.size(), 0);
+    for (size_t i = 0; i < graph.size(); ++i) {
+        const std::string& name = graph.node(i).name;
+        auto it = std::find_if(components_.begin(), components_.end(),
+                               [&](const ComponentProfile& c) { return c.name == name; });
+        if (it == components_.end()) {
+            components_.emplace_back();
+            components_.back().name = name;
+            it = components_.end() - 1;
+        }
+        binding_[i] = static_cast<size_t>(it - components_.begin());
+    }
+}
+
+void Profiler::beginFrame(uint64_t frame) {
+    current_.frame = frame;
+    current_.begin_ns = now();
+    current_.end_ns = current_.begin_ns;
+    current_.critical_path.clear();
+    current_.spans.assign(binding_.size(), ComponentSpan());
+    for (size_t i = 0; i < binding_.size(); ++i) {
+        current_.spans[i].component = binding_[i];
+        current_.spans[i].ready_ns = current_.begin_ns; // 源节点在帧开始时就绪
+    }
+}
+
+void Profiler::markReady(size_t node) {
+    current_.spans[node].ready_ns = now();
+}
+
+void Profiler::record(size_t node, const ComponentSpan& span) {
+    ComponentSpan& slot = current_.spans[node];
+    const int64_t ready = slot.ready_ns;
+    slot = span;
+    slot.component = binding_[node];
+    slot.ready_ns = ready;
+    slot.executed = true;
+}
+
+void Profiler::endFrame(const PipelineGraph& graph) {
+    current_.end_ns = now();
+    std::vector<ComponentSpan>& spans = current_.spans;
+
+    for (const ComponentSpan& span : spans) {
+        if (!span.executed) {
+            continue;
+        }
+        ComponentProfile& profile = components_[span.component];
+        if (span.frames == 0) {
+            ++profile.idle;
+            continue;
+        }
+        profile.wall_ns.record(static_cast<uint64_t>(std::max<int64_t>(0, span.end_ns - span.begin_ns)));
+        profile.cpu_ns.record(static_cast<uint64_t>(std::max<int64_t>(0, span.cpu_ns)));
+        profile.queue_wait_ns.record(static_cast<uint64_t>(std::max<int64_t>(0, span.begin_ns - span.ready_ns)));
+        profile.allocations.record(span.allocations);
+    }
+
+    // 从最后完成的节点沿最晚完成的上游回溯
+    size_t last = PipelineGraph::npos;
+    for (size_t i = 0; i < spans.size(); ++i) {
+        if (spans[i].executed && (last == PipelineGraph::npos || spans[i].end_ns > spans[last].end_ns)) {
+            last = i;
+        }
+    }
+    std::vector<size_t> path;
+    for (size_t node = last; node != PipelineGraph::npos;) {
+        size_t latest = PipelineGraph::npos;
+        for (size_t in : graph.node(node).inputs) {
+            if (spans[in].executed && (latest == PipelineGraph::npos || spans[in].end_ns > spans[latest].end_ns)) {
+                latest = in;
+            }
+        }
+        const int64_t from = latest == PipelineGraph::npos ? current_.begin_ns : spans[latest].end_ns;
+        ComponentProfile& profile = components_[spans[node].component];
+        ++profile.critical_frames;
+        profile.critical_ns += static_cast<uint64_t>(std::max<int64_t>(0, spans[node].end_ns - from));
+        spans[node].critical = true;
+        path.push_back(spans[node].component);
+        node = latest;
+    }
+    std::reverse(path.begin(), path.end());
+    current_.critical_path = path;
+    if (!path.empty()) {
+        ++paths_[path];
+    }
+    frame_ns_.record(static_cast<uint64_t>(std::max<int64_t>(0, current_.end_ns - current_.begin_ns)));
+
+    if (trace_frames_ > 0) {
+        if (frames_.size() == trace_frames_) {
+            frames_.pop_front();
+        }
+        frames_.push_back(std::move(current_));
+    }
+    current_ = FrameProfile();
+}
+
+const ComponentProfile* Profiler::component(const std::string& name) const {
+    for (const auto& profile : components_) {
+        if (profile.name == name) {
+            return &profile;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::string> Profiler::dominantPath(uint64_t* frames) const {
+    auto best = paths_.end();
+    for (auto it = paths_.begin(); it != paths_.end(); ++it) {
+        if (best == paths_.end() || it->second > best->second) {
+            best = it;
+        }
+    }
+    std::vector<std::string> names;
+    if (frames) {
+        *frames = best == paths_.end() ? 0 : best->second;
+    }
+    if (best != paths_.end()) {
+        for (size_t c : best->first) {
+            names.push_back(components_[c].name);
+        }
+    }
+    return names;
+}
+
+void Profiler::print(std::ostream& os) const {
+    auto us = [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    const uint64_t total = frameCount();
+    std::ios saved(nullptr);
+    saved.copyfmt(os);
+    os << std::fixed << std::setprecision(1);
+    os << "Profile: " << total << " frames, latency p50 " << us(frame_ns_.percentile(50)) << " us, p99 "
+       << us(frame_ns_.percentile(99)) << " us, max " << us(frame_ns_.max()) << " us\n";
+    os << "  " << std::left << std::setw(22) << "component" << std::right << std::setw(7) << "calls" << std::setw(10)
+       << "wall p50" << std::setw(10) << "wall p99" << std::setw(10) << "cpu p50" << std::setw(10) << "wait p50"
+       << std::setw(10) << "wait p99" << std::setw(9) << "allocs" << std::setw(10) << "critical" << std::setw(12)
+       << "crit avg" << "\n";
+    for (const auto& c : components_) {
+        const double share = total ? 100.0 * static_cast<double>(c.critical_frames) / static_cast<double>(total) : 0.0;
+        const double crit_avg = c.critical_frames ? us(c.critical_ns) / static_cast<double>(c.critical_frames) : 0.0;
+        os << "  " << std::left << std::setw(22) << c.name << std::right << std::setw(7) << c.wall_ns.count()
+           << std::setw(10) << us(c.wall_ns.percentile(50)) << std::setw(10) << us(c.wall_ns.percentile(99))
+           << std::setw(10) << us(c.cpu_ns.percentile(50)) << std::setw(10) << us(c.queue_wait_ns.percentile(50))
+           << std::setw(10) << us(c.queue_wait_ns.percentile(99)) << std::setw(9) << c.allocations.mean()
+           << std::setw(9) << share << "%" << std::setw(12) << crit_avg << "\n";
+    }
+    uint64_t frames = 0;
+    const std::vector<std::string> path = dominantPath(&frames);
+    if (!path.empty()) {
+        os << "  critical path (" << frames << "/" << total << " frames):";
+        for (size_t i = 0; i < path.size(); ++i) {
+            os << (i ? " -> " : " ") << path[i];
+        }
+        os << "\n";
+    }
+    os.copyfmt(saved);
+}
+
+void Profiler::writeChromeTrace(std::ostream& os) const {
+    // 时间单位为微秒；tid 0 放帧，其余为执行线程
+    nlohmann::json events = nlohmann::json::array();
+    auto us = [](int64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    std::vector<uint32_t> threads;
+    for (const FrameProfile& frame : frames_) {
+        events.push_back({{"name", "frame " + std::to_string(frame.frame)},
+                          {"cat", "frame"},
+                          {"ph", "X"},
+                          {"pid", 1},
+                          {"tid", 0},
+                          {"ts", us(frame.begin_ns)},
+                          {"dur", us(frame.end_ns - frame.begin_ns)}});
+        for (const ComponentSpan& span : frame.spans) {
+            if (!span.executed) {
+                continue;
+            }
+            if (std::find(threads.begin(), threads.end(), span.thread) == threads.end()) {
+                threads.push_back(span.thread);
+            }
+            events.push_back({{"name", components_[span.component].name},
+                              {"cat", span.critical ? "component,critical" : "component"},
+                              {"ph", "X"},
+                              {"pid", 1},
+                              {"tid", span.thread},
+                              {"ts", us(span.begin_ns)},
+                              {"dur", us(span.end_ns - span.begin_ns)},
+                              {"args",
+                               {{"frame", frame.frame},
+                                {"frames", span.frames},
+                                {"cpu_us", us(span.cpu_ns)},
+                                {"queue_wait_us", us(span.begin_ns - span.ready_ns)},
+                                {"allocations", span.allocations},
+                                {"critical", span.critical}}}});
+        }
+    }
+    events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", 0}, {"args", {{"name", "frames"}}}});
+    for (uint32_t thread : threads) {
+        events.push_back({{"name", "thread_name"},
+                          {"ph", "M"},
+                          {"pid", 1},
+                          {"tid", thread},
+                          {"args", {{"name", "worker " + std::to_string(thread)}}}});
+    }
+    os << nlohmann::json{{"traceEvents", events}, {"displayTimeUnit", "ms"}}.dump();
+}
+
+ProfileScope::ProfileScope(Profiler& profiler, size_t node)
+    : profiler_(profiler), node_(node), begin_ns_(profiler.now()), cpu_ns_(threadCpuTimeNs()),
+      allocations_(threadAllocationCount()) {}
+
+ProfileScope::~ProfileScope() {
+    ComponentSpan span;
+    span.allocations = threadAllocationCount() - allocations_;
+    span.cpu_ns = threadCpuTimeNs() - cpu_ns_;
+    span.end_ns = profiler_.now();
+    span.begin_ns = begin_ns_;
+    span.thread = profilerThreadId();
+    span.frames = frames;
+    profiler_.record(node_, span);
+}
+
+}
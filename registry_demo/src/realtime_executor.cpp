@@ -0,0 +1,344 @@
+#include "realtime_executor.hpp"
+#include "pipeline_topics.hpp"
+#include "registry.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <pthread.h>
+#include <sched.h>
+#include <stdexcept>
+
+namespace duan {
+
+namespace {
+
+constexpr size_t kNone = static_cast<size_t>(-1);
+
+void pinCurrentThread(size_t cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<int>(cpu), &set);
+    // 没有权限或CPU被cgroup限制时失败，不影响运行
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+// 成功切换返回 true；普通用户没有 CAP_SYS_NICE 时 SCHED_FIFO 返回 EPERM
+bool setCurrentPolicy(int policy, int priority) {
+    sched_param param{};
+    param.sched_priority = priority;
+    return pthread_setschedparam(pthread_self(), policy, &param) == 0;
+}
+
+std::chrono::steady_clock::duration fromMs(double ms) {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(ms));
+}
+
+}
+
+RealtimeOptions realtimeOptions(const ConfigView& config) {
+    RealtimeOptions options;
+    if (!config.contains("realtime")) {
+        return options;
+    }
+    const ConfigView cfg = config.at("realtime");
+    options.workers = static_cast<size_t>(std::max<int64_t>(1, cfg.value("workers", static_cast<int64_t>(options.workers))));
+    options.background_workers = static_cast<size_t>(
+        std::max<int64_t>(0, cfg.value("background_workers", static_cast<int64_t>(options.background_workers))));
+    options.pin_threads = cfg.value("pin_threads", options.pin_threads);
+    options.sched_fifo = cfg.value("sched_fifo", options.sched_fifo);
+    options.fifo_priority = cfg.value("fifo_priority", options.fifo_priority);
+    const std::string policy(cfg.value("policy", "edf"));
+    if (policy == "edf") {
+        options.policy = RtPolicy::EarliestDeadlineFirst;
+    } else if (policy == "fixed_priority") {
+        options.policy = RtPolicy::FixedPriority;
+    } else {
+        throw std::runtime_error("未知的实时调度策略: " + policy);
+    }
+    return options;
+}
+
+RealtimeExecutor::RealtimeExecutor(const nlohmann::json& config, const RealtimeOptions& options)
+    : RealtimeExecutor(std::make_shared<const CompiledConfig>(CompiledConfig::compile(config)), options) {}
+
+RealtimeExecutor::RealtimeExecutor(std::shared_ptr<const CompiledConfig> config, const RealtimeOptions& options)
+    : config_(std::move(config)), graph_(config_->root()), options_(options) {
+    options_.workers = std::max<size_t>(1, options_.workers);
+
+    // 先解码并检查全部节点（组件自身的配置与实时参数），一次报告所有错误
+    std::string errors;
+    std::vector<RealtimeParams> params(graph_.size());
+    std::vector<ComponentRegistry::Factory> factories(graph_.size());
+    for (size_t i = 0; i < graph_.size(); ++i) {
+        const PipelineNode& node = graph_.node(i);
+        try {
+            factories[i] = ComponentRegistry::Prepare(ComponentRegistry::Find(node.type), node.config);
+            params[i] = decodeConfig<RealtimeParams>(node.config);
+            if (params[i].period_ms < 0.0 || params[i].deadline_ms < 0.0) {
+                throw std::invalid_argument("period_ms 与 deadline_ms 不能为负");
+            }
+            if (params[i].priority > 0 && params[i].period_ms <= 0.0) {
+                throw std::invalid_argument("实时组件 (priority > 0) 必须配置 period_ms");
+            }
+        } catch (const std::exception& e) {
+            errors += "\n  " + node.name + " (" + node.type + "): " + e.what();
+        }
+    }
+    if (!errors.empty()) {
+        throw std::runtime_error("组件配置不合法:" + errors);
+    }
+
+    tasks_.resize(graph_.size());
+    for (size_t i = 0; i < graph_.size(); ++i) {
+        const PipelineNode& node = graph_.node(i);
+        Task& task = tasks_[i];
+        task.component = factories[i] ? factories[i]() : nullptr;
+        if (!task.component) {
+            throw std::runtime_error("未注册的组件类型: " + node.type + " (" + node.name + ")");
+        }
+        task.params = params[i];
+        task.period = fromMs(params[i].period_ms);
+        task.deadline = fromMs(params[i].deadline_ms > 0.0 ? params[i].deadline_ms : params[i].period_ms);
+        task.background = params[i].priority <= 0;
+    }
+}
+
+RealtimeExecutor::~RealtimeExecutor() = default;
+
+size_t RealtimeExecutor::index(const std::string& name) const {
+    const size_t i = graph_.find(name);
+    if (i == PipelineGraph::npos) {
+        throw std::runtime_error("组件不存在: " + name);
+    }
+    return i;
+}
+
+std::shared_ptr<Component> RealtimeExecutor::component(const std::string& name) const {
+    return tasks_[index(name)].component;
+}
+
+const RealtimeParams& RealtimeExecutor::params(const std::string& name) const {
+    return tasks_[index(name)].params;
+}
+
+RealtimeStats RealtimeExecutor::stats(const std::string& name) const {
+    const size_t i = index(name);
+    std::lock_guard<PriorityInheritMutex> lock(mutex_);
+    return tasks_[i].stats;
+}
+
+void RealtimeExecutor::start() {
+    for (size_t i : graph_.order()) {
+        tasks_[i].component->start();
+    }
+}
+
+void RealtimeExecutor::runFor(std::chrono::milliseconds duration) {
+    {
+        std::lock_guard<PriorityInheritMutex> lock(mutex_);
+        for (Task& task : tasks_) {
+            task.next_release = Clock::time_point::max(); // 全部线程就绪后才释放
+            task.running = false;
+        }
+        stopping_ = false;
+        ready_ = 0;
+        error_ = nullptr;
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < options_.workers; ++i) {
+        threads.emplace_back([this, i] { worker(i, false); });
+    }
+    for (size_t i = 0; i < options_.background_workers; ++i) {
+        threads.emplace_back([this, i] { worker(i, true); });
+    }
+    // 等每个线程设置好绑核与调度策略再同时首次释放，避免启动期间的线程创建拖慢第一批实时作业
+    {
+        std::unique_lock<PriorityInheritMutex> lock(mutex_);
+        wakeup_.wait(lock, [&] { return ready_ == threads.size(); });
+        const Clock::time_point now = Clock::now();
+        for (Task& task : tasks_) {
+            task.next_release = now;
+        }
+    }
+    wakeup_.notify_all();
+
+    std::this_thread::sleep_for(duration);
+    {
+        std::lock_guard<PriorityInheritMutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wakeup_.notify_all();
+    // 正在执行的作业不能打断，等它们完成
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+size_t RealtimeExecutor::pick(bool background, Clock::time_point now, Clock::time_point& wake) const {
+    // 后台组件没有共用的后台线程时排在全部实时作业之后
+    const bool shared = !background && options_.background_workers == 0;
+    size_t best = kNone;
+    for (size_t i = 0; i < tasks_.size(); ++i) {
+        const Task& task = tasks_[i];
+        if (task.running || (task.background != background && !(shared && task.background))) {
+            continue;
+        }
+        if (task.next_release > now) {
+            wake = std::min(wake, task.next_release);
+            continue;
+        }
+        if (best == kNone) {
+            best = i;
+            continue;
+        }
+        const Task& other = tasks_[best];
+        if (task.background != other.background) {
+            best = task.background ? best : i;
+            continue;
+        }
+        const Clock::time_point due = task.next_release + task.deadline;
+        const Clock::time_point other_due = other.next_release + other.deadline;
+        if (options_.policy == RtPolicy::FixedPriority && task.params.priority != other.params.priority) {
+            best = task.params.priority > other.params.priority ? i : best;
+        } else if (due < other_due) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void RealtimeExecutor::runJob(Task& task) {
+    Component& component = *task.component;
+    ComponentPorts* ports = component.ports();
+    if (!ports) {
+        component.spinOnce();
+        return;
+    }
+    // 与 ROS 定时器相同: 处理到目前为止积压的输入，没有输入时直接返回
+    const size_t pending = ports->pending();
+    if (pending == 0) {
+        return;
+    }
+    const size_t batch = std::min({pending, std::max<size_t>(1, component.maxBatchSize()), ports->credits()});
+    if (batch > 0) {
+        runComponent(component, *ports, task.jobs, batch);
+    }
+}
+
+void RealtimeExecutor::worker(size_t id, bool background) {
+    // 线程自己在取第一个作业前设置好调度策略，后台作业不会以普通优先级先跑起来
+    // 实时线程从 0 号核起，后台线程从最后一个核倒着绑
+    const size_t cpus = std::max(1u, std::thread::hardware_concurrency());
+    if (options_.pin_threads) {
+        pinCurrentThread(background ? cpus - 1 - id % cpus : id % cpus);
+    }
+    if (background) {
+        // 降低优先级总是允许的；与实时线程同核时只在其空闲时运行
+        setCurrentPolicy(SCHED_IDLE, 0);
+    } else if (options_.sched_fifo && setCurrentPolicy(SCHED_FIFO, options_.fifo_priority)) {
+        fifo_active_.store(true, std::memory_order_relaxed);
+    }
+
+    std::unique_lock<PriorityInheritMutex> lock(mutex_);
+    ++ready_;
+    wakeup_.notify_all();
+    while (!stopping_) {
+        Clock::time_point now = Clock::now();
+        Clock::time_point wake = Clock::time_point::max();
+        const size_t picked = pick(background, now, wake);
+        if (picked == kNone) {
+            if (wake == Clock::time_point::max()) {
+                wakeup_.wait(lock);
+            } else {
+                wakeup_.wait_until(lock, wake);
+            }
+            continue;
+        }
+
+        // 一个组件同时只有一个作业；落后时跳过错过的释放，执行最近的一次
+        Task& task = tasks_[picked];
+        RealtimeStats& stats = task.stats;
+        Clock::time_point release = task.next_release;
+        if (task.period.count() > 0) {
+            const auto behind = static_cast<uint64_t>((now - release) / task.period);
+            if (behind > 0) {
+                stats.skipped += behind;
+                stats.deadline_misses += behind;
+                stats.releases += behind;
+                release += task.period * static_cast<int64_t>(behind);
+            }
+            task.next_release = release + task.period;
+        }
+        ++stats.releases;
+        task.running = true;
+        ++task.jobs;
+        lock.unlock();
+
+        const Clock::time_point begin = Clock::now();
+        std::exception_ptr error;
+        try {
+            runJob(task);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        const Clock::time_point finish = Clock::now();
+
+        lock.lock();
+        task.running = false;
+        if (task.period.count() == 0) {
+            task.next_release = finish; // 后台组件连续执行
+        }
+        stats.start_delay_ns.record(static_cast<uint64_t>(std::chrono::nanoseconds(begin - release).count()));
+        stats.response_ns.record(static_cast<uint64_t>(std::chrono::nanoseconds(finish - release).count()));
+        if (error) {
+            ++stats.errors;
+            if (!error_) {
+                error_ = error;
+            }
+        } else {
+            if (task.deadline.count() > 0) {
+                const int64_t lateness = std::chrono::nanoseconds(finish - (release + task.deadline)).count();
+                if (stats.completed == 0 || lateness > stats.max_lateness_ns) {
+                    stats.max_lateness_ns = lateness;
+                }
+                if (lateness > 0) {
+                    ++stats.deadline_misses;
+                }
+            }
+            ++stats.completed;
+        }
+        // 共用实时线程的后台作业完成后，其他线程可能在等它
+        wakeup_.notify_all();
+    }
+}
+
+void RealtimeExecutor::print(std::ostream& os) const {
+    auto us = [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    std::lock_guard<PriorityInheritMutex> lock(mutex_);
+    std::ios saved(nullptr);
+    saved.copyfmt(os);
+    os << std::fixed << std::setprecision(1);
+    os << "Realtime (" << (options_.policy == RtPolicy::EarliestDeadlineFirst ? "edf" : "fixed_priority") << ", "
+       << options_.workers << " rt + " << options_.background_workers << " background workers"
+       << (fifoActive() ? ", SCHED_FIFO" : "") << "):\n";
+    os << "  " << std::left << std::setw(22) << "component" << std::right << std::setw(6) << "prio" << std::setw(9)
+       << "period" << std::setw(9) << "deadline" << std::setw(9) << "releases" << std::setw(8) << "misses"
+       << std::setw(8) << "skipped" << std::setw(11) << "delay p99" << std::setw(11) << "resp p99" << std::setw(11)
+       << "resp max" << "\n";
+    for (size_t i = 0; i < tasks_.size(); ++i) {
+        const Task& task = tasks_[i];
+        const RealtimeStats& s = task.stats;
+        os << "  " << std::left << std::setw(22) << graph_.node(i).name << std::right << std::setw(6)
+           << task.params.priority << std::setw(9) << task.params.period_ms << std::setw(9)
+           << std::chrono::duration<double, std::milli>(task.deadline).count() << std::setw(9) << s.releases
+           << std::setw(8) << s.deadline_misses << std::setw(8) << s.skipped << std::setw(11)
+           << us(s.start_delay_ns.percentile(99)) << std::setw(11) << us(s.response_ns.percentile(99))
+           << std::setw(11) << us(s.response_ns.max()) << "\n";
+    }
+    os.copyfmt(saved);
+}
+
+}
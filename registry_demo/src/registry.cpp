@@ -0,0 +1,217 @@
+#include "registry.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace duan {
+
+namespace {
+
+// 类型名的 64 位哈希（按字长处理），高 32 位选桶，整体再与位移混合后选槽
+uint64_t hashType(std::string_view type) {
+    return std::hash<std::string_view>{}(type);
+}
+
+size_t nextPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+// splitmix64 的末端混合
+uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+uint64_t slotHash(uint64_t hash, uint32_t displacement) {
+    return mix(hash + displacement * 0x9E3779B97F4A7C15ull);
+}
+
+}
+
+/*
+不可变快照，发布后只读
+未封存时用 unordered_map 查找；封存后用 hash-and-displace 完美哈希:
+每个类型先按哈希落到一个桶，每个桶选一个位移使桶内所有类型落到互不冲突的空槽，
+查找只需 一次哈希 + 读位移 + 读槽 + 一次字符串比较
+*/
+struct ComponentRegistry::Snapshot {
+    std::vector<Handle> entries;
+    std::unordered_map<std::string_view, Handle> index;
+
+    bool sealed = false;
+    std::vector<uint32_t> displacement;
+    std::vector<Handle> slots;
+    uint64_t bucket_mask = 0;
+    uint64_t slot_mask = 0;
+
+    Handle find(std::string_view type) const {
+        if (sealed) {
+            const uint64_t hash = hashType(type);
+            const uint32_t d = displacement[(hash >> 32) & bucket_mask];
+            Handle entry = slots[slotHash(hash, d) & slot_mask];
+            return entry && entry->type == type ? entry : nullptr;
+        }
+        auto it = index.find(type);
+        return it == index.end() ? nullptr : it->second;
+    }
+
+    void buildPerfectHash() {
+        const size_t n = entries.size();
+        std::vector<uint64_t> hashes(n);
+        for (size_t i = 0; i < n; ++i) {
+            hashes[i] = hashType(entries[i]->type);
+        }
+        // 槽数取不小于 2n 的 2 的幂，负载不超过一半，每个桶很快能找到位移；桶数与槽数都取 2 的幂，查找时用掩码代替取模
+        size_t slot_count = nextPowerOfTwo(2 * n);
+        const size_t bucket_count = nextPowerOfTwo(std::max<size_t>(1, n / 2));
+        for (;; slot_count <<= 1) {
+            if (tryBuild(hashes, bucket_count, slot_count)) {
+                break;
+            }
+        }
+        sealed = true;
+    }
+
+private:
+    bool tryBuild(const std::vector<uint64_t>& hashes, size_t bucket_count, size_t slot_count) {
+        std::vector<std::vector<size_t>> buckets(bucket_count);
+        for (size_t i = 0; i < hashes.size(); ++i) {
+            buckets[(hashes[i] >> 32) & (bucket_count - 1)].push_back(i);
+        }
+        // 大桶先放，空槽多时更容易找到位移
+        std::vector<size_t> order(bucket_count);
+        for (size_t b = 0; b < bucket_count; ++b) {
+            order[b] = b;
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t a, size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+        displacement.assign(bucket_count, 0);
+        bucket_mask = bucket_count - 1;
+        slots.assign(slot_count, nullptr);
+        slot_mask = slot_count - 1;
+        std::vector<size_t> placed;
+        for (size_t b : order) {
+            if (buckets[b].empty()) {
+                break;
+            }
+            bool found = false;
+            for (uint32_t d = 0; d < (1u << 16) && !found; ++d) {
+                placed.clear();
+                found = true;
+                for (size_t key : buckets[b]) {
+                    const size_t slot = slotHash(hashes[key], d) & slot_mask;
+                    if (slots[slot] || std::find(placed.begin(), placed.end(), slot) != placed.end()) {
+                        found = false;
+                        break;
+                    }
+                    placed.push_back(slot);
+                }
+                if (found) {
+                    displacement[b] = d;
+                    for (size_t k = 0; k < placed.size(); ++k) {
+                        slots[placed[k]] = entries[buckets[b][k]];
+                    }
+                }
+            }
+            if (!found) {
+                return false; // 换更大的槽表重来
+            }
+        }
+        return true;
+    }
+};
+
+struct ComponentRegistry::State {
+    std::atomic<const Snapshot*> current{nullptr};
+    std::mutex write_mutex;
+    bool sealed = false;
+    std::vector<std::unique_ptr<Entry>> entries;            // 注册过的全部条目，含被替换的
+    std::vector<Handle> live;                               // 当前有效的条目，按首次注册顺序
+    std::vector<std::unique_ptr<const Snapshot>> snapshots; // 发布过的全部快照
+};
+
+ComponentRegistry::State& ComponentRegistry::state() {
+    // 组件在其他编译单元的静态初始化中注册，用函数内静态变量保证先构造
+    static State s;
+    return s;
+}
+
+const ComponentRegistry::Snapshot* ComponentRegistry::snapshot() {
+    return state().current.load(std::memory_order_acquire);
+}
+
+// 调用方持有 write_mutex
+void ComponentRegistry::publish(State& s) {
+    auto next = std::make_unique<Snapshot>();
+    next->entries = s.live;
+    if (s.sealed) {
+        next->buildPerfectHash();
+    } else {
+        next->index.reserve(s.live.size());
+        for (Handle entry : s.live) {
+            next->index.emplace(entry->type, entry);
+        }
+    }
+    s.current.store(next.get(), std::memory_order_release);
+    s.snapshots.push_back(std::move(next));
+}
+
+void ComponentRegistry::Register(const std::string& type, Creator creator, Validator validator) {
+    RegisterPreparer(type, untypedPreparer(std::move(creator), std::move(validator)));
+}
+
+void ComponentRegistry::RegisterPreparer(const std::string& type, Preparer preparer) {
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.write_mutex);
+    s.entries.push_back(std::make_unique<Entry>(Entry{type, std::move(preparer)}));
+    Handle entry = s.entries.back().get();
+    auto it = std::find_if(s.live.begin(), s.live.end(), [&](Handle e) { return e->type == type; });
+    if (it != s.live.end()) {
+        *it = entry; // 旧条目保留，正在用它创建组件的读者不受影响
+    } else {
+        s.live.push_back(entry);
+    }
+    publish(s);
+}
+
+ComponentRegistry::Handle ComponentRegistry::Find(std::string_view type) {
+    const Snapshot* current = snapshot();
+    return current ? current->find(type) : nullptr;
+}
+
+void ComponentRegistry::Seal() {
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.write_mutex);
+    if (s.sealed) {
+        return;
+    }
+    s.sealed = true;
+    publish(s);
+}
+
+bool ComponentRegistry::IsSealed() {
+    const Snapshot* current = snapshot();
+    return current && current->sealed;
+}
+
+std::vector<std::string> ComponentRegistry::Types() {
+    std::vector<std::string> types;
+    if (const Snapshot* current = snapshot()) {
+        for (Handle entry : current->entries) {
+            types.push_back(entry->type);
+        }
+    }
+    return types;
+}
+
+}
@@ -1,62 +1,133 @@
 #include "component.hpp"
-#include "registry.hpp"
+#include "plugin_api.hpp"
+#include "messages.hpp"
+#include "pipeline_topics.hpp"
+#include <chrono>
 #include <iostream>
 
 namespace duan {
 
+namespace {
+double nowSeconds() {
+    return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+}
+
+struct RoboSenseConfig : PortConfig {
+    int rings = 32;
+    int beams = 900;
+};
+
+struct HikvisionConfig : PortConfig {
+    int width = 640;
+    int height = 480;
+};
+
+}
+
+DUAN_CONFIG_SCHEMA_EXTENDS(duan::RoboSenseConfig, duan::PortConfig, DUAN_FIELD(rings), DUAN_FIELD(beams))
+DUAN_CONFIG_SCHEMA_EXTENDS(duan::HikvisionConfig, duan::PortConfig, DUAN_FIELD(width), DUAN_FIELD(height))
+
+namespace duan {
+
 // RoboSense 激光雷达
-class RoboSenseLidar : public duan::Component {
+class RoboSenseLidar : public TopicComponent {
     std::string topic_;
+    int rings_;
+    int beams_;
+    uint64_t seq_ = 0;
 public:
-    RoboSenseLidar(const nlohmann::json& cfg) : topic_(cfg.at("topic")) {}
+    explicit RoboSenseLidar(const RoboSenseConfig& cfg)
+        : TopicComponent(cfg),
+          topic_(ports_.outputTopic()),
+          rings_(cfg.rings),
+          beams_(cfg.beams) {}
 
     void start() override {
         std::cout << "[RoboSenseLidar] listening " << topic_ << std::endl;
     }
+
+    void process(const FrameContext&, const Inputs&, Outputs& out) override {
+        out.publish(std::make_shared<LidarFrame>(simulateLidarFrame(rings_, beams_, seq_++)));
+    }
 };
 
 // Hikvision 摄像头
-class HikvisionCamera : public Component {
+class HikvisionCamera : public TopicComponent {
     std::string topic_;
+    int width_;
+    int height_;
+    uint64_t seq_ = 0;
 public:
-    HikvisionCamera(const nlohmann::json& cfg) : topic_(cfg.at("topic")) {}
+    explicit HikvisionCamera(const HikvisionConfig& cfg)
+        : TopicComponent(cfg),
+          topic_(ports_.outputTopic()),
+          width_(cfg.width),
+          height_(cfg.height) {}
     void start() override {
         std::cout << "[HikvisionCamera] streaming " << topic_ << std::endl;
     }
+
+    // 模拟图像: 渐变背景上有一个随帧号平移的亮块
+    void process(const FrameContext&, const Inputs&, Outputs& out) override {
+        auto image = std::make_shared<CameraImage>();
+        image->seq = seq_++;
+        image->timestamp = nowSeconds();
+        image->width = width_;
+        image->height = height_;
+        image->data.resize(static_cast<size_t>(width_) * height_ * 3);
+        const int box_x = static_cast<int>((image->seq * 16) % static_cast<uint64_t>(width_));
+        const int box_y = height_ / 3;
+        for (int y = 0; y < height_; ++y) {
+            uint8_t* row = image->data.data() + static_cast<size_t>(y) * width_ * 3;
+            for (int x = 0; x < width_; ++x) {
+                const bool in_box = x >= box_x && x < box_x + width_ / 8 && y >= box_y && y < box_y + height_ / 6;
+                const uint8_t v = in_box ? 250 : static_cast<uint8_t>((x + y) * 96 / (width_ + height_));
+                row[x * 3 + 0] = v;
+                row[x * 3 + 1] = v;
+                row[x * 3 + 2] = v;
+            }
+        }
+        out.publish(std::move(image));
+    }
 };
 
 // Ublox GNSS
-class UbloxGnss : public Component {
+class UbloxGnss : public TopicComponent {
     std::string topic_;
+    uint64_t seq_ = 0;
 public:
-    UbloxGnss(const nlohmann::json& cfg) : topic_(cfg.at("topic")) {}
+    explicit UbloxGnss(const PortConfig& cfg)
+        : TopicComponent(cfg),
+          topic_(ports_.outputTopic()) {}
     void start() override {
         std::cout << "[UbloxGNSS] acquiring " << topic_ << std::endl;
     }
+
+    // 模拟以约 10 m/s 向东北方向行驶
+    void process(const FrameContext&, const Inputs&, Outputs& out) override {
+        auto fix = std::make_shared<GnssFix>();
+        fix->seq = seq_++;
+        fix->timestamp = nowSeconds();
+        fix->latitude = 31.2304 + 0.000006 * static_cast<double>(fix->seq);
+        fix->longitude = 121.4737 + 0.000008 * static_cast<double>(fix->seq);
+        fix->altitude = 4.0;
+        fix->satellites = 12;
+        out.publish(std::move(fix));
+    }
 };
 
 }
 
-using ComponentRegistry = duan::ComponentRegistry;
-
-// 静态注册模块，实现自动注册
+// 组件库注册: 静态链接时启动即注册，编译为插件时由 PluginLoader 按需加载
 namespace {
-
-    // 会放到map中
-    const bool reg1 = [](){
-        ComponentRegistry::Register("robosense", [](const nlohmann::json& cfg) {
+    void registerSensors(duan::PluginRegistrar& registrar) {
+        registrar.addTyped<duan::RoboSenseConfig>("robosense", [](const duan::RoboSenseConfig& cfg) {
             return std::make_shared<duan::RoboSenseLidar>(cfg);
         });
-        return true;
-    }();
-
-    const bool reg2 = []{
-        ComponentRegistry::Register("hikvision", [](const nlohmann::json& cfg){ return std::make_shared<duan::HikvisionCamera>(cfg); });
-        return true;
-    }();
-
-    const bool reg3 = []{
-        ComponentRegistry::Register("ublox", [](const nlohmann::json& cfg){ return std::make_shared<duan::UbloxGnss>(cfg); });
-        return true;
-    }();
-}
\ No newline at end of file
+        registrar.addTyped<duan::HikvisionConfig>("hikvision", [](const duan::HikvisionConfig& cfg){ return std::make_shared<duan::HikvisionCamera>(cfg); });
+        registrar.addTyped<duan::PortConfig>("ublox", [](const duan::PortConfig& cfg){ return std::make_shared<duan::UbloxGnss>(cfg); });
+    }
+}
+
+DUAN_COMPONENT_LIBRARY("sensors", registerSensors)
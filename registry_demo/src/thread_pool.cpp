@@ -0,0 +1,68 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace duan {
+
+ThreadPool::ThreadPool(size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers_.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::workerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return; // stopping_ 且队列已清空
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+        task();
+    }
+}
+
+void ThreadPool::parallelFor(size_t n, const std::function<void(size_t)>& fn) {
+    if (n == 0) {
+        return;
+    }
+    // 下标通过原子计数器动态领取，耗时不均的任务也能均衡
+    auto next = std::make_shared<std::atomic<size_t>>(0);
+    auto drain = [next, n, &fn] {
+        for (size_t i = next->fetch_add(1); i < n; i = next->fetch_add(1)) {
+            fn(i);
+        }
+    };
+
+    const size_t helpers = std::min(workers_.size(), n - 1);
+    std::vector<std::future<void>> pending;
+    pending.reserve(helpers);
+    for (size_t i = 0; i < helpers; ++i) {
+        pending.push_back(submit(drain));
+    }
+    drain();
+    for (auto& f : pending) {
+        f.get();
+    }
+}
+
+}
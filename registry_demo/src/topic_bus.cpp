@@ -0,0 +1,301 @@
+#include "topic_bus.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+namespace duan {
+
+namespace detail {
+
+struct Topic {
+    explicit Topic(std::string topic_name) : name(std::move(topic_name)) {
+        for (auto& slot : slots) {
+            slot.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    std::string name;
+    // 发布方只读这两个原子量，订阅关系的增删在总线锁内完成
+    std::array<std::atomic<Subscription*>, TopicBus::kMaxSubscribers> slots;
+    std::atomic<size_t> slot_count{0};
+    std::atomic<uint64_t> published{0};
+    // 正在遍历 slots 的发布方数，为0时没有线程还拿着已取消订阅的裸指针
+    std::atomic<size_t> publishing{0};
+    // 持有订阅对象的生命周期：取消订阅后发布线程可能仍在访问，等没有发布方在遍历时再释放
+    std::vector<std::shared_ptr<Subscription>> owned;
+};
+
+// 发布方遍历 slots 期间计数，与 TopicBus::unsubscribe 清空槽位后的检查配对（均为 seq_cst）
+class PublishGuard {
+public:
+    explicit PublishGuard(Topic& topic) : topic_(topic) { topic_.publishing.fetch_add(1, std::memory_order_seq_cst); }
+    ~PublishGuard() { topic_.publishing.fetch_sub(1, std::memory_order_seq_cst); }
+    PublishGuard(const PublishGuard&) = delete;
+    PublishGuard& operator=(const PublishGuard&) = delete;
+
+private:
+    Topic& topic_;
+};
+
+}
+
+Subscription::Subscription(std::string topic, const SubscriptionOptions& options)
+    : topic_(std::move(topic)), options_(options), queue_(options.depth) {
+    if (options.depth == 0) {
+        throw std::invalid_argument("订阅队列深度必须大于0: " + topic_);
+    }
+}
+
+bool Subscription::deliver(const MessagePtr& msg) {
+    const size_t depth = options_.depth;
+    std::chrono::steady_clock::time_point deadline{};
+    for (;;) {
+        // 先占名额再入队，名额数始终不小于队列中的消息数，所以入队不会失败
+        const size_t used = count_.fetch_add(1, std::memory_order_acq_rel);
+        if (used < depth) {
+            MessagePtr copy = msg;
+            if (!queue_.tryPush(copy)) {
+                count_.fetch_sub(1, std::memory_order_acq_rel);
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            size_t peak = peak_.load(std::memory_order_relaxed);
+            while (used + 1 > peak && !peak_.compare_exchange_weak(peak, used + 1, std::memory_order_relaxed)) {
+            }
+            received_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        count_.fetch_sub(1, std::memory_order_acq_rel);
+
+        if (options_.policy == QueuePolicy::DropNewest) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (options_.policy == QueuePolicy::Block) {
+            // 等消费者取走消息；取消订阅或超时则放弃这条
+            const auto now = std::chrono::steady_clock::now();
+            if (deadline == std::chrono::steady_clock::time_point{}) {
+                deadline = now + options_.block_timeout;
+                blocked_.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (!active() || now >= deadline) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+        // KeepLatest: 挤掉最旧的一条后重试
+        MessagePtr oldest;
+        if (queue_.tryPop(oldest)) {
+            count_.fetch_sub(1, std::memory_order_acq_rel);
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool Subscription::take(MessagePtr& out) {
+    if (!queue_.tryPop(out)) {
+        return false;
+    }
+    count_.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+MessagePtr Subscription::takeLatest() {
+    MessagePtr latest;
+    MessagePtr msg;
+    while (take(msg)) {
+        latest = std::move(msg);
+    }
+    return latest;
+}
+
+size_t Publisher::publish(MessagePtr msg) const {
+    if (!topic_) {
+        throw std::runtime_error("发布者未绑定话题");
+    }
+    if (!msg) {
+        return 0;
+    }
+    size_t delivered = 0;
+    detail::PublishGuard guard(*topic_);
+    const size_t n = topic_->slot_count.load(std::memory_order_seq_cst);
+    for (size_t i = 0; i < n; ++i) {
+        Subscription* sub = topic_->slots[i].load(std::memory_order_seq_cst);
+        if (sub && !sub->paused() && sub->deliver(msg)) {
+            ++delivered;
+        }
+    }
+    topic_->published.fetch_add(1, std::memory_order_relaxed);
+    return delivered;
+}
+
+size_t Publisher::credits() const {
+    size_t credits = SIZE_MAX;
+    if (!topic_) {
+        return credits;
+    }
+    detail::PublishGuard guard(*topic_);
+    const size_t n = topic_->slot_count.load(std::memory_order_seq_cst);
+    for (size_t i = 0; i < n; ++i) {
+        Subscription* sub = topic_->slots[i].load(std::memory_order_seq_cst);
+        if (sub && !sub->paused() && sub->options().policy == QueuePolicy::Block) {
+            credits = std::min(credits, sub->credits());
+        }
+    }
+    return credits;
+}
+
+const std::string& Publisher::topic() const {
+    static const std::string empty;
+    return topic_ ? topic_->name : empty;
+}
+
+uint64_t Publisher::published() const {
+    return topic_ ? topic_->published.load(std::memory_order_relaxed) : 0;
+}
+
+namespace {
+thread_local int g_paused_scopes = 0;
+}
+
+PausedSubscriptionScope::PausedSubscriptionScope() {
+    ++g_paused_scopes;
+}
+
+PausedSubscriptionScope::~PausedSubscriptionScope() {
+    --g_paused_scopes;
+}
+
+bool PausedSubscriptionScope::active() {
+    return g_paused_scopes > 0;
+}
+
+TopicBus& TopicBus::global() {
+    static TopicBus bus;
+    return bus;
+}
+
+std::shared_ptr<detail::Topic> TopicBus::getOrCreate(const std::string& topic) {
+    auto it = topics_.find(topic);
+    if (it != topics_.end()) {
+        return it->second;
+    }
+    auto created = std::make_shared<detail::Topic>(topic);
+    topics_.emplace(topic, created);
+    return created;
+}
+
+Publisher TopicBus::advertise(const std::string& topic) {
+    if (topic.empty()) {
+        throw std::invalid_argument("话题名不能为空");
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return Publisher(getOrCreate(topic));
+}
+
+std::shared_ptr<Subscription> TopicBus::subscribe(const std::string& topic, const SubscriptionOptions& options) {
+    if (topic.empty()) {
+        throw std::invalid_argument("话题名不能为空");
+    }
+    auto sub = std::make_shared<Subscription>(topic, options);
+    sub->paused_.store(PausedSubscriptionScope::active(), std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto t = getOrCreate(topic);
+    release(*t);
+
+    // 优先复用取消订阅留下的空槽
+    const size_t n = t->slot_count.load(std::memory_order_relaxed);
+    size_t slot = n;
+    for (size_t i = 0; i < n; ++i) {
+        if (t->slots[i].load(std::memory_order_relaxed) == nullptr) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot == kMaxSubscribers) {
+        throw std::runtime_error("话题订阅者数量超过上限: " + topic);
+    }
+
+    t->owned.push_back(sub);
+    t->slots[slot].store(sub.get(), std::memory_order_release);
+    if (slot == n) {
+        t->slot_count.store(n + 1, std::memory_order_release);
+    }
+    return sub;
+}
+
+void TopicBus::unsubscribe(const std::shared_ptr<Subscription>& sub) {
+    if (!sub) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = topics_.find(sub->topic());
+    if (it == topics_.end()) {
+        return;
+    }
+    auto& t = *it->second;
+    const size_t n = t.slot_count.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < n; ++i) {
+        if (t.slots[i].load(std::memory_order_relaxed) == sub.get()) {
+            t.slots[i].store(nullptr, std::memory_order_seq_cst);
+            sub->active_.store(false, std::memory_order_release);
+            break;
+        }
+    }
+    // 排队的消息不会再有人取，立即释放；清空槽位前已开始的发布仍可能再放进来，随订阅对象一起释放
+    MessagePtr msg;
+    while (sub->take(msg)) {
+    }
+    release(t);
+}
+
+// 调用方持有 mutex_
+void TopicBus::release(detail::Topic& t) {
+    // 槽位已清空（seq_cst）后看到没有发布方在遍历: 之后开始的发布都读不到这些订阅
+    if (t.publishing.load(std::memory_order_seq_cst) != 0) {
+        return; // 留到下一次 subscribe/unsubscribe 再回收
+    }
+    t.owned.erase(std::remove_if(t.owned.begin(), t.owned.end(),
+                                 [](const std::shared_ptr<Subscription>& sub) { return !sub->active(); }),
+                  t.owned.end());
+}
+
+std::vector<std::string> TopicBus::topics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> names;
+    names.reserve(topics_.size());
+    for (const auto& kv : topics_) {
+        names.push_back(kv.first);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+size_t TopicBus::retainedCount(const std::string& topic) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = topics_.find(topic);
+    return it == topics_.end() ? 0 : it->second->owned.size();
+}
+
+size_t TopicBus::subscriberCount(const std::string& topic) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = topics_.find(topic);
+    if (it == topics_.end()) {
+        return 0;
+    }
+    size_t count = 0;
+    const size_t n = it->second->slot_count.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < n; ++i) {
+        if (it->second->slots[i].load(std::memory_order_relaxed)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+}
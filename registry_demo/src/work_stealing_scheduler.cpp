@@ -0,0 +1,192 @@
+#include "work_stealing_scheduler.hpp"
+#include <algorithm>
+#include <pthread.h>
+#include <sched.h>
+
+namespace duan {
+
+namespace {
+
+// 当前线程所属的调度器与工作线程编号
+thread_local const WorkStealingScheduler* tls_scheduler = nullptr;
+thread_local int tls_worker = -1;
+
+// xorshift，挑选窃取对象用
+inline uint64_t nextRandom(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+void pinToCpu(std::thread& thread, size_t index) {
+    const unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<int>(index % cpus), &set);
+    // 没有权限或CPU被cgroup限制时失败，不影响运行
+    pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+}
+
+}
+
+WorkStealingScheduler::WorkStealingScheduler(const WorkStealingOptions& options)
+    : spin_rounds_(std::max(0, options.spin_rounds)) {
+    size_t threads = options.threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    // 全部 Worker 构造完再启动线程，窃取时遍历的数组不再变化
+    for (size_t i = 0; i < threads; ++i) {
+        workers_[i]->thread = std::thread([this, i] { workerLoop(i); });
+        if (options.pin_threads) {
+            pinToCpu(workers_[i]->thread, i);
+        }
+    }
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+    // 任务可能继续提交新任务，等全部完成后再停
+    while (outstanding_.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+    stopping_.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(park_mutex_);
+        park_cv_.notify_all();
+    }
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+}
+
+int WorkStealingScheduler::currentWorker() const {
+    return tls_scheduler == this ? tls_worker : -1;
+}
+
+void WorkStealingScheduler::schedule(Task task) {
+    Task* item = new Task(std::move(task));
+    outstanding_.fetch_add(1, std::memory_order_relaxed);
+    const int self = currentWorker();
+    if (self >= 0) {
+        workers_[static_cast<size_t>(self)]->deque.push(item);
+    } else {
+        std::lock_guard<std::mutex> lock(inject_mutex_);
+        injected_.push_back(item);
+        injected_count_.fetch_add(1, std::memory_order_release);
+    }
+    wakeOne();
+}
+
+void WorkStealingScheduler::wakeOne() {
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(park_mutex_);
+        park_cv_.notify_one();
+    }
+}
+
+TaskScheduler::Task* WorkStealingScheduler::takeInjected() {
+    if (injected_count_.load(std::memory_order_acquire) == 0) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(inject_mutex_);
+    if (injected_.empty()) {
+        return nullptr;
+    }
+    Task* item = injected_.front();
+    injected_.pop_front();
+    injected_count_.fetch_sub(1, std::memory_order_relaxed);
+    return item;
+}
+
+TaskScheduler::Task* WorkStealingScheduler::findTask(size_t index, uint64_t& rng) {
+    Worker& self = *workers_[index];
+    Task* item = nullptr;
+    if (self.deque.pop(item)) {
+        return item;
+    }
+    if ((item = takeInjected()) != nullptr) {
+        self.injected.fetch_add(1, std::memory_order_relaxed);
+        return item;
+    }
+    // 从随机位置开始轮一遍其他线程
+    const size_t n = workers_.size();
+    const size_t start = static_cast<size_t>(nextRandom(rng) % n);
+    for (size_t k = 0; k < n; ++k) {
+        const size_t victim = (start + k) % n;
+        if (victim != index && workers_[victim]->deque.steal(item)) {
+            self.stolen.fetch_add(1, std::memory_order_relaxed);
+            return item;
+        }
+    }
+    return nullptr;
+}
+
+bool WorkStealingScheduler::hasWork() const {
+    if (injected_count_.load(std::memory_order_acquire) > 0) {
+        return true;
+    }
+    for (const auto& worker : workers_) {
+        if (!worker->deque.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingScheduler::workerLoop(size_t index) {
+    tls_scheduler = this;
+    tls_worker = static_cast<int>(index);
+    Worker& self = *workers_[index];
+    uint64_t rng = 0x9E3779B97F4A7C15ull * (index + 1);
+    int idle = 0;
+
+    for (;;) {
+        if (Task* item = findTask(index, rng)) {
+            (*item)();
+            delete item;
+            self.executed.fetch_add(1, std::memory_order_relaxed);
+            outstanding_.fetch_sub(1, std::memory_order_acq_rel);
+            idle = 0;
+            continue;
+        }
+        if (stopping_.load(std::memory_order_acquire)) {
+            return;
+        }
+        if (++idle < spin_rounds_) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // 休眠前先登记再复查，与 wakeOne 的 "递增epoch、检查sleepers" 配对，不会丢失唤醒
+        const uint64_t seen = epoch_.load(std::memory_order_acquire);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        if (!hasWork() && !stopping_.load(std::memory_order_acquire)) {
+            self.parks.fetch_add(1, std::memory_order_relaxed);
+            std::unique_lock<std::mutex> lock(park_mutex_);
+            park_cv_.wait(lock, [this, seen] {
+                return stopping_.load(std::memory_order_acquire) || epoch_.load(std::memory_order_acquire) != seen;
+            });
+        }
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        idle = 0;
+    }
+}
+
+WorkStealingScheduler::Stats WorkStealingScheduler::stats() const {
+    Stats total;
+    for (const auto& worker : workers_) {
+        total.executed += worker->executed.load(std::memory_order_relaxed);
+        total.stolen += worker->stolen.load(std::memory_order_relaxed);
+        total.injected += worker->injected.load(std::memory_order_relaxed);
+        total.parks += worker->parks.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+}
@@ -0,0 +1,27 @@
+#include "plugin_api.hpp"
+
+// PluginLoader 测试用组件库，提供 "test_plugin_echo"
+namespace {
+
+class EchoComponent : public duan::Component {
+public:
+    explicit EchoComponent(const duan::ConfigView&) {}
+    void start() override {}
+    void spinOnce() override {}
+};
+
+void registerEcho(duan::PluginRegistrar& registrar) {
+    registrar.add("test_plugin_echo", [](const duan::ConfigView& cfg) { return std::make_shared<EchoComponent>(cfg); });
+}
+
+}
+
+#ifdef TEST_PLUGIN_BAD_VERSION
+// 模拟按旧接口编译的库
+extern "C" __attribute__((visibility("default"))) const duan::PluginDescriptor* duan_plugin_descriptor() {
+    static const duan::PluginDescriptor descriptor{duan::kPluginApiVersion + 1, "test_bad_version", registerEcho};
+    return &descriptor;
+}
+#else
+DUAN_COMPONENT_LIBRARY("test_echo", registerEcho)
+#endif
@@ -0,0 +1,1729 @@
+#include <atomic>
+#include <cassert>
+#include <functional>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <thread>
+#include "registry.hpp"
+#include "ground_segmentation.hpp"
+#include "messages.hpp"
+#include "pipeline_executor.hpp"
+#include "pipeline_topics.hpp"
+#include "plugin_loader.hpp"
+#include "chase_lev_deque.hpp"
+#include "config_cache.hpp"
+#include "config_watcher.hpp"
+#include "profiler.hpp"
+#include "realtime_executor.hpp"
+#include "work_stealing_scheduler.hpp"
+#include "topic_bus.hpp"
+
+using namespace duan;
+
+// 测试中用 JSON 写配置，编译后交给以 ConfigView 为参数的接口；视图只在返回值存活期间有效
+CompiledConfig compiled(const nlohmann::json& cfg) {
+    return CompiledConfig::compile(cfg);
+}
+
+void testRegistryCreate() {
+    std::cout << "测试注册表创建组件..." << std::endl;
+
+    nlohmann::json lidar = {{"name", "lidar"}, {"type", "robosense"}, {"topic", "/lidar/points"}};
+    assert(ComponentRegistry::Create("robosense", compiled(lidar).root()) != nullptr);
+    assert(ComponentRegistry::Create("not_registered", compiled(lidar).root()) == nullptr);
+
+    nlohmann::json stage = {{"name", "obstacle_clustering"}, {"type", "ground_cluster"}, {"input", {"lidar"}}, {"threads", 2}};
+    assert(ComponentRegistry::Create("ground_cluster", compiled(stage).root()) != nullptr);
+
+    std::cout << "注册表测试通过！" << std::endl;
+}
+
+void testGroundSegmentation() {
+    std::cout << "测试地面分割与聚类..." << std::endl;
+
+    LidarFrame frame = simulateLidarFrame(64, 1800, 0);
+    assert(frame.size() == 64 * 1800);
+
+    SegmentationResult serial;
+    GroundObstacleSegmenter serial_segmenter;
+    serial_segmenter.process(frame, serial);
+
+    ThreadPool pool(4);
+    GroundObstacleSegmenter parallel_segmenter(SegmentationConfig(), &pool);
+    SegmentationResult parallel;
+    auto t0 = std::chrono::steady_clock::now();
+    parallel_segmenter.process(frame, parallel);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    // 串行和并行结果一致
+    assert(serial.labels == parallel.labels);
+    assert(serial.cluster_ids == parallel.cluster_ids);
+    assert(serial.obstacles.size() == parallel.obstacles.size());
+
+    // 大部分有效点是地面，模拟场景中的5个障碍物都应被检出
+    assert(parallel.ground_points > frame.size() / 2);
+    assert(parallel.obstacles.size() >= 5);
+    for (const auto& box : parallel.obstacles) {
+        assert(box.num_points >= SegmentationConfig().min_cluster_points);
+        assert(box.min_z > -1.8f - 0.3f);
+    }
+
+    // 第一个障碍物位于车辆正前方 8~12.5 米
+    bool found_front = false;
+    for (const auto& box : parallel.obstacles) {
+        if (box.min_x > 7.5f && box.max_x < 13.0f && box.min_y > -1.5f && box.max_y < 1.5f) {
+            found_front = true;
+        }
+    }
+    assert(found_front);
+
+    std::cout << "地面分割测试通过！(" << frame.size() << " 点, " << parallel.obstacles.size()
+              << " 个障碍物, " << ms << " ms)" << std::endl;
+}
+
+void testTopicBus() {
+    std::cout << "测试话题总线..." << std::endl;
+
+    TopicBus bus;
+    auto latest = bus.subscribe("/test", {2, QueuePolicy::KeepLatest});
+    auto oldest = bus.subscribe("/test", {2, QueuePolicy::DropNewest});
+    Publisher pub = bus.advertise("/test");
+    assert(bus.subscriberCount("/test") == 2);
+
+    // 零拷贝：订阅者拿到的是同一个对象
+    auto frame = std::make_shared<LidarFrame>();
+    frame->seq = 0;
+    assert(pub.publish(frame) == 2);
+    MessagePtr got;
+    assert(latest->take(got) && got.get() == frame.get());
+    assert(oldest->take(got) && got.get() == frame.get());
+    assert(!latest->take(got));
+
+    for (uint64_t i = 1; i <= 5; ++i) {
+        auto msg = std::make_shared<LidarFrame>();
+        msg->seq = i;
+        pub.publish(msg);
+    }
+    // KeepLatest 保留最后两帧，DropNewest 保留最先两帧
+    assert(latest->pending() == 2 && latest->dropped() == 3);
+    assert(latest->take(got) && got->seq == 4);
+    assert(latest->take(got) && got->seq == 5);
+    assert(oldest->pending() == 2 && oldest->dropped() == 3);
+    assert(oldest->takeLatest()->seq == 2);
+    assert(oldest->takeLatest() == nullptr);
+
+    // 取消订阅后不再接收
+    bus.unsubscribe(oldest);
+    assert(!oldest->active() && bus.subscriberCount("/test") == 1);
+    assert(pub.publish(std::make_shared<LidarFrame>()) == 1);
+
+    // 反复订阅、排队、取消: 排队的消息立即释放，总线不再持有取消的订阅
+    std::weak_ptr<Message> queued;
+    for (int i = 0; i < 100; ++i) {
+        auto churn = bus.subscribe("/test", {4, QueuePolicy::KeepLatest});
+        auto msg = std::make_shared<LidarFrame>();
+        queued = msg;
+        pub.publish(std::move(msg));
+        assert(churn->pending() == 1 && latest->takeLatest() != nullptr);
+        bus.unsubscribe(churn);
+        assert(churn->pending() == 0 && queued.expired());
+        assert(bus.retainedCount("/test") == 1);
+    }
+    assert(bus.subscriberCount("/test") == 1);
+
+    // 多个发布线程并发投递，订阅线程同时消费，消息不丢不重
+    auto sub = bus.subscribe("/mt", {64, QueuePolicy::DropNewest});
+    Publisher mt = bus.advertise("/mt");
+    const uint64_t per_thread = 20000;
+    std::vector<std::thread> producers;
+    for (uint64_t t = 0; t < 3; ++t) {
+        producers.emplace_back([&, t] {
+            for (uint64_t i = 0; i < per_thread; ++i) {
+                auto msg = std::make_shared<Message>();
+                msg->seq = t * per_thread + i;
+                while (mt.publish(msg) == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    std::vector<uint8_t> seen(3 * per_thread, 0);
+    uint64_t consumed = 0;
+    while (consumed < 3 * per_thread) {
+        if (sub->take(got)) {
+            assert(seen[got->seq] == 0);
+            seen[got->seq] = 1;
+            ++consumed;
+        }
+    }
+    for (auto& p : producers) p.join();
+    assert(sub->received() == 3 * per_thread);
+    assert(mt.published() >= 3 * per_thread);   // 队列满时的重试也计入发布次数
+
+    std::cout << "话题总线测试通过！" << std::endl;
+}
+
+void testPipelineTopics() {
+    std::cout << "测试配置驱动的话题连接..." << std::endl;
+
+    nlohmann::json config = {
+        {"sensors", {
+            {{"name", "lidar_t"}, {"type", "robosense"}, {"topic", "/t/lidar"}, {"rings", 32}, {"beams", 360}},
+            {{"name", "camera_t"}, {"type", "hikvision"}, {"topic", "/t/camera"}, {"width", 320}, {"height", 240}},
+            {{"name", "gnss_t"}, {"type", "ublox"}, {"topic", "/t/gnss"}}
+        }},
+        {"algorithms", {
+            {{"name", "detector_t"}, {"type", "yolox"}, {"input", {"camera_t"}}},
+            {{"name", "localization_t"}, {"type", "ekf"}, {"input", {"gnss_t", "lidar_t"}}},
+            {{"name", "clustering_t"}, {"type", "ground_cluster"}, {"input", {"lidar_t"}}, {"threads", 2}},
+            {{"name", "fusion_t"}, {"type", "fusion_v2"}, {"input", {"detector_t", "localization_t"}}}
+        }}
+    };
+    resolvePipelineTopics(config);
+    assert(config["algorithms"][0]["topic"] == "/detector_t");
+    assert(config["algorithms"][1]["input_topics"] == nlohmann::json({"/t/gnss", "/t/lidar"}));
+    assert(config["algorithms"][3]["input_topics"] == nlohmann::json({"/detector_t", "/localization_t"}));
+
+    std::vector<std::shared_ptr<Component>> components;
+    for (const char* section : {"sensors", "algorithms"}) {
+        for (const auto& cfg : config[section]) {
+            components.push_back(ComponentRegistry::Create(cfg.at("type"), compiled(cfg).root()));
+            assert(components.back() != nullptr);
+        }
+    }
+
+    auto fused = TopicBus::global().subscribe("/fusion_t");
+    auto obstacles = TopicBus::global().subscribe("/clustering_t");
+    for (int i = 0; i < 3; ++i) {
+        for (auto& c : components) c->spinOnce();
+    }
+
+    assert(fused->received() == 3);
+    auto result = std::dynamic_pointer_cast<const FusedObjects>(fused->takeLatest());
+    assert(result && result->seq == 2 && result->num_detections > 0);
+    auto clusters = std::dynamic_pointer_cast<const ObstacleList>(obstacles->takeLatest());
+    assert(clusters && !clusters->obstacles.empty());
+
+    // 输入引用不存在的组件
+    nlohmann::json bad = {{"algorithms", {{{"name", "a"}, {"type", "yolox"}, {"input", {"missing"}}}}}};
+    bool thrown = false;
+    try {
+        resolvePipelineTopics(bad);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "话题连接测试通过！" << std::endl;
+}
+
+namespace {
+
+// 执行器测试用组件: 记录每次执行的先后顺序，可选地与另一个节点会合或抛出异常
+struct ProbeEvent {
+    std::string name;
+    int begin;
+    int end;
+};
+
+std::mutex g_probe_mutex;
+std::vector<ProbeEvent> g_probe_events;
+std::atomic<int> g_probe_clock{0};
+std::atomic<int> g_rendezvous{0};
+std::atomic<int> g_rendezvous_timeouts{0};
+
+class ProbeComponent : public Component {
+    std::string name_;
+    bool rendezvous_;
+    bool fail_;
+    int start_ms_;
+    bool start_fail_;
+    int runs_ = 0;
+public:
+    explicit ProbeComponent(const ConfigView& cfg)
+        : name_(cfg.at("name").asString()), rendezvous_(cfg.value("rendezvous", false)), fail_(cfg.value("fail", false)),
+          start_ms_(cfg.value("start_ms", 0)), start_fail_(cfg.value("start_fail", false)) {}
+    // 模拟耗时的初始化（加载模型、打开设备）
+    void start() override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(start_ms_));
+        if (start_fail_) {
+            throw std::runtime_error("probe start failure: " + name_);
+        }
+    }
+    void spinOnce() override {
+        const int begin = g_probe_clock.fetch_add(1);
+        ++runs_;
+        if (rendezvous_) {
+            // 两个会合节点每帧各到达一次，只有并行执行时才能都等到对方
+            g_rendezvous.fetch_add(1);
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+            while (g_rendezvous.load() < 2 * runs_) {
+                if (std::chrono::steady_clock::now() > deadline) {
+                    g_rendezvous_timeouts.fetch_add(1);
+                    break;
+                }
+                std::this_thread::yield();
+            }
+        }
+        const int end = g_probe_clock.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(g_probe_mutex);
+            g_probe_events.push_back({name_, begin, end});
+        }
+        if (fail_) {
+            throw std::runtime_error("probe failure: " + name_);
+        }
+    }
+};
+
+const bool probe_registered = [] {
+    ComponentRegistry::Register("test_probe", [](const ConfigView& cfg) { return std::make_shared<ProbeComponent>(cfg); });
+    return true;
+}();
+
+const ProbeEvent* findEvent(const std::vector<ProbeEvent>& events, const std::string& name) {
+    for (const auto& e : events) {
+        if (e.name == name) return &e;
+    }
+    return nullptr;
+}
+
+}
+
+void testPipelineExecutor() {
+    std::cout << "测试依赖图执行器..." << std::endl;
+
+    // 依赖图: 拓扑序与层级
+    nlohmann::json config = {
+        {"sensors", {
+            {{"name", "lidar"}, {"type", "robosense"}, {"topic", "/lidar/points"}},
+            {{"name", "camera"}, {"type", "hikvision"}, {"topic", "/camera/image"}},
+            {{"name", "gnss"}, {"type", "ublox"}, {"topic", "/gnss/data"}}
+        }},
+        {"algorithms", {
+            {{"name", "sensor_fusion"}, {"type", "fusion_v2"}, {"input", {"object_detector", "localization"}}},
+            {{"name", "object_detector"}, {"type", "yolox"}, {"input", {"camera"}}},
+            {{"name", "localization"}, {"type", "ekf"}, {"input", {"gnss", "lidar"}}}
+        }}
+    };
+    const CompiledConfig graph_config = compiled(config);
+    PipelineGraph graph(graph_config.root());
+    assert(graph.size() == 6);
+    const size_t fusion = graph.find("sensor_fusion");
+    assert(graph.node(fusion).inputs.size() == 2);
+    assert(graph.depths()[fusion] == 2 && graph.depths()[graph.find("gnss")] == 0);
+    assert(graph.order().back() == fusion);
+    assert(graph.find("nothing") == PipelineGraph::npos);
+    std::ostringstream described;
+    graph.describe(described);
+    assert(described.str().find("sensor_fusion (fusion_v2) <- object_detector localization") != std::string::npos);
+
+    // 环、缺失输入、重名
+    auto rejects = [](const nlohmann::json& cfg) {
+        try {
+            PipelineGraph bad(compiled(cfg).root());
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    assert(rejects({{"algorithms", {{{"name", "a"}, {"type", "x"}, {"input", {"b"}}},
+                                    {{"name", "b"}, {"type", "x"}, {"input", {"a"}}}}}}));
+    assert(rejects({{"algorithms", {{{"name", "a"}, {"type", "x"}, {"input", {"a"}}}}}}));
+    assert(rejects({{"algorithms", {{{"name", "a"}, {"type", "x"}, {"input", {"missing"}}}}}}));
+    assert(rejects({{"sensors", {{{"name", "a"}, {"type", "x"}}, {{"name", "a"}, {"type", "x"}}}}}));
+
+    // 未注册的组件类型
+    bool thrown = false;
+    try {
+        nlohmann::json unknown = {{"sensors", {{{"name", "a"}, {"type", "not_registered"}}}}};
+        PipelineExecutor executor(unknown);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 菱形依赖: 下游在全部上游结束后才开始，独立分支并行执行
+    nlohmann::json diamond = {
+        {"sensors", {{{"name", "s1"}, {"type", "test_probe"}}, {{"name", "s2"}, {"type", "test_probe"}}}},
+        {"algorithms", {
+            {{"name", "join"}, {"type", "test_probe"}, {"input", {"left", "right"}}},
+            {{"name", "left"}, {"type", "test_probe"}, {"input", {"s1"}}, {"rendezvous", true}},
+            {{"name", "right"}, {"type", "test_probe"}, {"input", {"s2"}}, {"rendezvous", true}}
+        }}
+    };
+    PipelineExecutor executor(diamond, 2);
+    executor.start();
+    for (int frame = 0; frame < 5; ++frame) {
+        g_probe_events.clear();
+        executor.runFrame();
+        assert(g_probe_events.size() == 5);
+        const ProbeEvent* join = findEvent(g_probe_events, "join");
+        const ProbeEvent* left = findEvent(g_probe_events, "left");
+        const ProbeEvent* right = findEvent(g_probe_events, "right");
+        assert(join->begin > left->end && join->begin > right->end);
+        assert(left->begin > findEvent(g_probe_events, "s1")->end);
+        assert(right->begin > findEvent(g_probe_events, "s2")->end);
+    }
+    assert(g_rendezvous_timeouts.load() == 0);
+    assert(executor.frames() == 5);
+
+    // 组件抛出的异常在 runFrame 中重新抛出，本帧其余节点照常执行
+    nlohmann::json failing = {
+        {"sensors", {{{"name", "f1"}, {"type", "test_probe"}, {"fail", true}}}},
+        {"algorithms", {{{"name", "f2"}, {"type", "test_probe"}, {"input", {"f1"}}}}}
+    };
+    PipelineExecutor failing_executor(failing, 1);
+    g_probe_events.clear();
+    thrown = false;
+    try {
+        failing_executor.runFrame();
+    } catch (const std::runtime_error& e) {
+        thrown = std::string(e.what()) == "probe failure: f1";
+    }
+    assert(thrown);
+    assert(findEvent(g_probe_events, "f2") != nullptr);
+
+    // 真实组件: 每帧的数据沿依赖图流到融合节点
+    nlohmann::json pipeline = {
+        {"sensors", {
+            {{"name", "lidar_e"}, {"type", "robosense"}, {"topic", "/e/lidar"}, {"rings", 16}, {"beams", 360}},
+            {{"name", "camera_e"}, {"type", "hikvision"}, {"topic", "/e/camera"}, {"width", 320}, {"height", 240}},
+            {{"name", "gnss_e"}, {"type", "ublox"}, {"topic", "/e/gnss"}}
+        }},
+        {"algorithms", {
+            {{"name", "detector_e"}, {"type", "yolox"}, {"input", {"camera_e"}}},
+            {{"name", "localization_e"}, {"type", "ekf"}, {"input", {"gnss_e", "lidar_e"}}},
+            {{"name", "fusion_e"}, {"type", "fusion_v2"}, {"input", {"detector_e", "localization_e"}}}
+        }}
+    };
+    resolvePipelineTopics(pipeline);
+    PipelineExecutor real(pipeline);
+    auto fused = TopicBus::global().subscribe("/fusion_e");
+    real.run(3);
+    assert(fused->received() == 3);
+    auto result = std::dynamic_pointer_cast<const FusedObjects>(fused->takeLatest());
+    assert(result && result->seq == 2);
+    assert(real.component("detector_e") != nullptr && real.component("nothing") == nullptr);
+
+    std::cout << "依赖图执行器测试通过！(" << real.threads() << " 线程)" << std::endl;
+}
+
+namespace {
+
+// 批处理测试用组件: 源节点每帧发布 burst 条消息，下游记录每次调用的批大小
+class BurstSource : public TopicComponent {
+    int burst_;
+    uint64_t seq_ = 0;
+public:
+    explicit BurstSource(const ConfigView& cfg) : TopicComponent(cfg), burst_(cfg.value("burst", 1)) {}
+    void start() override {}
+    void process(const FrameContext&, const Inputs&, Outputs& out) override {
+        for (int i = 0; i < burst_; ++i) {
+            auto msg = std::make_shared<Message>();
+            msg->seq = seq_++;
+            out.publish(std::move(msg));
+        }
+    }
+};
+
+class BatchSink : public TopicComponent {
+    size_t max_batch_;
+    int sleep_us_;
+public:
+    std::vector<size_t> batches;
+    std::vector<uint64_t> seqs;
+
+    explicit BatchSink(const ConfigView& cfg)
+        : TopicComponent(cfg), max_batch_(static_cast<size_t>(cfg.value("max_batch", 1))), sleep_us_(cfg.value("sleep_us", 0)) {}
+    void start() override {}
+    void process(const FrameContext& ctx, const Inputs& in, Outputs&) override {
+        if (ctx.batch_size == 1) batches.push_back(1);
+        seqs.push_back(in[0]->seq);
+        std::this_thread::sleep_for(std::chrono::microseconds(sleep_us_));
+    }
+    void processBatch(const std::vector<FrameContext>& ctx, const std::vector<Inputs>& in,
+                      std::vector<Outputs>&) override {
+        batches.push_back(ctx.size());
+        for (size_t i = 0; i < ctx.size(); ++i) {
+            assert(ctx[i].batch_index == i && ctx[i].batch_size == ctx.size());
+            seqs.push_back(in[i][0]->seq);
+            std::this_thread::sleep_for(std::chrono::microseconds(sleep_us_));
+        }
+    }
+    size_t maxBatchSize() const override { return max_batch_; }
+};
+
+const bool batch_registered = [] {
+    ComponentRegistry::Register("test_burst", [](const ConfigView& cfg) { return std::make_shared<BurstSource>(cfg); });
+    ComponentRegistry::Register("test_batch_sink", [](const ConfigView& cfg) { return std::make_shared<BatchSink>(cfg); });
+    return true;
+}();
+
+}
+
+void testComponentBatching() {
+    std::cout << "测试组件批处理..." << std::endl;
+
+    // 端口按末尾对齐多路输入，没有新消息的输入沿用上一条
+    TopicBus& bus = TopicBus::global();
+    Publisher pub_a = bus.advertise("/batch/a");
+    Publisher pub_b = bus.advertise("/batch/b");
+    nlohmann::json port_cfg = {{"name", "ports"}, {"input_topics", {"/batch/a", "/batch/b"}}, {"queue_depth", 8}};
+    ComponentPorts ports(compiled(port_cfg).root(), bus);
+    assert(!ports.isSource() && ports.pending() == 0 && ports.outputTopic() == "/ports");
+    auto message = [](uint64_t seq) {
+        auto msg = std::make_shared<Message>();
+        msg->seq = seq;
+        return msg;
+    };
+    for (uint64_t i = 0; i < 3; ++i) pub_a.publish(message(i));
+    pub_b.publish(message(100));
+    assert(ports.pending() == 3);
+    std::vector<Inputs> frames;
+    assert(ports.collect(8, frames) == 3);
+    assert(frames[0][0]->seq == 0 && frames[0][1] == nullptr && !frames[0].updated(1));
+    assert(frames[2][0]->seq == 2 && frames[2][1]->seq == 100 && frames[2].updated(1));
+    // 积压超过上限时只处理最新的几帧，被丢弃的消息仍作为"上一条"
+    for (uint64_t i = 3; i < 7; ++i) pub_a.publish(message(i));
+    pub_b.publish(message(101));
+    pub_b.publish(message(102));
+    frames.clear();
+    assert(ports.collect(1, frames) == 1);
+    assert(frames[0][0]->seq == 6 && frames[0][1]->seq == 102);
+    frames.clear();
+    pub_a.publish(message(7));
+    assert(ports.collect(1, frames) == 1 && frames[0][1]->seq == 102 && !frames[0].updated(1));
+    frames.clear();
+    assert(ports.collect(4, frames) == 0);
+
+    // YOLOX 批处理与逐帧处理结果一致
+    nlohmann::json yolo_cfg = {{"name", "detector_batch"}, {"type", "yolox"}, {"input", {"camera_batch"}}, {"max_batch", 4}};
+    auto single = ComponentRegistry::Create("yolox", compiled(yolo_cfg).root());
+    auto batched = ComponentRegistry::Create("yolox", compiled(yolo_cfg).root());
+    assert(batched->maxBatchSize() == 4 && batched->ports() != nullptr);
+    std::vector<FrameContext> ctx(3);
+    std::vector<Inputs> images;
+    for (int i = 0; i < 3; ++i) {
+        auto image = std::make_shared<CameraImage>();
+        image->seq = i;
+        image->width = 160;
+        image->height = 120;
+        image->data.assign(160 * 120 * 3, 40);
+        for (int y = 20 * i; y < 20 * i + 20; ++y) {
+            std::fill(image->data.begin() + (y * 160 + 20 * i) * 3, image->data.begin() + (y * 160 + 20 * i + 20) * 3, 250);
+        }
+        images.emplace_back(std::vector<MessagePtr>{image}, std::vector<bool>{true});
+        ctx[i].batch_index = i;
+        ctx[i].batch_size = 3;
+    }
+    std::vector<Outputs> batch_out(3);
+    batched->processBatch(ctx, images, batch_out);
+    for (int i = 0; i < 3; ++i) {
+        Outputs out;
+        single->process(FrameContext(), images[i], out);
+        auto a = std::dynamic_pointer_cast<const DetectionList>(out.messages().at(0));
+        auto b = std::dynamic_pointer_cast<const DetectionList>(batch_out[i].messages().at(0));
+        assert(a && b && a->image_seq == b->image_seq && a->detections.size() == b->detections.size());
+        assert(!a->detections.empty());
+        for (size_t k = 0; k < a->detections.size(); ++k) {
+            assert(a->detections[k].x == b->detections[k].x && a->detections[k].score == b->detections[k].score);
+        }
+    }
+
+    // 执行器按积压选择批大小，不超过组件上限
+    nlohmann::json burst = {
+        {"sensors", {{{"name", "burst"}, {"type", "test_burst"}, {"burst", 5}}}},
+        {"algorithms", {
+            {{"name", "wide"}, {"type", "test_batch_sink"}, {"input", {"burst"}}, {"max_batch", 8}, {"queue_depth", 16}},
+            {{"name", "narrow"}, {"type", "test_batch_sink"}, {"input", {"burst"}}, {"max_batch", 3}, {"queue_depth", 16}},
+            {{"name", "single"}, {"type", "test_batch_sink"}, {"input", {"burst"}}, {"queue_depth", 16}}
+        }}
+    };
+    resolvePipelineTopics(burst);
+    PipelineExecutor executor(burst, 2);
+    executor.run(2);
+    auto wide = std::dynamic_pointer_cast<BatchSink>(executor.component("wide"));
+    auto narrow = std::dynamic_pointer_cast<BatchSink>(executor.component("narrow"));
+    auto one = std::dynamic_pointer_cast<BatchSink>(executor.component("single"));
+    assert(wide->batches == std::vector<size_t>({5, 5}));
+    assert(wide->seqs.size() == 10 && wide->seqs.front() == 0 && wide->seqs.back() == 9);
+    assert(narrow->batches == std::vector<size_t>({3, 3}));
+    assert(narrow->seqs == std::vector<uint64_t>({2, 3, 4, 7, 8, 9}));
+    assert(one->batches == std::vector<size_t>({1, 1}) && one->seqs == std::vector<uint64_t>({4, 9}));
+    assert(executor.stats("wide").frames == 10 && executor.stats("wide").max_batch == 5);
+    assert(executor.stats("burst").last_batch == 1);
+
+    // 配置了延迟预算时，按测得的单帧耗时缩小批大小
+    nlohmann::json budget = {
+        {"sensors", {{{"name", "burst_b"}, {"type", "test_burst"}, {"burst", 8}}}},
+        {"algorithms", {
+            {{"name", "slow"}, {"type", "test_batch_sink"}, {"input", {"burst_b"}}, {"max_batch", 8},
+             {"queue_depth", 16}, {"sleep_us", 2000}, {"batch_latency_ms", 5}}
+        }}
+    };
+    resolvePipelineTopics(budget);
+    PipelineExecutor budgeted(budget, 1);
+    budgeted.run(3);
+    auto slow = std::dynamic_pointer_cast<BatchSink>(budgeted.component("slow"));
+    assert(slow->batches.front() == 8);
+    assert(slow->batches.back() <= 2);
+    assert(budgeted.stats("slow").frame_cost_us >= 2000.0);
+
+    std::cout << "组件批处理测试通过！" << std::endl;
+}
+
+void testWorkStealingScheduler() {
+    std::cout << "测试工作窃取调度器..." << std::endl;
+
+    // 单线程语义: 所有者 LIFO，窃取者 FIFO，容量不足时扩容
+    ChaseLevDeque<int*> deque(4);
+    std::vector<int> values(1000);
+    for (int i = 0; i < 1000; ++i) {
+        values[i] = i;
+        deque.push(&values[i]);
+    }
+    assert(deque.sizeApprox() == 1000 && deque.capacity() >= 1000);
+    int* item = nullptr;
+    assert(deque.pop(item) && *item == 999);
+    assert(deque.steal(item) && *item == 0);
+    while (deque.pop(item)) {
+    }
+    assert(deque.empty() && !deque.steal(item));
+
+    // 所有者边压边弹，三个窃取者同时窃取，每个元素恰好被取走一次
+    constexpr int kItems = 200000;
+    std::vector<int> payload(kItems);
+    std::vector<std::atomic<int>> taken(kItems);
+    ChaseLevDeque<int*> shared(64);
+    std::atomic<bool> done{false};
+    auto take = [&](int* p) { taken[p - payload.data()].fetch_add(1); };
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t) {
+        thieves.emplace_back([&] {
+            int* p = nullptr;
+            while (!done.load()) {
+                if (shared.steal(p)) take(p);
+            }
+            while (shared.steal(p)) take(p);
+        });
+    }
+    for (int i = 0; i < kItems; ++i) {
+        shared.push(&payload[i]);
+        int* p = nullptr;
+        if (i % 3 == 0 && shared.pop(p)) take(p);
+    }
+    int* rest = nullptr;
+    while (shared.pop(rest)) take(rest);
+    done.store(true);
+    for (auto& t : thieves) t.join();
+    for (int i = 0; i < kItems; ++i) {
+        assert(taken[i].load() == 1);
+    }
+
+    // 调度器: 外部提交的任务在工作线程内再派生子任务，全部执行且只执行一次
+    std::atomic<int> leaves{0};
+    std::atomic<int> inside_worker{0};
+    {
+        WorkStealingOptions options;
+        options.threads = 3;
+        options.pin_threads = true;
+        WorkStealingScheduler scheduler(options);
+        assert(scheduler.size() == 3 && scheduler.currentWorker() == -1);
+        std::function<void(int)> spawn = [&](int depth) {
+            if (scheduler.currentWorker() >= 0) inside_worker.fetch_add(1);
+            if (depth == 0) {
+                leaves.fetch_add(1);
+                return;
+            }
+            scheduler.schedule([&spawn, depth] { spawn(depth - 1); });
+            scheduler.schedule([&spawn, depth] { spawn(depth - 1); });
+        };
+        for (int root = 0; root < 8; ++root) {
+            scheduler.schedule([&spawn] { spawn(10); });
+        }
+        while (leaves.load() < 8 * 1024) {
+            std::this_thread::yield();
+        }
+        // 空闲后休眠，新任务能唤醒
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::atomic<bool> woke{false};
+        scheduler.schedule([&woke] { woke.store(true); });
+        while (!woke.load()) {
+            std::this_thread::yield();
+        }
+        // executed 在任务返回并释放后才累加，最后一个任务的计数可能稍晚可见
+        while (scheduler.stats().executed < 8 * 2047 + 1) {
+            std::this_thread::yield();
+        }
+        const auto stats = scheduler.stats();
+        assert(stats.executed == 8 * 2047 + 1);
+        assert(stats.injected == 9);
+        assert(stats.parks > 0);
+    }
+    assert(leaves.load() == 8 * 1024);
+    assert(inside_worker.load() == 8 * 2047);
+
+    // 执行器参数与两种调度器
+    nlohmann::json cfg = {{"executor", {{"threads", 2}, {"scheduler", "shared_queue"}}},
+                          {"sensors", {{{"name", "q1"}, {"type", "test_probe"}}}},
+                          {"algorithms", {{{"name", "q2"}, {"type", "test_probe"}, {"input", {"q1"}}}}}};
+    ExecutorOptions options = executorOptions(compiled(cfg).root());
+    assert(options.threads == 2 && options.scheduler == SchedulerKind::SharedQueue);
+    PipelineExecutor shared_queue(cfg, options);
+    g_probe_events.clear();
+    shared_queue.run(3);
+    assert(g_probe_events.size() == 6 && shared_queue.threads() == 2);
+    cfg["executor"]["scheduler"] = "round_robin";
+    bool thrown = false;
+    try {
+        executorOptions(compiled(cfg).root());
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "工作窃取调度器测试通过！" << std::endl;
+}
+
+void testParallelStartup() {
+    std::cout << "测试并行启动..." << std::endl;
+
+    // 三层依赖，每个组件启动 60ms: 逐个启动需要 360ms，按层并行约 180ms
+    nlohmann::json config = {
+        {"sensors", {
+            {{"name", "s1"}, {"type", "test_probe"}, {"start_ms", 60}},
+            {{"name", "s2"}, {"type", "test_probe"}, {"start_ms", 60}},
+            {{"name", "s3"}, {"type", "test_probe"}, {"start_ms", 60}}
+        }},
+        {"algorithms", {
+            {{"name", "a"}, {"type", "test_probe"}, {"input", {"s1", "s2"}}, {"start_ms", 60}},
+            {{"name", "b"}, {"type", "test_probe"}, {"input", {"s3"}}, {"start_ms", 60}},
+            {{"name", "c"}, {"type", "test_probe"}, {"input", {"a"}}, {"start_ms", 60}}
+        }}
+    };
+    PipelineExecutor executor(config, 3);
+    StartupTimeline timeline = executor.start();
+    const PipelineGraph& graph = executor.graph();
+    assert(timeline.phases.size() == 6);
+    for (size_t i = 0; i < graph.size(); ++i) {
+        const StartupPhase& phase = timeline.phases[i];
+        assert(phase.status == StartupStatus::Started && phase.name == graph.node(i).name);
+        assert(phase.end_ms - phase.begin_ms >= 59.0);
+        for (size_t in : graph.node(i).inputs) {
+            assert(phase.begin_ms >= timeline.phases[in].end_ms);
+            assert(phase.ready_ms >= timeline.phases[in].end_ms);
+        }
+    }
+    assert(timeline.sequentialMs() >= 359.0);
+    assert(timeline.total_ms < timeline.sequentialMs() * 0.75);
+    assert(executor.startupTimeline().total_ms == timeline.total_ms);
+    std::ostringstream text;
+    timeline.print(text);
+    assert(text.str().find("Startup timeline") != std::string::npos && text.str().find("#") != std::string::npos);
+
+    // 启动失败: 依赖它的组件不启动，无关的组件照常启动
+    config["sensors"][0]["start_fail"] = true;
+    config["sensors"][0]["start_ms"] = 0;
+    PipelineExecutor failing(config, 2);
+    bool thrown = false;
+    try {
+        failing.start();
+    } catch (const std::runtime_error& e) {
+        thrown = std::string(e.what()) == "probe start failure: s1";
+    }
+    assert(thrown);
+    const StartupTimeline& partial = failing.startupTimeline();
+    assert(partial.phases[graph.find("s1")].status == StartupStatus::Failed);
+    assert(partial.phases[graph.find("a")].status == StartupStatus::Skipped);
+    assert(partial.phases[graph.find("c")].status == StartupStatus::Skipped);
+    assert(partial.phases[graph.find("b")].status == StartupStatus::Started);
+    assert(partial.phases[graph.find("s2")].status == StartupStatus::Started);
+
+    std::cout << "并行启动测试通过！(" << timeline.total_ms << " ms, 逐个启动 " << timeline.sequentialMs() << " ms)" << std::endl;
+}
+
+void testPluginLoader() {
+    std::cout << "测试组件库按需加载..." << std::endl;
+
+    PluginLoader loader;
+    loader.addManifest(compiled({{"plugins", {
+        {{"library", TEST_PLUGIN_PATH}, {"types", {"test_plugin_echo"}}},
+        {{"library", TEST_PLUGIN_BAD_VERSION_PATH}, {"types", {"test_plugin_stale"}}},
+        {{"library", "/nonexistent/libduan_missing.so"}, {"types", {"test_plugin_missing"}}}
+    }}}).root());
+
+    // 配置只用到已静态注册的类型: 一个库都不加载
+    nlohmann::json builtin = {{"sensors", {{{"name", "lidar"}, {"type", "robosense"}}}}};
+    assert(loader.loadFor(compiled(builtin).root()) == 0);
+    assert(loader.loadedLibraries().empty());
+    assert(!ComponentRegistry::Contains("test_plugin_echo"));
+
+    // 用到插件类型时才加载，且只加载一次
+    nlohmann::json config = {
+        {"sensors", {{{"name", "lidar"}, {"type", "robosense"}}}},
+        {"algorithms", {{{"name", "echo1"}, {"type", "test_plugin_echo"}, {"input", {"lidar"}}},
+                        {{"name", "echo2"}, {"type", "test_plugin_echo"}, {"input", {"lidar"}}}}}
+    };
+    assert(loader.loadFor(compiled(config).root()) == 1);
+    assert(loader.isLoaded(TEST_PLUGIN_PATH));
+    assert(ComponentRegistry::Create("test_plugin_echo", compiled(config["algorithms"][0]).root()) != nullptr);
+    assert(loader.loadFor(compiled(config).root()) == 0);
+    assert(loader.loadedLibraries().size() == 1);
+
+    // 清单外的类型留给执行器报错
+    assert(!loader.ensureType("not_registered"));
+
+    // 接口版本不符、库不存在: 抛异常，不注册任何类型
+    bool thrown = false;
+    try {
+        loader.ensureType("test_plugin_stale");
+    } catch (const std::runtime_error& e) {
+        thrown = std::string(e.what()).find("接口版本") != std::string::npos;
+    }
+    assert(thrown);
+    assert(!loader.isLoaded(TEST_PLUGIN_BAD_VERSION_PATH));
+    thrown = false;
+    try {
+        loader.ensureType("test_plugin_missing");
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(loader.loadedLibraries().size() == 1);
+
+    // 同一类型声明由两个库提供
+    thrown = false;
+    try {
+        loader.addLibrary("libother.so", {"test_plugin_echo"});
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "组件库加载测试通过！" << std::endl;
+}
+
+void testConfigCache() {
+    std::cout << "测试二进制配置缓存..." << std::endl;
+
+    const std::string json_path = "test_config_cache.json";
+    const std::string cache_path = "test_config_cache.bin";
+    std::remove(cache_path.c_str());
+    const std::string text = R"({
+        "sensors": [{"name": "lidar", "type": "robosense", "rings": 16, "scale": 0.5, "enabled": true}],
+        "algorithms": [{"name": "clusters", "type": "ground_cluster", "input": ["lidar"], "offset": -3,
+                        "big": 18446744073709551615, "note": null, "empty": {}, "none": []}]
+    })";
+    std::ofstream(json_path) << text;
+
+    ConfigLoadOptions options;
+    options.cache_path = cache_path;
+    CompiledConfig first = ConfigCache::load(json_path, options);
+    assert(first.valid() && !first.mapped());
+
+    // 内容未变: 直接映射缓存
+    CompiledConfig second = ConfigCache::load(json_path, options);
+    assert(second.mapped() && second.sourceHash() == first.sourceHash());
+
+    // 视图读取与原 JSON（含话题解析结果）一致
+    nlohmann::json expected = nlohmann::json::parse(text);
+    resolvePipelineTopics(expected);
+    assert(second.root().toJson() == expected);
+    ConfigView lidar = second.root().at("sensors")[0];
+    assert(lidar.at("name").asString() == "lidar");
+    assert(lidar.at("rings").asInt() == 16 && lidar.at("scale").asDouble() == 0.5 && lidar.at("enabled").asBool());
+    assert(lidar.value("missing", 7) == 7 && lidar.value("topic", "") == "/lidar");
+    ConfigView algo = second.root().at("algorithms")[0];
+    assert(algo.at("input").size() == 1 && algo.at("input")[0].asString() == "lidar");
+    assert(algo.at("offset").asInt() == -3 && algo.at("big").asUnsigned() == 18446744073709551615ull);
+    assert(algo.at("note").isNull() && algo.at("empty").isObject() && algo.at("none").size() == 0);
+    assert(!algo.contains("nope"));
+    bool thrown = false;
+    try {
+        algo.at("name").asInt();
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 源文件改动后哈希不符，重新编译
+    std::ofstream(json_path) << R"({"sensors": [{"name": "gnss", "type": "ublox"}]})";
+    CompiledConfig changed = ConfigCache::load(json_path, options);
+    assert(!changed.mapped() && changed.sourceHash() != first.sourceHash());
+    assert(changed.root().at("sensors")[0].at("name").asString() == "gnss");
+    assert(ConfigCache::load(json_path, options).mapped());
+
+    // 截断的缓存文件被拒绝并重建
+    {
+        std::ifstream in(cache_path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream(cache_path, std::ios::binary | std::ios::trunc) << bytes.substr(0, bytes.size() / 2);
+    }
+    assert(!CompiledConfig::map(cache_path).valid());
+    assert(!ConfigCache::load(json_path, options).mapped());
+    assert(ConfigCache::load(json_path, options).mapped());
+
+    // 偏移加长度会回绕的缓存同样被拒绝
+    {
+        std::ifstream in(cache_path, std::ios::binary);
+        const std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        auto rewrite = [&](auto patch) {
+            std::string corrupt = bytes;
+            patch(corrupt);
+            std::ofstream(cache_path, std::ios::binary | std::ios::trunc) << corrupt;
+            return CompiledConfig::map(cache_path).valid();
+        };
+        config_binary::Header header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        size_t string_node = 0;
+        for (size_t i = 0; i < header.node_count; ++i) {
+            config_binary::Node node;
+            std::memcpy(&node, bytes.data() + header.nodes_offset + i * sizeof(node), sizeof(node));
+            if (node.type == config_binary::Type::String) {
+                string_node = i;
+                break;
+            }
+        }
+        assert(string_node != 0);
+        assert(!rewrite([&](std::string& data) {
+            config_binary::Node node;
+            char* at = &data[header.nodes_offset + string_node * sizeof(node)];
+            std::memcpy(&node, at, sizeof(node));
+            node.payload = ~uint64_t(0) - node.count / 2;
+            std::memcpy(at, &node, sizeof(node));
+        }));
+        assert(!rewrite([&](std::string& data) {
+            config_binary::Node node;
+            char* at = &data[header.nodes_offset];
+            std::memcpy(&node, at, sizeof(node));
+            node.payload = ~uint64_t(0) - node.count / 2;
+            std::memcpy(at, &node, sizeof(node));
+        }));
+        assert(!rewrite([&](std::string& data) {
+            config_binary::Header h = header;
+            h.nodes_offset = ~uint64_t(0) - sizeof(config_binary::Node) + 1;
+            std::memcpy(&data[0], &h, sizeof(h));
+        }));
+        assert(rewrite([](std::string&) {}));
+    }
+
+    // 依赖图非法的配置编译失败
+    thrown = false;
+    try {
+        ConfigCache::compileText(R"({"algorithms": [{"name": "a", "type": "ekf", "input": ["ghost"]}]})");
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::remove(json_path.c_str());
+    std::remove(cache_path.c_str());
+    std::cout << "二进制配置缓存测试通过！(" << second.byteSize() << " 字节)" << std::endl;
+}
+
+struct SchemaProbeConfig : PortConfig {
+    int rings = 1;
+    double scale = 1.0;
+    bool enabled = false;
+    unsigned count = 0;
+    std::string mode;
+    std::vector<std::string> tags;
+};
+
+DUAN_CONFIG_SCHEMA_EXTENDS(SchemaProbeConfig, duan::PortConfig,
+    DUAN_FIELD(rings),
+    DUAN_FIELD(scale),
+    DUAN_FIELD(enabled),
+    DUAN_FIELD(count),
+    DUAN_REQUIRED(mode),
+    DUAN_FIELD(tags))
+
+void testConfigSchema() {
+    std::cout << "测试配置结构体解码..." << std::endl;
+
+    const std::string text = R"({"name": "probe", "input": ["lidar", "camera"], "rings": 64, "scale": 2,
+        "enabled": true, "count": 3, "mode": "fast", "tags": ["a", "b"],
+        "extra": {"nested": [1, {"rings": 5}]}, "queue_depth": 8})";
+
+    // 一遍 SAX 解析，未声明的字段（含嵌套）跳过，基类字段一并解码
+    SchemaProbeConfig sax = decodeConfigText<SchemaProbeConfig>(text);
+    assert(sax.name == "probe" && sax.input == std::vector<std::string>({"lidar", "camera"}));
+    assert(sax.rings == 64 && sax.scale == 2.0 && sax.enabled && sax.count == 3 && sax.mode == "fast");
+    assert(sax.tags == std::vector<std::string>({"a", "b"}) && sax.queue_depth == 8);
+    assert(sax.queue_policy == "keep_latest" && sax.topic.empty());
+
+    // DOM 与二进制配置走同一套字段描述，结果一致
+    const nlohmann::json dom = nlohmann::json::parse(text);
+    SchemaProbeConfig from_dom = decodeConfig<SchemaProbeConfig>(dom);
+    CompiledConfig compiled = CompiledConfig::compile(dom, 0, 0);
+    SchemaProbeConfig from_view = decodeConfig<SchemaProbeConfig>(compiled.root());
+    for (const SchemaProbeConfig* c : {&from_dom, &from_view}) {
+        assert(c->rings == sax.rings && c->scale == sax.scale && c->enabled && c->count == sax.count);
+        assert(c->mode == sax.mode && c->tags == sax.tags && c->input == sax.input && c->queue_depth == 8);
+    }
+
+    auto error = [](const std::string& json_text) {
+        try {
+            decodeConfigText<SchemaProbeConfig>(json_text);
+        } catch (const std::invalid_argument& e) {
+            return std::string(e.what());
+        }
+        return std::string();
+    };
+    assert(error(R"({"mode": "a", "rings": "many"})").find("rings") != std::string::npos);
+    assert(error(R"({"mode": "a", "rings": 1.5})").find("integer") != std::string::npos);
+    assert(error(R"({"mode": "a", "count": -1})").find("超出范围") != std::string::npos);
+    assert(error(R"({"mode": "a", "tags": ["x", 1]})").find("tags") != std::string::npos);
+    assert(error(R"({"mode": "a", "enabled": {"on": true}})").find("enabled") != std::string::npos);
+    assert(error(R"({"rings": 2})").find("缺少必填字段 mode") != std::string::npos);
+    assert(!error(R"([1, 2])").empty());
+    assert(!error(R"({"mode": )").empty());
+    assert(error(R"({"mode": "a"})").empty());
+
+    // 执行器在创建任何组件前检查全部节点，一次报告所有错误
+    nlohmann::json config = {
+        {"sensors", {{{"name", "lidar"}, {"type", "robosense"}, {"rings", "many"}},
+                     {{"name", "camera"}, {"type", "hikvision"}, {"height", "tall"}}}},
+        {"algorithms", {{{"name", "det"}, {"type", "yolox"}, {"input", {"camera"}}, {"max_batch", 4}}}}
+    };
+    std::string message;
+    try {
+        PipelineExecutor executor(config, 1);
+    } catch (const std::runtime_error& e) {
+        message = e.what();
+    }
+    assert(message.find("lidar (robosense)") != std::string::npos && message.find("rings") != std::string::npos);
+    assert(message.find("camera (hikvision)") != std::string::npos && message.find("height") != std::string::npos);
+    assert(message.find("det") == std::string::npos);
+
+    // 每个节点的配置只解码一次: 检查时解码出的结构体直接用于创建组件
+    struct Quiet : Component {
+        void start() override {}
+        void spinOnce() override {}
+    };
+    static int decodes = 0;
+    static int created = 0;
+    auto typed = ComponentRegistry::typedPreparer<SchemaProbeConfig>([](const SchemaProbeConfig& cfg) {
+        assert(cfg.mode == "fast" && cfg.rings == 8);
+        ++created;
+        return std::make_shared<Quiet>();
+    });
+    ComponentRegistry::RegisterPreparer("test_schema_probe", [typed](const ConfigView& cfg) {
+        ++decodes;
+        return typed(cfg);
+    });
+    nlohmann::json probes = {{"sensors", {{{"name", "p1"}, {"type", "test_schema_probe"}, {"mode", "fast"}, {"rings", 8}},
+                                          {{"name", "p2"}, {"type", "test_schema_probe"}, {"mode", "fast"}, {"rings", 8}}}}};
+    {
+        PipelineExecutor executor(probes, 1);
+        assert(decodes == 2 && created == 2);
+    }
+
+    std::cout << "配置结构体解码测试通过！" << std::endl;
+}
+
+class NullComponent : public Component {
+public:
+    void start() override {}
+    void spinOnce() override {}
+};
+
+void testRegistrySnapshots() {
+    std::cout << "测试注册表快照与完美哈希..." << std::endl;
+
+    auto creator = [](const ConfigView&) { return std::make_shared<NullComponent>(); };
+    const size_t builtin = ComponentRegistry::Types().size();
+
+    // 读者持续查找，同时注册新类型: 已有类型始终可见，新类型出现后不再消失
+    std::atomic<bool> stop{false};
+    std::atomic<int> misses{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&] {
+            bool seen_last = false;
+            while (!stop.load(std::memory_order_acquire)) {
+                if (!ComponentRegistry::Find("robosense")) {
+                    misses.fetch_add(1);
+                }
+                const bool seen = ComponentRegistry::Find("test_reg_63") != nullptr;
+                if (seen_last && !seen) {
+                    misses.fetch_add(1);
+                }
+                seen_last = seen;
+            }
+        });
+    }
+    for (int i = 0; i < 300; ++i) {
+        ComponentRegistry::Register("test_reg_" + std::to_string(i), creator);
+    }
+    stop.store(true, std::memory_order_release);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    assert(misses.load() == 0);
+    assert(ComponentRegistry::Types().size() == builtin + 300);
+
+    // 句柄注册后不变；同名再注册替换，旧句柄仍可用
+    ComponentRegistry::Handle first = ComponentRegistry::Find("test_reg_0");
+    assert(first && first->type == "test_reg_0");
+    ComponentRegistry::Register("test_reg_0", [](const ConfigView&) { return std::shared_ptr<Component>(); });
+    ComponentRegistry::Handle replaced = ComponentRegistry::Find("test_reg_0");
+    assert(replaced != first && !ComponentRegistry::Create(replaced, {}));
+    assert(ComponentRegistry::Create(first, {}) != nullptr);
+    assert(ComponentRegistry::Types().size() == builtin + 300);
+
+    // 封存后改用完美哈希，查找结果与封存前一致
+    std::vector<ComponentRegistry::Handle> before;
+    for (const auto& type : ComponentRegistry::Types()) {
+        before.push_back(ComponentRegistry::Find(type));
+    }
+    ComponentRegistry::Seal();
+    assert(ComponentRegistry::IsSealed());
+    const auto types = ComponentRegistry::Types();
+    for (size_t i = 0; i < types.size(); ++i) {
+        assert(ComponentRegistry::Find(types[i]) == before[i]);
+    }
+    for (const char* unknown : {"", "test_reg_", "test_reg_300", "robosense ", "test_reg_00", "not_registered"}) {
+        assert(ComponentRegistry::Find(unknown) == nullptr);
+    }
+    nlohmann::json lidar = {{"name", "lidar"}, {"type", "robosense"}, {"topic", "/lidar/points"}};
+    assert(ComponentRegistry::Create("robosense", compiled(lidar).root()) != nullptr);
+
+    // 封存后仍可注册（运行中加载插件）
+    ComponentRegistry::Register("test_reg_late", creator);
+    assert(ComponentRegistry::IsSealed() && ComponentRegistry::Create("test_reg_late", {}) != nullptr);
+    assert(ComponentRegistry::Find("test_reg_299") != nullptr);
+
+    std::cout << "注册表快照测试通过！(" << types.size() << " 个类型)" << std::endl;
+}
+
+void testHotReload() {
+    std::cout << "测试配置热加载..." << std::endl;
+
+    nlohmann::json config = {
+        {"sensors", {
+            {{"name", "r1"}, {"type", "test_probe"}},
+            {{"name", "r2"}, {"type", "test_probe"}},
+            {{"name", "r3"}, {"type", "test_probe"}}
+        }},
+        {"algorithms", {
+            {{"name", "ra"}, {"type", "test_probe"}, {"input", {"r1"}}},
+            {{"name", "rb"}, {"type", "test_probe"}, {"input", {"r2"}}},
+            {{"name", "rc"}, {"type", "test_probe"}, {"input", {"ra"}}},
+            {{"name", "rd"}, {"type", "test_probe"}, {"input", {"rb"}}}
+        }}
+    };
+    PipelineExecutor executor(config, 2);
+    executor.start();
+    executor.run(2);
+    std::map<std::string, std::shared_ptr<Component>> before;
+    for (const auto& node : executor.graph().nodes()) {
+        before[node.name] = executor.component(node.name);
+    }
+
+    // 配置不变: 什么都不重建
+    ReloadPlan same = executor.reload(config);
+    assert(same.empty() && same.kept.size() == 7);
+    for (const auto& kv : before) {
+        assert(executor.component(kv.first) == kv.second);
+    }
+
+    // 改 ra 的参数、删除 rd、新增 re: 只重建 ra 及其下游 rc 和新增的 re
+    nlohmann::json next = config;
+    next["algorithms"][0]["gain"] = 2;
+    next["algorithms"].erase(3);
+    next["algorithms"].push_back({{"name", "re"}, {"type", "test_probe"}, {"input", {"r3", "rb"}}});
+    ReloadPlan plan = executor.reload(next);
+    assert(plan.changed == std::vector<std::string>{"ra"});
+    assert(plan.downstream == std::vector<std::string>{"rc"});
+    assert(plan.added == std::vector<std::string>{"re"});
+    assert(plan.removed == std::vector<std::string>{"rd"});
+    assert(plan.kept.size() == 4 && plan.rebuilt() == 3);
+    for (const char* name : {"r1", "r2", "r3", "rb"}) {
+        assert(executor.component(name) == before[name]);
+    }
+    assert(executor.component("ra") != before["ra"] && executor.component("rc") != before["rc"]);
+    assert(executor.component("rd") == nullptr && executor.component("re") != nullptr);
+    // 保留的组件沿用统计，重建的从零开始
+    executor.runFrame();
+    assert(executor.stats("r1").frames == 3 && executor.stats("rb").frames == 3);
+    assert(executor.stats("ra").frames == 1 && executor.stats("re").frames == 1);
+    std::ostringstream text;
+    plan.print(text);
+    assert(text.str().find("downstream: rc") != std::string::npos);
+
+    // 失败时原流水线不变: 未注册的类型、启动失败、依赖不存在
+    std::vector<nlohmann::json> broken(3, next);
+    broken[0]["algorithms"][0]["type"] = "not_registered";
+    broken[1]["algorithms"][1]["start_fail"] = true;
+    broken[2]["algorithms"][2]["input"] = {"missing"};
+    const auto current = executor.component("ra");
+    for (const auto& bad : broken) {
+        bool thrown = false;
+        try {
+            executor.reload(bad);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+        assert(executor.graph().size() == 7 && executor.component("ra") == current);
+        assert(executor.component("r2") == before["r2"]);
+    }
+    executor.runFrame();
+    assert(executor.stats("r1").frames == 4);
+
+    // 后台热加载: 新配置就绪前帧照常运行、原组件不变，完成后在帧间替换
+    std::promise<void> go;
+    std::shared_future<void> ready = go.get_future().share();
+    nlohmann::json slow = next;
+    slow["algorithms"][0]["gain"] = 3;
+    executor.beginReload([ready, slow] {
+        ready.wait();
+        return std::make_shared<const CompiledConfig>(CompiledConfig::compile(slow));
+    });
+    bool busy = false;
+    try {
+        executor.reload(slow);
+    } catch (const std::runtime_error&) {
+        busy = true;
+    }
+    assert(busy && executor.reloading());
+    executor.runFrame();
+    assert(!executor.pollReload() && executor.component("ra") == current);
+    go.set_value();
+    std::optional<ReloadPlan> applied;
+    while (!(applied = executor.pollReload())) {
+        executor.runFrame();
+    }
+    assert(!executor.reloading() && applied->changed == std::vector<std::string>{"ra"});
+    assert(executor.component("ra") != current && executor.component("r1") == before["r1"]);
+    // 后台启动失败: pollReload 抛出，原流水线不变，可以再次开始
+    const auto async_ra = executor.component("ra");
+    executor.beginReload(std::make_shared<const CompiledConfig>(CompiledConfig::compile(broken[1])));
+    bool failed = false;
+    try {
+        while (!executor.pollReload()) {
+            executor.runFrame();
+        }
+    } catch (const std::runtime_error&) {
+        failed = true;
+    }
+    assert(failed && !executor.reloading() && executor.component("ra") == async_ra);
+    executor.beginReload(std::make_shared<const CompiledConfig>(CompiledConfig::compile(slow)));
+    while (!(applied = executor.pollReload())) {
+        executor.runFrame();
+    }
+    assert(applied->empty() && executor.component("ra") == async_ra);
+
+    // 带话题端口的组件: 被替换的实例析构时取消订阅，传感器的发布不受影响
+    nlohmann::json topics = {
+        {"sensors", {{{"name", "hr_lidar"}, {"type", "robosense"}, {"topic", "/hr/lidar"}, {"rings", 16}, {"beams", 180}}}},
+        {"algorithms", {{{"name", "hr_cluster"}, {"type", "ground_cluster"}, {"input", {"hr_lidar"}}, {"sectors", 32}}}}
+    };
+    resolvePipelineTopics(topics);
+    PipelineExecutor pipeline(topics, 1);
+    pipeline.start();
+    pipeline.run(2);
+    const auto lidar = pipeline.component("hr_lidar");
+    assert(TopicBus::global().subscriberCount("/hr/lidar") == 1);
+    for (int sectors : {16, 24, 48}) {
+        topics["algorithms"][0]["sectors"] = sectors;
+        ReloadPlan changed = pipeline.reload(topics);
+        assert(changed.changed.size() == 1 && changed.kept == std::vector<std::string>{"hr_lidar"});
+        assert(TopicBus::global().subscriberCount("/hr/lidar") == 1);
+        pipeline.runFrame();
+    }
+    assert(pipeline.component("hr_lidar") == lidar && pipeline.stats("hr_lidar").frames == 5);
+    assert(pipeline.stats("hr_cluster").frames == 1);
+    // 反复热加载不累积被替换实例的订阅
+    for (int i = 0; i < 50; ++i) {
+        topics["algorithms"][0]["sectors"] = 16 + i % 2 * 16;
+        pipeline.reload(topics);
+        pipeline.runFrame();
+        assert(TopicBus::global().retainedCount("/hr/lidar") == 1);
+    }
+
+    // 文件监视: 只 touch 或写回相同内容不算修改
+    const std::string path = "hot_reload_test.json";
+    std::ofstream(path) << config.dump();
+    ConfigWatcher watcher(path);
+    assert(!watcher.poll());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    std::ofstream(path) << config.dump();
+    assert(!watcher.poll());
+    std::ofstream(path) << next.dump();
+    assert(watcher.poll());
+    assert(!watcher.poll());
+    std::remove(path.c_str());
+    assert(!watcher.poll());
+
+    std::cout << "配置热加载测试通过！" << std::endl;
+}
+
+// 组件名 -> 执行过它的线程，"record_threads": true 时记录
+std::map<std::string, std::set<std::thread::id>> g_work_threads;
+
+// 每帧忙等 work_us 微秒并分配 allocs 次，用于验证 Profiler 的计时与分配统计
+class WorkComponent : public Component {
+    std::string name_;
+    int work_us_;
+    int allocs_;
+    bool record_threads_;
+public:
+    explicit WorkComponent(const ConfigView& cfg)
+        : name_(cfg.at("name").asString()), work_us_(cfg.value("work_us", 0)), allocs_(cfg.value("allocs", 0)),
+          record_threads_(cfg.value("record_threads", false)) {}
+    void start() override {}
+    void spinOnce() override {
+        if (record_threads_) {
+            std::lock_guard<std::mutex> lock(g_probe_mutex);
+            g_work_threads[name_].insert(std::this_thread::get_id());
+        }
+        std::vector<std::unique_ptr<int>> held;
+        held.reserve(allocs_);
+        for (int i = 0; i < allocs_; ++i) {
+            held.push_back(std::make_unique<int>(i));
+        }
+        const auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(work_us_);
+        while (std::chrono::steady_clock::now() < end) {
+        }
+    }
+};
+
+void testProfiler() {
+    std::cout << "测试组件性能剖析..." << std::endl;
+
+    Histogram histogram;
+    for (uint64_t v = 1; v <= 1000; ++v) {
+        histogram.record(v);
+    }
+    assert(histogram.count() == 1000 && histogram.min() == 1 && histogram.max() == 1000);
+    const uint64_t p50 = histogram.percentile(50);
+    const uint64_t p99 = histogram.percentile(99);
+    assert(p50 >= 440 && p50 <= 560 && p99 >= 870 && p99 <= 1000);
+    assert(histogram.percentile(0) == 1 && histogram.percentile(100) == 1000);
+
+    ComponentRegistry::Register("test_work", [](const ConfigView& cfg) { return std::make_shared<WorkComponent>(cfg); });
+    // 单线程执行: 源节点按配置顺序提交，fast 分支排在整条 slow 分支之后，
+    // 关键路径是 pw_fast_src -> pw_fast -> pw_join，其中 pw_fast_src 的排队等待占了大头
+    nlohmann::json config = {
+        {"executor", {{"threads", 1}, {"profile", true}}},
+        {"sensors", {
+            {{"name", "pw_slow_src"}, {"type", "test_work"}, {"work_us", 300}},
+            {{"name", "pw_fast_src"}, {"type", "test_work"}, {"work_us", 50}}
+        }},
+        {"algorithms", {
+            {{"name", "pw_slow"}, {"type", "test_work"}, {"input", {"pw_slow_src"}}, {"work_us", 3000}, {"allocs", 20}},
+            {{"name", "pw_fast"}, {"type", "test_work"}, {"input", {"pw_fast_src"}}, {"work_us", 50}},
+            {{"name", "pw_join"}, {"type", "test_work"}, {"input", {"pw_fast", "pw_slow"}}, {"work_us", 100}}
+        }}
+    };
+    PipelineExecutor executor(config, executorOptions(compiled(config).root()));
+    assert(executor.profiler() != nullptr && executor.threads() == 1);
+    executor.start();
+    const int frames = 20;
+    executor.run(frames);
+
+    const Profiler& profiler = *executor.profiler();
+    assert(profiler.frameCount() == frames && profiler.frames().size() == frames);
+    uint64_t dominant = 0;
+    const auto path = profiler.dominantPath(&dominant);
+    assert((path == std::vector<std::string>{"pw_fast_src", "pw_fast", "pw_join"}));
+    assert(dominant == frames);
+
+    const ComponentProfile* slow = profiler.component("pw_slow");
+    const ComponentProfile* fast_src = profiler.component("pw_fast_src");
+    assert(slow && fast_src && slow->wall_ns.count() == frames && slow->queue_wait_ns.count() == frames);
+    assert(slow->wall_ns.percentile(50) >= 2800 * 1000);
+    assert(slow->cpu_ns.max() > 0 && slow->cpu_ns.percentile(50) <= slow->wall_ns.percentile(50) * 1.15);
+    assert(slow->allocations.min() >= 20);
+    assert(slow->critical_frames == 0 && fast_src->critical_frames == frames);
+    assert(fast_src->queue_wait_ns.percentile(50) >= 3000 * 1000);
+    assert(fast_src->critical_ns / frames >= 3000 * 1000);
+    assert(profiler.frameLatency().percentile(50) >= 3300 * 1000);
+
+    // 每帧的关键路径都标记到对应的执行记录上
+    for (const FrameProfile& frame : profiler.frames()) {
+        size_t critical = 0;
+        for (const ComponentSpan& span : frame.spans) {
+            assert(span.executed && span.begin_ns >= span.ready_ns && span.end_ns >= span.begin_ns);
+            critical += span.critical ? 1 : 0;
+        }
+        assert(critical == frame.critical_path.size());
+    }
+
+    std::ostringstream text;
+    profiler.print(text);
+    assert(text.str().find("critical path") != std::string::npos && text.str().find("pw_slow") != std::string::npos);
+    std::ostringstream trace;
+    profiler.writeChromeTrace(trace);
+    const nlohmann::json events = nlohmann::json::parse(trace.str()).at("traceEvents");
+    size_t spans = 0;
+    size_t critical = 0;
+    for (const auto& event : events) {
+        if (event.at("ph") == "X" && event.at("cat") != "frame") {
+            ++spans;
+            critical += event.at("args").at("critical").get<bool>() ? 1 : 0;
+        }
+    }
+    assert(spans == 5 * frames && critical == 3 * frames);
+
+    // 热加载后按名称沿用统计，新组件从零开始
+    config["algorithms"].push_back({{"name", "pw_tail"}, {"type", "test_work"}, {"input", {"pw_join"}}});
+    executor.reload(config);
+    executor.runFrame();
+    assert(profiler.component("pw_slow")->wall_ns.count() == frames + 1);
+    assert(profiler.component("pw_tail")->wall_ns.count() == 1);
+    const std::vector<size_t>& last_path = profiler.frames().back().critical_path;
+    assert(last_path.size() == 4 && profiler.components()[last_path.back()].name == "pw_tail");
+
+    std::cout << "性能剖析测试通过！(关键路径 " << path.size() << " 个组件, p50 "
+              << profiler.frameLatency().percentile(50) / 1000 << " us/帧)" << std::endl;
+}
+
+// "hold_start": true 的 RelayComponent 在 start() 中等到它被清除，模拟很慢的初始化
+std::atomic<bool> g_relay_hold{false};
+
+// 每处理一帧发布一条消息，seq 为累计处理的帧数
+class RelayComponent : public TopicComponent {
+    uint64_t count_ = 0;
+    bool hold_;
+public:
+    explicit RelayComponent(const ConfigView& cfg) : TopicComponent(cfg), hold_(cfg.value("hold_start", false)) {}
+    void start() override {
+        while (hold_ && g_relay_hold.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    void process(const FrameContext&, const Inputs&, Outputs& out) override {
+        auto msg = std::make_shared<Message>();
+        msg->seq = ++count_;
+        out.publish(msg);
+    }
+};
+
+void testBackpressure() {
+    std::cout << "测试有界队列与按额度流控..." << std::endl;
+
+    // block: 队列满时发布方等待消费者，不丢消息
+    TopicBus bus;
+    Publisher pub = bus.advertise("/bp");
+    assert(pub.credits() == SIZE_MAX);
+    auto sub = bus.subscribe("/bp", {2, QueuePolicy::Block, std::chrono::milliseconds(2000)});
+    assert(pub.publish(std::make_shared<Message>()) == 1 && pub.publish(std::make_shared<Message>()) == 1);
+    assert(pub.credits() == 0 && sub->credits() == 0 && sub->peak() == 2);
+    std::thread consumer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        MessagePtr msg;
+        sub->take(msg);
+    });
+    assert(pub.publish(std::make_shared<Message>()) == 1);
+    consumer.join();
+    assert(sub->blocked() == 1 && sub->dropped() == 0 && sub->received() == 3 && sub->pending() == 2);
+    // 等待超时后丢弃，发布方不会永远卡住
+    auto stalled = bus.subscribe("/bp_stalled", {1, QueuePolicy::Block, std::chrono::milliseconds(10)});
+    Publisher stalled_pub = bus.advertise("/bp_stalled");
+    stalled_pub.publish(std::make_shared<Message>());
+    const auto t0 = std::chrono::steady_clock::now();
+    assert(stalled_pub.publish(std::make_shared<Message>()) == 0);
+    assert(std::chrono::steady_clock::now() - t0 >= std::chrono::milliseconds(10));
+    assert(stalled->dropped() == 1 && stalled->pending() == 1);
+
+    // 流水线: bp_src -> bp_mid -> 外部的慢消费者（block，深度3，暂不取）
+    ComponentRegistry::Register("test_relay", [](const ConfigView& cfg) { return std::make_shared<RelayComponent>(cfg); });
+    nlohmann::json config = {
+        {"sensors", {{{"name", "bp_src"}, {"type", "test_relay"}}}},
+        {"algorithms", {{{"name", "bp_mid"}, {"type", "test_relay"}, {"input", {"bp_src"}},
+                         {"queue_depth", 2}, {"queue_policy", "block"}}}}
+    };
+    resolvePipelineTopics(config);
+    auto slow = TopicBus::global().subscribe("/bp_mid", {3, QueuePolicy::Block});
+    PipelineExecutor executor(config, 1);
+    executor.start();
+    executor.run(10);
+    // bp_mid 用完3个额度后被推迟，输入队列积满2条后额度耗尽，背压传回传感器
+    assert(slow->pending() == 3 && slow->dropped() == 0 && slow->blocked() == 0);
+    assert(executor.stats("bp_mid").frames == 3 && executor.stats("bp_mid").throttled == 7);
+    assert(executor.stats("bp_src").frames == 5 && executor.stats("bp_src").throttled == 5);
+    const std::vector<EdgeStats> edges = executor.edgeStats();
+    assert(edges.size() == 1 && edges[0].from == "bp_src" && edges[0].to == "bp_mid");
+    assert(edges[0].policy == QueuePolicy::Block && edges[0].depth == 2 && edges[0].peak == 2);
+    assert(edges[0].capacity == 2 && edges[0].dropped == 0 && edges[0].received == 5);
+
+    // 慢消费者取走消息后按顺序恢复，全程没有丢失
+    std::vector<uint64_t> seqs;
+    for (int frame = 0; frame < 6; ++frame) {
+        MessagePtr msg;
+        while (slow->take(msg)) {
+            seqs.push_back(msg->seq);
+        }
+        executor.runFrame();
+    }
+    MessagePtr msg;
+    while (slow->take(msg)) {
+        seqs.push_back(msg->seq);
+    }
+    for (size_t i = 0; i < seqs.size(); ++i) {
+        assert(seqs[i] == i + 1);
+    }
+    assert(seqs.size() >= 8 && executor.stats("bp_mid").frames == seqs.size());
+
+    // 传感器的出边改为 keep_latest: 传感器不受下游拖累，丢弃最旧的帧
+    config["algorithms"][0]["queue_policy"] = "drop_oldest";
+    executor.reload(config);
+    const uint64_t src_frames = executor.stats("bp_src").frames;
+    executor.run(10);
+    assert(executor.stats("bp_src").frames == src_frames + 10);
+    const EdgeStats edge = executor.edgeStats()[0];
+    assert(edge.policy == QueuePolicy::KeepLatest && edge.dropped > 0 && edge.depth <= edge.capacity);
+    std::ostringstream text;
+    executor.printEdgeStats(text);
+    assert(text.str().find("bp_src -> bp_mid") != std::string::npos);
+
+    // 后台热加载换成 block 输入、启动很慢的 bp_mid: 切换前新实例的订阅不接收消息、不占额度，
+    // 保留的传感器每帧照常产出，从不被推迟
+    g_relay_hold = true;
+    config["algorithms"][0]["queue_policy"] = "block";
+    config["algorithms"][0]["hold_start"] = true;
+    const std::string src_topic = config["sensors"][0]["topic"];
+    executor.beginReload(std::make_shared<const CompiledConfig>(CompiledConfig::compile(config)));
+    while (TopicBus::global().subscriberCount(src_topic) < 2) {
+        executor.runFrame();
+    }
+    const NodeStats src_before = executor.stats("bp_src");
+    executor.run(10);
+    assert(!executor.pollReload());
+    assert(executor.stats("bp_src").frames == src_before.frames + 10);
+    assert(executor.stats("bp_src").throttled == src_before.throttled);
+    g_relay_hold = false;
+    while (!executor.pollReload()) {
+        executor.runFrame();
+    }
+    assert(executor.stats("bp_src").throttled == src_before.throttled);
+    assert(executor.edgeStats()[0].policy == QueuePolicy::Block && executor.edgeStats()[0].depth == 0);
+    executor.run(3);
+    assert(executor.edgeStats()[0].received > 0);
+    TopicBus::global().unsubscribe(slow);
+
+    std::cout << "流控测试通过！" << std::endl;
+}
+
+// 需要独占线程的组件，不参与链合并
+class SoloComponent : public Component {
+public:
+    void start() override {}
+    bool fusible() const override { return false; }
+};
+
+void testChainFusion() {
+    std::cout << "测试线性链合并..." << std::endl;
+
+    ComponentRegistry::Register("test_solo", [](const ConfigView&) { return std::make_shared<SoloComponent>(); });
+    // cf_s1 -> cf_f -> cf_p -> cf_d -> cf_j -> cf_t，cf_s2 同时连到 cf_j 和 cf_x
+    nlohmann::json config = {
+        {"executor", {{"threads", 2}, {"profile", true}}},
+        {"sensors", {
+            {{"name", "cf_s1"}, {"type", "test_work"}, {"work_us", 20}},
+            {{"name", "cf_s2"}, {"type", "test_work"}, {"work_us", 20}}
+        }},
+        {"algorithms", {
+            {{"name", "cf_f"}, {"type", "test_work"}, {"input", {"cf_s1"}}, {"work_us", 20}},
+            {{"name", "cf_p"}, {"type", "test_work"}, {"input", {"cf_f"}}, {"work_us", 20}},
+            {{"name", "cf_d"}, {"type", "test_work"}, {"input", {"cf_p"}}, {"work_us", 20}},
+            {{"name", "cf_j"}, {"type", "test_work"}, {"input", {"cf_d", "cf_s2"}}, {"work_us", 20}},
+            {{"name", "cf_t"}, {"type", "test_work"}, {"input", {"cf_j"}}, {"work_us", 20}},
+            {{"name", "cf_x"}, {"type", "test_work"}, {"input", {"cf_s2"}}, {"work_us", 20}}
+        }}
+    };
+    PipelineExecutor executor(config, executorOptions(compiled(config).root()));
+    const PipelineGraph& graph = executor.graph();
+    auto names = [&](const std::vector<size_t>& task) {
+        std::vector<std::string> out;
+        for (size_t i : task) {
+            out.push_back(graph.node(i).name);
+        }
+        return out;
+    };
+    auto hasTask = [&](const std::vector<std::string>& expected) {
+        for (const auto& task : executor.tasks()) {
+            if (names(task) == expected) {
+                return true;
+            }
+        }
+        return false;
+    };
+    assert(executor.tasks().size() == 4);
+    assert(hasTask({"cf_s1", "cf_f", "cf_p", "cf_d"}) && hasTask({"cf_j", "cf_t"}));
+    assert(hasTask({"cf_s2"}) && hasTask({"cf_x"}));
+
+    // 合并后仍按组件统计；同一条链每帧在同一线程上接连执行
+    executor.start();
+    executor.run(10);
+    for (const auto& node : graph.nodes()) {
+        assert(executor.stats(node.name).frames == 10);
+        assert(executor.profiler()->component(node.name)->wall_ns.count() == 10);
+    }
+    for (const FrameProfile& frame : executor.profiler()->frames()) {
+        const ComponentSpan& head = frame.spans[graph.find("cf_s1")];
+        int64_t previous_end = head.end_ns;
+        for (const char* name : {"cf_f", "cf_p", "cf_d"}) {
+            const ComponentSpan& span = frame.spans[graph.find(name)];
+            assert(span.thread == head.thread && span.begin_ns >= previous_end);
+            previous_end = span.end_ns;
+        }
+    }
+
+    // 配置 "fuse": false 或组件声明 fusible() == false 时不合并
+    nlohmann::json opted = config;
+    opted["algorithms"][1]["fuse"] = false;
+    opted["algorithms"][4]["type"] = "test_solo";
+    executor.reload(opted);
+    assert(executor.tasks().size() == 7);
+    assert(hasTask({"cf_s1", "cf_f"}) && hasTask({"cf_p"}) && hasTask({"cf_d"}) && hasTask({"cf_j"}) && hasTask({"cf_t"}));
+    executor.runFrame();
+    assert(executor.stats("cf_s1").frames == 11 && executor.stats("cf_t").frames == 1);
+
+    // 关闭合并时每个节点单独调度
+    opted["executor"]["fuse_chains"] = false;
+    PipelineExecutor unfused(opted, executorOptions(compiled(opted).root()));
+    assert(unfused.tasks().size() == graph.size());
+    unfused.run(3);
+    assert(unfused.stats("cf_t").frames == 3 && unfused.stats("cf_s1").frames == 3);
+
+    std::cout << "线性链合并测试通过！" << std::endl;
+}
+
+void testRealtimeExecutor() {
+    std::cout << "测试实时执行器..." << std::endl;
+
+    // 实时组件必须有周期；未知的策略名报错
+    bool threw = false;
+    try {
+        RealtimeExecutor bad({{"sensors", {{{"name", "rt_bad"}, {"type", "test_work"}, {"priority", 10}}}}}, RealtimeOptions());
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        realtimeOptions(compiled({{"realtime", {{"policy", "round_robin"}}}}).root());
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // 类似 ekf 的定位组件: 10ms 周期、5ms 截止时间、1ms 开销；两个后台组件每次占用 20ms
+    // 只断言与机器负载无关的结论: 哪些线程执行了哪些组件，以及作业不可抢占必然导致的错过
+    nlohmann::json config = {
+        {"realtime", {{"policy", "edf"}, {"workers", 1}, {"background_workers", 1}}},
+        {"sensors", {
+            {{"name", "rt_ekf"}, {"type", "test_work"}, {"work_us", 1000}, {"priority", 90}, {"period_ms", 10}, {"deadline_ms", 5},
+             {"record_threads", true}},
+            {{"name", "rt_map"}, {"type", "test_work"}, {"work_us", 20000}, {"record_threads", true}},
+            {{"name", "rt_log"}, {"type", "test_work"}, {"work_us", 20000}, {"period_ms", 30}, {"record_threads", true}}
+        }}
+    };
+    RealtimeOptions options = realtimeOptions(compiled(config).root());
+    assert(options.policy == RtPolicy::EarliestDeadlineFirst && options.background_workers == 1);
+    auto sharesThread = [](const std::string& a, const std::string& b) {
+        for (const auto& id : g_work_threads[a]) {
+            if (g_work_threads[b].count(id)) {
+                return true;
+            }
+        }
+        return false;
+    };
+    {
+        RealtimeExecutor executor(config, options);
+        assert(executor.params("rt_ekf").priority == 90 && executor.params("rt_map").priority == 0);
+        g_work_threads.clear();
+        executor.start();
+        executor.runFor(std::chrono::milliseconds(300));
+        const RealtimeStats ekf = executor.stats("rt_ekf");
+        const RealtimeStats map = executor.stats("rt_map");
+        assert(ekf.completed >= 1);
+        // 后台组件只在后台线程上执行，ekf 从不排在 20ms 的后台作业后面
+        assert(map.completed >= 1 && map.deadline_misses == 0);
+        assert(!sharesThread("rt_ekf", "rt_map") && !sharesThread("rt_ekf", "rt_log"));
+        executor.print(std::cout);
+    }
+
+    // 没有后台线程时后台作业与 ekf 共用实时线程，作业不可抢占:
+    // 一个 20ms 的 map 作业期间 ekf 至少释放一次，要等到 map 完成，必然错过 5ms 的截止时间
+    config["realtime"]["background_workers"] = 0;
+    {
+        RealtimeExecutor executor(config, realtimeOptions(compiled(config).root()));
+        g_work_threads.clear();
+        executor.start();
+        executor.runFor(std::chrono::milliseconds(300));
+        const RealtimeStats ekf = executor.stats("rt_ekf");
+        assert(sharesThread("rt_ekf", "rt_map"));
+        // 第二个 map 作业开始前，第一个之后的 ekf 作业已经执行（或把错过的释放计入 skipped）
+        if (executor.stats("rt_map").completed >= 2) {
+            assert(ekf.deadline_misses > 0);
+        }
+    }
+
+    // 同时释放: EDF 先执行截止时间早的，固定优先级先执行 priority 高的
+    nlohmann::json order = {
+        {"sensors", {
+            {{"name", "rt_urgent"}, {"type", "test_probe"}, {"priority", 10}, {"period_ms", 50}, {"deadline_ms", 5}},
+            {{"name", "rt_important"}, {"type", "test_probe"}, {"priority", 90}, {"period_ms", 50}, {"deadline_ms", 40}}
+        }}
+    };
+    for (RtPolicy policy : {RtPolicy::EarliestDeadlineFirst, RtPolicy::FixedPriority}) {
+        RealtimeOptions single;
+        single.policy = policy;
+        single.background_workers = 0;
+        RealtimeExecutor executor(order, single);
+        g_probe_events.clear();
+        executor.runFor(std::chrono::milliseconds(20));
+        // 线程被拖慢超过一个周期时会有第二轮释放，只看第一轮的顺序
+        assert(g_probe_events.size() >= 2);
+        const std::string first = policy == RtPolicy::EarliestDeadlineFirst ? "rt_urgent" : "rt_important";
+        assert(g_probe_events[0].name == first && g_probe_events[1].name != first);
+    }
+
+    std::cout << "实时执行器测试通过！" << std::endl;
+}
+
+int main() {
+    std::cout << "=== 注册表组件单元测试 ===" << std::endl;
+
+    try {
+        testRegistryCreate();
+        testGroundSegmentation();
+        testTopicBus();
+        testPipelineTopics();
+        testPipelineExecutor();
+        testComponentBatching();
+        testWorkStealingScheduler();
+        testParallelStartup();
+        testPluginLoader();
+        testConfigCache();
+        testConfigSchema();
+        testRegistrySnapshots();
+        testHotReload();
+        testProfiler();
+        testBackpressure();
+        testChainFusion();
+        testRealtimeExecutor();
+
+        std::cout << "所有测试通过！" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "测试失败: " << e.what() << std::endl;
+        return 1;
+    }
+}